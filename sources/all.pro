@@ -10,6 +10,8 @@ DESTDIR = ./bin
 SUBDIRS = plugins/scg \
           #plugins/scn \
 #          plugins/scs \
-          kbe
+          kbe \
+          kbe-cli \
+          kbe-bench
 
 #win32: SUBDIRS += updater
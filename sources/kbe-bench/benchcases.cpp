@@ -0,0 +1,329 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "benchcases.h"
+#include "benchrunner.h"
+#include "benchgenerator.h"
+
+#include "scgwindow.h"
+#include "scgscene.h"
+#include "scgview.h"
+#include "scgnode.h"
+#include "scgdefaultobjectbuilder.h"
+#include "scglayoutmanager.h"
+#include "scglazycontent.h"
+#include "arrangers/scgarrangervertical.h"
+#include "arrangers/scgarrangerhorizontal.h"
+#include "select/scgselectsubgraph.h"
+#include "gwf/gwfobjectinforeader.h"
+#include "gwf/gwbobjectinforeader.h"
+#include "gwf/gwffilewriter.h"
+#include "gwf/gwbfilewriter.h"
+
+#ifdef KBE_BENCH_WITH_SCS
+#include "scsparserwrapper.h"
+#endif
+
+#include <QDir>
+#include <QFile>
+#include <QDomDocument>
+#include <QUndoStack>
+#include <QImage>
+#include <QPainter>
+
+//! Number of identifiers, that are searched in one iteration of find case.
+static const int findCount = 100;
+
+//! Base of cases, that build objects on new scene.
+class BenchLoadCase : public BenchCase
+{
+public:
+    BenchLoadCase(const QString &name, BenchContext &context)
+        : BenchCase(name)
+        , mContext(context)
+        , mUndoStack(0)
+        , mScene(0)
+    {
+    }
+
+    void init()
+    {
+        mUndoStack = new QUndoStack();
+        mScene = new SCgScene(mUndoStack);
+    }
+
+    void cleanup()
+    {
+        delete mScene;
+        delete mUndoStack;
+        mScene = 0;
+        mUndoStack = 0;
+    }
+
+protected:
+    void build(const AbstractSCgObjectBuilder::TypeToObjectsMap &objects)
+    {
+        DefaultSCgObjectBuilder builder(mScene);
+        builder.buildObjects(objects);
+    }
+
+    BenchContext &mContext;
+    QUndoStack *mUndoStack;
+    SCgScene *mScene;
+};
+
+//! Parses gwf document without building objects.
+class BenchGwfReadCase : public BenchCase
+{
+public:
+    explicit BenchGwfReadCase(BenchContext &context)
+        : BenchCase("gwf.read")
+        , mContext(context)
+    {
+    }
+
+    void run()
+    {
+        QDomDocument document;
+        document.setContent(mContext.gwfData);
+        GwfObjectInfoReader reader(document);
+    }
+
+private:
+    BenchContext &mContext;
+};
+
+class BenchGwfLoadCase : public BenchLoadCase
+{
+public:
+    explicit BenchGwfLoadCase(BenchContext &context)
+        : BenchLoadCase("gwf.load", context)
+    {
+    }
+
+    void run()
+    {
+        QDomDocument document;
+        document.setContent(mContext.gwfData);
+        GwfObjectInfoReader reader(document);
+        build(reader.objectsInfo());
+    }
+};
+
+class BenchGwbLoadCase : public BenchLoadCase
+{
+public:
+    explicit BenchGwbLoadCase(BenchContext &context)
+        : BenchLoadCase("gwb.load", context)
+    {
+    }
+
+    void run()
+    {
+        QFile file(mContext.gwbFile);
+        if (!file.open(QFile::ReadOnly))
+            return;
+        uchar *data = file.map(0, file.size());
+        if (!data)
+            return;
+
+        GwbObjectInfoReader reader;
+        reader.read(data, file.size(), SCgContentSource::open(mContext.gwbFile));
+        file.unmap(data);
+        build(reader.objectsInfo());
+    }
+};
+
+//! Captures loaded scene and writes it.
+class BenchSaveCase : public BenchCase
+{
+public:
+    BenchSaveCase(const QString &format, BenchContext &context)
+        : BenchCase(format + ".save")
+        , mContext(context)
+        , mFormat(format)
+    {
+        mFileName = QDir(mContext.workDir).absoluteFilePath("save." + format);
+    }
+
+    void run()
+    {
+        GwfSceneSnapshot snapshot = GwfSceneSnapshot::capture(mContext.scene);
+        if (mFormat == "gwf")
+            GWFFileWriter().save(mFileName, snapshot);
+        else
+            GwbFileWriter().save(mFileName, snapshot);
+    }
+
+private:
+    BenchContext &mContext;
+    QString mFormat;
+    QString mFileName;
+};
+
+class BenchFindCase : public BenchCase
+{
+public:
+    explicit BenchFindCase(BenchContext &context)
+        : BenchCase("scene.find")
+        , mContext(context)
+    {
+        int nodes = mContext.scene->itemsByType(SCgNode::Type).size();
+        for (int i = 0; i < findCount && nodes > 0; ++i)
+            mIdtfs << BenchGenerator::nodeIdtf((i * 7919) % nodes);
+    }
+
+    void run()
+    {
+        foreach (const QString &idtf, mIdtfs)
+        {
+            mContext.scene->setCursorPos(QPointF());
+            mContext.scene->find(idtf, SCgScene::FindForward | SCgScene::CaseSensitive);
+        }
+    }
+
+private:
+    BenchContext &mContext;
+    QStringList mIdtfs;
+};
+
+//! Selects subgraph of every 16-th node.
+class BenchSelectSubgraphCase : public BenchCase
+{
+public:
+    explicit BenchSelectSubgraphCase(BenchContext &context)
+        : BenchCase("scene.selectSubgraph")
+        , mContext(context)
+    {
+    }
+
+    void init()
+    {
+        mContext.scene->clearSelection();
+        QList<SCgObject*> nodes = mContext.scene->itemsByType(SCgNode::Type);
+        for (int i = 0; i < nodes.size(); i += 16)
+            nodes[i]->setSelected(true);
+    }
+
+    void run()
+    {
+        SCgSelectSubGraph().doSelection(mContext.scene);
+    }
+
+    void cleanup()
+    {
+        mContext.scene->clearSelection();
+    }
+
+private:
+    BenchContext &mContext;
+};
+
+/*! Arranges all nodes with arranger, that doesn't ask user for parameters.
+    Changes are undone after each iteration.
+  */
+class BenchArrangeCase : public BenchCase
+{
+public:
+    BenchArrangeCase(const QString &name, int arrangerType, BenchContext &context)
+        : BenchCase(name)
+        , mContext(context)
+        , mArrangerType(arrangerType)
+        , mUndoIndex(0)
+    {
+    }
+
+    void init()
+    {
+        mUndoIndex = mContext.window->undoStack()->index();
+        foreach (SCgObject *node, mContext.scene->itemsByType(SCgNode::Type))
+            node->setSelected(true);
+    }
+
+    void run()
+    {
+        SCgLayoutManager::instance().arrange(mContext.view, mArrangerType);
+    }
+
+    void cleanup()
+    {
+        // arranger pushes no command, when there is nothing to move
+        if (mContext.window->undoStack()->index() != mUndoIndex)
+            mContext.window->undoStack()->undo();
+        mContext.scene->clearSelection();
+    }
+
+private:
+    BenchContext &mContext;
+    int mArrangerType;
+    //! Index of undo stack before arrangement
+    int mUndoIndex;
+};
+
+//! Paints whole scene into full HD image.
+class BenchRenderCase : public BenchCase
+{
+public:
+    explicit BenchRenderCase(BenchContext &context)
+        : BenchCase("scene.render")
+        , mContext(context)
+        , mImage(1920, 1080, QImage::Format_ARGB32_Premultiplied)
+    {
+    }
+
+    void init()
+    {
+        mImage.fill(Qt::white);
+    }
+
+    void run()
+    {
+        QPainter painter(&mImage);
+        mContext.scene->renderToImage(&painter, mImage.rect(), mContext.scene->itemsBoundingRect());
+    }
+
+private:
+    BenchContext &mContext;
+    QImage mImage;
+};
+
+#ifdef KBE_BENCH_WITH_SCS
+class BenchSCsParseCase : public BenchCase
+{
+public:
+    explicit BenchSCsParseCase(BenchContext &context)
+        : BenchCase("scs.parse")
+        , mContext(context)
+    {
+    }
+
+    void run()
+    {
+        SCsParser parser;
+        parser.getExceptions(mContext.scsText);
+    }
+
+private:
+    BenchContext &mContext;
+};
+#endif
+
+void addBenchCases(BenchRunner &runner, BenchContext &context)
+{
+    runner.addCase(new BenchGwfReadCase(context));
+    runner.addCase(new BenchGwfLoadCase(context));
+    runner.addCase(new BenchGwbLoadCase(context));
+    runner.addCase(new BenchSaveCase("gwf", context));
+    runner.addCase(new BenchSaveCase("gwb", context));
+    runner.addCase(new BenchFindCase(context));
+    runner.addCase(new BenchSelectSubgraphCase(context));
+    runner.addCase(new BenchArrangeCase("arrange.vertical", SCgVerticalArranger::Type, context));
+    runner.addCase(new BenchArrangeCase("arrange.horizontal", SCgHorizontalArranger::Type, context));
+    runner.addCase(new BenchRenderCase(context));
+#ifdef KBE_BENCH_WITH_SCS
+    runner.addCase(new BenchSCsParseCase(context));
+#endif
+}
@@ -0,0 +1,45 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+
+#include "gwf/gwfscenesnapshot.h"
+
+class BenchRunner;
+class SCgWindow;
+class SCgScene;
+class SCgView;
+
+//! Data shared by cases. Cases don't change it, scene is restored after each iteration.
+struct BenchContext
+{
+    BenchContext() : window(0), scene(0), view(0) {}
+
+    //! Directory for files, that are written by cases.
+    QString workDir;
+
+    /*! @defgroup corpus Generated corpus
+     *  @{
+     */
+    QString gwfFile;
+    QString gwbFile;
+    QString scsFile;
+    QByteArray gwfData;
+    QString scsText;
+    GwfSceneSnapshot snapshot;
+    /*! @}*/
+
+    //! Editor window with loaded corpus.
+    SCgWindow *window;
+    SCgScene *scene;
+    SCgView *view;
+};
+
+//! Adds all cases to \p runner.
+void addBenchCases(BenchRunner &runner, BenchContext &context);
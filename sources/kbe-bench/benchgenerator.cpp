@@ -0,0 +1,251 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "benchgenerator.h"
+
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgcontour.h"
+#include "scgcontent.h"
+
+#include <QVector>
+#include <QTextStream>
+
+#include <math.h>
+
+//! Distance between nodes of block.
+static const qreal nodeStep = 120;
+//! Distance between nested contours.
+static const qreal contourMargin = 30;
+
+BenchCorpusOptions::BenchCorpusOptions()
+    : nodes(1000)
+    , pairs(2000)
+    , contours(20)
+    , contentSize(64)
+    , depth(3)
+    , seed(1)
+{
+}
+
+QJsonObject BenchCorpusOptions::toJson() const
+{
+    QJsonObject res;
+    res["nodes"] = nodes;
+    res["pairs"] = pairs;
+    res["contours"] = contours;
+    res["contentSize"] = contentSize;
+    res["depth"] = depth;
+    res["seed"] = (qint64)seed;
+    return res;
+}
+
+// ---------------------
+BenchGenerator::BenchGenerator(const BenchCorpusOptions &options)
+    : mOptions(options)
+{
+    if (mOptions.depth < 1)
+        mOptions.depth = 1;
+    reset();
+}
+
+void BenchGenerator::reset()
+{
+    // xorshift never leaves zero state
+    mState = mOptions.seed ? mOptions.seed : 1;
+}
+
+quint32 BenchGenerator::next()
+{
+    mState ^= mState << 13;
+    mState ^= mState >> 17;
+    mState ^= mState << 5;
+    return mState;
+}
+
+int BenchGenerator::bounded(int bound)
+{
+    Q_ASSERT(bound > 0);
+    return next() % bound;
+}
+
+QString BenchGenerator::nodeIdtf(int index)
+{
+    return QString("node_%1").arg(index);
+}
+
+QString BenchGenerator::contentText(int index) const
+{
+    QString word = QString("content of %1 ").arg(nodeIdtf(index));
+    QString res;
+    res.reserve(mOptions.contentSize);
+    while (res.size() < mOptions.contentSize)
+        res.append(word);
+    res.truncate(mOptions.contentSize);
+    return res;
+}
+
+int BenchGenerator::chainCount() const
+{
+    if (mOptions.contours <= 0)
+        return 0;
+    return (mOptions.contours + mOptions.depth - 1) / mOptions.depth;
+}
+
+int BenchGenerator::blockSize() const
+{
+    int blocks = chainCount() + 1;
+    return qMax(1, (mOptions.nodes + blocks - 1) / blocks);
+}
+
+int BenchGenerator::blockOf(int index) const
+{
+    return index / blockSize();
+}
+
+int BenchGenerator::pairEnd(int begin)
+{
+    int end;
+    if (bounded(10) < 8)
+    {
+        // local pair
+        int first = blockOf(begin) * blockSize();
+        int count = qMin(blockSize(), mOptions.nodes - first);
+        end = first + bounded(count);
+    }else
+        end = bounded(mOptions.nodes);
+
+    if (end == begin)
+        end = (begin + 1) % mOptions.nodes;
+    return end;
+}
+
+GwfSceneSnapshot BenchGenerator::generateSCg()
+{
+    reset();
+
+    QVector<GwfObjectSnapshot> objects;
+    objects.reserve(mOptions.contours + mOptions.nodes + mOptions.pairs);
+
+    quint64 lastId = 0;
+    int chains = chainCount();
+    int side = (int)ceil(sqrt((double)blockSize()));
+    qreal blockExtent = side * nodeStep + 2 * mOptions.depth * contourMargin + nodeStep;
+    int blockColumns = (int)ceil(sqrt((double)(chains + 1)));
+
+    // innermost contour of each chain, nodes of block are placed into it
+    QVector<quint64> chainParents(chains + 1, 0);
+    for (int chain = 0; chain < chains; ++chain)
+    {
+        QPointF origin((chain % blockColumns) * blockExtent, (chain / blockColumns) * blockExtent);
+        int levels = qMin(mOptions.depth, mOptions.contours - chain * mOptions.depth);
+        quint64 parentId = 0;
+        for (int level = 0; level < levels; ++level)
+        {
+            GwfObjectSnapshot contour;
+            contour.type = SCgContour::Type;
+            contour.typeAlias = "contour/const/perm";
+            contour.id = ++lastId;
+            contour.parentId = parentId;
+
+            qreal size = side * nodeStep + 2 * (mOptions.depth - level) * contourMargin;
+            QRectF rect(origin + QPointF(level * contourMargin, level * contourMargin), QSizeF(size, size));
+            contour.points << rect.topLeft() << rect.topRight() << rect.bottomRight() << rect.bottomLeft();
+
+            objects.append(contour);
+            parentId = contour.id;
+        }
+        chainParents[chain] = parentId;
+    }
+
+    QVector<quint64> nodeIds(mOptions.nodes);
+    QVector<QPointF> nodePositions(mOptions.nodes);
+    for (int i = 0; i < mOptions.nodes; ++i)
+    {
+        int block = blockOf(i);
+        int local = i - block * blockSize();
+        QPointF origin((block % blockColumns) * blockExtent, (block / blockColumns) * blockExtent);
+
+        GwfObjectSnapshot node;
+        node.type = SCgNode::Type;
+        node.typeAlias = "node/const/perm/general";
+        node.idtf = nodeIdtf(i);
+        node.id = ++lastId;
+        node.parentId = chainParents[block];
+        node.pos = origin + QPointF(mOptions.depth * contourMargin + (local % side + 0.5) * nodeStep,
+                                    mOptions.depth * contourMargin + (local / side + 0.5) * nodeStep);
+        if (mOptions.contentSize > 0 && i % 8 == 0)
+        {
+            node.contentType = SCgContent::String;
+            node.contentData = contentText(i);
+        }
+
+        nodeIds[i] = node.id;
+        nodePositions[i] = node.pos;
+        objects.append(node);
+    }
+
+    if (mOptions.nodes > 1)
+        for (int i = 0; i < mOptions.pairs; ++i)
+        {
+            int begin = bounded(mOptions.nodes);
+            int end = pairEnd(begin);
+
+            GwfObjectSnapshot pair;
+            pair.type = SCgPair::Type;
+            pair.typeAlias = "pair/const/pos/perm/orient/membership";
+            pair.id = ++lastId;
+            if (blockOf(begin) == blockOf(end))
+                pair.parentId = chainParents[blockOf(begin)];
+            pair.beginId = nodeIds[begin];
+            pair.endId = nodeIds[end];
+            pair.beginPos = nodePositions[begin];
+            pair.endPos = nodePositions[end];
+
+            objects.append(pair);
+        }
+
+    return GwfSceneSnapshot(objects);
+}
+
+QString BenchGenerator::generateSCs()
+{
+    reset();
+
+    QString res;
+    QTextStream out(&res);
+
+    out << "// synthetic corpus: " << mOptions.nodes << " nodes, " << mOptions.pairs << " pairs, "
+        << mOptions.contours << " contours, seed " << mOptions.seed << "\n";
+
+    for (int i = 0; i < mOptions.nodes; ++i)
+    {
+        int chain = blockOf(i);
+        if (chain < chainCount())
+        {
+            // nested sentences repeat nesting of contours
+            int levels = qMin(mOptions.depth, mOptions.contours - chain * mOptions.depth);
+            QString sentence = nodeIdtf(i);
+            for (int level = levels - 1; level > 0; --level)
+                sentence = QString("contour_%1_%2 (* -> %3;; *)").arg(chain).arg(level).arg(sentence);
+            out << QString("contour_%1_0 -> ").arg(chain) << sentence << ";;\n";
+        }
+
+        if (mOptions.contentSize > 0 && i % 8 == 0)
+            out << nodeIdtf(i) << " -> [" << contentText(i) << "];;\n";
+    }
+
+    if (mOptions.nodes > 1)
+        for (int i = 0; i < mOptions.pairs; ++i)
+        {
+            int begin = bounded(mOptions.nodes);
+            int end = pairEnd(begin);
+            out << nodeIdtf(begin) << " -> " << nodeIdtf(end) << ";;\n";
+        }
+
+    out.flush();
+    return res;
+}
@@ -0,0 +1,77 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QString>
+#include <QJsonObject>
+
+#include "gwf/gwfscenesnapshot.h"
+
+//! Parameters of synthetic knowledge base.
+struct BenchCorpusOptions
+{
+    BenchCorpusOptions();
+
+    int nodes;
+    int pairs;
+    int contours;
+    //! Length of string contents in characters, nodes don't have contents if it's 0.
+    int contentSize;
+    //! Maximum nesting of contours.
+    int depth;
+    //! Seed of generator, corpora with equal options and seed are equal.
+    quint32 seed;
+
+    QJsonObject toJson() const;
+};
+
+/*! Generates synthetic sc.g and SCs corpora. Generator doesn't use qrand(), so
+ * generated corpus doesn't depend on platform.
+ *
+ * Nodes are placed on grid by blocks. Each block, except the last one, is wrapped
+ * into chain of nested contours, the last block holds nodes without contours.
+ * Most pairs connect nodes of the same block, every 8-th node has string content.
+ */
+class BenchGenerator
+{
+public:
+    explicit BenchGenerator(const BenchCorpusOptions &options);
+
+    //! @return Objects of sc.g-corpus.
+    GwfSceneSnapshot generateSCg();
+    //! @return Text of SCs-corpus with the same nodes and pairs.
+    QString generateSCs();
+
+    //! @return Identifier of node with index \p index.
+    static QString nodeIdtf(int index);
+
+private:
+    //! @return Next pseudo random number (xorshift).
+    quint32 next();
+    //! @return Pseudo random number in range [0, bound).
+    int bounded(int bound);
+
+    //! Restarts random sequence.
+    void reset();
+
+    //! @return Content text of node with index \p index.
+    QString contentText(int index) const;
+
+    //! @return Number of contour chains.
+    int chainCount() const;
+
+    //! @return Index of block of node with index \p index.
+    int blockOf(int index) const;
+    //! @return Number of nodes in one block.
+    int blockSize() const;
+
+    //! Picks end node of pair, that begins in \p begin.
+    int pairEnd(int begin);
+
+    BenchCorpusOptions mOptions;
+    quint32 mState;
+};
@@ -0,0 +1,110 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "benchrunner.h"
+
+#include <QElapsedTimer>
+#include <QVector>
+
+#include <algorithm>
+
+BenchCase::BenchCase(const QString &name)
+    : mName(name)
+{
+}
+
+BenchCase::~BenchCase()
+{
+}
+
+// ---------------------
+QJsonObject BenchResult::toJson() const
+{
+    QJsonObject res;
+    res["name"] = name;
+    res["iterations"] = iterations;
+    res["min"] = min;
+    res["median"] = median;
+    res["mean"] = mean;
+    res["max"] = max;
+    return res;
+}
+
+// ---------------------
+BenchRunner::BenchRunner(int iterations)
+    : mIterations(qMax(1, iterations))
+{
+}
+
+BenchRunner::~BenchRunner()
+{
+    qDeleteAll(mCases);
+}
+
+void BenchRunner::addCase(BenchCase *benchCase)
+{
+    Q_ASSERT(benchCase);
+    mCases.append(benchCase);
+}
+
+void BenchRunner::setFilter(const QRegExp &filter)
+{
+    mFilter = filter;
+}
+
+QStringList BenchRunner::caseNames() const
+{
+    QStringList res;
+    foreach (BenchCase *benchCase, mCases)
+        res << benchCase->name();
+    return res;
+}
+
+QList<BenchResult> BenchRunner::run()
+{
+    QList<BenchResult> res;
+    foreach (BenchCase *benchCase, mCases)
+        if (mFilter.isEmpty() || mFilter.indexIn(benchCase->name()) >= 0)
+            res.append(measure(benchCase));
+    return res;
+}
+
+BenchResult BenchRunner::measure(BenchCase *benchCase)
+{
+    // warm up
+    benchCase->init();
+    benchCase->run();
+    benchCase->cleanup();
+
+    QVector<double> times;
+    times.reserve(mIterations);
+
+    QElapsedTimer timer;
+    for (int i = 0; i < mIterations; ++i)
+    {
+        benchCase->init();
+        timer.start();
+        benchCase->run();
+        times.append(timer.nsecsElapsed() / 1000000.0);
+        benchCase->cleanup();
+    }
+
+    std::sort(times.begin(), times.end());
+
+    BenchResult res;
+    res.name = benchCase->name();
+    res.iterations = times.size();
+    res.min = times.first();
+    res.max = times.last();
+    int middle = times.size() / 2;
+    res.median = (times.size() % 2) ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+    double sum = 0;
+    foreach (double time, times)
+        sum += time;
+    res.mean = sum / times.size();
+
+    return res;
+}
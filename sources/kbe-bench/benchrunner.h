@@ -0,0 +1,82 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QString>
+#include <QList>
+#include <QStringList>
+#include <QRegExp>
+#include <QJsonObject>
+
+//! Measured operation.
+class BenchCase
+{
+public:
+    explicit BenchCase(const QString &name);
+    virtual ~BenchCase();
+
+    //! @return Name, that identifies case in results. Names mustn't change between versions.
+    const QString& name() const
+    {
+        return mName;
+    }
+
+    //! Prepares iteration, isn't measured.
+    virtual void init() {}
+    //! Measured operation.
+    virtual void run() = 0;
+    //! Cleans after iteration, isn't measured.
+    virtual void cleanup() {}
+
+private:
+    QString mName;
+};
+
+//! Timings of one case in milliseconds.
+struct BenchResult
+{
+    BenchResult() : iterations(0), min(0), median(0), mean(0), max(0) {}
+
+    QString name;
+    int iterations;
+    double min;
+    double median;
+    double mean;
+    double max;
+
+    QJsonObject toJson() const;
+};
+
+//! Runs cases in order they were added.
+class BenchRunner
+{
+public:
+    /*! @param iterations Number of measured iterations of each case.
+        One more iteration is done before measuring to warm up caches.
+      */
+    explicit BenchRunner(int iterations);
+    ~BenchRunner();
+
+    //! Adds case. Runner takes ownership of \p benchCase.
+    void addCase(BenchCase *benchCase);
+
+    //! Sets filter of case names, cases, that don't match it, are skipped.
+    void setFilter(const QRegExp &filter);
+
+    //! @return Names of all cases.
+    QStringList caseNames() const;
+
+    //! Runs cases. @return Results in order of cases.
+    QList<BenchResult> run();
+
+private:
+    BenchResult measure(BenchCase *benchCase);
+
+    QList<BenchCase*> mCases;
+    QRegExp mFilter;
+    int mIterations;
+};
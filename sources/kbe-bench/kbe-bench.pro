@@ -0,0 +1,70 @@
+# Benchmarks of sc.g-editor on generated knowledge base.
+# Editor sources are compiled into this tool, so it doesn't load plugins.
+
+TARGET   = kbe-bench
+TEMPLATE = app
+CONFIG  += console
+CONFIG  -= app_bundle
+
+DESTDIR = ../bin
+
+QT += xml widgets concurrent
+
+OBJECTS_DIR = obj
+MOC_DIR = moc
+
+INCLUDEPATH += ../kbe
+
+win32 {
+    DEFINES += _USE_MATH_DEFINES
+}
+
+include(../plugins/scg/scg.pri)
+
+HEADERS += \
+    benchgenerator.h \
+    benchrunner.h \
+    benchcases.h
+
+SOURCES += \
+    main.cpp \
+    benchgenerator.cpp \
+    benchrunner.cpp \
+    benchcases.cpp
+
+# SCs parsing case depends on antlr3c, so it's enabled with CONFIG+=with_scs
+with_scs {
+    DEFINES += KBE_BENCH_WITH_SCS
+
+    SCS_DIR = ../plugins/scs
+    INCLUDEPATH += $$SCS_DIR/scsparser
+
+    unix {
+        LIBS += -lantlr3c
+    }
+
+    win32 {
+        DEFINES += _XKEYCHECK_H
+
+        INCLUDEPATH += $$PWD/../../depends/antlr3c/
+        !contains(QMAKE_TARGET.arch, x86_64) {
+            LIBS += -l$$PWD/../../depends/antlr3c/antlr3c_x86
+        } else {
+            LIBS += -l$$PWD/../../depends/antlr3c/antlr3c_x86_64
+        }
+    }
+
+    HEADERS += \
+        $$SCS_DIR/scsparser/scsparserexception.h \
+        $$SCS_DIR/scsparser/scsparserwrapper.h \
+        $$SCS_DIR/scsparser/SCsCLexer.h \
+        $$SCS_DIR/scsparser/SCsCParser.h \
+        $$SCS_DIR/scsparser/scscparserdefs.h
+
+    SOURCES += \
+        $$SCS_DIR/scsparser/scsparserexception.cpp \
+        $$SCS_DIR/scsparser/scsparserwrapper.cpp \
+        $$SCS_DIR/scsparser/SCsCLexer.c \
+        $$SCS_DIR/scsparser/SCsCParser.c \
+        $$SCS_DIR/scsparser/scscparserdefs.c
+}
@@ -0,0 +1,237 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "benchgenerator.h"
+#include "benchrunner.h"
+#include "benchcases.h"
+
+#include "scgwindow.h"
+#include "scgview.h"
+#include "scgscene.h"
+#include "gwf/gwffilewriter.h"
+#include "gwf/gwbfilewriter.h"
+
+#include "scgcontentfactory.h"
+#include "scgcontentimage.h"
+#include "scgcontentnumeric.h"
+#include "scgcontentstring.h"
+
+#include "scglayoutmanager.h"
+#include "arrangers/scgarrangergrid.h"
+#include "arrangers/scgarrangerhorizontal.h"
+#include "arrangers/scgarrangertuple.h"
+#include "arrangers/scgarrangervertical.h"
+#include "arrangers/scgarrangerenergybased.h"
+#include "arrangers/scgarrangerhierarchical.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonArray>
+
+//! Version of results format, it's changed only when existing fields change.
+#define BENCH_RESULTS_FORMAT 1
+
+//! Writes corpus files into \p dir. @return If all files are written, then return true, else - false.
+static bool writeCorpus(const BenchCorpusOptions &options, const QDir &dir, BenchContext &context)
+{
+    BenchGenerator generator(options);
+    context.snapshot = generator.generateSCg();
+    context.scsText = generator.generateSCs();
+
+    context.gwfFile = dir.absoluteFilePath("bench.gwf");
+    context.gwbFile = dir.absoluteFilePath("bench.gwb");
+    context.scsFile = dir.absoluteFilePath("bench.scs");
+
+    GWFFileWriter gwfWriter;
+    GwbFileWriter gwbWriter;
+    if (!gwfWriter.save(context.gwfFile, context.snapshot) || !gwbWriter.save(context.gwbFile, context.snapshot))
+        return false;
+
+    QFile scsFile(context.scsFile);
+    if (!scsFile.open(QFile::WriteOnly | QFile::Text))
+        return false;
+    QTextStream stream(&scsFile);
+    stream.setCodec("UTF-8");
+    stream << context.scsText;
+
+    QFile gwfFile(context.gwfFile);
+    if (!gwfFile.open(QFile::ReadOnly))
+        return false;
+    context.gwfData = gwfFile.readAll();
+
+    return true;
+}
+
+//! Registers content factories and arrangers, as scg plugin does in editor.
+static void registerEditorComponents(QObject *parent)
+{
+    SCgContentFactory::registerFactory("string", new SCgContentStringFactory);
+    SCgContentFactory::registerFactory("image", new SCgContentImageFactory);
+    SCgContentFactory::registerFactory("numeric", new SCgContentNumericFactory);
+
+    SCgLayoutManager::instance().addArranger(new SCgGridArranger(parent));
+    SCgLayoutManager::instance().addArranger(new SCgVerticalArranger(parent));
+    SCgLayoutManager::instance().addArranger(new SCgHorizontalArranger(parent));
+    SCgLayoutManager::instance().addArranger(new SCgTupleArranger(parent));
+    SCgLayoutManager::instance().addArranger(new SCgEnergyBasedArranger(parent));
+    SCgLayoutManager::instance().addArranger(new SCgHierarchicalArranger(parent));
+}
+
+static int intOption(const QCommandLineParser &parser, const QCommandLineOption &option, int minimum, bool &ok)
+{
+    bool converted = false;
+    int res = parser.value(option).toInt(&converted);
+    if (!converted || res < minimum)
+    {
+        QTextStream(stderr) << QObject::tr("Invalid value '%1' of option %2")
+                               .arg(parser.value(option)).arg(option.names().last()) << endl;
+        ok = false;
+    }
+    return res;
+}
+
+int main(int argc, char *argv[])
+{
+    // scene is painted without display
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication a(argc, argv);
+
+    a.setOrganizationName("OSTIS");
+    a.setOrganizationDomain("ostis.net");
+    a.setApplicationName("kbe-bench");
+
+    BenchCorpusOptions corpus;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QObject::tr("Generates synthetic knowledge base and measures "
+                                                 "performance of sc.g-editor on it. Results are "
+                                                 "printed in JSON format."));
+    parser.addHelpOption();
+
+    QCommandLineOption nodesOption("nodes", QObject::tr("Number of nodes."), "count", QString::number(corpus.nodes));
+    QCommandLineOption pairsOption("pairs", QObject::tr("Number of pairs."), "count", QString::number(corpus.pairs));
+    QCommandLineOption contoursOption("contours", QObject::tr("Number of contours."), "count", QString::number(corpus.contours));
+    QCommandLineOption contentOption("content-size", QObject::tr("Length of node contents."), "chars", QString::number(corpus.contentSize));
+    QCommandLineOption depthOption("depth", QObject::tr("Nesting depth of contours."), "levels", QString::number(corpus.depth));
+    QCommandLineOption seedOption("seed", QObject::tr("Seed of generator."), "seed", QString::number(corpus.seed));
+    QCommandLineOption iterationsOption(QStringList() << "i" << "iterations", QObject::tr("Iterations of each case."), "count", "5");
+    QCommandLineOption filterOption(QStringList() << "f" << "filter", QObject::tr("Run cases, that match <regexp>."), "regexp");
+    QCommandLineOption outputOption(QStringList() << "o" << "output", QObject::tr("Write results to <file>."), "file");
+    QCommandLineOption generateOption(QStringList() << "g" << "generate", QObject::tr("Only write corpus to <directory>."), "directory");
+    QCommandLineOption listOption(QStringList() << "l" << "list", QObject::tr("List cases."));
+
+    parser.addOption(nodesOption);
+    parser.addOption(pairsOption);
+    parser.addOption(contoursOption);
+    parser.addOption(contentOption);
+    parser.addOption(depthOption);
+    parser.addOption(seedOption);
+    parser.addOption(iterationsOption);
+    parser.addOption(filterOption);
+    parser.addOption(outputOption);
+    parser.addOption(generateOption);
+    parser.addOption(listOption);
+
+    parser.process(a);
+
+    bool ok = true;
+    corpus.nodes = intOption(parser, nodesOption, 2, ok);
+    corpus.pairs = intOption(parser, pairsOption, 0, ok);
+    corpus.contours = intOption(parser, contoursOption, 0, ok);
+    corpus.contentSize = intOption(parser, contentOption, 0, ok);
+    corpus.depth = intOption(parser, depthOption, 1, ok);
+    corpus.seed = (quint32)intOption(parser, seedOption, 0, ok);
+    int iterations = intOption(parser, iterationsOption, 1, ok);
+    if (!ok)
+        return 2;
+
+    QTextStream err(stderr);
+    BenchContext context;
+
+    if (parser.isSet(generateOption))
+    {
+        QDir dir(parser.value(generateOption));
+        if (!dir.mkpath(".") || !writeCorpus(corpus, dir, context))
+        {
+            err << QObject::tr("Can't write corpus to '%1'").arg(dir.path()) << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    QTemporaryDir workDir;
+    if (!workDir.isValid() || !writeCorpus(corpus, QDir(workDir.path()), context))
+    {
+        err << QObject::tr("Can't write corpus to temporary directory") << endl;
+        return 1;
+    }
+    context.workDir = workDir.path();
+
+    registerEditorComponents(&a);
+
+    SCgWindow *window = new SCgWindow(QString());
+    window->resize(1280, 800);
+    window->show();
+    if (!window->loadFromFile(context.gwfFile))
+        return 1;
+
+    context.window = window;
+    context.view = window->findChild<SCgView*>();
+    Q_ASSERT(context.view);
+    context.scene = static_cast<SCgScene*>(context.view->scene());
+
+    BenchRunner runner(iterations);
+    addBenchCases(runner, context);
+
+    if (parser.isSet(listOption))
+    {
+        QTextStream out(stdout);
+        foreach (const QString &name, runner.caseNames())
+            out << name << endl;
+        return 0;
+    }
+
+    if (parser.isSet(filterOption))
+        runner.setFilter(QRegExp(parser.value(filterOption)));
+
+    QJsonArray results;
+    foreach (const BenchResult &result, runner.run())
+        results.append(result.toJson());
+
+    QJsonObject report;
+    report["format"] = BENCH_RESULTS_FORMAT;
+    report["unit"] = QString("ms");
+    report["qt"] = QString(qVersion());
+    report["corpus"] = corpus.toJson();
+    report["iterations"] = iterations;
+    report["results"] = results;
+
+    QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    delete window;
+    plugin.shutdown();
+
+    if (parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QFile::WriteOnly))
+        {
+            err << file.errorString() << endl;
+            return 1;
+        }
+        file.write(json);
+    }else
+        QTextStream(stdout) << json;
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "clifileprocessor.h"
+
+#include "scgobjectsinfo.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+#include "scglazycontent.h"
+#include "gwfobjectinforeader.h"
+#include "gwbobjectinforeader.h"
+#include "gwffilewriter.h"
+#include "gwbfilewriter.h"
+
+#ifdef KBE_CLI_WITH_SCS
+#include "scsparserwrapper.h"
+#endif
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QTextStream>
+
+QJsonObject CliFileReport::toJson() const
+{
+    QJsonObject res;
+    res["file"] = fileName;
+    res["format"] = format;
+    res["ok"] = ok;
+    res["errors"] = QJsonArray::fromStringList(errors);
+
+    QJsonObject timings;
+    timings["read"] = readTime;
+    timings["check"] = checkTime;
+    if (!output.isEmpty())
+        timings["convert"] = convertTime;
+    res["time"] = timings;
+
+    QJsonObject countsObject;
+    QMap<QString, int>::const_iterator it;
+    for (it = counts.begin(); it != counts.end(); ++it)
+        countsObject[it.key()] = it.value();
+    res["counts"] = countsObject;
+
+    if (!output.isEmpty())
+        res["output"] = output;
+
+    return res;
+}
+
+// ---------------------
+CliFileProcessor::CliFileProcessor(const CliOptions &options)
+    : mOptions(options)
+{
+}
+
+QStringList CliFileProcessor::supportedFormats()
+{
+    return QStringList() << "gwf" << "gwb" << "scs";
+}
+
+CliFileReport CliFileProcessor::operator()(const QString &fileName) const
+{
+    CliFileReport report;
+    report.fileName = fileName;
+    report.format = QFileInfo(fileName).suffix().toLower();
+
+    if (report.format == "gwf" || report.format == "gwb")
+        processSCg(report);
+    else if (report.format == "scs")
+        processSCs(report);
+    else
+        report.errors << QObject::tr("Unsupported file format '%1'").arg(report.format);
+
+    report.ok = report.errors.isEmpty();
+    return report;
+}
+
+void CliFileProcessor::processSCg(CliFileReport &report) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(report.fileName);
+    if (!file.open(QFile::ReadOnly))
+    {
+        report.errors << file.errorString();
+        return;
+    }
+
+    // readers are created only for the format of file, both of them own read info
+    GwfObjectInfoReader gwfReader;
+    GwbObjectInfoReader gwbReader;
+    GwfSceneSnapshot::ObjectInfoMap objects;
+
+    if (report.format == "gwf")
+    {
+        QString errorStr;
+        int errorLine = 0;
+        int errorColumn = 0;
+        QDomDocument document;
+        if (!document.setContent(&file, &errorStr, &errorLine, &errorColumn))
+        {
+            report.errors << QObject::tr("Parse error at line %1, column %2: %3")
+                             .arg(errorLine)
+                             .arg(errorColumn)
+                             .arg(errorStr);
+            return;
+        }
+        if (!gwfReader.read(document))
+        {
+            report.errors << gwfReader.lastError();
+            return;
+        }
+        objects = gwfReader.objectsInfo();
+    }else
+    {
+        uchar *data = file.map(0, file.size());
+        if (!data)
+        {
+            report.errors << file.errorString();
+            return;
+        }
+        bool res = gwbReader.read(data, file.size(), SCgContentSource::open(report.fileName));
+        file.unmap(data);
+        if (!res)
+        {
+            report.errors << gwbReader.lastError();
+            return;
+        }
+        objects = gwbReader.objectsInfo();
+    }
+    report.readTime = timer.restart();
+
+    report.counts["nodes"] = objects.value(SCgNode::Type).size();
+    report.counts["pairs"] = objects.value(SCgPair::Type).size();
+    report.counts["buses"] = objects.value(SCgBus::Type).size();
+    report.counts["contours"] = objects.value(SCgContour::Type).size();
+
+    int contents = 0;
+    foreach (const SCgObjectInfo *info, objects.value(SCgNode::Type))
+        if (static_cast<const SCgNodeInfo*>(info)->contentType() != 0)
+            ++contents;
+    report.counts["contents"] = contents;
+
+    checkObjects(objects, report);
+    report.checkTime = timer.restart();
+
+    if (!mOptions.convertTo.isEmpty() && report.errors.isEmpty())
+    {
+        convert(objects, report);
+        report.convertTime = timer.elapsed();
+    }
+}
+
+void CliFileProcessor::checkObjects(const GwfSceneSnapshot::ObjectInfoMap &objects, CliFileReport &report) const
+{
+    QSet<QString> ids;
+    QSet<QString> nodeIds;
+
+    GwfSceneSnapshot::ObjectInfoMap::const_iterator it;
+    for (it = objects.begin(); it != objects.end(); ++it)
+        foreach (const SCgObjectInfo *info, it.value())
+        {
+            if (ids.contains(info->id()))
+                report.errors << QObject::tr("Duplicate object id '%1'").arg(info->id());
+            ids.insert(info->id());
+            if (it.key() == SCgNode::Type)
+                nodeIds.insert(info->id());
+        }
+
+    for (it = objects.begin(); it != objects.end(); ++it)
+        foreach (const SCgObjectInfo *info, it.value())
+        {
+            // objects without parent have parent id "0"
+            if (info->parentId() != "0" && !ids.contains(info->parentId()))
+                report.errors << QObject::tr("Parent '%1' of object '%2' not found")
+                                 .arg(info->parentId()).arg(info->id());
+
+            if (it.key() == SCgPair::Type)
+            {
+                const SCgPairInfo *pair = static_cast<const SCgPairInfo*>(info);
+                if (!ids.contains(pair->beginObjectId()))
+                    report.errors << QObject::tr("Begin object '%1' of pair '%2' not found")
+                                     .arg(pair->beginObjectId()).arg(info->id());
+                if (!ids.contains(pair->endObjectId()))
+                    report.errors << QObject::tr("End object '%1' of pair '%2' not found")
+                                     .arg(pair->endObjectId()).arg(info->id());
+            }else if (it.key() == SCgBus::Type)
+            {
+                const SCgBusInfo *bus = static_cast<const SCgBusInfo*>(info);
+                if (!nodeIds.contains(bus->ownerId()))
+                    report.errors << QObject::tr("Owner node '%1' of bus '%2' not found")
+                                     .arg(bus->ownerId()).arg(info->id());
+            }
+        }
+}
+
+void CliFileProcessor::convert(const GwfSceneSnapshot::ObjectInfoMap &objects, CliFileReport &report) const
+{
+    QFileInfo source(report.fileName);
+    QDir dir = mOptions.outputDir.isEmpty() ? source.absoluteDir() : QDir(mOptions.outputDir);
+    QString output = dir.absoluteFilePath(source.completeBaseName() + "." + mOptions.convertTo);
+
+    if (QFileInfo(output) == source)
+    {
+        report.errors << QObject::tr("Output file '%1' is the same as source file").arg(output);
+        return;
+    }
+
+    GwfSceneSnapshot snapshot = GwfSceneSnapshot::fromInfo(objects);
+    if (mOptions.convertTo == "gwf")
+    {
+        GWFFileWriter writer;
+        if (!writer.save(output, snapshot))
+        {
+            report.errors << writer.lastError();
+            return;
+        }
+    }else
+    {
+        GwbFileWriter writer;
+        if (!writer.save(output, snapshot))
+        {
+            report.errors << writer.lastError();
+            return;
+        }
+    }
+
+    report.output = output;
+}
+
+void CliFileProcessor::processSCs(CliFileReport &report) const
+{
+#ifdef KBE_CLI_WITH_SCS
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(report.fileName);
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+    {
+        report.errors << file.errorString();
+        return;
+    }
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    QString text = stream.readAll();
+    report.readTime = timer.restart();
+
+    // generated parser keeps exceptions in global lists, so only one file is parsed at time
+    static QMutex parserMutex;
+    QMutexLocker locker(&parserMutex);
+
+    SCsParser parser;
+    QSharedPointer<SCsParserExceptionArray> exceptions = parser.getExceptions(text);
+    foreach (const SCsParserException &e, *exceptions)
+        report.errors << QObject::tr("%1 error at line %2, position %3")
+                         .arg(e.type() == SCsParserException::LEXER ? "Lexer" : "Parser")
+                         .arg(e.line())
+                         .arg(e.positionInLine());
+
+    report.counts["tokens"] = parser.getTokens(text)->size();
+    report.counts["identifiers"] = parser.getIdentifier(text)->size();
+    report.checkTime = timer.elapsed();
+#else
+    report.errors << QObject::tr("Tool is built without SCs support");
+#endif
+}
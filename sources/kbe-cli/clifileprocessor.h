@@ -0,0 +1,80 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QJsonObject>
+
+#include "gwfscenesnapshot.h"
+
+//! Options of file processing, that are common for all files.
+struct CliOptions
+{
+    //! Format (file extension), that sc.g-files are converted to. Empty, if they aren't converted.
+    QString convertTo;
+    //! Directory for converted files. Empty means directory of source file.
+    QString outputDir;
+};
+
+//! Result of processing of one file.
+struct CliFileReport
+{
+    CliFileReport() : ok(false), readTime(0), checkTime(0), convertTime(0) {}
+
+    QString fileName;
+    //! File extension in lower case
+    QString format;
+    bool ok;
+    QStringList errors;
+
+    /*! @defgroup timings Timings in milliseconds
+     *  @{
+     */
+    qint64 readTime;
+    qint64 checkTime;
+    qint64 convertTime;
+    /*! @}*/
+
+    //! Element counts by name (nodes, pairs, tokens, ...)
+    QMap<QString, int> counts;
+    //! Name of converted file
+    QString output;
+
+    //! @return Report as JSON object, it's printed as one line.
+    QJsonObject toJson() const;
+};
+
+/*! Reads, checks and converts one file without scene and widgets.
+ * Processor doesn't have state, so it's used as functor for QtConcurrent::mapped().
+ */
+class CliFileProcessor
+{
+public:
+    typedef CliFileReport result_type;
+
+    explicit CliFileProcessor(const CliOptions &options);
+
+    //! @return Supported file extensions.
+    static QStringList supportedFormats();
+
+    CliFileReport operator()(const QString &fileName) const;
+
+private:
+    //! Reads and checks gwf or gwb file.
+    void processSCg(CliFileReport &report) const;
+    //! Parses scs file.
+    void processSCs(CliFileReport &report) const;
+
+    //! Checks references between objects.
+    void checkObjects(const GwfSceneSnapshot::ObjectInfoMap &objects, CliFileReport &report) const;
+    //! Writes objects in format CliOptions::convertTo.
+    void convert(const GwfSceneSnapshot::ObjectInfoMap &objects, CliFileReport &report) const;
+
+    CliOptions mOptions;
+};
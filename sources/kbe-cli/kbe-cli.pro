@@ -0,0 +1,90 @@
+# Command line tool, that validates, converts and collects statistics
+# of knowledge base sources without user interface.
+
+TARGET   = kbe-cli
+TEMPLATE = app
+CONFIG  += console
+CONFIG  -= app_bundle
+
+DESTDIR = ../bin
+
+QT += xml widgets concurrent
+
+OBJECTS_DIR = obj
+MOC_DIR = moc
+
+# sc.g-files are read and written without scene: code, that refers
+# to scene items, isn't compiled into this tool
+DEFINES += SCG_NO_SCENE
+
+SCG_DIR = ../plugins/scg
+
+INCLUDEPATH += \
+    ../kbe \
+    $$SCG_DIR \
+    $$SCG_DIR/gwf
+
+HEADERS += \
+    clifileprocessor.h \
+    ../kbe/interfaces/filewriterinterface.h \
+    $$SCG_DIR/scgobjectsinfo.h \
+    $$SCG_DIR/scgobjectsinfodata.h \
+    $$SCG_DIR/scglazycontent.h \
+    $$SCG_DIR/scgblobstore.h \
+    $$SCG_DIR/gwf/gwfobjectinforeader.h \
+    $$SCG_DIR/gwf/gwbobjectinforeader.h \
+    $$SCG_DIR/gwf/gwfstreamwriter.h \
+    $$SCG_DIR/gwf/gwffilewriter.h \
+    $$SCG_DIR/gwf/gwbfilewriter.h \
+    $$SCG_DIR/gwf/gwfscenesnapshot.h
+
+SOURCES += \
+    main.cpp \
+    clifileprocessor.cpp \
+    $$SCG_DIR/scgobjectsinfo.cpp \
+    $$SCG_DIR/scgobjectsinfodata.cpp \
+    $$SCG_DIR/scglazycontent.cpp \
+    $$SCG_DIR/scgblobstore.cpp \
+    $$SCG_DIR/gwf/gwfobjectinforeader.cpp \
+    $$SCG_DIR/gwf/gwbobjectinforeader.cpp \
+    $$SCG_DIR/gwf/gwfstreamwriter.cpp \
+    $$SCG_DIR/gwf/gwffilewriter.cpp \
+    $$SCG_DIR/gwf/gwbfilewriter.cpp \
+    $$SCG_DIR/gwf/gwfscenesnapshot.cpp
+
+# SCs parser depends on antlr3c, so it's enabled with CONFIG+=with_scs
+with_scs {
+    DEFINES += KBE_CLI_WITH_SCS
+
+    SCS_DIR = ../plugins/scs
+    INCLUDEPATH += $$SCS_DIR/scsparser
+
+    unix {
+        LIBS += -lantlr3c
+    }
+
+    win32 {
+        DEFINES += _XKEYCHECK_H
+
+        INCLUDEPATH += $$PWD/../../depends/antlr3c/
+        !contains(QMAKE_TARGET.arch, x86_64) {
+            LIBS += -l$$PWD/../../depends/antlr3c/antlr3c_x86
+        } else {
+            LIBS += -l$$PWD/../../depends/antlr3c/antlr3c_x86_64
+        }
+    }
+
+    HEADERS += \
+        $$SCS_DIR/scsparser/scsparserexception.h \
+        $$SCS_DIR/scsparser/scsparserwrapper.h \
+        $$SCS_DIR/scsparser/SCsCLexer.h \
+        $$SCS_DIR/scsparser/SCsCParser.h \
+        $$SCS_DIR/scsparser/scscparserdefs.h
+
+    SOURCES += \
+        $$SCS_DIR/scsparser/scsparserexception.cpp \
+        $$SCS_DIR/scsparser/scsparserwrapper.cpp \
+        $$SCS_DIR/scsparser/SCsCLexer.c \
+        $$SCS_DIR/scsparser/SCsCParser.c \
+        $$SCS_DIR/scsparser/scscparserdefs.c
+}
@@ -0,0 +1,145 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "clifileprocessor.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QThread>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QtConcurrentMap>
+
+/*! Exit codes:
+ * 0 - all files are valid (and converted, if conversion was requested);
+ * 1 - at least one file has errors;
+ * 2 - invalid command line.
+ */
+
+//! @return Files from \p paths, directories are expanded to files of supported formats.
+static QStringList collectFiles(const QStringList &paths, bool recursive, QStringList &missing)
+{
+    QStringList filters;
+    foreach (const QString &format, CliFileProcessor::supportedFormats())
+        filters << "*." + format;
+
+    QStringList res;
+    foreach (const QString &path, paths)
+    {
+        QFileInfo info(path);
+        if (info.isDir())
+        {
+            QDirIterator it(path, filters, QDir::Files,
+                            recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+            QStringList dirFiles;
+            while (it.hasNext())
+                dirFiles << it.next();
+            // keep output stable between runs
+            dirFiles.sort();
+            res << dirFiles;
+        }else if (info.exists())
+            res << path;
+        else
+            missing << path;
+    }
+    return res;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    a.setOrganizationName("OSTIS");
+    a.setOrganizationDomain("ostis.net");
+    a.setApplicationName("kbe-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QObject::tr("Validates, converts and collects statistics of "
+                                                 "knowledge base sources without user interface.\n"
+                                                 "Prints one JSON object per file."));
+    parser.addHelpOption();
+
+    QCommandLineOption convertOption(QStringList() << "c" << "convert",
+                                     QObject::tr("Convert sc.g-files to <format> (gwf or gwb)."),
+                                     "format");
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+                                    QObject::tr("Write converted files to <directory>."),
+                                    "directory");
+    QCommandLineOption jobsOption(QStringList() << "j" << "jobs",
+                                  QObject::tr("Process <count> files in parallel."),
+                                  "count", QString::number(QThread::idealThreadCount()));
+    QCommandLineOption recursiveOption(QStringList() << "r" << "recursive",
+                                       QObject::tr("Search files in subdirectories."));
+    parser.addOption(convertOption);
+    parser.addOption(outputOption);
+    parser.addOption(jobsOption);
+    parser.addOption(recursiveOption);
+    parser.addPositionalArgument("paths", QObject::tr("Files and directories to process."), "<paths...>");
+
+    parser.process(a);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    CliOptions options;
+    options.convertTo = parser.value(convertOption).toLower();
+    options.outputDir = parser.value(outputOption);
+
+    if (!options.convertTo.isEmpty() && options.convertTo != "gwf" && options.convertTo != "gwb")
+    {
+        err << QObject::tr("Unsupported conversion format '%1'").arg(options.convertTo) << endl;
+        return 2;
+    }
+    if (!options.outputDir.isEmpty() && !QDir().mkpath(options.outputDir))
+    {
+        err << QObject::tr("Can't create output directory '%1'").arg(options.outputDir) << endl;
+        return 2;
+    }
+
+    bool ok = false;
+    int jobs = parser.value(jobsOption).toInt(&ok);
+    if (!ok || jobs < 1)
+    {
+        err << QObject::tr("Invalid jobs count '%1'").arg(parser.value(jobsOption)) << endl;
+        return 2;
+    }
+
+    if (parser.positionalArguments().isEmpty())
+        parser.showHelp(2);
+
+    QStringList missing;
+    QStringList files = collectFiles(parser.positionalArguments(), parser.isSet(recursiveOption), missing);
+    foreach (const QString &path, missing)
+        err << QObject::tr("File '%1' not found").arg(path) << endl;
+
+    QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // reports are returned in order of files, so output doesn't depend on jobs count
+    QList<CliFileReport> reports = QtConcurrent::blockingMapped<QList<CliFileReport> >(files, CliFileProcessor(options));
+
+    int failed = 0;
+    foreach (const CliFileReport &report, reports)
+    {
+        out << QJsonDocument(report.toJson()).toJson(QJsonDocument::Compact) << endl;
+        if (!report.ok)
+            ++failed;
+    }
+
+    err << QObject::tr("%1 files processed, %2 failed, %3 ms")
+           .arg(reports.size())
+           .arg(failed)
+           .arg(timer.elapsed()) << endl;
+
+    return (failed > 0 || !missing.isEmpty()) ? 1 : 0;
+}
@@ -14,3 +14,5 @@ const QString Config::settingsRecentFileList = Config::settingsApplicationRoot +
 const QString Config::settingsDocksGeometry = Config::settingsApplicationRoot +"/DockWindowsGeometry";
 const QString Config::settingsMainWindowGeometry = Config::settingsApplicationRoot +"/MainWindowGeometry";
 const QString Config::settingsShowStartupDialog = Config::settingsApplicationRoot +"/StartupDialog/Show";
+const QString Config::settingsTraceEnabled = Config::settingsApplicationRoot +"/Trace/Enabled";
+const QString Config::settingsLastProject = Config::settingsApplicationRoot +"/LastProject";
@@ -30,6 +30,10 @@ public:
     static const QString settingsMainWindowGeometry;
     //! Key for saving value indicating whether the guide dialog appears on startupt.
     static const QString settingsShowStartupDialog;
+    //! Key for value indicating whether performance trace is written. @see TraceRecorder
+    static const QString settingsTraceEnabled;
+    //! Key for storing file name of opened project, it's opened on next start.
+    static const QString settingsLastProject;
     /*! @}*/
 };
 
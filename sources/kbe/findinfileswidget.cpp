@@ -0,0 +1,289 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "findinfileswidget.h"
+#include "projectindexer.h"
+#include "trace.h"
+
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QBoxLayout>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrentMap>
+
+#include <string.h>
+
+//! Data roles of hit items.
+enum HitRoles
+{
+    FileNameRole = Qt::UserRole + 1,
+    LineRole,
+    ColumnRole,
+    TextRole,
+    IdentifierRole,
+    ObjectPosRole
+};
+
+FindInFilesWidget::SearchFunctor::SearchFunctor(const SearchQuery &query, const tSearchersMap &searchers)
+    : mQuery(query)
+    , mQueryUtf8(query.text.toUtf8())
+    , mSearchers(searchers)
+{
+}
+
+SearchHitList FindInFilesWidget::SearchFunctor::operator()(const QString &fileName) const
+{
+    KBE_TRACE_SCOPE("find", "searchFile", fileName);
+
+    DocumentSearcherInterface *searcher = mSearchers.value(QFileInfo(fileName).suffix(), 0);
+    if (!searcher)
+        return SearchHitList();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+        return SearchHitList();
+
+    // mapped file isn't copied, pages are read only when they are scanned
+    uchar *mapped = file.map(0, file.size());
+    QByteArray data;
+    if (mapped)
+        data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), file.size());
+    else
+        data = file.readAll();
+
+    SearchHitList res;
+    if (mayContain(data))
+        res = searcher->search(fileName, data, mQuery);
+
+    if (mapped)
+        file.unmap(mapped);
+    return res;
+}
+
+bool FindInFilesWidget::SearchFunctor::mayContain(const QByteArray &data) const
+{
+    // characters, that are escaped in xml, aren't found in raw bytes
+    static const char escaped[] = "&<>\"'";
+    for (int i = 0; i < mQueryUtf8.size(); ++i)
+    {
+        if (strchr(escaped, mQueryUtf8[i]))
+            return true;
+    }
+
+    if (mQuery.caseSensitive)
+        return data.indexOf(mQueryUtf8) >= 0;
+
+    // case insensitive check works for ascii only
+    for (int i = 0; i < mQueryUtf8.size(); ++i)
+    {
+        if (static_cast<uchar>(mQueryUtf8[i]) >= 0x80)
+            return true;
+    }
+
+    const char *begin = data.constData();
+    const char *last = begin + data.size() - mQueryUtf8.size();
+    for (const char *p = begin; p <= last; ++p)
+    {
+        if (qstrnicmp(p, mQueryUtf8.constData(), mQueryUtf8.size()) == 0)
+            return true;
+    }
+    return false;
+}
+
+FindInFilesWidget::FindInFilesWidget(QWidget *parent)
+    : QWidget(parent)
+    , mHitCount(0)
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(2, 2, 2, 2);
+
+    QHBoxLayout *queryLayout = new QHBoxLayout();
+    layout->addLayout(queryLayout);
+
+    mQueryLine = new QLineEdit(this);
+    connect(mQueryLine, SIGNAL(returnPressed()), this, SLOT(startSearch()));
+    connect(mQueryLine, SIGNAL(textChanged(QString)), this, SLOT(updateButtons()));
+    queryLayout->addWidget(mQueryLine);
+
+    mCaseSensitiveCheck = new QCheckBox(tr("Case Sensitive"), this);
+    queryLayout->addWidget(mCaseSensitiveCheck);
+
+    mWholeIdentifierCheck = new QCheckBox(tr("Whole Identifier"), this);
+    queryLayout->addWidget(mWholeIdentifierCheck);
+
+    mFindButton = new QPushButton(tr("Find"), this);
+    connect(mFindButton, SIGNAL(clicked()), this, SLOT(startSearch()));
+    queryLayout->addWidget(mFindButton);
+
+    mStopButton = new QPushButton(tr("Stop"), this);
+    connect(mStopButton, SIGNAL(clicked()), this, SLOT(stopSearch()));
+    queryLayout->addWidget(mStopButton);
+
+    mResultsTree = new QTreeWidget(this);
+    mResultsTree->setColumnCount(2);
+    mResultsTree->setHeaderLabels(QStringList() << tr("Location") << tr("Text"));
+    mResultsTree->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    mResultsTree->setUniformRowHeights(true);
+    connect(mResultsTree, SIGNAL(itemActivated(QTreeWidgetItem*,int)), this, SLOT(itemActivated(QTreeWidgetItem*)));
+    layout->addWidget(mResultsTree);
+
+    mStatusLabel = new QLabel(this);
+    layout->addWidget(mStatusLabel);
+
+    connect(&mFutureWatcher, SIGNAL(resultReadyAt(int)), this, SLOT(searchResultReady(int)));
+    connect(&mFutureWatcher, SIGNAL(progressValueChanged(int)), this, SLOT(searchProgress(int)));
+    connect(&mFutureWatcher, SIGNAL(finished()), this, SLOT(searchFinished()));
+
+    updateButtons();
+}
+
+FindInFilesWidget::~FindInFilesWidget()
+{
+    shutdown();
+}
+
+void FindInFilesWidget::setSearchers(const tSearchersMap &searchers)
+{
+    mSearchers = searchers;
+}
+
+void FindInFilesWidget::activate()
+{
+    mQueryLine->selectAll();
+    mQueryLine->setFocus(Qt::ShortcutFocusReason);
+}
+
+void FindInFilesWidget::shutdown()
+{
+    mFutureWatcher.cancel();
+    mFutureWatcher.waitForFinished();
+    mSearchers.clear();
+}
+
+void FindInFilesWidget::startSearch()
+{
+    if (mQueryLine->text().isEmpty())
+        return;
+
+    // results of previous search aren't delivered after it's replaced
+    stopSearch();
+    mFutureWatcher.waitForFinished();
+
+    mResultsTree->clear();
+    mFileItems.clear();
+    mHitCount = 0;
+
+    QStringList files;
+    if (ProjectIndexer::instance())
+    {
+        foreach (const QString &fileName, ProjectIndexer::instance()->files())
+        {
+            if (mSearchers.contains(QFileInfo(fileName).suffix()))
+                files << fileName;
+        }
+    }
+
+    if (files.isEmpty())
+    {
+        mStatusLabel->setText(tr("There are no files to search. Open project or documents."));
+        return;
+    }
+
+    SearchQuery query;
+    query.text = mQueryLine->text();
+    query.caseSensitive = mCaseSensitiveCheck->isChecked();
+    query.wholeIdentifier = mWholeIdentifierCheck->isChecked();
+
+    mFutureWatcher.setFuture(QtConcurrent::mapped(files, SearchFunctor(query, mSearchers)));
+
+    mStatusLabel->setText(tr("Searching %1 files...").arg(files.size()));
+    updateButtons();
+}
+
+void FindInFilesWidget::stopSearch()
+{
+    mFutureWatcher.cancel();
+}
+
+void FindInFilesWidget::searchResultReady(int index)
+{
+    foreach (const SearchHit &hit, mFutureWatcher.resultAt(index))
+        addHit(hit);
+}
+
+void FindInFilesWidget::searchProgress(int value)
+{
+    mStatusLabel->setText(tr("Searched %1 of %2 files, %3 occurrences found")
+                          .arg(value).arg(mFutureWatcher.progressMaximum()).arg(mHitCount));
+}
+
+void FindInFilesWidget::searchFinished()
+{
+    QString text = tr("%1 occurrences found in %2 files").arg(mHitCount).arg(mFileItems.size());
+    if (mFutureWatcher.isCanceled())
+        text += tr(" (stopped)");
+    mStatusLabel->setText(text);
+
+    updateButtons();
+}
+
+void FindInFilesWidget::addHit(const SearchHit &hit)
+{
+    QTreeWidgetItem *fileItem = mFileItems.value(hit.fileName, 0);
+    if (!fileItem)
+    {
+        fileItem = new QTreeWidgetItem(mResultsTree);
+        fileItem->setText(0, QFileInfo(hit.fileName).fileName());
+        fileItem->setToolTip(0, hit.fileName);
+        fileItem->setExpanded(true);
+        mFileItems.insert(hit.fileName, fileItem);
+    }
+
+    QTreeWidgetItem *item = new QTreeWidgetItem(fileItem);
+    item->setText(0, hit.line > 0 ? QString("%1:%2").arg(hit.line).arg(hit.column) : QString("-"));
+    item->setText(1, hit.text);
+    item->setData(0, FileNameRole, hit.fileName);
+    item->setData(0, LineRole, hit.line);
+    item->setData(0, ColumnRole, hit.column);
+    item->setData(0, TextRole, hit.text);
+    item->setData(0, IdentifierRole, hit.identifier);
+    if (hit.hasObjectPos)
+        item->setData(0, ObjectPosRole, hit.objectPos);
+
+    ++mHitCount;
+    fileItem->setText(1, tr("%1 occurrences").arg(fileItem->childCount()));
+}
+
+void FindInFilesWidget::itemActivated(QTreeWidgetItem *item)
+{
+    // file items don't have hits
+    if (!item->parent())
+        return;
+
+    SearchHit hit;
+    hit.fileName = item->data(0, FileNameRole).toString();
+    hit.line = item->data(0, LineRole).toInt();
+    hit.column = item->data(0, ColumnRole).toInt();
+    hit.text = item->data(0, TextRole).toString();
+    hit.identifier = item->data(0, IdentifierRole).toString();
+    QVariant objectPos = item->data(0, ObjectPosRole);
+    hit.hasObjectPos = objectPos.isValid();
+    hit.objectPos = objectPos.toPointF();
+
+    emit hitActivated(hit);
+}
+
+void FindInFilesWidget::updateButtons()
+{
+    bool running = mFutureWatcher.isRunning();
+    mFindButton->setEnabled(!mQueryLine->text().isEmpty());
+    mStopButton->setEnabled(running);
+}
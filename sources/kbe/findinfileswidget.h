@@ -0,0 +1,97 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/documentsearcherinterface.h"
+
+#include <QWidget>
+#include <QMap>
+#include <QHash>
+#include <QFutureWatcher>
+
+class QLineEdit;
+class QCheckBox;
+class QPushButton;
+class QLabel;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+/*! Find in project panel. Files of project and opened documents are searched on disk
+ * in thread pool, every file is memory mapped and scanned by DocumentSearcherInterface
+ * of its format. Results are shown as soon as file is searched.
+ */
+class FindInFilesWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    typedef QMap<QString, DocumentSearcherInterface*> tSearchersMap;
+
+    explicit FindInFilesWidget(QWidget *parent = 0);
+    virtual ~FindInFilesWidget();
+
+    //! Sets searchers by file extensions. Files with other extensions aren't searched.
+    void setSearchers(const tSearchersMap &searchers);
+
+    //! Focuses query line and selects its text.
+    void activate();
+
+    //! Stops search and waits for workers. Must be called before searchers are unloaded.
+    void shutdown();
+
+signals:
+    //! Emitted when user activates found occurrence.
+    void hitActivated(const SearchHit &hit);
+
+public slots:
+    //! Starts search of query text in all project files.
+    void startSearch();
+    void stopSearch();
+
+private slots:
+    void searchResultReady(int index);
+    void searchProgress(int value);
+    void searchFinished();
+    void itemActivated(QTreeWidgetItem *item);
+    void updateButtons();
+
+private:
+    //! Searches single file in worker thread.
+    struct SearchFunctor
+    {
+        SearchFunctor(const SearchQuery &query, const tSearchersMap &searchers);
+
+        typedef SearchHitList result_type;
+        SearchHitList operator()(const QString &fileName) const;
+
+        /*! @return False, if @p data doesn't contain query text, so file can be skipped
+          without parsing. Always true, if it can't be checked on raw bytes.
+          */
+        bool mayContain(const QByteArray &data) const;
+
+        SearchQuery mQuery;
+        QByteArray mQueryUtf8;
+        tSearchersMap mSearchers;
+    };
+
+    void addHit(const SearchHit &hit);
+
+private:
+    QLineEdit *mQueryLine;
+    QCheckBox *mCaseSensitiveCheck;
+    QCheckBox *mWholeIdentifierCheck;
+    QPushButton *mFindButton;
+    QPushButton *mStopButton;
+    QLabel *mStatusLabel;
+    QTreeWidget *mResultsTree;
+
+    tSearchersMap mSearchers;
+
+    QFutureWatcher<SearchHitList> mFutureWatcher;
+    //! Top level result items by file names.
+    QHash<QString, QTreeWidgetItem*> mFileItems;
+    int mHitCount;
+};
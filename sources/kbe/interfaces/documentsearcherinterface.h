@@ -0,0 +1,85 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QtPlugin>
+#include <QStringList>
+#include <QList>
+#include <QPointF>
+
+//! Parameters of search in documents.
+struct SearchQuery
+{
+    SearchQuery()
+        : caseSensitive(false)
+        , wholeIdentifier(false)
+    {
+    }
+
+    //! @return True, if @p value matches query.
+    bool matches(const QString &value) const
+    {
+        Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        if (wholeIdentifier)
+            return value.compare(text, cs) == 0;
+        return value.contains(text, cs);
+    }
+
+    QString text;
+    bool caseSensitive;
+    //! Identifiers must be equal to text, otherwise they must contain it.
+    bool wholeIdentifier;
+};
+
+//! Occurrence of searched text in document.
+struct SearchHit
+{
+    SearchHit()
+        : line(0)
+        , column(0)
+        , hasObjectPos(false)
+    {
+    }
+
+    QString fileName;
+    //! Line number starting from 1, or 0 if format doesn't have lines.
+    int line;
+    //! Column number starting from 1, or 0 if it's unknown.
+    int column;
+    //! Found identifier or line of text.
+    QString text;
+    //! Identifier of object, that contains hit. Editors without lines use it to show hit.
+    QString identifier;
+    //! Position of object, that contains hit, for formats without lines. Used for objects without identifier.
+    QPointF objectPos;
+    bool hasObjectPos;
+};
+
+typedef QList<SearchHit> SearchHitList;
+
+/*! Interface for searching in documents of some file format without opening them
+  * in editors. It's used by find in project. @see EditorInterface::showSearchHit
+  */
+class DocumentSearcherInterface
+{
+public:
+    virtual ~DocumentSearcherInterface() {}
+
+    //! Return list of file extensions, that can be searched
+    virtual QStringList supportedFormatsExt() const = 0;
+
+    /*! Finds all occurrences of @p query in document. It's called from worker threads
+      at the same time for different files, so it must be reentrant.
+      @param fileName Name of file, it's set to hits.
+      @param data Content of file. It's usually mapped into memory, so it must not be kept.
+      */
+    virtual SearchHitList search(const QString &fileName, const QByteArray &data,
+                                 const SearchQuery &query) const = 0;
+};
+
+Q_DECLARE_INTERFACE(DocumentSearcherInterface,
+                    "com.OSTIS.kbe.DocumentSearcherInterface")
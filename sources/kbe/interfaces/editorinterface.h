@@ -15,6 +15,7 @@ class FileWriterInterface;
 class QToolBar;
 class QMainWindow;
 class EditorInterface;
+struct SearchHit;
 
 /*! Interface for observer, that observes changes in editors
   */
@@ -98,6 +99,11 @@ public:
     */
     virtual const QString& currentFileName() const { return mFileName; }
 
+    /*! Shows occurrence, that is found by find in project, in loaded document.
+     @param hit Occurrence in file of this window. @see DocumentSearcherInterface
+     */
+    virtual void showSearchHit(const SearchHit &hit) { Q_UNUSED(hit); }
+
     /*! Window activation.
      @brief    Calls when window made active (selected in main window tab).
      @param    window  Pointer to main window
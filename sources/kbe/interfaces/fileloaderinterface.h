@@ -0,0 +1,37 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QtPlugin>
+#include <QStringList>
+
+/*! Interface for loading documents of some file format.
+  * Together with FileWriterInterface it allows to convert documents between
+  * formats, that are loaded into the same kind of object.
+  */
+class FileLoaderInterface
+{
+public:
+    virtual ~FileLoaderInterface() {}
+
+    /*! Loads file.
+      @param fileName Name of file.
+      @param output Object, that receives loaded document (e.g. editor scene).
+
+      @return If file loaded, then return true, else - false. @see lastError()
+      */
+    virtual bool load(QString fileName, QObject *output) = 0;
+
+    //! Return list of file extensions, that can be loaded
+    virtual QStringList supportedFormatsExt() const = 0;
+
+    //! Return description of last error
+    virtual const QString& lastError() const = 0;
+};
+
+Q_DECLARE_INTERFACE(FileLoaderInterface,
+                    "com.OSTIS.kbe.FileLoaderInterface")
@@ -0,0 +1,36 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QtPlugin>
+#include <QStringList>
+
+/*! Interface for saving documents in some file format.
+  * @see FileLoaderInterface
+  */
+class FileWriterInterface
+{
+public:
+    virtual ~FileWriterInterface() {}
+
+    /*! Saves document to file.
+      @param fileName Name of file.
+      @param input Object, that holds document (e.g. editor scene).
+
+      @return If file saved, then return true, else - false. @see lastError()
+      */
+    virtual bool save(QString fileName, QObject *input) = 0;
+
+    //! Return list of file extensions, that can be written
+    virtual QStringList supportedFormatsExt() const = 0;
+
+    //! Return description of last error
+    virtual const QString& lastError() const = 0;
+};
+
+Q_DECLARE_INTERFACE(FileWriterInterface,
+                    "com.OSTIS.kbe.FileWriterInterface")
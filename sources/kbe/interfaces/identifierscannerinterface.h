@@ -0,0 +1,61 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QtPlugin>
+#include <QStringList>
+#include <QList>
+
+//! Occurrence of identifier in file.
+struct IdentifierLocation
+{
+    IdentifierLocation()
+        : line(0)
+        , column(0)
+    {
+    }
+
+    IdentifierLocation(const QString &_identifier, const QString &_fileName, int _line, int _column)
+        : identifier(_identifier)
+        , fileName(_fileName)
+        , line(_line)
+        , column(_column)
+    {
+    }
+
+    QString identifier;
+    //! Absolute name of file.
+    QString fileName;
+    //! Line number starting from 1, or 0 if it's unknown.
+    int line;
+    //! Column number starting from 1, or 0 if it's unknown.
+    int column;
+};
+
+typedef QList<IdentifierLocation> IdentifierLocationList;
+
+/*! Interface for finding identifiers in documents of some file format.
+  * It's used to build identifier index of all project files. @see ProjectIndexInterface
+  */
+class IdentifierScannerInterface
+{
+public:
+    virtual ~IdentifierScannerInterface() {}
+
+    //! Return list of file extensions, that can be scanned
+    virtual QStringList supportedFormatsExt() const = 0;
+
+    /*! Finds all identifiers in document. It's called from worker threads at the same
+      time for different files, so it must be reentrant.
+      @param fileName Name of file, it's set to found locations.
+      @param data Content of file.
+      */
+    virtual IdentifierLocationList scan(const QString &fileName, const QByteArray &data) const = 0;
+};
+
+Q_DECLARE_INTERFACE(IdentifierScannerInterface,
+                    "com.OSTIS.kbe.IdentifierScannerInterface")
@@ -0,0 +1,44 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/identifierscannerinterface.h"
+
+/*! Identifier index of all project files and opened documents. It's implemented
+  * by application and updated in background, so queries don't scan any files.
+  * @see ProjectIndex
+  */
+class ProjectIndexInterface
+{
+public:
+    virtual ~ProjectIndexInterface() {}
+
+    /*! @return Sorted identifiers, that start with @p prefix (case sensitive).
+      @param limit Maximum number of identifiers, all of them are returned if it's less or equal to 0.
+      */
+    virtual QStringList identifiers(const QString &prefix, int limit) const = 0;
+
+    //! @return All known occurrences of @p identifier.
+    virtual IdentifierLocationList locations(const QString &identifier) const = 0;
+
+    /*! Indexes file of opened document, even if it doesn't belong to project.
+      Repeated calls rescan file, e.g. after it's saved.
+      */
+    virtual void documentOpened(const QString &fileName) = 0;
+
+    /*! Indexes unsaved content of opened document instead of its file.
+      @param fileName Document file name, untitled documents aren't indexed.
+      @param content Document content in file format.
+      */
+    virtual void documentChanged(const QString &fileName, const QByteArray &content) = 0;
+
+    //! Returns to indexing of file on disk, if it belongs to project, or forgets it.
+    virtual void documentClosed(const QString &fileName) = 0;
+};
+
+Q_DECLARE_INTERFACE(ProjectIndexInterface,
+                    "com.OSTIS.kbe.ProjectIndexInterface")
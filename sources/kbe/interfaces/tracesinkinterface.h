@@ -0,0 +1,35 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QtPlugin>
+#include <QString>
+
+/*! Receives trace events of application and plugins. It's implemented by application,
+  * when tracing is enabled. @see Trace, TraceScope
+  */
+class TraceSinkInterface
+{
+public:
+    virtual ~TraceSinkInterface() {}
+
+    //! @return Time in microseconds since tracing started, it's common for all threads.
+    virtual qint64 now() const = 0;
+
+    /*! Adds complete event of current thread.
+      @param category Event category. Must be string literal.
+      @param name Event name. Must be string literal.
+      @param start Start time. @see now()
+      @param duration Duration in microseconds.
+      @param detail Optional detail, that is shown with event (e.g. file name).
+      */
+    virtual void addEvent(const char *category, const char *name, qint64 start, qint64 duration,
+                          const QString &detail) = 0;
+};
+
+Q_DECLARE_INTERFACE(TraceSinkInterface,
+                    "com.OSTIS.kbe.TraceSinkInterface")
@@ -4,7 +4,7 @@
 
 DESTDIR = ../bin
 
-QT      += xml widgets
+QT      += xml widgets concurrent
 
 TEMPLATE = app
 
@@ -17,6 +17,10 @@ SOURCES += \
     guidedialog.cpp \
     newfiledialog.cpp \
     settingsdialog.cpp \
+    tracerecorder.cpp \
+    project.cpp \
+    projectindexer.cpp \
+    findinfileswidget.cpp \
 
 HEADERS += version.h \
     platform.h \
@@ -26,6 +30,18 @@ HEADERS += version.h \
     interfaces/plugininterface.h \
     pluginmanager.h \
     interfaces/editorinterface.h \
+    interfaces/fileloaderinterface.h \
+    interfaces/filewriterinterface.h \
+    interfaces/tracesinkinterface.h \
+    interfaces/identifierscannerinterface.h \
+    interfaces/projectindexinterface.h \
+    interfaces/documentsearcherinterface.h \
+    trace.h \
+    tracerecorder.h \
+    project.h \
+    projectindex.h \
+    projectindexer.h \
+    findinfileswidget.h \
     guidedialog.h \
     newfiledialog.h \
     settingsdialog.h
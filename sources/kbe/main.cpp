@@ -9,6 +9,8 @@
 #include "platform.h"
 #include "mainwindow.h"
 #include "guidedialog.h"
+#include "tracerecorder.h"
+#include "projectindexer.h"
 
 #include <QApplication>
 #include <QTranslator>
@@ -62,6 +64,10 @@ int main(int argc, char *argv[])
     myappTranslator.load(":/media/translations/lang_" + QLocale::system().name() + ".qm");
     a.installTranslator(&myappTranslator);
 
+    // plugins get recorder from application, so it's installed before they are loaded
+    TraceRecorder *traceRecorder = TraceRecorder::install(&a);
+    ProjectIndexer::install(&a);
+
     //splash.showMessage(a.tr("Create interface"), Qt::AlignBottom | Qt::AlignHCenter);
     MainWindow::getInstance()->show();
 
@@ -88,5 +94,10 @@ int main(int argc, char *argv[])
 //    }
 
     //splash.finish(&w);
-    return a.exec();
+    int res = a.exec();
+
+    if (traceRecorder)
+        traceRecorder->save();
+
+    return res;
 }
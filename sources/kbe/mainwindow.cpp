@@ -11,6 +11,10 @@
 
 #include "interfaces/editorinterface.h"
 #include "pluginmanager.h"
+#include "project.h"
+#include "projectindexer.h"
+#include "findinfileswidget.h"
+#include "interfaces/documentsearcherinterface.h"
 #include "guidedialog.h"
 #include "newfiledialog.h"
 #include "settingsdialog.h"
@@ -35,6 +39,7 @@
 #include <QSettings>
 #include <QDockWidget>
 #include <QMimeData>
+#include <QStatusBar>
 
 MainWindow* MainWindow::mInstance = 0;
 
@@ -53,6 +58,9 @@ MainWindow::MainWindow(QWidget *parent)
     , mLastActiveWindow(0)
     , mToolBarFile(0)
     , mToolBarEdit(0)
+    , mProject(0)
+    , mFindInFiles(0)
+    , mFindInFilesDock(0)
 {
     ui->setupUi(this);
 
@@ -81,6 +89,12 @@ MainWindow::MainWindow(QWidget *parent)
     new PluginManager();
     PluginManager::instance()->initialize(Config::pathPlugins.absolutePath());
 
+    if (ProjectIndexer *indexer = ProjectIndexer::instance())
+    {
+        indexer->setScanners(PluginManager::instance()->getIdentifierScannersByExt());
+        connect(indexer, SIGNAL(indexingProgress(int,int)), this, SLOT(onIndexingProgress(int,int)));
+    }
+
     // blur effect
     mBlurEffect = new QGraphicsBlurEffect(this);
     mBlurEffect->setEnabled(false);
@@ -94,6 +108,20 @@ MainWindow::MainWindow(QWidget *parent)
 
     mSettingsDialog = new SettingsDialog(this);
     mSettingsDialog->initialize();
+
+    mFindInFiles = new FindInFilesWidget(this);
+    mFindInFiles->setSearchers(PluginManager::instance()->getDocumentSearchersByExt());
+    connect(mFindInFiles, SIGNAL(hitActivated(SearchHit)), this, SLOT(onFindHitActivated(SearchHit)));
+
+    mFindInFilesDock = new QDockWidget(tr("Find in Project"), this);
+    mFindInFilesDock->setObjectName("FindInProjectDock");
+    mFindInFilesDock->setWidget(mFindInFiles);
+    addDockWidget(Qt::BottomDockWidgetArea, mFindInFilesDock);
+    mFindInFilesDock->hide();
+
+    QString projectFileName = settings.value(Config::settingsLastProject).toString();
+    if (!projectFileName.isEmpty() && QFile::exists(projectFileName))
+        onProjectOpen(projectFileName);
 }
 
 
@@ -105,6 +133,12 @@ MainWindow::~MainWindow()
     delete ui;
     delete mTabWidget;
 
+    // indexer and find in project use plugins in worker threads
+    mFindInFiles->shutdown();
+    if (ProjectIndexer::instance())
+        ProjectIndexer::instance()->shutdown();
+    delete mProject;
+
     PluginManager::instance()->shutdown();
     delete PluginManager::instance();
 }
@@ -158,7 +192,13 @@ void MainWindow::createActions()
     connect(ui->actionClose_Others, SIGNAL(triggered()), this, SLOT(onUpdateMenu()));
     connect(ui->actionExit, SIGNAL(triggered()), this, SLOT(onFileExit()));
 
+    connect(ui->actionNew_Project, SIGNAL(triggered()), this, SLOT(onProjectNew()));
+    connect(ui->actionOpen_Project, SIGNAL(triggered()), this, SLOT(onProjectOpen()));
+    connect(ui->actionSave_Project, SIGNAL(triggered()), this, SLOT(onProjectSave()));
+    connect(ui->actionClose_Project, SIGNAL(triggered()), this, SLOT(onProjectClose()));
+
     connect(ui->actionSettings, SIGNAL(triggered()), this, SLOT(onViewSettings()));
+    connect(ui->actionFind_in_Project, SIGNAL(triggered()), this, SLOT(onFindInProject()));
 
     for (int i = 0; i < MaxRecentFiles; ++i)
     {
@@ -230,6 +270,9 @@ void MainWindow::onUpdateMenu()
     ui->actionClose->setEnabled(subWindow != 0);
     ui->actionClose_All->setEnabled(subWindow != 0);
     ui->actionClose_Others->setEnabled(mTabWidget->subWindowList().size() > 1);
+
+    ui->actionSave_Project->setEnabled(mProject != 0);
+    ui->actionClose_Project->setEnabled(mProject != 0);
 }
 
 void MainWindow::updateRecentFileActions()
@@ -499,12 +542,150 @@ void MainWindow::onFileExit()
     close();
 }
 
+QString MainWindow::getProjectFileName(bool save)
+{
+    QFileDialog::Options options;
+    options |= QFileDialog::DontUseNativeDialog;
+    QString filter = tr("KBE project (*.%1)").arg(Project::fileExtension());
+
+    mBlurEffect->setEnabled(true);
+    QString fileName;
+    if (save)
+        fileName = QFileDialog::getSaveFileName(this, tr("New project"), mLastDir.absolutePath(),
+                                                filter, 0, options);
+    else
+        fileName = QFileDialog::getOpenFileName(this, tr("Open project"), mLastDir.absolutePath(),
+                                                filter, 0, options);
+    mBlurEffect->setEnabled(false);
+
+    if (fileName.isEmpty())
+        return fileName;
+
+    mLastDir = QFileInfo(fileName).absoluteDir();
+    if (save && QFileInfo(fileName).suffix() != Project::fileExtension())
+        fileName += "." + Project::fileExtension();
+    return fileName;
+}
+
+void MainWindow::setProject(Project *project)
+{
+    if (ProjectIndexer::instance())
+        ProjectIndexer::instance()->setProject(project);
+
+    delete mProject;
+    mProject = project;
+
+    QSettings().setValue(Config::settingsLastProject, mProject ? mProject->fileName() : QString());
+    onUpdateMenu();
+}
+
+void MainWindow::onProjectNew()
+{
+    QString fileName = getProjectFileName(true);
+    if (fileName.isEmpty())
+        return;
+
+    // sources of new project are in its directory
+    Project *project = new Project(this);
+    if (!project->save(fileName))
+    {
+        QMessageBox::warning(this, qAppName(), project->lastError());
+        delete project;
+        return;
+    }
+
+    setProject(project);
+}
+
+void MainWindow::onProjectOpen(QString fileName)
+{
+    if (fileName.isNull())
+    {
+        fileName = getProjectFileName(false);
+        if (fileName.isEmpty())
+            return;
+    }
+
+    Project *project = new Project(this);
+    if (!project->load(fileName))
+    {
+        QMessageBox::warning(this, qAppName(), project->lastError());
+        delete project;
+        return;
+    }
+
+    setProject(project);
+}
+
+void MainWindow::onProjectSave()
+{
+    Q_ASSERT(mProject);
+
+    if (!mProject->save(mProject->fileName()))
+        QMessageBox::warning(this, qAppName(), mProject->lastError());
+}
+
+void MainWindow::onProjectClose()
+{
+    setProject(0);
+}
+
+void MainWindow::onIndexingProgress(int done, int total)
+{
+    if (done < total)
+        statusBar()->showMessage(tr("Indexing project: %1 of %2 files").arg(done).arg(total));
+    else
+        statusBar()->clearMessage();
+}
+
 void MainWindow::onViewSettings()
 {
     Q_ASSERT(mSettingsDialog);
     mSettingsDialog->show();
 }
 
+void MainWindow::onFindInProject()
+{
+    mFindInFilesDock->show();
+    mFindInFilesDock->raise();
+    mFindInFiles->activate();
+}
+
+void MainWindow::onFindHitActivated(const SearchHit &hit)
+{
+    if (!QFile::exists(hit.fileName))
+    {
+        QMessageBox::warning(this, qAppName(), tr("Can't open file.\nFile \"%1\" not found. ").arg(hit.fileName));
+        return;
+    }
+
+    // index keeps absolute names, so documents are compared by file info
+    QFileInfo hitFile(hit.fileName);
+    EditorInterface *editor = 0;
+    foreach (EditorInterface *child, mWidget2EditorInterface)
+    {
+        if (!child->currentFileName().isEmpty() && QFileInfo(child->currentFileName()) == hitFile)
+        {
+            editor = child;
+            break;
+        }
+    }
+
+    if (editor)
+    {
+        mTabWidget->setCurrentWidget(editor->widget());
+    }
+    else
+    {
+        load(hit.fileName);
+        editor = activeChild();
+        if (!editor || QFileInfo(editor->currentFileName()) != hitFile)
+            return;
+    }
+
+    editor->showSearchHit(hit);
+}
+
 void MainWindow::onHelpAbout()
 {
     QMessageBox::about(this, tr("About KBE"),
@@ -24,6 +24,9 @@ class QKeyEvent;
 class EditorInterface;
 class SCgWindow;
 class SettingsDialog;
+class Project;
+class FindInFilesWidget;
+struct SearchHit;
 
 class MainWindow : public QMainWindow,
                    public EditorObserverInterface
@@ -112,6 +115,14 @@ private:
      */
     QString getSettingKeyValueForWindow(const QString& editorType) const;
 
+    /*! Makes @p project current, previous project is closed.
+     * @param project Project or null pointer. Main window becomes its owner.
+     */
+    void setProject(Project *project);
+
+    //! Asks for project file name in save or open dialog. @return Empty string, if dialog is canceled.
+    QString getProjectFileName(bool save);
+
     /*!
      * Saves main window layout including dock widgets and geometry.
      */
@@ -160,6 +171,13 @@ private:
 
     SettingsDialog * mSettingsDialog;
 
+    //! Current project or null pointer
+    Project *mProject;
+
+    //! Find in project panel and its dock
+    FindInFilesWidget *mFindInFiles;
+    QDockWidget *mFindInFilesDock;
+
 public slots:
     void onUpdateMenu();
     void updateRecentFileActions();
@@ -174,7 +192,18 @@ public slots:
     void onFileExportToImage();
     void onFileExit();
 
+    void onProjectNew();
+    void onProjectOpen(QString fileName = QString());
+    void onProjectSave();
+    void onProjectClose();
+
+    //! Shows progress of project indexing in status bar. @see ProjectIndexer::indexingProgress
+    void onIndexingProgress(int done, int total);
+
     void onViewSettings();
+    void onFindInProject();
+    //! Opens document of found occurrence and shows it.
+    void onFindHitActivated(const SearchHit &hit);
 
     void onHelpAbout();
     void onHelpAboutQt();
@@ -7,6 +7,8 @@
 #include "pluginmanager.h"
 #include "interfaces/plugininterface.h"
 #include "interfaces/editorinterface.h"
+#include "interfaces/identifierscannerinterface.h"
+#include "interfaces/documentsearcherinterface.h"
 #include "config.h"
 
 #include <QDir>
@@ -109,6 +111,8 @@ void PluginManager::processLoadPlugin(PluginInterface * pluginInterface)
     foreach(_interface, interfaces)
     {
         EditorFactoryInterface * factory = qobject_cast<EditorFactoryInterface*>(_interface);
+        IdentifierScannerInterface * scanner = qobject_cast<IdentifierScannerInterface*>(_interface);
+        DocumentSearcherInterface * searcher = qobject_cast<DocumentSearcherInterface*>(_interface);
         if (factory != 0)
         {
             QString type = factory->name();
@@ -123,6 +127,20 @@ void PluginManager::processLoadPlugin(PluginInterface * pluginInterface)
                 mEditorFactoriesByExt[ext] = factory;
             }
         }
+        else if (scanner != 0)
+        {
+            QStringList extList = scanner->supportedFormatsExt();
+            QString ext;
+            foreach(ext, extList)
+                mIdentifierScannersByExt[ext] = scanner;
+        }
+        else if (searcher != 0)
+        {
+            QStringList extList = searcher->supportedFormatsExt();
+            QString ext;
+            foreach(ext, extList)
+                mDocumentSearchersByExt[ext] = searcher;
+        }
         else
         {
             // interface can't be handled
@@ -15,6 +15,8 @@ class QPluginLoader;
 class PluginInterface;
 class EditorInterface;
 class EditorFactoryInterface;
+class IdentifierScannerInterface;
+class DocumentSearcherInterface;
 
 class PluginManager : public QObject
 {
@@ -33,6 +35,8 @@ public:
     typedef QSet<QString> tExtensionsSet;
     typedef QMap<QString, EditorFactoryInterface*> tEditorFactoryInterfacesMap;
     typedef QMap<QString, QWidget*> tSettingWidgetsMap;
+    typedef QMap<QString, IdentifierScannerInterface*> tIdentifierScannersMap;
+    typedef QMap<QString, DocumentSearcherInterface*> tDocumentSearchersMap;
 
 public:
 
@@ -62,6 +66,10 @@ public:
     tEditorFactoryInterfacesMap const & getEditorFactoriesByExt() const { return mEditorFactoriesByExt; }
     //! Return map of registered settings widgets
     tSettingWidgetsMap const & getSettingWidgets() const { return mSettingWidgets; }
+    //! Return map of registered identifier scanners by file extensions
+    tIdentifierScannersMap const & getIdentifierScannersByExt() const { return mIdentifierScannersByExt; }
+    //! Return map of registered document searchers by file extensions
+    tDocumentSearchersMap const & getDocumentSearchersByExt() const { return mDocumentSearchersByExt; }
 
     /*! Create editor for specified window type
       * @param type String that represents window type
@@ -99,6 +107,10 @@ protected:
     tEditorFactoryInterfacesMap mEditorFactoriesByExt;
     //! Pointer to all settings widgets by names
     tSettingWidgetsMap mSettingWidgets;
+    //! Registered identifier scanners by extensions
+    tIdentifierScannersMap mIdentifierScannersByExt;
+    //! Registered document searchers by extensions
+    tDocumentSearchersMap mDocumentSearchersByExt;
 
 signals:
 
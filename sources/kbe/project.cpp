@@ -0,0 +1,159 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "project.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+Project::Project(QObject *parent)
+    : QObject(parent)
+{
+    // new project takes sources from its own directory
+    mSourceDirs << ".";
+}
+
+Project::~Project()
+{
+}
+
+QString Project::fileExtension()
+{
+    return "kbproj";
+}
+
+bool Project::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        mLastError = tr("Can't open file %1:\n%2").arg(fileName, file.errorString());
+        return false;
+    }
+
+    QString name;
+    QStringList sourceDirs;
+    bool isProject = false;
+
+    QXmlStreamReader reader(&file);
+    while (!reader.atEnd())
+    {
+        if (reader.readNext() != QXmlStreamReader::StartElement)
+            continue;
+
+        if (reader.name() == "project")
+        {
+            isProject = true;
+            name = reader.attributes().value("name").toString();
+        }
+        else if (reader.name() == "sources" && isProject)
+        {
+            QString path = reader.attributes().value("path").toString();
+            if (!path.isEmpty())
+                sourceDirs << path;
+        }
+    }
+
+    if (reader.hasError())
+    {
+        mLastError = tr("Error in file %1 at line %2:\n%3")
+                .arg(fileName).arg(reader.lineNumber()).arg(reader.errorString());
+        return false;
+    }
+    if (!isProject)
+    {
+        mLastError = tr("File %1 isn't a project file").arg(fileName);
+        return false;
+    }
+
+    mFileName = QFileInfo(fileName).absoluteFilePath();
+    mName = name.isEmpty() ? QFileInfo(fileName).completeBaseName() : name;
+    mSourceDirs = sourceDirs;
+    mLastError.clear();
+    return true;
+}
+
+bool Project::save(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        mLastError = tr("Can't open file %1 for writing:\n%2").arg(fileName, file.errorString());
+        return false;
+    }
+
+    // keep directories at the same place, when project file is moved
+    QStringList absDirs = sourceDirs();
+    QDir newRoot = QFileInfo(fileName).absoluteDir();
+
+    if (mName.isEmpty())
+        mName = QFileInfo(fileName).completeBaseName();
+
+    QXmlStreamWriter writer(&file);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+    writer.writeStartElement("project");
+    writer.writeAttribute("name", mName);
+    writer.writeAttribute("version", "1");
+
+    mSourceDirs.clear();
+    foreach (const QString &dir, absDirs)
+    {
+        QString path = newRoot.relativeFilePath(dir);
+        if (path.isEmpty())
+            path = ".";
+        mSourceDirs << path;
+
+        writer.writeStartElement("sources");
+        writer.writeAttribute("path", path);
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+
+    if (file.error() != QFile::NoError)
+    {
+        mLastError = file.errorString();
+        return false;
+    }
+
+    mFileName = QFileInfo(fileName).absoluteFilePath();
+    mLastError.clear();
+    return true;
+}
+
+void Project::setName(const QString &name)
+{
+    mName = name;
+}
+
+QDir Project::rootDir() const
+{
+    if (mFileName.isEmpty())
+        return QDir::current();
+    return QFileInfo(mFileName).absoluteDir();
+}
+
+QStringList Project::sourceDirs() const
+{
+    QDir root = rootDir();
+    QStringList res;
+    foreach (const QString &dir, mSourceDirs)
+    {
+        QString path = QDir::cleanPath(root.absoluteFilePath(dir));
+        if (!res.contains(path))
+            res << path;
+    }
+    return res;
+}
+
+void Project::setSourceDirs(const QStringList &dirs)
+{
+    mSourceDirs = dirs;
+}
@@ -0,0 +1,65 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+#include <QDir>
+
+/*! Knowledge base project. Project file lists directories with source files,
+ * all files with supported extensions in them (recursively) belong to project.
+ *
+ * File format:
+ * @code
+ * <project name="..." version="1">
+ *     <sources path="relative/or/absolute/path"/>
+ * </project>
+ * @endcode
+ */
+class Project : public QObject
+{
+    Q_OBJECT
+public:
+    explicit Project(QObject *parent = 0);
+    virtual ~Project();
+
+    //! @return Extension of project files without dot.
+    static QString fileExtension();
+
+    /*! Loads project from file.
+      @return If project loaded, then return true, else - false. @see lastError
+      */
+    bool load(const QString &fileName);
+    /*! Saves project to file. Source directories are stored relative to it.
+      @return If project saved, then return true, else - false. @see lastError
+      */
+    bool save(const QString &fileName);
+
+    //! @return Name of project file, or empty string for unsaved project.
+    const QString& fileName() const { return mFileName; }
+
+    const QString& name() const { return mName; }
+    void setName(const QString &name);
+
+    //! @return Directory of project file.
+    QDir rootDir() const;
+
+    //! @return Absolute paths of source directories.
+    QStringList sourceDirs() const;
+    //! Sets source directories, relative paths are resolved from rootDir.
+    void setSourceDirs(const QStringList &dirs);
+
+    //! @return Description of last load or save error.
+    const QString& lastError() const { return mLastError; }
+
+private:
+    QString mFileName;
+    QString mName;
+    //! Source directories as they are written in file.
+    QStringList mSourceDirs;
+    QString mLastError;
+};
@@ -0,0 +1,38 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/projectindexinterface.h"
+
+#include <QCoreApplication>
+#include <QVariant>
+
+//! Property of application, that holds project index object.
+#define KBE_PROJECT_INDEX_PROPERTY "kbeProjectIndex"
+
+/*! Access to project identifier index. It's header only like Trace, so plugins use
+ * it without linking to application.
+ */
+class ProjectIndex
+{
+public:
+    //! @return Project index or null pointer, if it isn't available (e.g. in command line tools).
+    static ProjectIndexInterface* instance()
+    {
+        static ProjectIndexInterface *index = findIndex();
+        return index;
+    }
+
+private:
+    static ProjectIndexInterface* findIndex()
+    {
+        QCoreApplication *app = QCoreApplication::instance();
+        if (!app)
+            return 0;
+        return qobject_cast<ProjectIndexInterface*>(app->property(KBE_PROJECT_INDEX_PROPERTY).value<QObject*>());
+    }
+};
@@ -0,0 +1,489 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "projectindexer.h"
+#include "projectindex.h"
+#include "project.h"
+#include "trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+
+//! Delay of scanning after the last change, merges changes of typing user.
+#define SCAN_DELAY 200
+
+ProjectIndexer* ProjectIndexer::mInstance = 0;
+
+ProjectIndexer* ProjectIndexer::install(QCoreApplication *app)
+{
+    Q_ASSERT(app);
+
+    ProjectIndexer *indexer = new ProjectIndexer(app);
+    app->setProperty(KBE_PROJECT_INDEX_PROPERTY, QVariant::fromValue<QObject*>(indexer));
+    return indexer;
+}
+
+ProjectIndexer* ProjectIndexer::instance()
+{
+    return mInstance;
+}
+
+ProjectIndexer::ProjectIndexer(QObject *parent)
+    : QObject(parent)
+    , mSortedValid(true)
+    , mNextVersion(0)
+    , mScanning(false)
+    , mScanDone(0)
+    , mScanTotal(0)
+{
+    Q_ASSERT(mInstance == 0);
+    mInstance = this;
+
+    mScanTimer.setSingleShot(true);
+    mScanTimer.setInterval(SCAN_DELAY);
+    connect(&mScanTimer, SIGNAL(timeout()), this, SLOT(startScan()));
+
+    connect(&mFutureWatcher, SIGNAL(resultReadyAt(int)), this, SLOT(scanResultReady(int)));
+    connect(&mFutureWatcher, SIGNAL(finished()), this, SLOT(scanFinished()));
+
+    connect(&mWatcher, SIGNAL(directoryChanged(QString)), this, SLOT(directoryChanged(QString)));
+    connect(&mWatcher, SIGNAL(fileChanged(QString)), this, SLOT(fileChanged(QString)));
+}
+
+ProjectIndexer::~ProjectIndexer()
+{
+    shutdown();
+
+    Q_ASSERT(mInstance == this);
+    mInstance = 0;
+}
+
+void ProjectIndexer::setScanners(const tScannersMap &scanners)
+{
+    mScanners = scanners;
+}
+
+void ProjectIndexer::setProject(const Project *project)
+{
+    QSet<QString> files = mProjectFiles;
+    foreach (const QString &fileName, files)
+        removeProjectFile(fileName);
+
+    if (!mProjectSubdirs.isEmpty())
+        mWatcher.removePaths(mProjectSubdirs.toList());
+    mProjectSubdirs.clear();
+
+    if (!project)
+        return;
+
+    foreach (const QString &dir, project->sourceDirs())
+        addProjectDir(dir);
+}
+
+void ProjectIndexer::shutdown()
+{
+    mScanTimer.stop();
+    mPending.clear();
+
+    // scanners belong to plugins, so workers must be stopped before they are unloaded
+    mFutureWatcher.cancel();
+    mFutureWatcher.waitForFinished();
+
+    mScanners.clear();
+}
+
+bool ProjectIndexer::isIndexing() const
+{
+    return mScanning || !mPending.isEmpty();
+}
+
+QStringList ProjectIndexer::files() const
+{
+    QStringList res = (mProjectFiles + mOpenFiles).toList();
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+QStringList ProjectIndexer::identifiers(const QString &prefix, int limit) const
+{
+    if (!mSortedValid)
+    {
+        mSortedIdentifiers = mLocations.keys();
+        std::sort(mSortedIdentifiers.begin(), mSortedIdentifiers.end());
+        mSortedValid = true;
+    }
+
+    QStringList res;
+    QStringList::const_iterator it = std::lower_bound(mSortedIdentifiers.constBegin(),
+                                                      mSortedIdentifiers.constEnd(), prefix);
+    for (; it != mSortedIdentifiers.constEnd() && it->startsWith(prefix); ++it)
+    {
+        res << *it;
+        if (limit > 0 && res.size() >= limit)
+            break;
+    }
+    return res;
+}
+
+IdentifierLocationList ProjectIndexer::locations(const QString &identifier) const
+{
+    return mLocations.value(identifier);
+}
+
+void ProjectIndexer::documentOpened(const QString &fileName)
+{
+    QString name = normalizedName(fileName);
+    if (!scannerFor(name))
+        return;
+
+    mOpenFiles.insert(name);
+    mWatcher.addPath(name);
+
+    // file is saved, so it replaces unsaved content
+    mDocuments.remove(name);
+    queueScan(name);
+}
+
+void ProjectIndexer::documentChanged(const QString &fileName, const QByteArray &content)
+{
+    if (fileName.isEmpty())
+        return;
+
+    QString name = normalizedName(fileName);
+    if (!scannerFor(name))
+        return;
+
+    if (!mOpenFiles.contains(name))
+    {
+        mOpenFiles.insert(name);
+        mWatcher.addPath(name);
+    }
+
+    mDocuments.insert(name);
+    queueScan(name, content);
+}
+
+void ProjectIndexer::documentClosed(const QString &fileName)
+{
+    QString name = normalizedName(fileName);
+    if (!mOpenFiles.remove(name))
+        return;
+
+    bool hadContent = mDocuments.remove(name);
+    if (isProjectFile(name))
+    {
+        // unsaved changes are lost, return to file on disk
+        if (hadContent)
+            queueScan(name);
+    }
+    else
+    {
+        mWatcher.removePath(name);
+        removeFile(name);
+    }
+}
+
+void ProjectIndexer::startScan()
+{
+    if (mScanning || mPending.isEmpty())
+        return;
+
+    QList<ScanTask> tasks = mPending.values();
+    mPending.clear();
+
+    mScanning = true;
+    mFutureWatcher.setFuture(QtConcurrent::mapped(tasks, ScanFunctor()));
+
+    emit indexingProgress(mScanDone, mScanTotal);
+}
+
+void ProjectIndexer::scanResultReady(int index)
+{
+    ScanResult res = mFutureWatcher.resultAt(index);
+    ++mScanDone;
+
+    QHash<QString, int>::const_iterator it = mVersions.find(res.fileName);
+    if (it != mVersions.end() && it.value() == res.version)
+        setFileLocations(res.fileName, res.ok ? res.locations : IdentifierLocationList());
+
+    emit indexingProgress(mScanDone, mScanTotal);
+}
+
+void ProjectIndexer::scanFinished()
+{
+    mScanning = false;
+    emit indexChanged();
+
+    if (mPending.isEmpty())
+    {
+        mScanDone = mScanTotal = 0;
+        emit indexingProgress(0, 0);
+    }
+    else if (!mScanTimer.isActive())
+    {
+        startScan();
+    }
+}
+
+void ProjectIndexer::directoryChanged(const QString &path)
+{
+    if (!mProjectSubdirs.contains(path))
+        return;
+
+    QDir dir(path);
+    if (!dir.exists())
+    {
+        removeProjectDir(path);
+        return;
+    }
+
+    QStringList filters;
+    foreach (const QString &ext, mScanners.keys())
+        filters << "*." + ext;
+
+    QSet<QString> current;
+    foreach (const QFileInfo &info, dir.entryInfoList(filters, QDir::Files))
+        current.insert(info.absoluteFilePath());
+
+    QSet<QString> files = mProjectFiles;
+    foreach (const QString &fileName, files)
+    {
+        if (!current.contains(fileName) && QFileInfo(fileName).absolutePath() == path)
+            removeProjectFile(fileName);
+    }
+    foreach (const QString &fileName, current)
+        addProjectFile(fileName);
+
+    foreach (const QFileInfo &info, dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+    {
+        if (!mProjectSubdirs.contains(info.absoluteFilePath()))
+            addProjectDir(info.absoluteFilePath());
+    }
+}
+
+void ProjectIndexer::fileChanged(const QString &path)
+{
+    if (!isIndexed(path) || !QFileInfo(path).exists())
+        return;
+
+    // some editors save files by replacing them, then file is removed from watcher
+    mWatcher.addPath(path);
+
+    // unsaved content of document is more recent
+    if (!mDocuments.contains(path))
+        queueScan(path);
+}
+
+ProjectIndexer::ScanResult ProjectIndexer::ScanFunctor::operator()(const ScanTask &task) const
+{
+    KBE_TRACE_SCOPE("index", "scanFile", task.fileName);
+
+    ScanResult res;
+    res.fileName = task.fileName;
+    res.version = task.version;
+    res.ok = true;
+
+    QByteArray data = task.content;
+    if (!task.hasContent)
+    {
+        QFile file(task.fileName);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            res.ok = false;
+            return res;
+        }
+        data = file.readAll();
+    }
+
+    res.locations = task.scanner->scan(task.fileName, data);
+    return res;
+}
+
+QString ProjectIndexer::normalizedName(const QString &fileName)
+{
+    return QDir::cleanPath(QFileInfo(fileName).absoluteFilePath());
+}
+
+IdentifierScannerInterface* ProjectIndexer::scannerFor(const QString &fileName) const
+{
+    return mScanners.value(QFileInfo(fileName).suffix(), 0);
+}
+
+bool ProjectIndexer::isIndexed(const QString &fileName) const
+{
+    return mProjectFiles.contains(fileName) || mOpenFiles.contains(fileName);
+}
+
+bool ProjectIndexer::isProjectFile(const QString &fileName) const
+{
+    return mProjectFiles.contains(fileName);
+}
+
+void ProjectIndexer::queueScan(const QString &fileName)
+{
+    ScanTask task;
+    task.fileName = fileName;
+    task.hasContent = false;
+    queueTask(task);
+}
+
+void ProjectIndexer::queueScan(const QString &fileName, const QByteArray &content)
+{
+    ScanTask task;
+    task.fileName = fileName;
+    task.hasContent = true;
+    task.content = content;
+    queueTask(task);
+}
+
+void ProjectIndexer::queueTask(ScanTask &task)
+{
+    task.scanner = scannerFor(task.fileName);
+    if (!task.scanner)
+        return;
+
+    task.version = ++mNextVersion;
+    mVersions[task.fileName] = task.version;
+
+    if (!mPending.contains(task.fileName))
+        ++mScanTotal;
+    mPending[task.fileName] = task;
+
+    mScanTimer.start();
+}
+
+void ProjectIndexer::removeFile(const QString &fileName)
+{
+    mVersions.remove(fileName);
+    if (mPending.remove(fileName) > 0)
+        --mScanTotal;
+
+    mDocuments.remove(fileName);
+    setFileLocations(fileName, IdentifierLocationList());
+}
+
+void ProjectIndexer::setFileLocations(const QString &fileName, const IdentifierLocationList &locations)
+{
+    QSet<QString> oldIdtfs = mFileIdentifiers.take(fileName);
+    foreach (const QString &idtf, oldIdtfs)
+    {
+        QHash<QString, IdentifierLocationList>::iterator it = mLocations.find(idtf);
+        Q_ASSERT(it != mLocations.end());
+
+        QMutableListIterator<IdentifierLocation> locIt(it.value());
+        while (locIt.hasNext())
+        {
+            if (locIt.next().fileName == fileName)
+                locIt.remove();
+        }
+
+        if (it.value().isEmpty())
+        {
+            mLocations.erase(it);
+            mSortedValid = false;
+        }
+    }
+
+    QSet<QString> idtfs;
+    foreach (const IdentifierLocation &loc, locations)
+    {
+        if (loc.identifier.isEmpty())
+            continue;
+
+        QHash<QString, IdentifierLocationList>::iterator it = mLocations.find(loc.identifier);
+        if (it == mLocations.end())
+        {
+            it = mLocations.insert(loc.identifier, IdentifierLocationList());
+            mSortedValid = false;
+        }
+        it.value().append(loc);
+        idtfs.insert(loc.identifier);
+    }
+
+    if (!idtfs.isEmpty())
+        mFileIdentifiers.insert(fileName, idtfs);
+}
+
+void ProjectIndexer::addProjectDir(const QString &path)
+{
+    QString dirPath = normalizedName(path);
+
+    QStringList dirs;
+    dirs << dirPath;
+    QDirIterator dirIt(dirPath, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (dirIt.hasNext())
+        dirs << normalizedName(dirIt.next());
+
+    foreach (const QString &dir, dirs)
+    {
+        if (!mProjectSubdirs.contains(dir))
+        {
+            mProjectSubdirs.insert(dir);
+            mWatcher.addPath(dir);
+        }
+    }
+
+    QStringList filters;
+    foreach (const QString &ext, mScanners.keys())
+        filters << "*." + ext;
+
+    QDirIterator fileIt(dirPath, filters, QDir::Files, QDirIterator::Subdirectories);
+    while (fileIt.hasNext())
+        addProjectFile(normalizedName(fileIt.next()));
+}
+
+void ProjectIndexer::removeProjectDir(const QString &path)
+{
+    QString prefix = path + "/";
+
+    QSet<QString> dirs = mProjectSubdirs;
+    foreach (const QString &dir, dirs)
+    {
+        if (dir == path || dir.startsWith(prefix))
+        {
+            mProjectSubdirs.remove(dir);
+            mWatcher.removePath(dir);
+        }
+    }
+
+    QSet<QString> files = mProjectFiles;
+    foreach (const QString &fileName, files)
+    {
+        if (fileName.startsWith(prefix))
+            removeProjectFile(fileName);
+    }
+}
+
+void ProjectIndexer::addProjectFile(const QString &fileName)
+{
+    if (mProjectFiles.contains(fileName))
+        return;
+
+    mProjectFiles.insert(fileName);
+    mWatcher.addPath(fileName);
+
+    if (!mDocuments.contains(fileName))
+        queueScan(fileName);
+}
+
+void ProjectIndexer::removeProjectFile(const QString &fileName)
+{
+    if (!mProjectFiles.remove(fileName))
+        return;
+
+    // opened documents stay in index until they are closed
+    if (!mOpenFiles.contains(fileName))
+    {
+        mWatcher.removePath(fileName);
+        removeFile(fileName);
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/projectindexinterface.h"
+
+#include <QObject>
+#include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QFileSystemWatcher>
+
+class QCoreApplication;
+class Project;
+
+/*! Background identifier index of project files and opened documents.
+ *
+ * Files are scanned in parallel by IdentifierScannerInterface objects of plugins.
+ * Index is updated incrementally: changed files on disk are reported by file system
+ * watcher, unsaved document content comes from editors with documentChanged. Requests
+ * for the same file are merged, only its last state is scanned.
+ *
+ * All methods must be called from main thread.
+ */
+class ProjectIndexer : public QObject,
+                       public ProjectIndexInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(ProjectIndexInterface)
+
+public:
+    typedef QMap<QString, IdentifierScannerInterface*> tScannersMap;
+
+    /*! Creates indexer and makes it available for plugins. Must be called before
+      plugins are loaded. @see ProjectIndex
+      */
+    static ProjectIndexer* install(QCoreApplication *app);
+    static ProjectIndexer* instance();
+
+    explicit ProjectIndexer(QObject *parent = 0);
+    virtual ~ProjectIndexer();
+
+    //! Sets scanners by file extensions. Files with other extensions aren't indexed.
+    void setScanners(const tScannersMap &scanners);
+
+    /*! Indexes files of @p project instead of previous project files.
+      @param project Project or null pointer to index opened documents only.
+      */
+    void setProject(const Project *project);
+
+    //! Stops scanning and forgets scanners. Must be called before plugins are unloaded.
+    void shutdown();
+
+    //! @return True, if some files are being scanned or waiting for it.
+    bool isIndexing() const;
+
+    //! @return Sorted names of project files and opened documents.
+    QStringList files() const;
+
+    //! @copydoc ProjectIndexInterface::identifiers
+    QStringList identifiers(const QString &prefix, int limit) const;
+    //! @copydoc ProjectIndexInterface::locations
+    IdentifierLocationList locations(const QString &identifier) const;
+    //! @copydoc ProjectIndexInterface::documentOpened
+    void documentOpened(const QString &fileName);
+    //! @copydoc ProjectIndexInterface::documentChanged
+    void documentChanged(const QString &fileName, const QByteArray &content);
+    //! @copydoc ProjectIndexInterface::documentClosed
+    void documentClosed(const QString &fileName);
+
+signals:
+    //! Emitted when scan results are added to index.
+    void indexChanged();
+    //! Emitted while files are scanned. Scanning is finished when @p done equals to @p total.
+    void indexingProgress(int done, int total);
+
+private slots:
+    //! Starts scanning of pending files, if there is no running scan.
+    void startScan();
+    void scanResultReady(int index);
+    void scanFinished();
+
+    void directoryChanged(const QString &path);
+    void fileChanged(const QString &path);
+
+private:
+    //! File to scan.
+    struct ScanTask
+    {
+        QString fileName;
+        //! True, if document content is scanned, else file is read by worker.
+        bool hasContent;
+        QByteArray content;
+        IdentifierScannerInterface *scanner;
+        //! File version, that is assigned to task. @see mVersions
+        int version;
+    };
+
+    struct ScanResult
+    {
+        QString fileName;
+        IdentifierLocationList locations;
+        int version;
+        //! False, if file can't be read.
+        bool ok;
+    };
+
+    //! Scans files in worker threads.
+    struct ScanFunctor
+    {
+        typedef ScanResult result_type;
+        ScanResult operator()(const ScanTask &task) const;
+    };
+
+    static QString normalizedName(const QString &fileName);
+    IdentifierScannerInterface* scannerFor(const QString &fileName) const;
+    //! @return True, if file belongs to project or opened.
+    bool isIndexed(const QString &fileName) const;
+    bool isProjectFile(const QString &fileName) const;
+
+    //! Queues scan of file on disk. Previous queued or running scans of it are discarded.
+    void queueScan(const QString &fileName);
+    //! Queues scan of document content instead of file.
+    void queueScan(const QString &fileName, const QByteArray &content);
+    void queueTask(ScanTask &task);
+    //! Removes file from index and discards its scans.
+    void removeFile(const QString &fileName);
+    //! Replaces index entries of file.
+    void setFileLocations(const QString &fileName, const IdentifierLocationList &locations);
+
+    //! Adds directory with subdirectories and all their files to project.
+    void addProjectDir(const QString &path);
+    //! Removes directory with subdirectories and all their files from project.
+    void removeProjectDir(const QString &path);
+    void addProjectFile(const QString &fileName);
+    void removeProjectFile(const QString &fileName);
+
+private:
+    static ProjectIndexer *mInstance;
+
+    tScannersMap mScanners;
+
+    //! Identifier occurrences.
+    QHash<QString, IdentifierLocationList> mLocations;
+    //! Identifiers, that are found in file.
+    QHash<QString, QSet<QString> > mFileIdentifiers;
+    //! Sorted identifiers for prefix queries, rebuilt lazily after index changes.
+    mutable QStringList mSortedIdentifiers;
+    mutable bool mSortedValid;
+
+    //! Watched directories of project, including subdirectories.
+    QSet<QString> mProjectSubdirs;
+    QSet<QString> mProjectFiles;
+    //! Files of opened documents.
+    QSet<QString> mOpenFiles;
+    //! Files, that are indexed from unsaved editor content.
+    QSet<QString> mDocuments;
+    /*! Version of every indexed file, it changes when new scan is queued. Results of
+      older scans and scans of removed files are discarded.
+      */
+    QHash<QString, int> mVersions;
+    int mNextVersion;
+
+    QFileSystemWatcher mWatcher;
+
+    //! Queued scans by file names.
+    QMap<QString, ScanTask> mPending;
+    //! Merges frequent changes of documents.
+    QTimer mScanTimer;
+    QFutureWatcher<ScanResult> mFutureWatcher;
+    //! True, while scan results are delivered.
+    bool mScanning;
+    int mScanDone;
+    int mScanTotal;
+};
@@ -6,14 +6,20 @@
 
 #include "settingsdialog.h"
 #include "pluginmanager.h"
+#include "tracerecorder.h"
+#include "config.h"
 
 #include <QTabWidget>
 #include <QDialogButtonBox>
 #include <QVBoxLayout>
+#include <QCheckBox>
+#include <QLabel>
+#include <QSettings>
 
 SettingsDialog::SettingsDialog(QWidget * parent)
     : QDialog(parent)
     , mGeneralTab(0)
+    , mTraceCheckBox(0)
 {
     setWindowTitle(tr("Settings"));
 
@@ -40,6 +46,26 @@ SettingsDialog::~SettingsDialog()
 void SettingsDialog::createGeneralTab()
 {
     mGeneralTab = new QWidget(this);
+
+    mTraceCheckBox = new QCheckBox(tr("Write performance trace"), mGeneralTab);
+    mTraceCheckBox->setChecked(QSettings().value(Config::settingsTraceEnabled, false).toBool());
+    connect(mTraceCheckBox, SIGNAL(toggled(bool)), this, SLOT(traceToggled(bool)));
+
+    QLabel *traceLabel = new QLabel(tr("Trace is written to %1 on exit, it can be opened in "
+                                       "chrome://tracing or Perfetto. Takes effect after restart.")
+                                    .arg(TraceRecorder::defaultFileName()), mGeneralTab);
+    traceLabel->setWordWrap(true);
+
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->addWidget(mTraceCheckBox);
+    layout->addWidget(traceLabel);
+    layout->addStretch();
+    mGeneralTab->setLayout(layout);
+}
+
+void SettingsDialog::traceToggled(bool enabled)
+{
+    QSettings().setValue(Config::settingsTraceEnabled, enabled);
 }
 
 void SettingsDialog::initialize()
@@ -10,6 +10,7 @@
 
 class QTabWidget;
 class QDialogButtonBox;
+class QCheckBox;
 
 class SettingsDialog : public QDialog
 {
@@ -24,6 +25,10 @@ private:
     /// Create general tab widget
     void createGeneralTab();
 
+private slots:
+    /// Saves trace setting, it's applied after restart
+    void traceToggled(bool enabled);
+
 private:
     /// Pointer to dialog box with buttons ok, cancel
     QDialogButtonBox * mButtonBox;
@@ -31,6 +36,8 @@ private:
     QTabWidget * mTabWidget;
     /// Pointer to tab widget with general configuration
     QWidget * mGeneralTab;
+    /// Pointer to check box, that enables performance trace
+    QCheckBox * mTraceCheckBox;
 };
 
 
@@ -0,0 +1,93 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/tracesinkinterface.h"
+
+#include <QCoreApplication>
+#include <QVariant>
+
+//! Property of application, that holds trace sink object, if tracing is enabled.
+#define KBE_TRACE_SINK_PROPERTY "kbeTraceSink"
+
+/*! Access to trace sink. It's header only, so plugins and tools use it without
+ * linking to application: sink is taken from application property once.
+ */
+class Trace
+{
+public:
+    //! @return Trace sink or null pointer, if tracing is disabled.
+    static TraceSinkInterface* sink()
+    {
+        static TraceSinkInterface *sink = findSink();
+        return sink;
+    }
+
+    //! @return True, if tracing is enabled.
+    static bool isEnabled()
+    {
+        return sink() != 0;
+    }
+
+private:
+    static TraceSinkInterface* findSink()
+    {
+        QCoreApplication *app = QCoreApplication::instance();
+        if (!app)
+            return 0;
+        return qobject_cast<TraceSinkInterface*>(app->property(KBE_TRACE_SINK_PROPERTY).value<QObject*>());
+    }
+};
+
+/*! Adds trace event, that lasts for lifetime of scope object. When tracing is
+ * disabled it costs one pointer check.
+ * @see KBE_TRACE_SCOPE
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name)
+        : mSink(Trace::sink())
+        , mCategory(category)
+        , mName(name)
+        , mStart(mSink ? mSink->now() : 0)
+    {
+    }
+
+    TraceScope(const char *category, const char *name, const QString &detail)
+        : mSink(Trace::sink())
+        , mCategory(category)
+        , mName(name)
+        , mStart(mSink ? mSink->now() : 0)
+    {
+        if (mSink)
+            mDetail = detail;
+    }
+
+    ~TraceScope()
+    {
+        if (mSink)
+            mSink->addEvent(mCategory, mName, mStart, mSink->now() - mStart, mDetail);
+    }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+
+    TraceSinkInterface *mSink;
+    const char *mCategory;
+    const char *mName;
+    qint64 mStart;
+    QString mDetail;
+};
+
+#define KBE_TRACE_CONCAT_IMPL(a, b) a##b
+#define KBE_TRACE_CONCAT(a, b) KBE_TRACE_CONCAT_IMPL(a, b)
+
+/*! Traces rest of current scope. Arguments are category, name (string literals)
+ * and optional detail string.
+ */
+#define KBE_TRACE_SCOPE(...) TraceScope KBE_TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,135 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "tracerecorder.h"
+#include "trace.h"
+#include "config.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QSettings>
+#include <QSaveFile>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+TraceRecorder* TraceRecorder::install(QCoreApplication *app)
+{
+    Q_ASSERT(app);
+
+    QString fileName = QString::fromLocal8Bit(qgetenv("KBE_TRACE"));
+    if (fileName.isEmpty() && QSettings().value(Config::settingsTraceEnabled, false).toBool())
+        fileName = defaultFileName();
+    if (fileName.isEmpty())
+        return 0;
+
+    TraceRecorder *recorder = new TraceRecorder(fileName, app);
+    app->setProperty(KBE_TRACE_SINK_PROPERTY, QVariant::fromValue<QObject*>(recorder));
+    return recorder;
+}
+
+QString TraceRecorder::defaultFileName()
+{
+    return QDir::temp().absoluteFilePath("kbe-trace.json");
+}
+
+TraceRecorder::TraceRecorder(const QString &fileName, QObject *parent)
+    : QObject(parent)
+    , mFileName(fileName)
+{
+    mTimer.start();
+    // recorder is created in main thread
+    mThreads.insert(QThread::currentThreadId(), 0);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+}
+
+qint64 TraceRecorder::now() const
+{
+    return mTimer.nsecsElapsed() / 1000;
+}
+
+void TraceRecorder::addEvent(const char *category, const char *name, qint64 start, qint64 duration,
+                             const QString &detail)
+{
+    QMutexLocker locker(&mMutex);
+
+    Event event;
+    event.category = category;
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+    event.thread = currentThread();
+    event.detail = detail;
+    mEvents.append(event);
+}
+
+int TraceRecorder::currentThread()
+{
+    Qt::HANDLE handle = QThread::currentThreadId();
+    QHash<Qt::HANDLE, int>::const_iterator it = mThreads.find(handle);
+    if (it != mThreads.end())
+        return it.value();
+
+    int res = mThreads.size();
+    mThreads.insert(handle, res);
+    return res;
+}
+
+bool TraceRecorder::save()
+{
+    QMutexLocker locker(&mMutex);
+
+    qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+
+    // thread names, so worker threads are shown under main one
+    for (int thread = 0; thread < mThreads.size(); ++thread)
+    {
+        QJsonObject args;
+        args["name"] = thread == 0 ? QString("main") : QString("worker %1").arg(thread);
+
+        QJsonObject meta;
+        meta["ph"] = QString("M");
+        meta["name"] = QString("thread_name");
+        meta["pid"] = pid;
+        meta["tid"] = thread;
+        meta["args"] = args;
+        events.append(meta);
+    }
+
+    foreach (const Event &event, mEvents)
+    {
+        QJsonObject obj;
+        obj["ph"] = QString("X");
+        obj["cat"] = QString::fromLatin1(event.category);
+        obj["name"] = QString::fromLatin1(event.name);
+        obj["ts"] = event.start;
+        obj["dur"] = event.duration;
+        obj["pid"] = pid;
+        obj["tid"] = event.thread;
+        if (!event.detail.isEmpty())
+        {
+            QJsonObject args;
+            args["detail"] = event.detail;
+            obj["args"] = args;
+        }
+        events.append(obj);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = QString("ms");
+
+    QSaveFile file(mFileName);
+    if (!file.open(QFile::WriteOnly))
+        return false;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
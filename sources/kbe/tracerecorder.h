@@ -0,0 +1,73 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/tracesinkinterface.h"
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+
+/*! Collects trace events in memory and writes them in Chrome trace event format,
+ * that can be opened in chrome://tracing or Perfetto UI.
+ *
+ * Tracing is enabled with KBE_TRACE environment variable, that holds name of trace file,
+ * or with Config::settingsTraceEnabled setting, then trace is written to defaultFileName().
+ */
+class TraceRecorder : public QObject,
+                      public TraceSinkInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(TraceSinkInterface)
+
+public:
+    /*! Creates recorder, if tracing is enabled, and makes it available for plugins.
+      Must be called before plugins are loaded.
+      @return Created recorder or null pointer, if tracing is disabled.
+      */
+    static TraceRecorder* install(QCoreApplication *app);
+
+    //! @return Name of trace file, that is used when tracing is enabled in settings.
+    static QString defaultFileName();
+
+    explicit TraceRecorder(const QString &fileName, QObject *parent = 0);
+    virtual ~TraceRecorder();
+
+    //! @copydoc TraceSinkInterface::now
+    qint64 now() const;
+    //! @copydoc TraceSinkInterface::addEvent
+    void addEvent(const char *category, const char *name, qint64 start, qint64 duration,
+                  const QString &detail);
+
+    /*! Writes all collected events to trace file.
+      @return If file written, then return true, else - false.
+      */
+    bool save();
+
+private:
+    struct Event
+    {
+        const char *category;
+        const char *name;
+        qint64 start;
+        qint64 duration;
+        int thread;
+        QString detail;
+    };
+
+    //! @return Small number of current thread, main thread is 0. Must be called under mMutex.
+    int currentThread();
+
+    QString mFileName;
+    QElapsedTimer mTimer;
+
+    QMutex mMutex;
+    QVector<Event> mEvents;
+    QHash<Qt::HANDLE, int> mThreads;
+};
@@ -13,6 +13,9 @@
 #include "scgcontour.h"
 #include "scgbus.h"
 
+#include "commands/scgcommandapplypositions.h"
+#include "trace.h"
+
 #include <QDialogButtonBox>
 #include <QApplication>
 #include <QMessageBox>
@@ -23,7 +26,9 @@
 
 SCgArranger::SCgArranger(QObject *parent) :
     QObject(parent),
-    mView(0)
+    mView(0),
+    mParentCommand(0),
+    mPositionsCommand(0)
 {
 }
 
@@ -39,35 +44,50 @@ void SCgArranger::arrange(SCgView* view)
 
     mParentCommand = new SCgBaseCommand(0, 0, 0);
     mParentCommand->setText(name());
+    mPositionsCommand = 0;
 
     mView = view;
     mScene = static_cast<SCgScene*>(mView->scene());
+    mScene->materializeSelection();
     if(configDialog())
     {
+        // time of dialog isn't traced
+        KBE_TRACE_SCOPE("scg", "arrange", name());
         startOperation();
         mScene->addCommandToStack(mParentCommand);
     }
+    else
+        delete mParentCommand;
+
+    mParentCommand = 0;
+    mPositionsCommand = 0;
+}
+
+SCgCommandApplyPositions* SCgArranger::positionsCommand()
+{
+    // all positions and points changes go into one command, so
+    // connected objects are rebuilt once per undo/redo, not once per change
+    if(!mPositionsCommand)
+        mPositionsCommand = mScene->applyPositionsCommand(mParentCommand);
+
+    return mPositionsCommand;
 }
 
 void SCgArranger::registerCommand(SCgObject* obj, const QPointF& newPos)
 {
-    if(!mParentCommand)
-        mParentCommand = mScene->changeObjectPositionCommand(obj, newPos, 0, false);
-    else
-        mScene->changeObjectPositionCommand(obj, newPos, mParentCommand, false);
+    positionsCommand()->addPosition(obj, newPos);
 }
 
 void SCgArranger::registerCommand(SCgPointObject* obj, const QVector<QPointF>& newPoints)
 {
-
-    if(!mParentCommand)
-        mParentCommand = mScene->changeObjectPointsCommand(obj, newPoints, 0, false);
-    else
-        mScene->changeObjectPointsCommand(obj, newPoints, mParentCommand, false);
+    positionsCommand()->addPoints(obj, newPoints);
 }
 
 void SCgArranger::registerCommandRemoveBreakPoints(SCgPair *pair)
 {
+    // next position changes must be applied after this command
+    mPositionsCommand = 0;
+
     if (!mParentCommand) {
         mParentCommand = mScene->removeBreakPointsCommand(pair, 0, false);
     } else {
@@ -77,6 +97,9 @@ void SCgArranger::registerCommandRemoveBreakPoints(SCgPair *pair)
 
 void SCgArranger::registerCommandMinimizeContour(SCgContour *contour)
 {
+    // next position changes must be applied after this command
+    mPositionsCommand = 0;
+
     if (!mParentCommand) {
         mParentCommand = mScene->minimizeContourCommand(contour, 0, false);
     } else {
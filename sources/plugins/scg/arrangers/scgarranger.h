@@ -16,6 +16,7 @@ class SCgView;
 class SCgObject;
 class QGraphicsItem;
 class SCgBaseCommand;
+class SCgCommandApplyPositions;
 
 /*! To create new arranger you should implement 4 functions:
  *   bool configDialog();
@@ -81,8 +82,13 @@ protected:
 
 private:
     SCgScene* mScene;
+    //! @return command for positions and points changes. It will be created, if needed.
+    SCgCommandApplyPositions* positionsCommand();
+
     //! Parent command for all changes on scene;
     SCgBaseCommand* mParentCommand;
+    //! Command that accumulates positions and points changes (it's a child of mParentCommand)
+    SCgCommandApplyPositions* mPositionsCommand;
     /*! Creates ghost for specified object (@p obj).
     * Note: the isDead flag will be set.
     * @p opacityLevel - opacity value for top level items.
@@ -0,0 +1,504 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgarrangerenergybased.h"
+
+#include "scgview.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+
+#include <QDialogButtonBox>
+#include <QVBoxLayout>
+#include <QFormLayout>
+#include <QProgressBar>
+#include <QMessageBox>
+#include <QApplication>
+#include <QSpinBox>
+#include <QTimer>
+#include <QtConcurrentRun>
+
+//! Number of iterations between updates of ghosts positions
+#define SCG_ENERGY_PREVIEW_ITERATIONS 5
+//! Interval of ghosts update (milliseconds)
+#define SCG_ENERGY_PREVIEW_INTERVAL 40
+
+SCgEnergyBasedArranger::SCgEnergyBasedArranger(QObject *parent) :
+    SCgArranger(parent),
+    mDialog(0),
+    mSpringLengthSpinBox(0),
+    mRepulsionSpinBox(0),
+    mIterationsSpinBox(0),
+    mProgressBar(0),
+    mPreviewTimer(0),
+    mStopRequested(0),
+    mCalculatedIteration(0)
+{
+    mPreviewTimer = new QTimer(this);
+    mPreviewTimer->setInterval(SCG_ENERGY_PREVIEW_INTERVAL);
+    connect(mPreviewTimer, SIGNAL(timeout()), this, SLOT(updateGhosts()));
+}
+
+SCgEnergyBasedArranger::~SCgEnergyBasedArranger()
+{
+    stopCalculation();
+    delete mDialog;
+}
+
+bool SCgEnergyBasedArranger::configDialog()
+{
+    if (!collectItems())
+    {
+        QMessageBox::information(0, qAppName(), tr("Nothing to arrange. There should be at least two nodes."));
+        clearItems();
+        return false;
+    }
+
+    if (!mDialog)
+        createDialog();
+    mDialog->setParent(mView->viewport(), Qt::Dialog);
+
+    QList<QGraphicsItem*> items;
+    foreach (SCgNode *node, mNodes)
+        items.append(node);
+    foreach (SCgPair *pair, mPairs)
+        items.append(pair);
+    foreach (SCgBus *bus, mBuses)
+        items.append(bus);
+    foreach (SCgContour *contour, mContours)
+        items.append(contour);
+    createGhosts(items);
+
+    startCalculation();
+
+    bool res = mDialog->exec() == QDialog::Accepted;
+
+    stopCalculation();
+    mPreviewTimer->stop();
+    deleteGhosts();
+
+    mDialog->setParent(0, Qt::Dialog);
+
+    if (!res)
+        clearItems();
+
+    return res;
+}
+
+void SCgEnergyBasedArranger::startOperation()
+{
+    QVector<QPointF> positions = calculatedPositions();
+
+    for (int i = 0; i < mNodes.size(); ++i)
+    {
+        SCgNode *node = mNodes[i];
+        QGraphicsItem *parent = node->parentItem();
+        registerCommand(node, parent ? parent->mapFromScene(positions[i]) : positions[i]);
+    }
+
+    foreach (SCgBus *bus, mBuses)
+    {
+        QPointF delta = positions[bodyIndex(bus->owner())] - mInitialPositions[bodyIndex(bus->owner())];
+        QVector<QPointF> points = bus->scenePoints();
+        for (int i = 0; i < points.size(); ++i)
+            points[i] += delta;
+        registerCommand(bus, points);
+    }
+
+    for (int i = 0; i < mPairs.size(); ++i)
+    {
+        SCgPair *pair = mPairs[i];
+        const SCgForceCalculator::Spring &spring = mSprings[i];
+        QVector<QPointF> points = pair->scenePoints();
+        QVector<QPointF> straight;
+        straight << points.first() + positions[spring.first] - mInitialPositions[spring.first]
+                 << points.last() + positions[spring.second] - mInitialPositions[spring.second];
+        registerCommand(pair, straight);
+    }
+
+    QMap<SCgContour*, QVector<QPointF> > contours = calculateContours(positions);
+    QMap<SCgContour*, QVector<QPointF> >::const_iterator it;
+    for (it = contours.constBegin(); it != contours.constEnd(); ++it)
+        registerCommand(it.key(), it.value());
+
+    clearItems();
+}
+
+QString SCgEnergyBasedArranger::name() const
+{
+    return tr("Energy-based arrange");
+}
+
+void SCgEnergyBasedArranger::createDialog()
+{
+    mDialog = new QDialog();
+    mDialog->setWindowTitle(tr("Energy-based Arranger Parameters"));
+
+    QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok
+                                     | QDialogButtonBox::Cancel);
+    buttonBox->setParent(mDialog);
+
+    mSpringLengthSpinBox = new QSpinBox(mDialog);
+    mSpringLengthSpinBox->setToolTip(tr("Natural spring length"));
+    mSpringLengthSpinBox->setMinimum(20);
+    mSpringLengthSpinBox->setMaximum(500);
+    mSpringLengthSpinBox->setValue((int)mParameters.springLength);
+
+    mRepulsionSpinBox = new QSpinBox(mDialog);
+    mRepulsionSpinBox->setToolTip(tr("Repulsive force factor between nodes"));
+    mRepulsionSpinBox->setSuffix("%");
+    mRepulsionSpinBox->setMinimum(10);
+    mRepulsionSpinBox->setMaximum(500);
+    mRepulsionSpinBox->setValue(qRound(mParameters.repulsion * 100));
+
+    mIterationsSpinBox = new QSpinBox(mDialog);
+    mIterationsSpinBox->setToolTip(tr("Number of layout iterations"));
+    mIterationsSpinBox->setMinimum(10);
+    mIterationsSpinBox->setMaximum(5000);
+    mIterationsSpinBox->setValue(mParameters.iterations);
+
+    mProgressBar = new QProgressBar(mDialog);
+
+    QFormLayout *fl = new QFormLayout();
+    fl->addRow(tr("Spring length:"), mSpringLengthSpinBox);
+    fl->addRow(tr("Node repulsion factor:"), mRepulsionSpinBox);
+    fl->addRow(tr("Iterations:"), mIterationsSpinBox);
+
+    QVBoxLayout *vl = new QVBoxLayout();
+    vl->addLayout(fl);
+    vl->addWidget(mProgressBar);
+    vl->addWidget(buttonBox);
+
+    connect(mSpringLengthSpinBox, SIGNAL(valueChanged(int)), this, SLOT(springLengthChanged(int)));
+    connect(mRepulsionSpinBox, SIGNAL(valueChanged(int)), this, SLOT(repulsionChanged(int)));
+    connect(mIterationsSpinBox, SIGNAL(valueChanged(int)), this, SLOT(iterationsChanged(int)));
+    connect(buttonBox, SIGNAL(accepted()), mDialog, SLOT(accept()));
+    connect(buttonBox, SIGNAL(rejected()), mDialog, SLOT(reject()));
+
+    mDialog->setLayout(vl);
+}
+
+void SCgEnergyBasedArranger::springLengthChanged(int value)
+{
+    mParameters.springLength = value;
+    startCalculation();
+}
+
+void SCgEnergyBasedArranger::repulsionChanged(int value)
+{
+    mParameters.repulsion = value / 100.0;
+    startCalculation();
+}
+
+void SCgEnergyBasedArranger::iterationsChanged(int value)
+{
+    mParameters.iterations = value;
+    startCalculation();
+}
+
+void SCgEnergyBasedArranger::updateGhosts()
+{
+    QVector<QPointF> positions;
+    int iteration;
+    {
+        QMutexLocker locker(&mMutex);
+        positions = mCalculated;
+        iteration = mCalculatedIteration;
+    }
+
+    if (positions.size() != mNodes.size())
+        return;
+
+    for (int i = 0; i < mNodes.size(); ++i)
+    {
+        SCgObject *ghost = mGhosts.value(mNodes[i]);
+        if (!ghost)
+            continue;
+
+        QGraphicsItem *parent = ghost->parentItem();
+        ghost->setPos(parent ? parent->mapFromScene(positions[i]) : positions[i]);
+    }
+
+    foreach (SCgBus *bus, mBuses)
+    {
+        SCgPointObject *ghost = static_cast<SCgPointObject*>(mGhosts.value(bus));
+        if (!ghost)
+            continue;
+
+        int index = bodyIndex(bus->owner());
+        QVector<QPointF> points = bus->scenePoints();
+        for (int i = 0; i < points.size(); ++i)
+            points[i] += positions[index] - mInitialPositions[index];
+        ghost->setPoints(points);
+    }
+
+    for (int i = 0; i < mPairs.size(); ++i)
+    {
+        SCgPointObject *ghost = static_cast<SCgPointObject*>(mGhosts.value(mPairs[i]));
+        if (!ghost)
+            continue;
+
+        const SCgForceCalculator::Spring &spring = mSprings[i];
+        QVector<QPointF> points = mPairs[i]->scenePoints();
+        QVector<QPointF> straight;
+        straight << points.first() + positions[spring.first] - mInitialPositions[spring.first]
+                 << points.last() + positions[spring.second] - mInitialPositions[spring.second];
+        ghost->setPoints(straight);
+    }
+
+    QMap<SCgContour*, QVector<QPointF> > contours = calculateContours(positions);
+    QMap<SCgContour*, QVector<QPointF> >::const_iterator it;
+    for (it = contours.constBegin(); it != contours.constEnd(); ++it)
+    {
+        SCgPointObject *ghost = static_cast<SCgPointObject*>(mGhosts.value(it.key()));
+        if (ghost)
+            ghost->setPoints(it.value());
+    }
+
+    mProgressBar->setValue(iteration);
+
+    if (mFuture.isFinished() && iteration == mCalculatedIteration)
+        mPreviewTimer->stop();
+}
+
+bool SCgEnergyBasedArranger::collectItems()
+{
+    clearItems();
+
+    QList<QGraphicsItem*> items = mView->scene()->selectedItems();
+    if (items.isEmpty())
+        items = mView->scene()->items();
+
+    foreach (QGraphicsItem *item, items)
+    {
+        if (!SCgObject::isSCgObjectType(item->type()))
+            continue;
+
+        SCgObject *obj = static_cast<SCgObject*>(item);
+        if (!obj->isDead())
+            collectObject(obj);
+    }
+
+    if (mNodes.size() < 2)
+        return false;
+
+    // contours, that contain arranged nodes, will be rebuilt around them
+    QHash<SCgContour*, int> contourDepth;
+    foreach (SCgNode *node, mNodes)
+    {
+        QGraphicsItem *parent = node->parentItem();
+        while (parent && parent->type() == SCgContour::Type)
+        {
+            SCgContour *contour = static_cast<SCgContour*>(parent);
+            if (!contourDepth.contains(contour))
+            {
+                int depth = 0;
+                for (QGraphicsItem *p = contour->parentItem(); p; p = p->parentItem())
+                    ++depth;
+                contourDepth.insert(contour, depth);
+            }
+            parent = parent->parentItem();
+        }
+    }
+
+    // sort contours, so outer ones go first
+    QMultiMap<int, SCgContour*> contoursByDepth;
+    QHash<SCgContour*, int>::const_iterator cit;
+    for (cit = contourDepth.constBegin(); cit != contourDepth.constEnd(); ++cit)
+        contoursByDepth.insert(cit.value(), cit.key());
+    mContours = contoursByDepth.values();
+
+    // group of node is its innermost contour
+    mGroups.fill(-1, mNodes.size());
+    for (int i = 0; i < mNodes.size(); ++i)
+    {
+        QGraphicsItem *parent = mNodes[i]->parentItem();
+        if (parent && parent->type() == SCgContour::Type)
+            mGroups[i] = mContours.indexOf(static_cast<SCgContour*>(parent));
+    }
+
+    // pairs are springs, buses follow their owners
+    foreach (QGraphicsItem *item, mView->scene()->items())
+    {
+        if (item->type() != SCgPair::Type && item->type() != SCgBus::Type)
+            continue;
+
+        SCgObject *obj = static_cast<SCgObject*>(item);
+        if (obj->isDead())
+            continue;
+
+        if (item->type() == SCgBus::Type)
+        {
+            SCgBus *bus = static_cast<SCgBus*>(item);
+            if (bodyIndex(bus->owner()) >= 0)
+                mBuses.append(bus);
+            continue;
+        }
+
+        SCgPair *pair = static_cast<SCgPair*>(item);
+        int begin = bodyIndex(pair->beginObject());
+        int end = bodyIndex(pair->endObject());
+        if (begin >= 0 && end >= 0 && begin != end)
+        {
+            mPairs.append(pair);
+            mSprings.append(qMakePair(begin, end));
+        }
+    }
+
+    mInitialPositions.resize(mNodes.size());
+    for (int i = 0; i < mNodes.size(); ++i)
+        mInitialPositions[i] = mNodes[i]->scenePos();
+
+    return true;
+}
+
+void SCgEnergyBasedArranger::collectObject(SCgObject *obj)
+{
+    switch (obj->type())
+    {
+    case SCgNode::Type:
+        if (!mBodyIndex.contains(obj))
+        {
+            mBodyIndex.insert(obj, mNodes.size());
+            mNodes.append(static_cast<SCgNode*>(obj));
+        }
+        break;
+
+    case SCgBus::Type:
+        if (static_cast<SCgBus*>(obj)->owner())
+            collectObject(static_cast<SCgBus*>(obj)->owner());
+        break;
+
+    case SCgContour::Type:
+        foreach (QGraphicsItem *item, obj->childItems())
+        {
+            if (SCgObject::isSCgObjectType(item->type()) && !static_cast<SCgObject*>(item)->isDead())
+                collectObject(static_cast<SCgObject*>(item));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void SCgEnergyBasedArranger::clearItems()
+{
+    mNodes.clear();
+    mBodyIndex.clear();
+    mPairs.clear();
+    mBuses.clear();
+    mContours.clear();
+    mSprings.clear();
+    mGroups.clear();
+    mInitialPositions.clear();
+}
+
+int SCgEnergyBasedArranger::bodyIndex(SCgObject *obj) const
+{
+    if (!obj)
+        return -1;
+
+    // pairs from bus are connected to its owner
+    if (obj->type() == SCgBus::Type)
+        obj = static_cast<SCgBus*>(obj)->owner();
+
+    return mBodyIndex.value(obj, -1);
+}
+
+void SCgEnergyBasedArranger::startCalculation()
+{
+    if (mNodes.isEmpty())
+        return;
+
+    stopCalculation();
+
+    SCgForceCalculator calculator(mInitialPositions, mSprings, mGroups);
+    calculator.setParameters(mParameters);
+
+    {
+        QMutexLocker locker(&mMutex);
+        mCalculated = mInitialPositions;
+        mCalculatedIteration = 0;
+    }
+
+    mProgressBar->setMaximum(mParameters.iterations);
+    mProgressBar->setValue(0);
+
+    mStopRequested.storeRelease(0);
+    mFuture = QtConcurrent::run(this, &SCgEnergyBasedArranger::calculate, calculator);
+    mPreviewTimer->start();
+}
+
+void SCgEnergyBasedArranger::stopCalculation()
+{
+    mStopRequested.storeRelease(1);
+    mFuture.waitForFinished();
+}
+
+void SCgEnergyBasedArranger::calculate(SCgForceCalculator calculator)
+{
+    while (!calculator.isFinished() && !mStopRequested.loadAcquire())
+    {
+        calculator.step();
+
+        if (calculator.iteration() % SCG_ENERGY_PREVIEW_ITERATIONS == 0 || calculator.isFinished())
+        {
+            QMutexLocker locker(&mMutex);
+            mCalculated = calculator.positions();
+            mCalculatedIteration = calculator.iteration();
+        }
+    }
+}
+
+QMap<SCgContour*, QVector<QPointF> > SCgEnergyBasedArranger::calculateContours(const QVector<QPointF> &positions) const
+{
+    QMap<SCgContour*, QVector<QPointF> > result;
+    QHash<SCgContour*, QRectF> bounds;
+
+    // inner contours go last, so calculate them first
+    for (int c = mContours.size() - 1; c >= 0; --c)
+    {
+        SCgContour *contour = mContours[c];
+        QRectF rect;
+
+        foreach (QGraphicsItem *item, contour->childItems())
+        {
+            if (!SCgObject::isSCgObjectType(item->type()) || static_cast<SCgObject*>(item)->isDead())
+                continue;
+
+            SCgObject *obj = static_cast<SCgObject*>(item);
+            int index = mBodyIndex.value(obj, -1);
+
+            if (index >= 0)
+                rect |= obj->boundingRect().translated(positions[index]);
+            else if (obj->type() == SCgContour::Type && bounds.contains(static_cast<SCgContour*>(obj)))
+                rect |= bounds.value(static_cast<SCgContour*>(obj));
+            else if (obj->type() != SCgPair::Type && obj->type() != SCgBus::Type)
+                rect |= obj->sceneBoundingRect(); // isn't arranged, so it stays at its place
+        }
+
+        if (rect.isNull())
+            continue;
+
+        qreal border = SCgContour::borderDistance();
+        rect.adjust(-border, -border, border, border);
+        bounds.insert(contour, rect);
+
+        QVector<QPointF> points;
+        points << rect.topLeft() << rect.topRight() << rect.bottomRight() << rect.bottomLeft();
+        result.insert(contour, points);
+    }
+
+    return result;
+}
+
+QVector<QPointF> SCgEnergyBasedArranger::calculatedPositions() const
+{
+    QMutexLocker locker(&mMutex);
+    return mCalculated;
+}
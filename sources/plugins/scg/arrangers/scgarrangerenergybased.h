@@ -0,0 +1,144 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "scgarranger.h"
+#include "scgforcecalculator.h"
+
+#include <QFuture>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QHash>
+
+class SCgNode;
+class SCgPair;
+class SCgBus;
+class SCgContour;
+class QSpinBox;
+class QProgressBar;
+class QTimer;
+
+/*! Force-directed (energy-based) arranger.
+ *  Nodes are bodies, pairs are springs and contours keep their content together.
+ *  Layout is calculated by SCgForceCalculator on a worker thread, while
+ *  ghosts show intermediate result. When user accepts result, all changes are
+ *  applied as one undoable command.
+ *  If there are selected objects, then only they are arranged (selected contours
+ *  are arranged with all their content); otherwise all objects on scene are arranged.
+ */
+class SCgEnergyBasedArranger : public SCgArranger
+{
+Q_OBJECT
+
+public:
+    enum
+    {
+        Type = 5
+    };
+
+    explicit SCgEnergyBasedArranger(QObject *parent = 0);
+    virtual ~SCgEnergyBasedArranger();
+
+    //! @see SCgArranger::type
+    int type() const { return Type; }
+
+protected:
+    //! @see SCgArranger::configDialog
+    bool configDialog();
+
+    //! @see SCgArranger::startOperation
+    void startOperation();
+
+    //! @see SCgArranger::name
+    QString name() const;
+
+    //! Creates dialog for asking layout parameters.
+    void createDialog();
+
+protected slots:
+    /*! @defgroup Slots Slots to react on user actions
+     *  @{
+     */
+    void springLengthChanged(int value);
+    void repulsionChanged(int value);
+    void iterationsChanged(int value);
+    /*! @}*/
+
+    //! Moves ghosts to the last calculated positions and updates progress
+    void updateGhosts();
+
+private:
+    //! Collects nodes, springs and contours, that will be arranged
+    bool collectItems();
+
+    //! Collects object @p obj (and all its content for contours) into arranged items
+    void collectObject(SCgObject *obj);
+
+    //! Clears all collected items
+    void clearItems();
+
+    //! @return index of body, that corresponds to object @p obj; -1 if there are no such body
+    int bodyIndex(SCgObject *obj) const;
+
+    //! Starts layout calculation on worker thread with current parameters
+    void startCalculation();
+
+    //! Stops layout calculation and waits until worker thread is finished
+    void stopCalculation();
+
+    //! Layout calculation, that runs on worker thread
+    void calculate(SCgForceCalculator calculator);
+
+    /*! Calculates contours bounds for nodes positions @p positions.
+     * @return Map of contours to their new scene points.
+     */
+    QMap<SCgContour*, QVector<QPointF> > calculateContours(const QVector<QPointF> &positions) const;
+
+    //! @return calculated positions in scene coordinates
+    QVector<QPointF> calculatedPositions() const;
+
+    //! Dialog to configure layout parameters
+    QDialog *mDialog;
+    QSpinBox *mSpringLengthSpinBox;
+    QSpinBox *mRepulsionSpinBox;
+    QSpinBox *mIterationsSpinBox;
+    QProgressBar *mProgressBar;
+
+    //! Timer to update ghosts while layout is calculated
+    QTimer *mPreviewTimer;
+
+    //! Layout parameters
+    SCgForceCalculator::Parameters mParameters;
+
+    //! Arranged nodes (bodies). Index of node is the index of body in calculator.
+    QList<SCgNode*> mNodes;
+    //! Map of objects to body indexes
+    QHash<SCgObject*, int> mBodyIndex;
+    //! Pairs between bodies, they are straightened by arranger. Each pair has a spring with the same index.
+    QList<SCgPair*> mPairs;
+    //! Buses, whose owners are arranged
+    QList<SCgBus*> mBuses;
+    //! Arranged contours, inner contours go after outer ones
+    QList<SCgContour*> mContours;
+    //! Springs between bodies
+    QVector<SCgForceCalculator::Spring> mSprings;
+    //! Group (index in mContours) of each body
+    QVector<int> mGroups;
+    //! Initial positions of bodies in scene coordinates
+    QVector<QPointF> mInitialPositions;
+
+    //! Result of worker thread
+    QFuture<void> mFuture;
+    //! Flag to stop worker thread
+    QAtomicInt mStopRequested;
+    //! Guards mCalculated and mCalculatedIteration
+    mutable QMutex mMutex;
+    //! Last positions, that were calculated by worker thread
+    QVector<QPointF> mCalculated;
+    //! Number of iterations done for mCalculated
+    int mCalculatedIteration;
+};
@@ -0,0 +1,505 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgarrangerhierarchical.h"
+
+#include "scgview.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+
+#include <QDialogButtonBox>
+#include <QVBoxLayout>
+#include <QFormLayout>
+#include <QMessageBox>
+#include <QApplication>
+#include <QSpinBox>
+
+SCgHierarchicalArranger::SCgHierarchicalArranger(QObject *parent) :
+    SCgArranger(parent),
+    mDialog(0),
+    mLayerSpacingSpinBox(0),
+    mVertexSpacingSpinBox(0)
+{
+}
+
+SCgHierarchicalArranger::~SCgHierarchicalArranger()
+{
+    delete mDialog;
+}
+
+bool SCgHierarchicalArranger::configDialog()
+{
+    if (!collectItems())
+    {
+        QMessageBox::information(0, qAppName(), tr("Nothing to arrange. There are no nodes to arrange."));
+        clearItems();
+        return false;
+    }
+
+    if (!mDialog)
+        createDialog();
+    mDialog->setParent(mView->viewport(), Qt::Dialog);
+
+    QList<QGraphicsItem*> items;
+    foreach (SCgObject *obj, mArrangedList)
+        items.append(obj);
+    foreach (SCgPair *pair, mPairs)
+        items.append(pair);
+    foreach (SCgBus *bus, mBuses)
+        items.append(bus);
+    createGhosts(items);
+
+    calculate();
+    updateGhosts();
+
+    bool res = mDialog->exec() == QDialog::Accepted;
+
+    deleteGhosts();
+    mDialog->setParent(0, Qt::Dialog);
+
+    if (!res)
+        clearItems();
+
+    return res;
+}
+
+void SCgHierarchicalArranger::startOperation()
+{
+    QHash<SCgNode*, QPointF>::const_iterator nodeIt;
+    for (nodeIt = mNodePositions.constBegin(); nodeIt != mNodePositions.constEnd(); ++nodeIt)
+    {
+        QGraphicsItem *parent = nodeIt.key()->parentItem();
+        registerCommand(nodeIt.key(), parent ? parent->mapFromScene(nodeIt.value()) : nodeIt.value());
+    }
+
+    QHash<SCgContour*, QVector<QPointF> >::const_iterator contourIt;
+    for (contourIt = mContourPoints.constBegin(); contourIt != mContourPoints.constEnd(); ++contourIt)
+        registerCommand(contourIt.key(), contourIt.value());
+
+    QHash<SCgBus*, QVector<QPointF> >::const_iterator busIt;
+    for (busIt = mBusPoints.constBegin(); busIt != mBusPoints.constEnd(); ++busIt)
+        registerCommand(busIt.key(), busIt.value());
+
+    QHash<SCgPair*, QVector<QPointF> >::const_iterator pairIt;
+    for (pairIt = mPairPoints.constBegin(); pairIt != mPairPoints.constEnd(); ++pairIt)
+        registerCommand(pairIt.key(), pairIt.value());
+
+    clearItems();
+}
+
+QString SCgHierarchicalArranger::name() const
+{
+    return tr("Hierarchical arrange");
+}
+
+void SCgHierarchicalArranger::createDialog()
+{
+    mDialog = new QDialog();
+    mDialog->setWindowTitle(tr("Hierarchical Arranger Parameters"));
+
+    QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok
+                                     | QDialogButtonBox::Cancel);
+    buttonBox->setParent(mDialog);
+
+    mLayerSpacingSpinBox = new QSpinBox(mDialog);
+    mLayerSpacingSpinBox->setToolTip(tr("Distance between layers"));
+    mLayerSpacingSpinBox->setMinimum(20);
+    mLayerSpacingSpinBox->setMaximum(500);
+    mLayerSpacingSpinBox->setValue((int)mParameters.layerSpacing);
+
+    mVertexSpacingSpinBox = new QSpinBox(mDialog);
+    mVertexSpacingSpinBox->setToolTip(tr("Distance between objects in layer"));
+    mVertexSpacingSpinBox->setMinimum(10);
+    mVertexSpacingSpinBox->setMaximum(500);
+    mVertexSpacingSpinBox->setValue((int)mParameters.vertexSpacing);
+
+    QFormLayout *fl = new QFormLayout();
+    fl->addRow(tr("Layer spacing:"), mLayerSpacingSpinBox);
+    fl->addRow(tr("Object spacing:"), mVertexSpacingSpinBox);
+
+    QVBoxLayout *vl = new QVBoxLayout();
+    vl->addLayout(fl);
+    vl->addWidget(buttonBox);
+
+    connect(mLayerSpacingSpinBox, SIGNAL(valueChanged(int)), this, SLOT(layerSpacingChanged(int)));
+    connect(mVertexSpacingSpinBox, SIGNAL(valueChanged(int)), this, SLOT(vertexSpacingChanged(int)));
+    connect(buttonBox, SIGNAL(accepted()), mDialog, SLOT(accept()));
+    connect(buttonBox, SIGNAL(rejected()), mDialog, SLOT(reject()));
+
+    mDialog->setLayout(vl);
+}
+
+void SCgHierarchicalArranger::layerSpacingChanged(int value)
+{
+    mParameters.layerSpacing = value;
+    calculate();
+    updateGhosts();
+}
+
+void SCgHierarchicalArranger::vertexSpacingChanged(int value)
+{
+    mParameters.vertexSpacing = value;
+    calculate();
+    updateGhosts();
+}
+
+bool SCgHierarchicalArranger::collectItems()
+{
+    clearItems();
+
+    QList<QGraphicsItem*> items = mView->scene()->selectedItems();
+    if (items.isEmpty())
+        items = mView->scene()->items();
+
+    foreach (QGraphicsItem *item, items)
+    {
+        if (!SCgObject::isSCgObjectType(item->type()))
+            continue;
+
+        SCgObject *obj = static_cast<SCgObject*>(item);
+        if (!obj->isDead())
+            collectObject(obj);
+    }
+
+    if (mArrangedList.isEmpty())
+        return false;
+
+    // inner containers are laid out first, their sizes are used by outer ones
+    QMultiMap<int, QGraphicsItem*> containersByDepth;
+    QHash<QGraphicsItem*, QList<SCgObject*> >::const_iterator it;
+    for (it = mChildren.constBegin(); it != mChildren.constEnd(); ++it)
+    {
+        int depth = 0;
+        for (QGraphicsItem *p = it.key(); p; p = p->parentItem())
+            ++depth;
+        containersByDepth.insert(-depth, it.key());
+    }
+    mContainers = containersByDepth.values();
+
+    // pairs and buses
+    foreach (QGraphicsItem *item, mView->scene()->items())
+    {
+        if (item->type() != SCgPair::Type && item->type() != SCgBus::Type)
+            continue;
+
+        SCgObject *obj = static_cast<SCgObject*>(item);
+        if (obj->isDead())
+            continue;
+
+        if (item->type() == SCgBus::Type)
+        {
+            if (arrangedVertex(obj))
+                mBuses.append(static_cast<SCgBus*>(item));
+            continue;
+        }
+
+        SCgPair *pair = static_cast<SCgPair*>(item);
+        SCgObject *begin = arrangedVertex(pair->beginObject());
+        SCgObject *end = arrangedVertex(pair->endObject());
+        if (!begin || !end)
+            continue;
+
+        mPairs.append(pair);
+        if (!pair->isOrient() || begin == end)
+            continue;
+
+        // find the lowest container, that contains both ends of pair
+        QHash<QGraphicsItem*, SCgObject*> beginChain;
+        for (SCgObject *v = begin; v; v = parentContour(v))
+            beginChain.insert(v->parentItem(), v);
+
+        for (SCgObject *v = end; v; v = parentContour(v))
+        {
+            if (!beginChain.contains(v->parentItem()))
+                continue;
+
+            SCgObject *from = beginChain.value(v->parentItem());
+            if (from != v)
+            {
+                EdgeInfo info;
+                info.container = v->parentItem();
+                info.from = from;
+                info.to = v;
+                info.edge = -1;
+                info.isDirect = (from == begin && v == end);
+                mEdges.insert(pair, info);
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+void SCgHierarchicalArranger::collectObject(SCgObject *obj)
+{
+    switch (obj->type())
+    {
+    case SCgNode::Type:
+    case SCgContour::Type:
+        if (mArranged.contains(obj))
+            break;
+
+        mArranged.insert(obj);
+        mArrangedList.append(obj);
+        mChildren[obj->parentItem()].append(obj);
+
+        if (obj->type() == SCgContour::Type)
+        {
+            foreach (QGraphicsItem *item, obj->childItems())
+            {
+                if (SCgObject::isSCgObjectType(item->type()) && !static_cast<SCgObject*>(item)->isDead())
+                    collectObject(static_cast<SCgObject*>(item));
+            }
+        }
+        break;
+
+    case SCgBus::Type:
+        if (static_cast<SCgBus*>(obj)->owner())
+            collectObject(static_cast<SCgBus*>(obj)->owner());
+        break;
+
+    default:
+        break;
+    }
+}
+
+void SCgHierarchicalArranger::clearItems()
+{
+    mChildren.clear();
+    mArranged.clear();
+    mArrangedList.clear();
+    mContainers.clear();
+    mEdges.clear();
+    mPairs.clear();
+    mBuses.clear();
+
+    mNodePositions.clear();
+    mContourPoints.clear();
+    mPairPoints.clear();
+    mBusPoints.clear();
+}
+
+SCgObject* SCgHierarchicalArranger::arrangedVertex(SCgObject *obj) const
+{
+    if (obj && obj->type() == SCgBus::Type)
+        obj = static_cast<SCgBus*>(obj)->owner();
+
+    if (obj && obj->type() == SCgNode::Type && mArranged.contains(obj))
+        return obj;
+
+    return 0;
+}
+
+SCgContour* SCgHierarchicalArranger::parentContour(SCgObject *obj) const
+{
+    QGraphicsItem *parent = obj->parentItem();
+    if (!parent || parent->type() != SCgContour::Type)
+        return 0;
+
+    SCgContour *contour = static_cast<SCgContour*>(parent);
+    return mArranged.contains(contour) ? contour : 0;
+}
+
+QPointF SCgHierarchicalArranger::displacement(SCgObject *obj) const
+{
+    if (obj && obj->type() == SCgBus::Type)
+        obj = static_cast<SCgBus*>(obj)->owner();
+
+    if (!obj || obj->type() != SCgNode::Type)
+        return QPointF(0, 0);
+
+    SCgNode *node = static_cast<SCgNode*>(obj);
+    if (!mNodePositions.contains(node))
+        return QPointF(0, 0);
+
+    return mNodePositions.value(node) - node->scenePos();
+}
+
+void SCgHierarchicalArranger::calculate()
+{
+    mNodePositions.clear();
+    mContourPoints.clear();
+    mPairPoints.clear();
+    mBusPoints.clear();
+
+    const qreal border = SCgContour::borderDistance();
+    QHash<QGraphicsItem*, SCgLayeredLayout*> layouts;
+
+    // edges of each container
+    QHash<QGraphicsItem*, QList<SCgPair*> > containerEdges;
+    QHash<SCgPair*, EdgeInfo>::const_iterator edgeIt;
+    for (edgeIt = mEdges.constBegin(); edgeIt != mEdges.constEnd(); ++edgeIt)
+        containerEdges[edgeIt.value().container].append(edgeIt.key());
+
+    // lay out containers from inner to outer ones
+    foreach (QGraphicsItem *container, mContainers)
+    {
+        const QList<SCgObject*> &vertices = mChildren[container];
+        QHash<SCgObject*, int> indexes;
+        QVector<QSizeF> sizes(vertices.size());
+
+        for (int i = 0; i < vertices.size(); ++i)
+        {
+            SCgObject *v = vertices[i];
+            indexes.insert(v, i);
+
+            if (layouts.contains(v))
+            {
+                QSizeF content = layouts.value(v)->size();
+                sizes[i] = QSizeF(content.width() + 2 * border, content.height() + 2 * border);
+            }
+            else if (v->type() == SCgContour::Type)
+                sizes[i] = v->sceneBoundingRect().size();
+            else
+                sizes[i] = v->boundingRect().size();
+        }
+
+        QVector<SCgLayeredLayout::Edge> edges;
+        foreach (SCgPair *pair, containerEdges.value(container))
+        {
+            EdgeInfo &info = mEdges[pair];
+            info.edge = edges.size();
+            edges.append(qMakePair(indexes.value(info.from), indexes.value(info.to)));
+        }
+
+        SCgLayeredLayout *layout = new SCgLayeredLayout(sizes, edges);
+        layout->setParameters(mParameters);
+        layout->calculate();
+        layouts.insert(container, layout);
+    }
+
+    // place top level containers at the top-left corner of their current content
+    QHash<QGraphicsItem*, QPointF> origins;
+    foreach (QGraphicsItem *container, mContainers)
+    {
+        if (container && container->type() == SCgContour::Type
+                && mArranged.contains(static_cast<SCgContour*>(container)))
+            continue;
+
+        QRectF bounds;
+        foreach (SCgObject *v, mChildren[container])
+            bounds |= v->sceneBoundingRect();
+
+        place(container, bounds.topLeft(), layouts, origins);
+    }
+
+    // pairs between arranged nodes are straightened, oriented ones get bends from layout
+    foreach (SCgPair *pair, mPairs)
+    {
+        QVector<QPointF> points = pair->scenePoints();
+        QVector<QPointF> newPoints;
+        newPoints << points.first() + displacement(pair->beginObject());
+
+        if (mEdges.contains(pair) && mEdges[pair].isDirect)
+        {
+            const EdgeInfo &info = mEdges[pair];
+            QPointF origin = origins.value(info.container);
+            foreach (const QPointF &bend, layouts.value(info.container)->edgeBends(info.edge))
+                newPoints << origin + bend;
+        }
+
+        newPoints << points.last() + displacement(pair->endObject());
+        mPairPoints.insert(pair, newPoints);
+    }
+
+    foreach (SCgBus *bus, mBuses)
+    {
+        QPointF delta = displacement(bus);
+        QVector<QPointF> points = bus->scenePoints();
+        for (int i = 0; i < points.size(); ++i)
+            points[i] += delta;
+        mBusPoints.insert(bus, points);
+    }
+
+    qDeleteAll(layouts);
+}
+
+void SCgHierarchicalArranger::place(QGraphicsItem *container, const QPointF &origin,
+                                    const QHash<QGraphicsItem*, SCgLayeredLayout*> &layouts,
+                                    QHash<QGraphicsItem*, QPointF> &origins)
+{
+    const qreal border = SCgContour::borderDistance();
+    const SCgLayeredLayout *layout = layouts.value(container);
+    const QList<SCgObject*> &vertices = mChildren[container];
+
+    origins.insert(container, origin);
+
+    for (int i = 0; i < vertices.size(); ++i)
+    {
+        SCgObject *v = vertices[i];
+        QPointF center = origin + layout->positions()[i];
+
+        if (v->type() == SCgNode::Type)
+        {
+            mNodePositions.insert(static_cast<SCgNode*>(v), center - v->boundingRect().center());
+            continue;
+        }
+
+        SCgContour *contour = static_cast<SCgContour*>(v);
+        QVector<QPointF> points;
+
+        if (layouts.contains(contour))
+        {
+            QSizeF content = layouts.value(contour)->size();
+            QSizeF size(content.width() + 2 * border, content.height() + 2 * border);
+            QRectF rect(center - QPointF(size.width() / 2, size.height() / 2), size);
+
+            points << rect.topLeft() << rect.topRight() << rect.bottomRight() << rect.bottomLeft();
+            place(contour, rect.topLeft() + QPointF(border, border), layouts, origins);
+        }
+        else
+        {
+            // contour without content keeps its shape
+            QPointF delta = center - contour->sceneBoundingRect().center();
+            points = contour->scenePoints();
+            for (int j = 0; j < points.size(); ++j)
+                points[j] += delta;
+        }
+
+        mContourPoints.insert(contour, points);
+    }
+}
+
+void SCgHierarchicalArranger::updateGhosts()
+{
+    QHash<SCgContour*, QVector<QPointF> >::const_iterator contourIt;
+    for (contourIt = mContourPoints.constBegin(); contourIt != mContourPoints.constEnd(); ++contourIt)
+    {
+        SCgPointObject *ghost = static_cast<SCgPointObject*>(mGhosts.value(contourIt.key()));
+        if (ghost)
+            ghost->setPoints(contourIt.value());
+    }
+
+    QHash<SCgNode*, QPointF>::const_iterator nodeIt;
+    for (nodeIt = mNodePositions.constBegin(); nodeIt != mNodePositions.constEnd(); ++nodeIt)
+    {
+        SCgObject *ghost = mGhosts.value(nodeIt.key());
+        if (!ghost)
+            continue;
+
+        QGraphicsItem *parent = ghost->parentItem();
+        ghost->setPos(parent ? parent->mapFromScene(nodeIt.value()) : nodeIt.value());
+    }
+
+    QHash<SCgBus*, QVector<QPointF> >::const_iterator busIt;
+    for (busIt = mBusPoints.constBegin(); busIt != mBusPoints.constEnd(); ++busIt)
+    {
+        SCgPointObject *ghost = static_cast<SCgPointObject*>(mGhosts.value(busIt.key()));
+        if (ghost)
+            ghost->setPoints(busIt.value());
+    }
+
+    QHash<SCgPair*, QVector<QPointF> >::const_iterator pairIt;
+    for (pairIt = mPairPoints.constBegin(); pairIt != mPairPoints.constEnd(); ++pairIt)
+    {
+        SCgPointObject *ghost = static_cast<SCgPointObject*>(mGhosts.value(pairIt.key()));
+        if (ghost)
+            ghost->setPoints(pairIt.value());
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "scgarranger.h"
+#include "scglayeredlayout.h"
+
+#include <QHash>
+
+class SCgNode;
+class SCgPair;
+class SCgBus;
+class SCgContour;
+class QSpinBox;
+
+/*! Hierarchical (layered) arranger for graphs of oriented pairs.
+ *  Nodes are placed into layers, so oriented pairs go from top to bottom.
+ *  Contours are laid out as compound vertices: content of each contour is
+ *  laid out separately, then contour is placed into its parent layout as one vertex
+ *  and rebuilt around its content. Pairs, that cross several layers, get bend points.
+ *  If there are selected objects, then only they are arranged (selected contours
+ *  are arranged with all their content); otherwise all objects on scene are arranged.
+ *  @see SCgLayeredLayout
+ */
+class SCgHierarchicalArranger : public SCgArranger
+{
+Q_OBJECT
+
+public:
+    enum
+    {
+        Type = 6
+    };
+
+    explicit SCgHierarchicalArranger(QObject *parent = 0);
+    virtual ~SCgHierarchicalArranger();
+
+    //! @see SCgArranger::type
+    int type() const { return Type; }
+
+protected:
+    //! @see SCgArranger::configDialog
+    bool configDialog();
+
+    //! @see SCgArranger::startOperation
+    void startOperation();
+
+    //! @see SCgArranger::name
+    QString name() const;
+
+    //! Creates dialog for asking layout parameters.
+    void createDialog();
+
+protected slots:
+    /*! @defgroup Slots Slots to react on user actions
+     *  @{
+     */
+    void layerSpacingChanged(int value);
+    void vertexSpacingChanged(int value);
+    /*! @}*/
+
+private:
+    //! Pair, that is laid out as an edge of some container
+    struct EdgeInfo
+    {
+        //! Container, where edge is laid out
+        QGraphicsItem *container;
+        //! Vertex of container, that contains begin of pair
+        SCgObject *from;
+        //! Vertex of container, that contains end of pair
+        SCgObject *to;
+        //! Index of edge in container layout
+        int edge;
+        //! True, if pair connects vertices of container directly (so it can be bent)
+        bool isDirect;
+    };
+
+    //! Collects objects, that will be arranged
+    bool collectItems();
+
+    //! Collects object @p obj (and all its content for contours) into arranged items
+    void collectObject(SCgObject *obj);
+
+    //! Clears collected items and calculated geometry
+    void clearItems();
+
+    //! @return arranged node for object @p obj (owner for bus); 0 if object isn't arranged
+    SCgObject* arrangedVertex(SCgObject *obj) const;
+
+    //! Calculates new geometry of all arranged objects
+    void calculate();
+
+    /*! Places content of container @p container, so its top-left corner is at @p origin.
+     * @param layouts Calculated layouts of containers.
+     * @param origins Map, where origins of all placed containers are stored.
+     */
+    void place(QGraphicsItem *container, const QPointF &origin,
+               const QHash<QGraphicsItem*, SCgLayeredLayout*> &layouts,
+               QHash<QGraphicsItem*, QPointF> &origins);
+
+    //! @return arranged contour, that contains object @p obj; 0 if there are no such contour
+    SCgContour* parentContour(SCgObject *obj) const;
+
+    //! @return displacement of object @p obj (node or bus) by calculated layout
+    QPointF displacement(SCgObject *obj) const;
+
+    //! Moves ghosts to calculated positions
+    void updateGhosts();
+
+    //! Dialog to configure layout parameters
+    QDialog *mDialog;
+    QSpinBox *mLayerSpacingSpinBox;
+    QSpinBox *mVertexSpacingSpinBox;
+
+    //! Layout parameters
+    SCgLayeredLayout::Parameters mParameters;
+
+    //! Arranged vertices (nodes and contours) of each container. Container is a parent item (0 for scene).
+    QHash<QGraphicsItem*, QList<SCgObject*> > mChildren;
+    //! Set of arranged nodes and contours
+    QSet<SCgObject*> mArranged;
+    //! Arranged nodes and contours in order they were collected
+    QList<SCgObject*> mArrangedList;
+    //! Containers in order they should be laid out (inner ones go first)
+    QList<QGraphicsItem*> mContainers;
+    //! Oriented pairs, that are laid out as edges
+    QHash<SCgPair*, EdgeInfo> mEdges;
+    //! Pairs, whose both ends are arranged
+    QList<SCgPair*> mPairs;
+    //! Buses, whose owners are arranged
+    QList<SCgBus*> mBuses;
+
+    /*! @defgroup calcGeometry Calculated geometry (scene coordinates)
+     *  @{
+     */
+    QHash<SCgNode*, QPointF> mNodePositions;
+    QHash<SCgContour*, QVector<QPointF> > mContourPoints;
+    QHash<SCgPair*, QVector<QPointF> > mPairPoints;
+    QHash<SCgBus*, QVector<QPointF> > mBusPoints;
+    /*! @}*/
+};
@@ -0,0 +1,264 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgforcecalculator.h"
+
+#include <QRectF>
+#include <QtCore/qmath.h>
+
+//! Maximal depth of quadtree. Bodies in one cell on this depth are merged.
+#define SCG_FORCE_MAX_TREE_DEPTH 32
+//! Minimal distance between bodies, that is used in force calculation
+#define SCG_FORCE_MIN_DISTANCE 0.01
+
+SCgForceCalculator::Parameters::Parameters() :
+    springLength(100),
+    repulsion(1),
+    containment(0.5),
+    gravity(0.05),
+    theta(0.8),
+    iterations(300)
+{
+}
+
+SCgForceCalculator::SCgForceCalculator(const QVector<QPointF> &positions,
+                                       const QVector<Spring> &springs,
+                                       const QVector<int> &groups) :
+    mPositions(positions),
+    mSprings(springs),
+    mGroups(groups),
+    mGroupCount(0),
+    mIteration(0),
+    mStartTemperature(0)
+{
+    Q_ASSERT_X(mGroups.size() == mPositions.size(),
+               "SCgForceCalculator::SCgForceCalculator",
+               "Number of groups doesn't match number of bodies");
+
+    foreach (int group, mGroups)
+        mGroupCount = qMax(mGroupCount, group + 1);
+
+    setParameters(Parameters());
+}
+
+SCgForceCalculator::~SCgForceCalculator()
+{
+}
+
+void SCgForceCalculator::setParameters(const Parameters &params)
+{
+    mParameters = params;
+    mStartTemperature = mParameters.springLength * 2;
+}
+
+const SCgForceCalculator::Parameters& SCgForceCalculator::parameters() const
+{
+    return mParameters;
+}
+
+bool SCgForceCalculator::isFinished() const
+{
+    return mIteration >= mParameters.iterations;
+}
+
+int SCgForceCalculator::iteration() const
+{
+    return mIteration;
+}
+
+const QVector<QPointF>& SCgForceCalculator::positions() const
+{
+    return mPositions;
+}
+
+qreal SCgForceCalculator::step()
+{
+    int count = mPositions.size();
+    if (count == 0 || isFinished())
+        return 0;
+
+    const qreal k = mParameters.springLength;
+    QVector<QPointF> forces(count, QPointF(0, 0));
+
+    // repulsion between all bodies
+    buildTree();
+    for (int i = 0; i < count; ++i)
+        forces[i] += repulsionForce(i) * mParameters.repulsion;
+
+    // springs attraction
+    foreach (const Spring &spring, mSprings)
+    {
+        QPointF delta = mPositions[spring.second] - mPositions[spring.first];
+        qreal dist = qMax(qSqrt(delta.x() * delta.x() + delta.y() * delta.y()), qreal(SCG_FORCE_MIN_DISTANCE));
+        QPointF force = delta * (dist / k);
+        forces[spring.first] += force;
+        forces[spring.second] -= force;
+    }
+
+    // group containment and gravity to the graph center
+    QVector<QPointF> groupCenters(mGroupCount, QPointF(0, 0));
+    QVector<int> groupSizes(mGroupCount, 0);
+    QPointF center(0, 0);
+    for (int i = 0; i < count; ++i)
+    {
+        center += mPositions[i];
+        if (mGroups[i] >= 0)
+        {
+            groupCenters[mGroups[i]] += mPositions[i];
+            ++groupSizes[mGroups[i]];
+        }
+    }
+    center /= count;
+    for (int g = 0; g < mGroupCount; ++g)
+        if (groupSizes[g] > 0)
+            groupCenters[g] /= groupSizes[g];
+
+    for (int i = 0; i < count; ++i)
+    {
+        forces[i] += (center - mPositions[i]) * mParameters.gravity;
+        if (mGroups[i] >= 0)
+            forces[i] += (groupCenters[mGroups[i]] - mPositions[i]) * mParameters.containment;
+    }
+
+    // move bodies, displacement is limited by temperature, that cools down linearly
+    qreal temperature = mStartTemperature * (1.0 - qreal(mIteration) / mParameters.iterations);
+    qreal maxDisplacement = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        const QPointF &f = forces[i];
+        qreal len = qSqrt(f.x() * f.x() + f.y() * f.y());
+        if (len < SCG_FORCE_MIN_DISTANCE)
+            continue;
+
+        qreal displacement = qMin(len, temperature);
+        mPositions[i] += f * (displacement / len);
+        maxDisplacement = qMax(maxDisplacement, displacement);
+    }
+
+    ++mIteration;
+    return maxDisplacement;
+}
+
+void SCgForceCalculator::buildTree()
+{
+    mCells.clear();
+
+    QRectF bounds(mPositions.first(), QSizeF(0, 0));
+    foreach (const QPointF &p, mPositions)
+        bounds |= QRectF(p, QSizeF(0, 0));
+
+    Cell root;
+    root.center = bounds.center();
+    root.halfSize = qMax(qMax(bounds.width(), bounds.height()) / 2, qreal(1));
+    root.mass = 0;
+    root.body = -1;
+    root.firstChild = -1;
+    mCells.append(root);
+
+    for (int i = 0; i < mPositions.size(); ++i)
+        insertBody(0, i, 0);
+}
+
+void SCgForceCalculator::insertBody(int cell, int body, int depth)
+{
+    const QPointF &pos = mPositions[body];
+
+    // empty leaf
+    if (mCells[cell].mass == 0)
+    {
+        mCells[cell].body = body;
+        mCells[cell].mass = 1;
+        mCells[cell].massCenter = pos;
+        return;
+    }
+
+    // leaf with one body, move it down into a child
+    if (mCells[cell].firstChild < 0 && depth < SCG_FORCE_MAX_TREE_DEPTH && mCells[cell].body >= 0)
+    {
+        int oldBody = mCells[cell].body;
+        splitCell(cell);
+        mCells[cell].body = -1;
+        insertBody(childCellFor(cell, mPositions[oldBody]), oldBody, depth + 1);
+    }
+
+    Cell &c = mCells[cell];
+    c.massCenter = (c.massCenter * c.mass + pos) / (c.mass + 1);
+    c.mass += 1;
+
+    if (c.firstChild >= 0)
+        insertBody(childCellFor(cell, pos), body, depth + 1);
+    else
+        c.body = -1; // too deep, bodies are merged
+}
+
+void SCgForceCalculator::splitCell(int cell)
+{
+    qreal half = mCells[cell].halfSize / 2;
+    QPointF center = mCells[cell].center;
+    mCells[cell].firstChild = mCells.size();
+
+    for (int i = 0; i < 4; ++i)
+    {
+        Cell child;
+        child.center = center + QPointF((i & 1) ? half : -half, (i & 2) ? half : -half);
+        child.halfSize = half;
+        child.mass = 0;
+        child.body = -1;
+        child.firstChild = -1;
+        mCells.append(child);
+    }
+}
+
+int SCgForceCalculator::childCellFor(int cell, const QPointF &pos) const
+{
+    const Cell &c = mCells[cell];
+    int index = (pos.x() >= c.center.x() ? 1 : 0) | (pos.y() >= c.center.y() ? 2 : 0);
+    return c.firstChild + index;
+}
+
+QPointF SCgForceCalculator::repulsionForce(int body) const
+{
+    const QPointF &pos = mPositions[body];
+    const qreal k2 = mParameters.springLength * mParameters.springLength;
+    const qreal theta2 = mParameters.theta * mParameters.theta;
+
+    QPointF force(0, 0);
+    QVector<int> stack;
+    stack.append(0);
+
+    while (!stack.isEmpty())
+    {
+        const Cell &c = mCells[stack.last()];
+        stack.removeLast();
+
+        if (c.mass == 0 || c.body == body)
+            continue;
+
+        QPointF delta = pos - c.massCenter;
+        qreal dist2 = delta.x() * delta.x() + delta.y() * delta.y();
+        qreal size = c.halfSize * 2;
+
+        // go deeper, if cell is too close to be approximated
+        if (c.firstChild >= 0 && size * size >= theta2 * dist2)
+        {
+            for (int i = 0; i < 4; ++i)
+                stack.append(c.firstChild + i);
+            continue;
+        }
+
+        if (dist2 < SCG_FORCE_MIN_DISTANCE * SCG_FORCE_MIN_DISTANCE)
+        {
+            // bodies at the same point, push them apart in a stable direction
+            delta = QPointF(qCos(body), qSin(body)) * SCG_FORCE_MIN_DISTANCE;
+            dist2 = SCG_FORCE_MIN_DISTANCE * SCG_FORCE_MIN_DISTANCE;
+        }
+
+        // f = k^2 / d in direction of delta, so f_vec = delta * k^2 / d^2
+        force += delta * (k2 * c.mass / dist2);
+    }
+
+    return force;
+}
@@ -0,0 +1,117 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QPointF>
+#include <QPair>
+
+/*! Calculates force-directed layout of a graph (Fruchterman-Reingold model).
+ *  Bodies repulse each other, springs attract connected bodies and groups keep
+ *  their members together. Repulsion is approximated with a Barnes-Hut quadtree,
+ *  so each iteration costs O(n log n).
+ *  Calculator works with plain data only, so it can be used from a worker thread.
+ */
+class SCgForceCalculator
+{
+public:
+    //! Layout parameters
+    struct Parameters
+    {
+        //! Natural length of spring (ideal distance between connected bodies)
+        qreal springLength;
+        //! Repulsion factor between bodies
+        qreal repulsion;
+        //! Factor of the force, that holds group members together
+        qreal containment;
+        //! Factor of the force, that holds all bodies near the graph center
+        qreal gravity;
+        //! Barnes-Hut accuracy: cell is approximated, if cellSize / distance < theta
+        qreal theta;
+        //! Number of iterations
+        int iterations;
+
+        Parameters();
+    };
+
+    typedef QPair<int, int> Spring;
+
+    /*! Constructor
+     * @param positions Initial positions of bodies.
+     * @param springs Pairs of indexes of connected bodies.
+     * @param groups Group index for each body; -1 if body doesn't belong to any group.
+     */
+    SCgForceCalculator(const QVector<QPointF> &positions,
+                       const QVector<Spring> &springs,
+                       const QVector<int> &groups);
+    virtual ~SCgForceCalculator();
+
+    //! Set layout parameters
+    void setParameters(const Parameters &params);
+    //! @return layout parameters
+    const Parameters& parameters() const;
+
+    /*! Make one iteration of layout.
+     * @return Maximal displacement of bodies on this iteration.
+     */
+    qreal step();
+
+    //! @return true, if all iterations are done
+    bool isFinished() const;
+
+    //! @return number of done iterations
+    int iteration() const;
+
+    //! @return current positions of bodies
+    const QVector<QPointF>& positions() const;
+
+private:
+    //! Quadtree cell
+    struct Cell
+    {
+        //! Cell center
+        QPointF center;
+        //! Half of cell size
+        qreal halfSize;
+        //! Number of bodies in cell
+        qreal mass;
+        //! Center of mass of bodies in cell
+        QPointF massCenter;
+        //! Index of body for leaf with one body; -1 otherwise
+        int body;
+        //! Index of first child cell; -1 for leaves
+        int firstChild;
+    };
+
+    //! Build quadtree for current positions
+    void buildTree();
+    //! Insert body with index @p body into cell with index @p cell
+    void insertBody(int cell, int body, int depth);
+    //! Create four children for cell with index @p cell
+    void splitCell(int cell);
+    //! @return index of child cell of @p cell, that contains point @p pos
+    int childCellFor(int cell, const QPointF &pos) const;
+    //! Calculate approximate repulsion force for body with index @p body
+    QPointF repulsionForce(int body) const;
+
+    //! Current positions of bodies
+    QVector<QPointF> mPositions;
+    //! Springs between bodies
+    QVector<Spring> mSprings;
+    //! Group of each body
+    QVector<int> mGroups;
+    //! Number of groups
+    int mGroupCount;
+    //! Quadtree cells, root cell has index 0
+    QVector<Cell> mCells;
+    //! Layout parameters
+    Parameters mParameters;
+    //! Number of done iterations
+    int mIteration;
+    //! Initial temperature (maximal displacement on first iteration)
+    qreal mStartTemperature;
+};
@@ -0,0 +1,452 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scglayeredlayout.h"
+
+#include <QtAlgorithms>
+
+#include <algorithm>
+
+//! Number of coordinates refinement passes
+#define SCG_LAYERED_COORDINATE_PASSES 8
+
+namespace
+{
+
+//! Vertex with barycenter, used to sort layers
+struct BarycenterItem
+{
+    qreal barycenter;
+    int vertex;
+
+    bool operator < (const BarycenterItem &other) const
+    {
+        return barycenter < other.barycenter;
+    }
+};
+
+}
+
+SCgLayeredLayout::Parameters::Parameters() :
+    layerSpacing(80),
+    vertexSpacing(40),
+    sweeps(4)
+{
+}
+
+SCgLayeredLayout::SCgLayeredLayout(const QVector<QSizeF> &sizes, const QVector<Edge> &edges) :
+    mVertexCount(sizes.size()),
+    mSizes(sizes),
+    mEdges(edges),
+    mCrossings(0)
+{
+}
+
+SCgLayeredLayout::~SCgLayeredLayout()
+{
+}
+
+void SCgLayeredLayout::setParameters(const Parameters &params)
+{
+    mParameters = params;
+}
+
+const QVector<QPointF>& SCgLayeredLayout::positions() const
+{
+    return mPositions;
+}
+
+QSizeF SCgLayeredLayout::size() const
+{
+    return mSize;
+}
+
+int SCgLayeredLayout::crossings() const
+{
+    return mCrossings;
+}
+
+QVector<QPointF> SCgLayeredLayout::edgeBends(int edge) const
+{
+    Q_ASSERT(edge >= 0 && edge < mChains.size());
+
+    QVector<QPointF> bends;
+    const QVector<int> &chain = mChains[edge];
+    for (int i = 1; i < chain.size() - 1; ++i)
+        bends.append(mPositions[chain[i]]);
+
+    if (mReversed[edge])
+        std::reverse(bends.begin(), bends.end());
+
+    return bends;
+}
+
+void SCgLayeredLayout::calculate()
+{
+    // reset results of previous calculation
+    mSizes.resize(mVertexCount);
+    mPositions.clear();
+    mChains.clear();
+    mSize = QSizeF();
+    mCrossings = 0;
+
+    if (mVertexCount == 0)
+        return;
+
+    removeCycles();
+    assignLayers();
+    insertDummies();
+    orderLayers();
+    assignCoordinates();
+}
+
+void SCgLayeredLayout::removeCycles()
+{
+    mReversed.fill(false, mEdges.size());
+
+    QVector< QVector<int> > outEdges(mVertexCount);
+    for (int i = 0; i < mEdges.size(); ++i)
+        outEdges[mEdges[i].first].append(i);
+
+    // iterative depth-first search, edges to vertices on the stack are back edges
+    enum { White = 0, Gray, Black };
+    QVector<int> color(mVertexCount, White);
+    QVector< QPair<int, int> > stack; // vertex, index of next out edge
+
+    for (int root = 0; root < mVertexCount; ++root)
+    {
+        if (color[root] != White)
+            continue;
+
+        color[root] = Gray;
+        stack.append(qMakePair(root, 0));
+
+        while (!stack.isEmpty())
+        {
+            QPair<int, int> &top = stack.last();
+            int v = top.first;
+
+            if (top.second >= outEdges[v].size())
+            {
+                color[v] = Black;
+                stack.removeLast();
+                continue;
+            }
+
+            int e = outEdges[v][top.second++];
+            int u = mEdges[e].second;
+
+            if (color[u] == Gray)
+                mReversed[e] = true;
+            else if (color[u] == White)
+            {
+                color[u] = Gray;
+                stack.append(qMakePair(u, 0));
+            }
+        }
+    }
+}
+
+void SCgLayeredLayout::assignLayers()
+{
+    // longest path from sources, vertices are processed in topological order
+    QVector<int> inDegree(mVertexCount, 0);
+    QVector< QVector<int> > successors(mVertexCount);
+
+    for (int i = 0; i < mEdges.size(); ++i)
+    {
+        int from = mReversed[i] ? mEdges[i].second : mEdges[i].first;
+        int to = mReversed[i] ? mEdges[i].first : mEdges[i].second;
+        if (from == to)
+            continue;
+
+        successors[from].append(to);
+        ++inDegree[to];
+    }
+
+    mLayer.fill(0, mVertexCount);
+    QVector<int> queue;
+    for (int v = 0; v < mVertexCount; ++v)
+        if (inDegree[v] == 0)
+            queue.append(v);
+
+    for (int i = 0; i < queue.size(); ++i)
+    {
+        int v = queue[i];
+        foreach (int u, successors[v])
+        {
+            mLayer[u] = qMax(mLayer[u], mLayer[v] + 1);
+            if (--inDegree[u] == 0)
+                queue.append(u);
+        }
+    }
+
+    int layerCount = 0;
+    foreach (int layer, mLayer)
+        layerCount = qMax(layerCount, layer + 1);
+
+    // initial order is the topological one, it keeps connected vertices close
+    mLayers.clear();
+    mLayers.resize(layerCount);
+    foreach (int v, queue)
+        mLayers[mLayer[v]].append(v);
+}
+
+void SCgLayeredLayout::insertDummies()
+{
+    mUpper.clear();
+    mLower.clear();
+    mUpper.resize(mVertexCount);
+    mLower.resize(mVertexCount);
+    mChains.resize(mEdges.size());
+
+    for (int i = 0; i < mEdges.size(); ++i)
+    {
+        int from = mReversed[i] ? mEdges[i].second : mEdges[i].first;
+        int to = mReversed[i] ? mEdges[i].first : mEdges[i].second;
+
+        QVector<int> &chain = mChains[i];
+        chain.append(from);
+        if (from == to)
+            continue;
+
+        int prev = from;
+        for (int layer = mLayer[from] + 1; layer < mLayer[to]; ++layer)
+        {
+            int dummy = mSizes.size();
+            mSizes.append(QSizeF(0, 0));
+            mLayer.append(layer);
+            mUpper.append(QVector<int>());
+            mLower.append(QVector<int>());
+            mLayers[layer].append(dummy);
+
+            mLower[prev].append(dummy);
+            mUpper[dummy].append(prev);
+            chain.append(dummy);
+            prev = dummy;
+        }
+
+        mLower[prev].append(to);
+        mUpper[to].append(prev);
+        chain.append(to);
+    }
+
+    mOrder.resize(mSizes.size());
+    for (int l = 0; l < mLayers.size(); ++l)
+        for (int i = 0; i < mLayers[l].size(); ++i)
+            mOrder[mLayers[l][i]] = i;
+}
+
+void SCgLayeredLayout::orderLayers()
+{
+    QVector< QVector<int> > bestLayers = mLayers;
+    int bestCrossings = countAllCrossings();
+
+    for (int sweep = 0; sweep < mParameters.sweeps && bestCrossings > 0; ++sweep)
+    {
+        for (int l = 1; l < mLayers.size(); ++l)
+            sortByBarycenter(l, mUpper);
+        for (int l = mLayers.size() - 2; l >= 0; --l)
+            sortByBarycenter(l, mLower);
+
+        int crossings = countAllCrossings();
+        if (crossings < bestCrossings)
+        {
+            bestCrossings = crossings;
+            bestLayers = mLayers;
+        }
+    }
+
+    mLayers = bestLayers;
+    for (int l = 0; l < mLayers.size(); ++l)
+        for (int i = 0; i < mLayers[l].size(); ++i)
+            mOrder[mLayers[l][i]] = i;
+
+    mCrossings = bestCrossings;
+}
+
+void SCgLayeredLayout::sortByBarycenter(int layer, const QVector< QVector<int> > &neighbours)
+{
+    QVector<int> &vertices = mLayers[layer];
+    QVector<BarycenterItem> items(vertices.size());
+
+    for (int i = 0; i < vertices.size(); ++i)
+    {
+        int v = vertices[i];
+        const QVector<int> &adj = neighbours[v];
+
+        items[i].vertex = v;
+        // vertices without neighbours keep their place
+        items[i].barycenter = i;
+
+        if (!adj.isEmpty())
+        {
+            qreal sum = 0;
+            foreach (int u, adj)
+                sum += mOrder[u];
+            items[i].barycenter = sum / adj.size();
+        }
+    }
+
+    qStableSort(items.begin(), items.end());
+
+    for (int i = 0; i < items.size(); ++i)
+    {
+        vertices[i] = items[i].vertex;
+        mOrder[vertices[i]] = i;
+    }
+}
+
+int SCgLayeredLayout::countCrossings(int layer) const
+{
+    // collect edges as pairs of positions and count inversions of lower ends
+    // with a binary indexed tree, it takes O(E log V)
+    QVector< QPair<int, int> > edges;
+    foreach (int v, mLayers[layer])
+        foreach (int u, mLower[v])
+            edges.append(qMakePair(mOrder[v], mOrder[u]));
+
+    qSort(edges.begin(), edges.end());
+
+    int size = mLayers[layer + 1].size();
+    QVector<int> tree(size + 1, 0);
+    int crossings = 0;
+
+    for (int i = 0; i < edges.size(); ++i)
+    {
+        // count already added edges, that end to the right of current one
+        int pos = edges[i].second + 1;
+        int lessOrEqual = 0;
+        for (int j = pos; j > 0; j -= j & -j)
+            lessOrEqual += tree[j];
+        crossings += i - lessOrEqual;
+
+        for (int j = pos; j <= size; j += j & -j)
+            ++tree[j];
+    }
+
+    return crossings;
+}
+
+int SCgLayeredLayout::countAllCrossings() const
+{
+    int crossings = 0;
+    for (int l = 0; l < mLayers.size() - 1; ++l)
+        crossings += countCrossings(l);
+
+    return crossings;
+}
+
+qreal SCgLayeredLayout::separation(int a, int b) const
+{
+    qreal spacing = mParameters.vertexSpacing;
+    // dummy vertices may be placed closer
+    if (a >= mVertexCount || b >= mVertexCount)
+        spacing /= 2;
+
+    return (mSizes[a].width() + mSizes[b].width()) / 2 + spacing;
+}
+
+void SCgLayeredLayout::assignCoordinates()
+{
+    mPositions.fill(QPointF(0, 0), mSizes.size());
+
+    // y coordinates, each layer is as high as its highest vertex
+    qreal top = 0;
+    for (int l = 0; l < mLayers.size(); ++l)
+    {
+        qreal height = 0;
+        foreach (int v, mLayers[l])
+            height = qMax(height, mSizes[v].height());
+
+        foreach (int v, mLayers[l])
+            mPositions[v].setY(top + height / 2);
+
+        top += height + mParameters.layerSpacing;
+    }
+
+    // initial x coordinates, vertices are packed to the left
+    for (int l = 0; l < mLayers.size(); ++l)
+    {
+        const QVector<int> &vertices = mLayers[l];
+        for (int i = 0; i < vertices.size(); ++i)
+        {
+            qreal x = (i == 0) ? mSizes[vertices[i]].width() / 2
+                               : mPositions[vertices[i - 1]].x() + separation(vertices[i - 1], vertices[i]);
+            mPositions[vertices[i]].setX(x);
+        }
+    }
+
+    // move vertices to the average position of their neighbours
+    for (int pass = 0; pass < SCG_LAYERED_COORDINATE_PASSES; ++pass)
+    {
+        bool down = (pass % 2) == 0;
+        const QVector< QVector<int> > &neighbours = down ? mUpper : mLower;
+
+        for (int i = 0; i < mLayers.size(); ++i)
+        {
+            int l = down ? i : mLayers.size() - 1 - i;
+            const QVector<int> &vertices = mLayers[l];
+            QVector<qreal> desired(vertices.size());
+
+            for (int j = 0; j < vertices.size(); ++j)
+            {
+                const QVector<int> &adj = neighbours[vertices[j]];
+                desired[j] = mPositions[vertices[j]].x();
+                if (adj.isEmpty())
+                    continue;
+
+                qreal sum = 0;
+                foreach (int u, adj)
+                    sum += mPositions[u].x();
+                desired[j] = sum / adj.size();
+            }
+
+            placeLayer(l, desired);
+        }
+    }
+
+    // normalize layout, so its top-left corner is (0, 0)
+    qreal left = 0, right = 0;
+    bool first = true;
+    for (int v = 0; v < mSizes.size(); ++v)
+    {
+        qreal l = mPositions[v].x() - mSizes[v].width() / 2;
+        qreal r = mPositions[v].x() + mSizes[v].width() / 2;
+        left = first ? l : qMin(left, l);
+        right = first ? r : qMax(right, r);
+        first = false;
+    }
+
+    for (int v = 0; v < mPositions.size(); ++v)
+        mPositions[v].rx() -= left;
+
+    mSize = QSizeF(right - left, qMax(qreal(0), top - mParameters.layerSpacing));
+}
+
+void SCgLayeredLayout::placeLayer(int layer, const QVector<qreal> &desired)
+{
+    const QVector<int> &vertices = mLayers[layer];
+    int count = vertices.size();
+    if (count == 0)
+        return;
+
+    // the closest placement, where vertices are pushed to the right
+    QVector<qreal> pushRight(count);
+    pushRight[0] = desired[0];
+    for (int i = 1; i < count; ++i)
+        pushRight[i] = qMax(desired[i], pushRight[i - 1] + separation(vertices[i - 1], vertices[i]));
+
+    // the closest placement, where vertices are pushed to the left
+    QVector<qreal> pushLeft(count);
+    pushLeft[count - 1] = desired[count - 1];
+    for (int i = count - 2; i >= 0; --i)
+        pushLeft[i] = qMin(desired[i], pushLeft[i + 1] - separation(vertices[i], vertices[i + 1]));
+
+    // average of two valid placements is valid too
+    for (int i = 0; i < count; ++i)
+        mPositions[vertices[i]].setX((pushRight[i] + pushLeft[i]) / 2);
+}
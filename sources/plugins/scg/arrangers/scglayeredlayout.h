@@ -0,0 +1,119 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QPointF>
+#include <QSizeF>
+#include <QPair>
+
+/*! Calculates layered (Sugiyama-style) layout of a directed graph.
+ *  Layout is made in several steps:
+ *  - cycles are broken by reversing back edges found with depth-first search;
+ *  - vertices are assigned to layers by the longest path from sources;
+ *  - long edges are split by dummy vertices, one per crossed layer;
+ *  - crossings are reduced by barycenter sweeps (the best found order is kept);
+ *  - coordinates are assigned by averaging neighbours positions with respect to vertices sizes.
+ *  Every step is (almost) linear, so graphs with tens of thousands of vertices are laid out quickly.
+ *  Calculator works with plain data only, so it can be used from a worker thread.
+ */
+class SCgLayeredLayout
+{
+public:
+    //! Layout parameters
+    struct Parameters
+    {
+        //! Distance between layers
+        qreal layerSpacing;
+        //! Distance between neighbour vertices in layer
+        qreal vertexSpacing;
+        //! Number of barycenter sweeps (one sweep is a down and an up pass)
+        int sweeps;
+
+        Parameters();
+    };
+
+    typedef QPair<int, int> Edge;
+
+    /*! Constructor
+     * @param sizes Sizes of vertices.
+     * @param edges Directed edges (source, target) between vertices.
+     */
+    SCgLayeredLayout(const QVector<QSizeF> &sizes, const QVector<Edge> &edges);
+    virtual ~SCgLayeredLayout();
+
+    //! Set layout parameters
+    void setParameters(const Parameters &params);
+
+    //! Calculate layout
+    void calculate();
+
+    /*! @return centers of vertices. Top-left corner of layout is (0, 0).
+     * Dummy vertices go after the real ones.
+     */
+    const QVector<QPointF>& positions() const;
+
+    //! @return bend points of edge with index @p edge (from source to target)
+    QVector<QPointF> edgeBends(int edge) const;
+
+    //! @return size of layout
+    QSizeF size() const;
+
+    //! @return number of edge crossings in calculated layout
+    int crossings() const;
+
+private:
+    //! Reverse edges, that make cycles
+    void removeCycles();
+    //! Assign each vertex to layer
+    void assignLayers();
+    //! Split edges, that go through several layers, by dummy vertices
+    void insertDummies();
+    //! Order vertices in layers to reduce crossings
+    void orderLayers();
+    //! Sort layer @p layer by barycenters of neighbours in @p neighbours
+    void sortByBarycenter(int layer, const QVector< QVector<int> > &neighbours);
+    //! @return number of crossings between layer @p layer and next one
+    int countCrossings(int layer) const;
+    //! @return number of crossings between all layers
+    int countAllCrossings() const;
+    //! Assign coordinates to vertices
+    void assignCoordinates();
+    //! Place vertices of layer @p layer as close as possible to @p desired x coordinates
+    void placeLayer(int layer, const QVector<qreal> &desired);
+    //! @return minimal distance between centers of vertices @p a and @p b in one layer
+    qreal separation(int a, int b) const;
+
+    //! Layout parameters
+    Parameters mParameters;
+    //! Number of real (not dummy) vertices
+    int mVertexCount;
+    //! Sizes of all vertices (dummy vertices have zero size)
+    QVector<QSizeF> mSizes;
+    //! Original edges
+    QVector<Edge> mEdges;
+    //! Flags of edges, that were reversed to remove cycles
+    QVector<bool> mReversed;
+    //! Layer of each vertex
+    QVector<int> mLayer;
+    //! Vertices of each layer in their order
+    QVector< QVector<int> > mLayers;
+    //! Position of each vertex in its layer
+    QVector<int> mOrder;
+    //! Neighbours of each vertex in previous layer
+    QVector< QVector<int> > mUpper;
+    //! Neighbours of each vertex in next layer
+    QVector< QVector<int> > mLower;
+    //! Chain of vertices for each edge (in layers order)
+    QVector< QVector<int> > mChains;
+    //! Centers of all vertices
+    QVector<QPointF> mPositions;
+    //! Size of layout
+    QSizeF mSize;
+    //! Number of crossings
+    int mCrossings;
+};
@@ -31,3 +31,65 @@ QGraphicsScene* SCgBaseCommand::getScene() const
 {
     return mScene;
 }
+
+qint64 SCgBaseCommand::commandMemoryUsage(const QUndoCommand *cmd)
+{
+    const SCgBaseCommand *scgCmd = dynamic_cast<const SCgBaseCommand*>(cmd);
+    if (scgCmd)
+        return scgCmd->memoryUsage();
+
+    qint64 size = sizeof(QUndoCommand) + cmd->text().size() * sizeof(QChar);
+    for (int i = 0; i < cmd->childCount(); ++i)
+        size += commandMemoryUsage(cmd->child(i));
+
+    return size;
+}
+
+qint64 SCgBaseCommand::memoryUsage() const
+{
+    qint64 size = sizeof(SCgBaseCommand) + text().size() * sizeof(QChar);
+    for (int i = 0; i < childCount(); ++i)
+        size += commandMemoryUsage(child(i));
+
+    return size;
+}
+
+void SCgBaseCommand::compact()
+{
+    for (int i = 0; i < childCount(); ++i)
+    {
+        SCgBaseCommand *cmd = dynamic_cast<SCgBaseCommand*>(const_cast<QUndoCommand*>(child(i)));
+        if (cmd)
+            cmd->compact();
+    }
+}
+
+bool SCgBaseCommand::isCompacted() const
+{
+    for (int i = 0; i < childCount(); ++i)
+    {
+        const SCgBaseCommand *cmd = dynamic_cast<const SCgBaseCommand*>(child(i));
+        if (cmd && cmd->isCompacted())
+            return true;
+    }
+
+    return false;
+}
+
+void SCgBaseCommand::collectObjects(QSet<SCgObject*> &objects) const
+{
+    addObject(mObject, objects);
+
+    for (int i = 0; i < childCount(); ++i)
+    {
+        const SCgBaseCommand *cmd = dynamic_cast<const SCgBaseCommand*>(child(i));
+        if (cmd)
+            cmd->collectObjects(objects);
+    }
+}
+
+void SCgBaseCommand::addObject(QGraphicsItem *item, QSet<SCgObject*> &objects)
+{
+    if (item && SCgObject::isSCgObjectType(item->type()))
+        objects.insert(static_cast<SCgObject*>(item));
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <QUndoCommand>
+#include <QSet>
 #include "../scgscene.h"
 
 class SCgObject;
@@ -26,7 +27,40 @@ public:
       */
     QGraphicsScene *getScene() const;
 
+    /*! Get approximate amount of memory used by command.
+      It includes memory of objects, that are kept alive only by this command
+      (for example deleted objects), and memory of all child commands.
+      @return Memory size in bytes.
+      */
+    virtual qint64 memoryUsage() const;
+
+    /*! Release memory-heavy parts of objects, that are kept alive only by this command.
+      They will be restored, when undo/redo reaches command.
+      Default implementation compacts child commands.
+      @see SCgObject::compact
+      */
+    virtual void compact();
+
+    //! Check if command (or any of its child commands) is compacted
+    virtual bool isCompacted() const;
+
+    /*! Collect objects, that command (or any of its child commands) refers to.
+      They must not be destroyed while command is in undo stack.
+      Default implementation collects object of command and objects of child commands.
+      @see SCgSceneVirtualizer
+      */
+    virtual void collectObjects(QSet<SCgObject*> &objects) const;
+
+    /*! Get approximate amount of memory used by command.
+      @param cmd Pointer to command. If it isn't sc.g-command, then only size of command
+                 and its childs will be counted.
+      */
+    static qint64 commandMemoryUsage(const QUndoCommand *cmd);
+
 protected:
+    //! Adds @p item to @p objects, if it's sc.g-object.
+    static void addObject(QGraphicsItem *item, QSet<SCgObject*> &objects);
+
     //! Pointer to scene that used for command working
     SCgScene *mScene;
     //! Pointer to object that command affects to
@@ -0,0 +1,158 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgcommandapplypositions.h"
+
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+
+SCgCommandApplyPositions::SCgCommandApplyPositions(SCgScene *scene,
+                                                   QUndoCommand *parent)
+        : SCgBaseCommand(scene, 0, parent)
+{
+    setText(QObject::tr("Apply positions"));
+}
+
+SCgCommandApplyPositions::~SCgCommandApplyPositions()
+{
+}
+
+void SCgCommandApplyPositions::addPosition(SCgObject *obj, const QPointF &newPos)
+{
+    Q_ASSERT_X(obj != 0,
+               "void SCgCommandApplyPositions::addPosition(SCgObject *obj, const QPointF &newPos)",
+               "Pointer to object is null");
+
+    Change change;
+    change.object = obj;
+    change.isPoints = false;
+    change.oldPos = obj->pos();
+    change.newPos = newPos;
+    change.isPair = false;
+    change.oldBeginDot = 0;
+    change.oldEndDot = 0;
+
+    mChanges.append(change);
+}
+
+void SCgCommandApplyPositions::addPoints(SCgPointObject *obj, const QVector<QPointF> &newPoints)
+{
+    Q_ASSERT_X(obj != 0,
+               "void SCgCommandApplyPositions::addPoints(SCgPointObject *obj, const QVector<QPointF> &newPoints)",
+               "Pointer to object is null");
+
+    Change change;
+    change.object = obj;
+    change.isPoints = true;
+    change.oldPoints = obj->scenePoints();
+    change.newPoints = newPoints;
+    change.isPair = obj->type() == SCgPair::Type;
+    change.oldBeginDot = change.isPair ? static_cast<SCgPair*>(obj)->beginDot() : 0;
+    change.oldEndDot = change.isPair ? static_cast<SCgPair*>(obj)->endDot() : 0;
+
+    mChanges.append(change);
+}
+
+bool SCgCommandApplyPositions::isEmpty() const
+{
+    return mChanges.isEmpty();
+}
+
+qint64 SCgCommandApplyPositions::memoryUsage() const
+{
+    qint64 size = SCgBaseCommand::memoryUsage();
+    foreach (const Change &change, mChanges)
+        size += sizeof(Change) + (change.oldPoints.size() + change.newPoints.size()) * sizeof(QPointF);
+
+    return size;
+}
+
+void SCgCommandApplyPositions::redo()
+{
+    SCgBaseCommand::redo();
+    apply(true);
+}
+
+void SCgCommandApplyPositions::undo()
+{
+    apply(false);
+    SCgBaseCommand::undo();
+}
+
+void SCgCommandApplyPositions::apply(bool forward)
+{
+    if (mChanges.isEmpty())
+        return;
+
+    bool wasSuspended = mScene->isGeometryPropagationSuspended();
+    mScene->setGeometryPropagationSuspended(true);
+
+    // apply changes
+    for (int i = 0; i < mChanges.size(); ++i)
+    {
+        const Change &change = mChanges.at(forward ? i : mChanges.size() - i - 1);
+
+        if (!change.isPoints)
+        {
+            change.object->setPos(forward ? change.newPos : change.oldPos);
+            continue;
+        }
+
+        SCgPointObject *pointObj = static_cast<SCgPointObject*>(change.object);
+        pointObj->setPoints(forward ? change.newPoints : change.oldPoints);
+        if (!forward && change.isPair)
+        {
+            static_cast<SCgPair*>(pointObj)->setBeginDot(change.oldBeginDot);
+            static_cast<SCgPair*>(pointObj)->setEndDot(change.oldEndDot);
+        }
+    }
+
+    // collect objects, that need to be rebuilt
+    QSet<SCgObject*> affected;
+    foreach (const Change &change, mChanges)
+        collectAffected(change.object, affected);
+
+    QList<SCgObject*> alive;
+    foreach (SCgObject *obj, affected)
+        if (!obj->isDead())
+            alive.append(obj);
+
+    // rebuild each of them once, objects they depend on are already rebuilt
+    mScene->rebuildGeometry(alive);
+
+    mScene->setGeometryPropagationSuspended(wasSuspended);
+}
+
+void SCgCommandApplyPositions::collectAffected(SCgObject *obj, QSet<SCgObject*> &affected) const
+{
+    if (!obj || affected.contains(obj))
+        return;
+
+    affected.insert(obj);
+
+    foreach (SCgObject *connected, obj->connectedObjects())
+        collectAffected(connected, affected);
+
+    if (obj->type() == SCgNode::Type)
+        collectAffected(static_cast<SCgNode*>(obj)->bus(), affected);
+
+    // child objects are moved with their parent
+    foreach (QGraphicsItem *item, obj->childItems())
+    {
+        if (SCgObject::isSCgObjectType(item->type()))
+            collectAffected(static_cast<SCgObject*>(item), affected);
+    }
+}
+
+void SCgCommandApplyPositions::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    foreach (const Change &change, mChanges)
+        addObject(change.object, objects);
+}
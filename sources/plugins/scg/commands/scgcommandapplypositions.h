@@ -0,0 +1,87 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "scgbasecommand.h"
+
+#include <QVector>
+#include <QPointF>
+#include <QSet>
+
+class SCgPointObject;
+
+/*! Applies positions and points of a lot of objects at once.
+  Geometry propagation on scene is suspended while changes are applied, so connected
+  objects aren't rebuilt after each change. When all changes are applied, every affected
+  pair, bus and contour is rebuilt exactly once (in order of their dependencies).
+  It's used by arrangers instead of a chain of SCgCommandObjectMove and SCgCommandPointsChange.
+  */
+class SCgCommandApplyPositions : public SCgBaseCommand
+{
+public:
+    /*! Constructor
+      @param    scene       Pointer to SCgScene that will be used for command working
+      @param    parent      Pointer to parent command. @see QUndoCommand()
+      */
+    explicit SCgCommandApplyPositions(SCgScene *scene,
+                                      QUndoCommand *parent = 0);
+    virtual ~SCgCommandApplyPositions();
+
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
+    /*! Add new position for object. Current object position will be used on undo.
+      @param    obj     Pointer to object that will be moved
+      @param    newPos  New object position (in parent coordinates)
+      */
+    void addPosition(SCgObject *obj, const QPointF &newPos);
+
+    /*! Add new points for object. Current object points will be used on undo.
+      @param    obj         Pointer to object that will be changed
+      @param    newPoints   Points will be set
+      */
+    void addPoints(SCgPointObject *obj, const QVector<QPointF> &newPoints);
+
+    //! @return true, if there are no changes in command
+    bool isEmpty() const;
+
+    //! @see SCgBaseCommand::memoryUsage
+    qint64 memoryUsage() const;
+
+protected:
+    void redo();
+    void undo();
+
+private:
+    //! Change of one object
+    struct Change
+    {
+        SCgObject *object;
+        bool isPoints;
+        QPointF oldPos;
+        QPointF newPos;
+        QVector<QPointF> oldPoints;
+        QVector<QPointF> newPoints;
+        bool isPair;
+        double oldBeginDot;
+        double oldEndDot;
+    };
+
+    /*! Apply changes in forward (redo) or backward (undo) order
+      and rebuild affected objects.
+      */
+    void apply(bool forward);
+
+    /*! Collect objects, whose geometry depends on geometry of @p obj.
+      @param    obj         Pointer to changed object
+      @param    affected    Set of already collected objects
+      */
+    void collectAffected(SCgObject *obj, QSet<SCgObject*> &affected) const;
+
+    //! List of changes in order they were added
+    QList<Change> mChanges;
+};
@@ -43,3 +43,11 @@ void SCgCommandChangeIncedentObject::undo()
     static_cast<SCgPointObject*>(mObject)->changeIncidentObject(mOldObject, mOldPoint, mRole);
 }
 
+
+void SCgCommandChangeIncedentObject::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    addObject(mOldObject, objects);
+    addObject(mNewObject, objects);
+}
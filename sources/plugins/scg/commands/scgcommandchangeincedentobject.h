@@ -30,6 +30,9 @@ public:
 
     virtual ~SCgCommandChangeIncedentObject();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     void redo();
     void undo();
@@ -50,3 +50,10 @@ void SCgCommandContentChange::undo()
         mNode->showContent();
 }
 
+
+void SCgCommandContentChange::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    addObject(mNode, objects);
+}
@@ -21,6 +21,9 @@ public:
                                      QUndoCommand *parent = 0);
     virtual ~SCgCommandContentChange();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -111,3 +111,18 @@ void SCgCommandAllContentVisibility::undo()
     mUnchangedNodeList.clear();
     SCgBaseCommand::undo();
 }
+
+void SCgCommandContentVisibility::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    addObject(mNode, objects);
+}
+
+void SCgCommandAllContentVisibility::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    foreach (SCgNode *node, mUnchangedNodeList)
+        addObject(node, objects);
+}
@@ -24,6 +24,9 @@ public:
     //! Destructor
     virtual ~SCgCommandContentVisibility();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -48,6 +51,9 @@ public:
     //! Destructor
     virtual ~SCgCommandAllContentVisibility();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -65,3 +65,11 @@ void SCgCommandCreateBus::undo()
 
     SCgBaseCommand::undo();
 }
+
+void SCgCommandCreateBus::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    addObject(mOwner, objects);
+    addObject(mParentContour, objects);
+}
@@ -84,3 +84,12 @@ void SCgCommandCreateContour::undo()
 
     SCgBaseCommand::undo();
 }
+
+void SCgCommandCreateContour::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    foreach (QGraphicsItem *item, mChildObjects)
+        addObject(item, objects);
+    addObject(mParentContour, objects);
+}
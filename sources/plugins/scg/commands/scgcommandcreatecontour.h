@@ -31,6 +31,9 @@ public:
     //! Destructor
     virtual ~SCgCommandCreateContour();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -62,3 +62,10 @@ void SCgCommandCreateNode::redo()
 
     SCgBaseCommand::redo();
 }
+
+void SCgCommandCreateNode::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    addObject(mParentContour, objects);
+}
@@ -28,6 +28,9 @@ public:
     //! Destructor
     virtual ~SCgCommandCreateNode();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -70,3 +70,12 @@ void SCgCommandCreatePair::undo()
 
     SCgBaseCommand::undo();
 }
+
+void SCgCommandCreatePair::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    addObject(mBeginObject, objects);
+    addObject(mEndObject, objects);
+    addObject(mParentContour, objects);
+}
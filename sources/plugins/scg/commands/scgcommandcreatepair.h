@@ -32,6 +32,9 @@ public:
     //! Destructor
     virtual ~SCgCommandCreatePair();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -60,3 +60,12 @@ void SCgCommandDeleteContour::undo()
         item->setParentItem(mContour);
     }
 }
+
+void SCgCommandDeleteContour::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    addObject(mContour, objects);
+    foreach (QGraphicsItem *item, mChilds)
+        addObject(item, objects);
+}
@@ -24,6 +24,9 @@ public:
     //! Destructor
     virtual ~SCgCommandDeleteContour();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -6,6 +6,7 @@
 
 #include "scgcommandidtfmove.h"
 #include "scgtextitem.h"
+#include "scgobject.h"
 
 SCgCommandIdtfMove::SCgCommandIdtfMove(SCgObject *obj,
                                        SCgScene *scene,
@@ -39,3 +40,11 @@ void SCgCommandIdtfMove::undo()
         mObject->setIdtfPos(mOldPosition);
     SCgBaseCommand::undo();
 }
+
+void SCgCommandIdtfMove::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    // command has its own object pointer
+    addObject(mObject, objects);
+}
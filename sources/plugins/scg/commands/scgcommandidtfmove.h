@@ -30,6 +30,9 @@ public:
 
     //! Destructor
     virtual ~SCgCommandIdtfMove();
+
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
 protected:
     //! @copydoc QUndoCommand::redo
     void redo();
@@ -15,6 +15,7 @@ SCgCommandInsert::SCgCommandInsert(SCgScene *scene,
     : SCgBaseCommand(scene, 0, parent)
     , mList(objList)
     , mParent(parentContour)
+    , mIsCompacted(false)
 {
     foreach(SCgObject* obj, mList)
         connect(obj, SIGNAL(destroyed(QObject*)), this, SLOT(objectFromListDestroyed(QObject*)));
@@ -38,6 +39,13 @@ void SCgCommandInsert::redo()
     SCgBaseCommand::redo();
 
     QList<SCgObject*>::iterator it;
+    if (mIsCompacted)
+    {
+        for (it = mList.begin(); it != mList.end(); ++it)
+            (*it)->expand();
+        mIsCompacted = false;
+    }
+
     for (it = mList.begin(); it != mList.end(); ++it)
     {
         SCgObject *object = *it;
@@ -64,3 +72,51 @@ void SCgCommandInsert::undo()
 
     SCgBaseCommand::undo();
 }
+
+qint64 SCgCommandInsert::memoryUsage() const
+{
+    qint64 size = SCgBaseCommand::memoryUsage();
+    size += sizeof(SCgCommandInsert) - sizeof(SCgBaseCommand);
+
+    // inserted objects are owned by command while insertion is undone
+    foreach(SCgObject *object, mList)
+    {
+        if (object->isDead())
+            size += object->memoryUsage();
+    }
+
+    return size;
+}
+
+void SCgCommandInsert::compact()
+{
+    SCgBaseCommand::compact();
+
+    if (mIsCompacted || mList.isEmpty())
+        return;
+
+    foreach(SCgObject *object, mList)
+    {
+        if (!object->isDead())
+            return;
+    }
+
+    foreach(SCgObject *object, mList)
+        object->compact();
+
+    mIsCompacted = true;
+}
+
+bool SCgCommandInsert::isCompacted() const
+{
+    return mIsCompacted || SCgBaseCommand::isCompacted();
+}
+
+void SCgCommandInsert::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    foreach (SCgObject *obj, mList)
+        addObject(obj, objects);
+    addObject(mParent, objects);
+}
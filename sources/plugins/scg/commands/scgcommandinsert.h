@@ -28,6 +28,16 @@ public:
     //! Destructor
     virtual ~SCgCommandInsert();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
+    //! @see SCgBaseCommand::memoryUsage
+    qint64 memoryUsage() const;
+    //! @see SCgBaseCommand::compact
+    void compact();
+    //! @see SCgBaseCommand::isCompacted
+    bool isCompacted() const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -37,6 +47,8 @@ protected:
     QList<SCgObject*> mList;
     //! Parent contour
     SCgContour* mParent;
+    //! Flag that shows if inserted objects are compacted
+    bool mIsCompacted;
 private slots:
 
     void objectFromListDestroyed(QObject* obj);
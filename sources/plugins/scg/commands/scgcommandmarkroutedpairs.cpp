@@ -0,0 +1,57 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgcommandmarkroutedpairs.h"
+
+#include "scgpair.h"
+#include "scgpairrouter.h"
+
+SCgCommandMarkRoutedPairs::SCgCommandMarkRoutedPairs(SCgScene *scene,
+                                                     const QList<SCgPair*> &pairs,
+                                                     bool routed,
+                                                     QUndoCommand *parent)
+        : SCgBaseCommand(scene, 0, parent)
+        , mRouted(routed)
+{
+    setText(QObject::tr("Mark routed pairs"));
+
+    foreach (SCgPair *pair, pairs)
+        mOldFlags.insert(pair, false);
+}
+
+SCgCommandMarkRoutedPairs::~SCgCommandMarkRoutedPairs()
+{
+}
+
+void SCgCommandMarkRoutedPairs::redo()
+{
+    SCgBaseCommand::redo();
+
+    // flags are taken on every redo, they can be changed by other commands meanwhile
+    QMap<SCgPair*, bool>::iterator it;
+    for (it = mOldFlags.begin(); it != mOldFlags.end(); ++it)
+    {
+        it.value() = mScene->pairRouter()->isRouted(it.key());
+        mScene->pairRouter()->setRouted(it.key(), mRouted);
+    }
+}
+
+void SCgCommandMarkRoutedPairs::undo()
+{
+    QMap<SCgPair*, bool>::const_iterator it;
+    for (it = mOldFlags.constBegin(); it != mOldFlags.constEnd(); ++it)
+        mScene->pairRouter()->setRouted(it.key(), it.value());
+
+    SCgBaseCommand::undo();
+}
+
+void SCgCommandMarkRoutedPairs::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    foreach (SCgPair *pair, mOldFlags.keys())
+        addObject(pair, objects);
+}
@@ -0,0 +1,46 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "scgbasecommand.h"
+
+#include <QMap>
+
+class SCgPair;
+
+/*! Marks pairs as routed automatically (or not routed). Flags of pairs before redo
+  are restored on undo, so undone routing doesn't leave pairs rerouted on moves.
+  @see SCgPairRouter::setRouted
+  */
+class SCgCommandMarkRoutedPairs : public SCgBaseCommand
+{
+public:
+    /*! Constructor
+      @param    scene       Pointer to SCgScene that will be used for command working
+      @param    pairs       List of pairs to mark
+      @param    routed      Flag, that will be set to pairs
+      @param    parent      Pointer to parent command. @see QUndoCommand()
+      */
+    explicit SCgCommandMarkRoutedPairs(SCgScene *scene,
+                                       const QList<SCgPair*> &pairs,
+                                       bool routed,
+                                       QUndoCommand *parent = 0);
+    virtual ~SCgCommandMarkRoutedPairs();
+
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
+protected:
+    void redo();
+    void undo();
+
+private:
+    //! Pairs with their flags before redo
+    QMap<SCgPair*, bool> mOldFlags;
+    //! Flag, that is set on redo
+    bool mRouted;
+};
@@ -11,6 +11,7 @@ SCgCommandObjectDelete::SCgCommandObjectDelete(SCgScene *scene,
                                                SCgObject *object,
                                                QUndoCommand *parent)
         : SCgBaseCommand(scene, object, parent)
+        , mIsCompacted(false)
 {
     setText(QObject::tr("Delete object"));
 }
@@ -50,6 +51,13 @@ void SCgCommandObjectDelete::undo()
     SCgBaseCommand::undo();
 
     QList<SCgObject*>::iterator it;
+    if (mIsCompacted)
+    {
+        for (it = mDelList.begin(); it != mDelList.end(); ++it)
+            (*it)->expand();
+        mIsCompacted = false;
+    }
+
     for (it = mDelList.begin(); it != mDelList.end(); ++it)
     {
         SCgObject *object = *it;
@@ -65,3 +73,52 @@ void SCgCommandObjectDelete::undo()
     }
 
 }
+
+qint64 SCgCommandObjectDelete::memoryUsage() const
+{
+    qint64 size = SCgBaseCommand::memoryUsage();
+    size += sizeof(SCgCommandObjectDelete) - sizeof(SCgBaseCommand);
+
+    // deleted objects are owned by command until they will be restored
+    foreach(SCgObject *object, mDelList)
+    {
+        if (object->isDead())
+            size += object->memoryUsage();
+    }
+
+    return size;
+}
+
+void SCgCommandObjectDelete::compact()
+{
+    SCgBaseCommand::compact();
+
+    if (mIsCompacted || mDelList.isEmpty())
+        return;
+
+    foreach(SCgObject *object, mDelList)
+    {
+        if (!object->isDead())
+            return;
+    }
+
+    foreach(SCgObject *object, mDelList)
+        object->compact();
+
+    mIsCompacted = true;
+}
+
+bool SCgCommandObjectDelete::isCompacted() const
+{
+    return mIsCompacted || SCgBaseCommand::isCompacted();
+}
+
+void SCgCommandObjectDelete::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    foreach (SCgObject *obj, mDelList)
+        addObject(obj, objects);
+    foreach (QGraphicsItem *parent, mParents)
+        addObject(parent, objects);
+}
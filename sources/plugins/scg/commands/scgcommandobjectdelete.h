@@ -24,6 +24,16 @@ public:
     //! Destructor
     virtual ~SCgCommandObjectDelete();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
+    //! @see SCgBaseCommand::memoryUsage
+    qint64 memoryUsage() const;
+    //! @see SCgBaseCommand::compact
+    void compact();
+    //! @see SCgBaseCommand::isCompacted
+    bool isCompacted() const;
+
 protected:
     //! @see    QUndoCommand::redo
     void redo();
@@ -33,6 +43,8 @@ protected:
     QList<SCgObject*> mDelList;
     //! Map of parent objects
     QMap<SCgObject*, QGraphicsItem*> mParents;
+    //! Flag that shows if deleted objects are compacted
+    bool mIsCompacted;
 };
 
 
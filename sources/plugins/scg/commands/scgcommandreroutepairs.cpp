@@ -0,0 +1,67 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgcommandreroutepairs.h"
+
+#include "scgpair.h"
+#include "scgpairrouter.h"
+
+SCgCommandReroutePairs::SCgCommandReroutePairs(SCgScene *scene,
+                                               const QList<SCgPair*> &pairs,
+                                               QUndoCommand *parent)
+        : SCgBaseCommand(scene, 0, parent)
+        , mPairs(pairs)
+        , mIsCalculated(false)
+{
+    setText(QObject::tr("Route pairs"));
+}
+
+SCgCommandReroutePairs::~SCgCommandReroutePairs()
+{
+}
+
+void SCgCommandReroutePairs::redo()
+{
+    SCgBaseCommand::redo();
+
+    if (!mIsCalculated)
+    {
+        foreach (SCgPair *pair, mPairs)
+        {
+            mOldPoints.insert(pair, pair->scenePoints());
+            mOldDots.insert(pair, qMakePair(pair->beginDot(), pair->endDot()));
+        }
+
+        mNewPoints = mScene->pairRouter()->route(mPairs);
+        mIsCalculated = true;
+    }
+
+    QMap<SCgPair*, QVector<QPointF> >::const_iterator it;
+    for (it = mNewPoints.constBegin(); it != mNewPoints.constEnd(); ++it)
+        it.key()->setPoints(it.value());
+}
+
+void SCgCommandReroutePairs::undo()
+{
+    QMap<SCgPair*, QVector<QPointF> >::const_iterator it;
+    for (it = mOldPoints.constBegin(); it != mOldPoints.constEnd(); ++it)
+    {
+        SCgPair *pair = it.key();
+        pair->setPoints(it.value());
+        pair->setBeginDot(mOldDots.value(pair).first);
+        pair->setEndDot(mOldDots.value(pair).second);
+    }
+
+    SCgBaseCommand::undo();
+}
+
+void SCgCommandReroutePairs::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    foreach (SCgPair *pair, mPairs)
+        addObject(pair, objects);
+}
@@ -0,0 +1,51 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "scgbasecommand.h"
+
+#include <QMap>
+
+class SCgPair;
+
+/*! Recalculates routes of automatically routed pairs.
+  It's used as a child of commands, that move pair ends: routes are calculated on the first
+  redo (when ends are already moved), then calculated points are reused by next redo calls.
+  @see SCgPairRouter
+  */
+class SCgCommandReroutePairs : public SCgBaseCommand
+{
+public:
+    /*! Constructor
+      @param    scene       Pointer to SCgScene that will be used for command working
+      @param    pairs       List of pairs to reroute
+      @param    parent      Pointer to parent command. @see QUndoCommand()
+      */
+    explicit SCgCommandReroutePairs(SCgScene *scene,
+                                    const QList<SCgPair*> &pairs,
+                                    QUndoCommand *parent = 0);
+    virtual ~SCgCommandReroutePairs();
+
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
+protected:
+    void redo();
+    void undo();
+
+private:
+    //! Pairs to reroute
+    QList<SCgPair*> mPairs;
+    //! Flag, that routes are already calculated
+    bool mIsCalculated;
+    //! Points of pairs before rerouting
+    QMap<SCgPair*, QVector<QPointF> > mOldPoints;
+    //! Begin and end dots of pairs before rerouting
+    QMap<SCgPair*, QPair<float, float> > mOldDots;
+    //! Calculated points of pairs
+    QMap<SCgPair*, QVector<QPointF> > mNewPoints;
+};
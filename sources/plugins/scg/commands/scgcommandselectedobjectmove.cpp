@@ -66,6 +66,8 @@ void SCgCommandSelectedObjectMove::redo()
 
 void SCgCommandSelectedObjectMove::undo()
 {
+    SCgBaseCommand::undo();
+
     SCgScene::ObjectUndoInfo::ConstIterator const_it = mUndoInfo.begin();
     while(const_it != mUndoInfo.end())
     {
@@ -74,3 +76,16 @@ void SCgCommandSelectedObjectMove::undo()
         ++const_it;
     }
 }
+
+void SCgCommandSelectedObjectMove::collectObjects(QSet<SCgObject*> &objects) const
+{
+    SCgBaseCommand::collectObjects(objects);
+
+    SCgScene::ObjectUndoInfo::const_iterator it;
+    for (it = mUndoInfo.constBegin(); it != mUndoInfo.constEnd(); ++it)
+    {
+        addObject(it.key(), objects);
+        addObject(it.value().first.first, objects);
+        addObject(it.value().second.first, objects);
+    }
+}
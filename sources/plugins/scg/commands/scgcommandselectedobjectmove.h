@@ -21,6 +21,9 @@ public:
                                       QUndoCommand *parent = 0 );
     virtual ~SCgCommandSelectedObjectMove();
 
+    //! @see SCgBaseCommand::collectObjects
+    void collectObjects(QSet<SCgObject*> &objects) const;
+
     int id() const
     {
         return 1;
@@ -0,0 +1,109 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "gwbfileloader.h"
+
+#include "scgdefaultobjectbuilder.h"
+#include "scgscenevirtualizer.h"
+#include "gwbobjectinforeader.h"
+#include "scgscene.h"
+#include "scglazycontent.h"
+#include "trace.h"
+
+#include <QMessageBox>
+#include <QApplication>
+#include <QFile>
+
+GwbFileLoader::GwbFileLoader()
+{
+}
+
+GwbFileLoader::~GwbFileLoader()
+{
+}
+
+void GwbFileLoader::showLastError()
+{
+    QMessageBox::information(0, qAppName(), QObject::tr("Error while opening file %1\n").arg(mFileName) + mLastError);
+}
+
+bool GwbFileLoader::load(QString fileName, QObject *output)
+{
+    KBE_TRACE_SCOPE("io", "gwb.load", fileName);
+    SCgScene *scene = qobject_cast<SCgScene*>(output);
+
+    mFileName = fileName;
+    mLastError.clear();
+
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+    {
+        mLastError = file.errorString();
+        showLastError();
+        return false;
+    }
+
+    /////////////////////////////////////////////
+    // Read document
+    GwbObjectInfoReader reader;
+    uchar *data = file.map(0, file.size());
+    if (!data)
+    {
+        mLastError = file.errorString();
+        showLastError();
+        return false;
+    }
+
+    // binary contents stay in file until they are needed
+    bool res;
+    {
+        KBE_TRACE_SCOPE("io", "gwb.read");
+        res = reader.read(data, file.size(), SCgContentSource::open(fileName));
+    }
+    file.unmap(data);
+
+    if (!res)
+    {
+        mLastError = reader.lastError();
+        showLastError();
+        return false;
+    }
+    /////////////////////////////////////////////
+    /////////////////////////////////////////////
+    //Place objects to scene
+    if (scene && SCgSceneVirtualizer::isNeeded(AbstractSCgObjectBuilder::objectCount(reader.objectsInfo())))
+    {
+        // items of huge sheet are created only near viewport
+        scene->setVirtualModel(GwfSceneSnapshot::fromInfo(reader.objectsInfo()));
+        return true;
+    }
+
+    DefaultSCgObjectBuilder objectBuilder(scene);
+    objectBuilder.buildObjects(reader.objectsInfo());
+    if (objectBuilder.hasErrors())
+    {
+        mLastError = QObject::tr("Building process has finished with following errors:\n");
+        foreach(const QString& str, objectBuilder.errorList())
+            mLastError += str + '\n';
+
+        showLastError();
+    }
+    /////////////////////////////////////////////
+
+    return true;
+}
+
+QStringList GwbFileLoader::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "gwb";
+    return res;
+}
+
+const QString& GwbFileLoader::lastError() const
+{
+    return mLastError;
+}
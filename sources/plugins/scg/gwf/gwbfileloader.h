@@ -0,0 +1,46 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QObject>
+
+#include "interfaces/fileloaderinterface.h"
+
+//! Loads scene from binary companion of gwf format. @see gwbformat.h
+/*! File is mapped into memory, so records are read without parsing.
+  */
+class GwbFileLoader : public FileLoaderInterface
+{
+public:
+    GwbFileLoader();
+    virtual ~GwbFileLoader();
+
+    /*! Loads gwb format.
+      @param fileName Name of file.
+      @param output scg-editor scene.
+
+      @return If file loaded, then return true, else - false.
+      */
+    bool load(QString fileName, QObject *output);
+
+    //! @copydoc FileLoaderInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+
+    //! @copydoc FileLoaderInterface::lastError
+    const QString& lastError() const;
+
+    /*! Show last error
+      */
+    void showLastError();
+
+private:
+    //! File name
+    QString mFileName;
+    //! Last error
+    QString mLastError;
+};
+
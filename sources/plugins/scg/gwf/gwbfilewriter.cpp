@@ -0,0 +1,337 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "gwbfilewriter.h"
+#include "scgscene.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+#include "scglazycontent.h"
+#include "scgblobstore.h"
+#include "trace.h"
+
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QApplication>
+
+#include <string.h>
+
+//! @return Number of padding bytes, that aligns \p size by GWB_ALIGNMENT.
+static quint64 gwbPadding(quint64 size)
+{
+    return (GWB_ALIGNMENT - size % GWB_ALIGNMENT) % GWB_ALIGNMENT;
+}
+
+//! Writes data and padding after it.
+static bool gwbWriteAligned(QIODevice *device, const char *data, quint64 size)
+{
+    static const char zeros[GWB_ALIGNMENT] = {0};
+
+    if (size > 0 && device->write(data, size) != (qint64)size)
+        return false;
+
+    quint64 padding = gwbPadding(size);
+    return padding == 0 || device->write(zeros, padding) == (qint64)padding;
+}
+
+template <typename T>
+static bool gwbWriteVector(QIODevice *device, const QVector<T> &vec)
+{
+    return gwbWriteAligned(device, reinterpret_cast<const char*>(vec.constData()), sizeof(T) * vec.size());
+}
+
+GwbFileWriter::GwbFileWriter()
+    : mBlobDataSize(0)
+{
+}
+
+GwbFileWriter::~GwbFileWriter()
+{
+}
+
+bool GwbFileWriter::save(QString fileName, QObject *input)
+{
+#ifndef SCG_NO_SCENE
+    SCgScene *scene = qobject_cast<SCgScene*>(input);
+
+    if (!save(fileName, GwfSceneSnapshot::capture(scene)))
+    {
+        QMessageBox::warning(0, qAppName(), mLastError);
+        return false;
+    }
+
+    return true;
+#else
+    Q_UNUSED(fileName);
+    Q_UNUSED(input);
+    return false;
+#endif
+}
+
+bool GwbFileWriter::save(const QString &fileName, const GwfSceneSnapshot &snapshot, QAtomicInt *written)
+{
+    KBE_TRACE_SCOPE("io", "gwb.save", fileName);
+    mLastError.clear();
+
+    QSaveFile fileOut(fileName);
+    if (!fileOut.open(QFile::WriteOnly))
+    {
+        mLastError = QObject::tr("File saving error.\nCannot write file %1:\n%2.")
+                     .arg(fileName)
+                     .arg(fileOut.errorString());
+        return false;
+    }
+
+    collect(snapshot, written);
+    bool result = write(&fileOut);
+    clear();
+
+    // lazy contents must not refer to the file, that is going to be replaced
+    if (result)
+        SCgContentSource::detachFile(fileName);
+
+    // replaces target file only if everything was written
+    if (!result || !fileOut.commit())
+    {
+        mLastError = QObject::tr("File saving error.\nCannot write file %1:\n%2.")
+                     .arg(fileName)
+                     .arg(fileOut.errorString());
+        return false;
+    }
+
+    return true;
+}
+
+QStringList GwbFileWriter::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "gwb";
+    return res;
+}
+
+const QString& GwbFileWriter::lastError() const
+{
+    return mLastError;
+}
+
+void GwbFileWriter::collect(const GwfSceneSnapshot &snapshot, QAtomicInt *written)
+{
+    clear();
+
+    // string 0 is always empty
+    addString(QString());
+
+    int count = 0;
+    foreach (const GwfObjectSnapshot &obj, snapshot.objects())
+    {
+        switch (obj.type)
+        {
+        case SCgNode::Type:
+        {
+            GwbNode rec;
+            fillObject(rec.object, obj);
+            rec.x = obj.pos.x();
+            rec.y = obj.pos.y();
+            rec.idtfPos = obj.idtfPos;
+            rec.flags = (obj.haveBus ? Gwb::HaveBus : 0) | (obj.contentVisible ? Gwb::ContentVisible : 0);
+            rec.contentType = obj.contentType;
+            rec.contentMimeType = addString(obj.contentMimeType);
+            rec.contentFileName = addString(obj.contentFileName);
+            rec.content = GWB_NO_INDEX;
+
+            switch (obj.contentType)
+            {
+            case 1:
+            case 2:
+            case 3:
+            {
+                QString text = obj.contentData.toString();
+                rec.content = addBlob(QByteArray(reinterpret_cast<const char*>(text.utf16()), text.size() * sizeof(ushort)));
+                break;
+            }
+            case 4:
+            {
+                // equal contents share one blob
+                QByteArray hash = obj.contentHash();
+                if (!hash.isEmpty() && mBlobIndex.contains(hash))
+                {
+                    rec.content = mBlobIndex.value(hash);
+                    break;
+                }
+
+                if (SCgLazyContent::isLazy(obj.contentData))
+                {
+                    // raw data of not decoded content is written as is
+                    SCgLazyContent content = obj.contentData.value<SCgLazyContent>();
+                    QByteArray data = content.encodedData();
+                    if (content.encoding() == SCgLazyContent::Base64)
+                        data = QByteArray::fromBase64(data);
+                    rec.content = addBlob(data);
+                }else if (SCgBlob::isBlob(obj.contentData))
+                    rec.content = addBlob(obj.contentData.value<SCgBlob>().data());
+                else
+                    rec.content = addBlob(obj.contentData.toByteArray());
+
+                if (!hash.isEmpty())
+                    mBlobIndex.insert(hash, rec.content);
+                break;
+            }
+            }
+
+            mNodes.append(rec);
+            break;
+        }
+        case SCgPair::Type:
+        {
+            GwbPair rec;
+            fillObject(rec.object, obj);
+            rec.beginId = obj.beginId;
+            rec.endId = obj.endId;
+            rec.beginDot = obj.beginDot;
+            rec.endDot = obj.endDot;
+            rec.points = addPoints(obj.points);
+            mPairs.append(rec);
+            break;
+        }
+        case SCgBus::Type:
+        {
+            GwbBus rec;
+            fillObject(rec.object, obj);
+            rec.ownerId = obj.ownerId;
+            rec.points = addPoints(QVector<QPointF>() << obj.beginPos << obj.points << obj.endPos);
+            mBuses.append(rec);
+            break;
+        }
+        case SCgContour::Type:
+        {
+            GwbContour rec;
+            fillObject(rec.object, obj);
+            rec.points = addPoints(obj.points);
+            mContours.append(rec);
+            break;
+        }
+        }
+
+        if (written)
+            written->storeRelease(++count);
+    }
+}
+
+bool GwbFileWriter::write(QIODevice *device)
+{
+    GwbHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GWB_MAGIC, sizeof(header.magic));
+    header.version = GWB_VERSION;
+    header.byteOrderMark = GWB_BYTE_ORDER_MARK;
+
+    quint64 sizes[Gwb::SectionCount];
+    sizes[Gwb::StringIndex] = sizeof(GwbString) * mStrings.size();
+    sizes[Gwb::StringData] = sizeof(ushort) * mStringData.size();
+    sizes[Gwb::Nodes] = sizeof(GwbNode) * mNodes.size();
+    sizes[Gwb::Pairs] = sizeof(GwbPair) * mPairs.size();
+    sizes[Gwb::Buses] = sizeof(GwbBus) * mBuses.size();
+    sizes[Gwb::Contours] = sizeof(GwbContour) * mContours.size();
+    sizes[Gwb::Points] = sizeof(double) * mPoints.size();
+    sizes[Gwb::BlobIndex] = sizeof(GwbBlob) * mBlobs.size();
+    sizes[Gwb::BlobData] = mBlobDataSize;
+
+    quint64 offset = sizeof(GwbHeader) + gwbPadding(sizeof(GwbHeader));
+    for (int i = 0; i < Gwb::SectionCount; ++i)
+    {
+        header.sections[i].offset = offset;
+        header.sections[i].size = sizes[i];
+        offset += sizes[i] + gwbPadding(sizes[i]);
+    }
+
+    if (!gwbWriteAligned(device, reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        !gwbWriteVector(device, mStrings) ||
+        !gwbWriteAligned(device, reinterpret_cast<const char*>(mStringData.utf16()), sizes[Gwb::StringData]) ||
+        !gwbWriteVector(device, mNodes) ||
+        !gwbWriteVector(device, mPairs) ||
+        !gwbWriteVector(device, mBuses) ||
+        !gwbWriteVector(device, mContours) ||
+        !gwbWriteVector(device, mPoints) ||
+        !gwbWriteVector(device, mBlobs))
+        return false;
+
+    foreach (const QByteArray &data, mBlobData)
+        if (!data.isEmpty() && device->write(data) != data.size())
+            return false;
+
+    quint64 padding = gwbPadding(mBlobDataSize);
+    return padding == 0 || device->write(QByteArray(padding, 0)) == (qint64)padding;
+}
+
+void GwbFileWriter::clear()
+{
+    mStringIndex.clear();
+    mStrings.clear();
+    mStringData.clear();
+    mBlobs.clear();
+    mBlobIndex.clear();
+    mBlobData.clear();
+    mBlobDataSize = 0;
+    mPoints.clear();
+    mNodes.clear();
+    mPairs.clear();
+    mBuses.clear();
+    mContours.clear();
+}
+
+void GwbFileWriter::fillObject(GwbObject &rec, const GwfObjectSnapshot &obj)
+{
+    rec.id = obj.id;
+    rec.parentId = obj.parentId;
+    rec.typeAlias = addString(obj.typeAlias);
+    rec.idtf = addString(obj.idtf);
+    rec.shapeColor = obj.shapeColor;
+    rec.reserved = 0;
+}
+
+quint32 GwbFileWriter::addString(const QString &str)
+{
+    StringIndexHash::const_iterator it = mStringIndex.constFind(str);
+    if (it != mStringIndex.constEnd())
+        return it.value();
+
+    GwbString rec;
+    rec.offset = mStringData.size();
+    rec.size = str.size();
+
+    quint32 index = mStrings.size();
+    mStrings.append(rec);
+    mStringData.append(str);
+    mStringIndex.insert(str, index);
+
+    return index;
+}
+
+quint32 GwbFileWriter::addBlob(const QByteArray &data)
+{
+    GwbBlob rec;
+    rec.offset = mBlobDataSize;
+    rec.size = data.size();
+
+    mBlobs.append(rec);
+    mBlobData.append(data);
+    mBlobDataSize += data.size();
+
+    return mBlobs.size() - 1;
+}
+
+GwbPoints GwbFileWriter::addPoints(const QVector<QPointF> &points)
+{
+    GwbPoints res;
+    res.first = mPoints.size() / 2;
+    res.count = points.size();
+
+    foreach (const QPointF &point, points)
+        mPoints << point.x() << point.y();
+
+    return res;
+}
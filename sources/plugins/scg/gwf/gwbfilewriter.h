@@ -0,0 +1,89 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "gwbformat.h"
+#include "gwfscenesnapshot.h"
+#include "interfaces/filewriterinterface.h"
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QByteArray>
+
+class QIODevice;
+
+//! Writes scene in binary companion of gwf format. @see gwbformat.h
+class GwbFileWriter : public FileWriterInterface
+{
+public:
+    GwbFileWriter();
+    virtual ~GwbFileWriter();
+
+    /*! Saves gwb format to file.
+      @param fileName Name of file.
+      @param input scg-editor scene.
+
+      @return If file saved, then return true, else - false.
+      */
+    bool save(QString fileName, QObject *input);
+
+    /*! Saves scene snapshot to file. Works like GWFFileWriter::save for snapshots,
+      so it may be called from worker thread.
+      @param fileName Name of file.
+      @param snapshot Scene snapshot. @see GwfSceneSnapshot::capture
+      @param written If not null, then receives number of objects processed so far.
+
+      @return If file saved, then return true, else - false. @see lastError()
+      */
+    bool save(const QString &fileName, const GwfSceneSnapshot &snapshot, QAtomicInt *written = 0);
+
+    //! @copydoc FileWriterInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+
+    //! @copydoc FileWriterInterface::lastError
+    const QString& lastError() const;
+
+private:
+    //! Fills all tables from snapshot.
+    void collect(const GwfSceneSnapshot &snapshot, QAtomicInt *written);
+    //! Writes header and all tables to device.
+    bool write(QIODevice *device);
+    //! Clears all tables.
+    void clear();
+
+    void fillObject(GwbObject &rec, const GwfObjectSnapshot &obj);
+
+    //! @return Index of string in string table. Equal strings share one index.
+    quint32 addString(const QString &str);
+    //! @return Index of content in blob table.
+    quint32 addBlob(const QByteArray &data);
+    //! @return Range of added points in points table.
+    GwbPoints addPoints(const QVector<QPointF> &points);
+
+    typedef QHash<QString, quint32> StringIndexHash;
+    StringIndexHash mStringIndex;
+    QVector<GwbString> mStrings;
+    QString mStringData;
+
+    QVector<GwbBlob> mBlobs;
+    //! Blob indexes of binary contents by their SCgBlobStore hash.
+    QHash<QByteArray, quint32> mBlobIndex;
+    //! Content data is written as is, without copying it into one array.
+    QList<QByteArray> mBlobData;
+    quint64 mBlobDataSize;
+
+    QVector<double> mPoints;
+
+    QVector<GwbNode> mNodes;
+    QVector<GwbPair> mPairs;
+    QVector<GwbBus> mBuses;
+    QVector<GwbContour> mContours;
+
+    QString mLastError;
+};
+
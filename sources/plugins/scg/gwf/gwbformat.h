@@ -0,0 +1,157 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+/*! Binary companion of gwf format (*.gwb).
+ *
+ * File stores the same data as gwf document, and it is designed to be used
+ * directly from memory mapped file. It consists of header and sections,
+ * each section starts at offset aligned by GWB_ALIGNMENT:
+ * - string index: GwbString records, string 0 is always empty;
+ * - string data: UTF-16 characters of all strings;
+ * - nodes, pairs, buses, contours: arrays of fixed size records;
+ * - points: packed x, y coordinates, referenced by pairs, buses and contours;
+ * - blob index: GwbBlob records of node contents;
+ * - blob data: raw content bytes (UTF-16 characters for text contents).
+ *
+ * Values are stored in byte order of machine, that wrote the file. It can be
+ * detected by GwbHeader::byteOrderMark, files with foreign byte order are rejected.
+ */
+
+#define GWB_MAGIC           "KGWB"
+#define GWB_VERSION         1
+#define GWB_BYTE_ORDER_MARK 0x01020304u
+#define GWB_ALIGNMENT       8
+//! Blob reference of nodes without content.
+#define GWB_NO_INDEX        0xffffffffu
+
+namespace Gwb
+{
+
+//! Indexes of file sections. @see GwbHeader::sections
+enum Section
+{
+    StringIndex = 0,
+    StringData,
+    Nodes,
+    Pairs,
+    Buses,
+    Contours,
+    Points,
+    BlobIndex,
+    BlobData,
+    SectionCount
+};
+
+//! Node flags. @see GwbNode::flags
+enum NodeFlags
+{
+    HaveBus = 1,
+    ContentVisible = 2
+};
+
+}
+
+//! Section location in file.
+struct GwbSection
+{
+    quint64 offset;
+    //! Size in bytes.
+    quint64 size;
+};
+
+//! File header, that is placed at the beginning of file.
+struct GwbHeader
+{
+    char magic[4];
+    quint32 version;
+    quint32 byteOrderMark;
+    quint32 reserved;
+    GwbSection sections[Gwb::SectionCount];
+};
+
+//! String table item.
+struct GwbString
+{
+    //! Offset in characters from the beginning of string data section.
+    quint32 offset;
+    //! Size in characters.
+    quint32 size;
+};
+
+//! Content table item.
+struct GwbBlob
+{
+    //! Offset in bytes from the beginning of blob data section.
+    quint64 offset;
+    //! Size in bytes.
+    quint64 size;
+};
+
+//! Attributes common for all objects.
+struct GwbObject
+{
+    quint64 id;
+    quint64 parentId;
+    //! Type alias string index.
+    quint32 typeAlias;
+    //! Identifier string index.
+    quint32 idtf;
+    quint32 shapeColor;
+    quint32 reserved;
+};
+
+struct GwbNode
+{
+    GwbObject object;
+    double x;
+    double y;
+    qint32 idtfPos;
+    //! Combination of Gwb::NodeFlags.
+    quint32 flags;
+    qint32 contentType;
+    //! Mime type string index.
+    quint32 contentMimeType;
+    //! File name string index.
+    quint32 contentFileName;
+    //! Content blob index or GWB_NO_INDEX.
+    quint32 content;
+};
+
+//! Points range in points section. Each point is two doubles.
+struct GwbPoints
+{
+    quint32 first;
+    quint32 count;
+};
+
+struct GwbPair
+{
+    GwbObject object;
+    quint64 beginId;
+    quint64 endId;
+    double beginDot;
+    double endDot;
+    //! Break points without begin and end points.
+    GwbPoints points;
+};
+
+struct GwbBus
+{
+    GwbObject object;
+    quint64 ownerId;
+    //! All points including begin and end points.
+    GwbPoints points;
+};
+
+struct GwbContour
+{
+    GwbObject object;
+    GwbPoints points;
+};
@@ -0,0 +1,313 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "gwbobjectinforeader.h"
+
+#include <memory>
+
+#include "scgobjectsinfo.h"
+#include "scgnode.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+#include "scgpair.h"
+#include "scglazycontent.h"
+
+#include <string.h>
+
+GwbObjectInfoReader::GwbObjectInfoReader(bool isOwner)
+    : mIsOwner(isOwner)
+    , mData(0)
+    , mSize(0)
+    , mHeader(0)
+{
+}
+
+GwbObjectInfoReader::~GwbObjectInfoReader()
+{
+    if (mIsOwner)
+        del();
+}
+
+void GwbObjectInfoReader::del()
+{
+    TypeToObjectsMap::iterator it = mObjectsInfo.begin();
+    ObjectInfoList::iterator itList;
+
+    for(;it != mObjectsInfo.end(); ++it)
+    {
+        for(itList = it.value().begin(); itList != it.value().end(); ++itList)
+            delete *itList;
+        it.value().clear();
+    }
+    mObjectsInfo.clear();
+}
+
+bool GwbObjectInfoReader::read(const uchar *data, qint64 size, const QSharedPointer<SCgContentSource> &source)
+{
+    Q_ASSERT_X(quintptr(data) % GWB_ALIGNMENT == 0,
+               "bool GwbObjectInfoReader::read(const uchar *data, qint64 size, const QSharedPointer<SCgContentSource> &source)",
+               "Data must be aligned");
+
+    if (mIsOwner)
+        del();
+    mLastError.clear();
+
+    mData = data;
+    mSize = size;
+    mHeader = reinterpret_cast<const GwbHeader*>(data);
+    mSource = source;
+
+    bool res = checkHeader() && readNodes() && readPairs() && readBuses() && readContours();
+
+    // data is used only while reading
+    mData = 0;
+    mSize = 0;
+    mHeader = 0;
+    mSource.clear();
+
+    return res;
+}
+
+bool GwbObjectInfoReader::checkHeader()
+{
+    if (mSize < (qint64)sizeof(GwbHeader) || memcmp(mHeader->magic, GWB_MAGIC, sizeof(mHeader->magic)) != 0)
+    {
+        mLastError = QObject::tr("Given data has unsupported format");
+        return false;
+    }
+
+    if (mHeader->byteOrderMark != GWB_BYTE_ORDER_MARK)
+    {
+        mLastError = QObject::tr("Byte order of given data isn't supported");
+        return false;
+    }
+
+    if (mHeader->version != GWB_VERSION)
+    {
+        mLastError = QObject::tr("Version %1 of GWB files not supported.\n"
+                                 "Just %2 version supported.").arg(mHeader->version).arg(GWB_VERSION);
+        return false;
+    }
+
+    for (int i = 0; i < Gwb::SectionCount; ++i)
+    {
+        const GwbSection &s = mHeader->sections[i];
+        if (s.offset % GWB_ALIGNMENT != 0 || s.offset > quint64(mSize) || s.size > quint64(mSize) - s.offset)
+        {
+            mLastError = QObject::tr("Section %1 is out of data bounds").arg(i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const uchar* GwbObjectInfoReader::section(Gwb::Section section) const
+{
+    return mData + mHeader->sections[section].offset;
+}
+
+bool GwbObjectInfoReader::readObject(const GwbObject &rec, SCgObjectInfo *info)
+{
+    info->idRef() = QString::number(rec.id);
+    info->parentIdRef() = QString::number(rec.parentId);
+
+    return getString(rec.typeAlias, info->typeAliasRef()) && getString(rec.idtf, info->idtfValueRef());
+}
+
+bool GwbObjectInfoReader::readNodes()
+{
+    const GwbNode *nodes = reinterpret_cast<const GwbNode*>(section(Gwb::Nodes));
+    const GwbBlob *blobs = reinterpret_cast<const GwbBlob*>(section(Gwb::BlobIndex));
+    const char *blobData = reinterpret_cast<const char*>(section(Gwb::BlobData));
+    quint64 blobCount = count<GwbBlob>(Gwb::BlobIndex);
+    quint64 blobDataSize = mHeader->sections[Gwb::BlobData].size;
+
+    ObjectInfoList &list = mObjectsInfo[SCgNode::Type];
+    quint64 n = count<GwbNode>(Gwb::Nodes);
+    for (quint64 i = 0; i < n; ++i)
+    {
+        const GwbNode &rec = nodes[i];
+        std::auto_ptr<SCgNodeInfo> nodeInfo(new SCgNodeInfo());
+
+        if (!readObject(rec.object, nodeInfo.get()))
+            return false;
+
+        nodeInfo->posRef() = QPointF(rec.x, rec.y);
+        nodeInfo->idtfPosRef() = rec.idtfPos;
+        nodeInfo->haveBusRef() = (rec.flags & Gwb::HaveBus) != 0;
+        nodeInfo->contentVisibleRef() = (rec.flags & Gwb::ContentVisible) != 0;
+        nodeInfo->contentTypeRef() = rec.contentType;
+
+        if (!getString(rec.contentMimeType, nodeInfo->contentMimeTypeRef()) ||
+            !getString(rec.contentFileName, nodeInfo->contentFilenameRef()))
+            return false;
+
+        if (rec.content != GWB_NO_INDEX)
+        {
+            if (rec.content >= blobCount)
+            {
+                errorInvalidIndex("blob", rec.content);
+                return false;
+            }
+
+            const GwbBlob &blob = blobs[rec.content];
+            if (blob.offset > blobDataSize || blob.size > blobDataSize - blob.offset)
+            {
+                errorInvalidIndex("blob data", blob.offset);
+                return false;
+            }
+
+            const char *data = blobData + blob.offset;
+            if (rec.contentType == 4 && mSource)
+            {
+                // content is read from file and decoded, when it's needed
+                quint64 offset = mHeader->sections[Gwb::BlobData].offset + blob.offset;
+                SCgLazyContent content(SCgContent::Data, mSource, offset, blob.size, SCgLazyContent::Raw);
+                nodeInfo->contentDataRef() = QVariant::fromValue(content);
+            }
+            else if (rec.contentType == 4)
+                nodeInfo->contentDataRef() = QVariant(QByteArray(data, blob.size));
+            else
+            {
+                if (blob.size % sizeof(QChar) != 0)
+                {
+                    mLastError = QObject::tr("Text content %1 has odd size").arg(rec.content);
+                    return false;
+                }
+
+                // blobs aren't aligned, text may follow binary data of odd size
+                QString text(blob.size / sizeof(QChar), Qt::Uninitialized);
+                memcpy(text.data(), data, blob.size);
+                nodeInfo->contentDataRef() = QVariant(text);
+            }
+        }
+
+        list.append(nodeInfo.release());
+    }
+
+    return true;
+}
+
+bool GwbObjectInfoReader::readPairs()
+{
+    const GwbPair *pairs = reinterpret_cast<const GwbPair*>(section(Gwb::Pairs));
+
+    ObjectInfoList &list = mObjectsInfo[SCgPair::Type];
+    quint64 n = count<GwbPair>(Gwb::Pairs);
+    for (quint64 i = 0; i < n; ++i)
+    {
+        const GwbPair &rec = pairs[i];
+        std::auto_ptr<SCgPairInfo> pairInfo(new SCgPairInfo());
+
+        if (!readObject(rec.object, pairInfo.get()))
+            return false;
+
+        pairInfo->beginObjectIdRef() = QString::number(rec.beginId);
+        pairInfo->endObjectIdRef() = QString::number(rec.endId);
+        pairInfo->beginDotRef() = rec.beginDot;
+        pairInfo->endDotRef() = rec.endDot;
+
+        pairInfo->pointsRef().push_back(QPointF());
+        if (!getPoints(rec.points, pairInfo->pointsRef()))
+            return false;
+        pairInfo->pointsRef().push_back(QPointF());
+
+        list.append(pairInfo.release());
+    }
+
+    return true;
+}
+
+bool GwbObjectInfoReader::readBuses()
+{
+    const GwbBus *buses = reinterpret_cast<const GwbBus*>(section(Gwb::Buses));
+
+    ObjectInfoList &list = mObjectsInfo[SCgBus::Type];
+    quint64 n = count<GwbBus>(Gwb::Buses);
+    for (quint64 i = 0; i < n; ++i)
+    {
+        const GwbBus &rec = buses[i];
+        std::auto_ptr<SCgBusInfo> busInfo(new SCgBusInfo());
+
+        if (!readObject(rec.object, busInfo.get()))
+            return false;
+
+        busInfo->ownerIdRef() = QString::number(rec.ownerId);
+
+        if (!getPoints(rec.points, busInfo->pointsRef()))
+            return false;
+
+        list.append(busInfo.release());
+    }
+
+    return true;
+}
+
+bool GwbObjectInfoReader::readContours()
+{
+    const GwbContour *contours = reinterpret_cast<const GwbContour*>(section(Gwb::Contours));
+
+    ObjectInfoList &list = mObjectsInfo[SCgContour::Type];
+    quint64 n = count<GwbContour>(Gwb::Contours);
+    for (quint64 i = 0; i < n; ++i)
+    {
+        const GwbContour &rec = contours[i];
+        std::auto_ptr<SCgContourInfo> contourInfo(new SCgContourInfo());
+
+        if (!readObject(rec.object, contourInfo.get()))
+            return false;
+
+        if (!getPoints(rec.points, contourInfo->pointsRef()))
+            return false;
+
+        list.append(contourInfo.release());
+    }
+
+    return true;
+}
+
+bool GwbObjectInfoReader::getString(quint32 index, QString &result)
+{
+    if (index >= count<GwbString>(Gwb::StringIndex))
+    {
+        errorInvalidIndex("string", index);
+        return false;
+    }
+
+    const GwbString &rec = reinterpret_cast<const GwbString*>(section(Gwb::StringIndex))[index];
+    quint64 dataSize = count<QChar>(Gwb::StringData);
+    if (quint64(rec.offset) + rec.size > dataSize)
+    {
+        errorInvalidIndex("string data", rec.offset);
+        return false;
+    }
+
+    const QChar *data = reinterpret_cast<const QChar*>(section(Gwb::StringData));
+    result = QString(data + rec.offset, rec.size);
+    return true;
+}
+
+bool GwbObjectInfoReader::getPoints(const GwbPoints &points, QVector<QPointF> &result)
+{
+    if (quint64(points.first) + points.count > count<double>(Gwb::Points) / 2)
+    {
+        errorInvalidIndex("points", points.first);
+        return false;
+    }
+
+    const double *data = reinterpret_cast<const double*>(section(Gwb::Points)) + quint64(points.first) * 2;
+    result.reserve(result.size() + points.count + 1);
+    for (quint32 i = 0; i < points.count; ++i)
+        result.push_back(QPointF(data[i * 2], data[i * 2 + 1]));
+
+    return true;
+}
+
+void GwbObjectInfoReader::errorInvalidIndex(const QString &table, quint64 index)
+{
+    mLastError = QObject::tr("invalid reference %1 to %2 table").arg(index).arg(table);
+}
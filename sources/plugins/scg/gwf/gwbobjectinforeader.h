@@ -0,0 +1,102 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "gwbformat.h"
+
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QSharedPointer>
+
+class SCgObjectInfo;
+class SCgContentSource;
+
+//! Reads and stores SCgObjectInfo structures from gwb data. @see gwbformat.h
+//! Data isn't parsed: records are read directly from memory, so it's intended
+//! to be used with memory mapped files.
+class GwbObjectInfoReader
+{
+public:
+    typedef QList<SCgObjectInfo*>       ObjectInfoList;
+    typedef QMap<int, ObjectInfoList>   TypeToObjectsMap;
+
+    /*!
+     * @param isOwner true, if created object must delete all created structures(takes ownership).
+     */
+    GwbObjectInfoReader(bool isOwner = true);
+    virtual ~GwbObjectInfoReader();
+
+    /*! Reads info from gwb data.
+     * @param data Pointer to the beginning of data. Must be aligned by GWB_ALIGNMENT.
+     * @param size Size of data in bytes.
+     * @param source File, that holds the same data. If it's specified, then binary
+     * contents are not copied, they refer to byte ranges of that file. @see SCgLazyContent
+     * @return If read successfully returns true. @see lastError().
+     */
+    bool read(const uchar *data, qint64 size,
+              const QSharedPointer<SCgContentSource> &source = QSharedPointer<SCgContentSource>());
+
+    //! @return Last error message
+    const QString& lastError() const
+    {
+        return mLastError;
+    }
+
+    const TypeToObjectsMap& objectsInfo() const
+    {
+        return mObjectsInfo;
+    }
+
+private:
+    //! Checks header and bounds of all sections.
+    bool checkHeader();
+    //! @return Pointer to the beginning of section.
+    const uchar* section(Gwb::Section section) const;
+    //! @return Number of records of type \p T in section.
+    template <typename T>
+    quint64 count(Gwb::Section section) const
+    {
+        return mHeader->sections[section].size / sizeof(T);
+    }
+
+    bool readObject(const GwbObject &rec, SCgObjectInfo *info);
+    bool readNodes();
+    bool readPairs();
+    bool readBuses();
+    bool readContours();
+
+    /*! Gets string from string table.
+      @return If index is valid, then return true, else - false
+      */
+    bool getString(quint32 index, QString &result);
+
+    /*! Gets points from points table.
+      @return If range is valid, then return true, else - false
+      */
+    bool getPoints(const GwbPoints &points, QVector<QPointF> &result);
+
+    //! Generates last error message for invalid reference to table.
+    void errorInvalidIndex(const QString &table, quint64 index);
+
+    //! Deletes all read info.
+    void del();
+
+    //! Holds true if this object takes ownership of created info structures.
+    bool mIsOwner;
+
+    //! hold all read object info
+    TypeToObjectsMap mObjectsInfo;
+
+    QString mLastError;
+
+    const uchar *mData;
+    qint64 mSize;
+    const GwbHeader *mHeader;
+    QSharedPointer<SCgContentSource> mSource;
+};
+
@@ -0,0 +1,98 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "gwfasyncfilewriter.h"
+#include "scgscene.h"
+
+#include <QtConcurrentRun>
+#include <QFileInfo>
+
+#define GWF_PROGRESS_INTERVAL 100
+
+template <typename Writer>
+static bool saveSnapshotFn(Writer *writer, const QString &fileName,
+                           const GwfSceneSnapshot &snapshot, QAtomicInt *written)
+{
+    return writer->save(fileName, snapshot, written);
+}
+
+GWFAsyncFileWriter::GWFAsyncFileWriter(QObject *parent)
+    : QObject(parent)
+    , mIsBinary(false)
+    , mTotal(0)
+    , mProgress(0)
+{
+    mProgressTimer.setInterval(GWF_PROGRESS_INTERVAL);
+    connect(&mProgressTimer, SIGNAL(timeout()), this, SLOT(updateProgress()));
+    connect(&mWatcher, SIGNAL(finished()), this, SLOT(processFinished()));
+}
+
+GWFAsyncFileWriter::~GWFAsyncFileWriter()
+{
+    waitForFinished();
+}
+
+bool GWFAsyncFileWriter::save(const QString &fileName, SCgScene *scene)
+{
+    if (isRunning())
+        return false;
+
+    GwfSceneSnapshot snapshot = GwfSceneSnapshot::capture(scene);
+
+    mFileName = fileName;
+    mTotal = snapshot.objects().size();
+    mProgress = 0;
+    mWritten.storeRelease(0);
+
+    mIsBinary = mBinaryWriter.supportedFormatsExt().contains(QFileInfo(fileName).suffix(), Qt::CaseInsensitive);
+    if (mIsBinary)
+        mWatcher.setFuture(QtConcurrent::run(saveSnapshotFn<GwbFileWriter>, &mBinaryWriter, mFileName, snapshot, &mWritten));
+    else
+        mWatcher.setFuture(QtConcurrent::run(saveSnapshotFn<GWFFileWriter>, &mWriter, mFileName, snapshot, &mWritten));
+    mProgressTimer.start();
+
+    return true;
+}
+
+bool GWFAsyncFileWriter::isRunning() const
+{
+    return mWatcher.isRunning();
+}
+
+void GWFAsyncFileWriter::waitForFinished()
+{
+    mWatcher.waitForFinished();
+}
+
+const QString& GWFAsyncFileWriter::fileName() const
+{
+    return mFileName;
+}
+
+int GWFAsyncFileWriter::progress() const
+{
+    return mProgress;
+}
+
+void GWFAsyncFileWriter::updateProgress()
+{
+    int percent = mTotal > 0 ? mWritten.loadAcquire() * 100 / mTotal : 100;
+    if (percent != mProgress)
+    {
+        mProgress = percent;
+        emit progressChanged(mProgress);
+    }
+}
+
+void GWFAsyncFileWriter::processFinished()
+{
+    mProgressTimer.stop();
+    mProgress = 100;
+
+    bool result = mWatcher.result();
+    QString error = mIsBinary ? mBinaryWriter.lastError() : mWriter.lastError();
+    emit finished(result, result ? QString() : error);
+}
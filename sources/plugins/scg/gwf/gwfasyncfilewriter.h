@@ -0,0 +1,86 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "gwffilewriter.h"
+#include "gwbfilewriter.h"
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QTimer>
+
+class SCgScene;
+
+//! Saves scene in gwf or gwb format without blocking the editor.
+/*! Scene snapshot is captured on calling thread, then serialization, content
+    encoding and file writing run on worker thread.
+    @see GwfSceneSnapshot, GWFFileWriter, GwbFileWriter
+  */
+class GWFAsyncFileWriter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit GWFAsyncFileWriter(QObject *parent = 0);
+    //! Waits for running save to finish.
+    virtual ~GWFAsyncFileWriter();
+
+    /*! Starts saving scene.
+      @param fileName Name of file. Format is chosen by file extension.
+      @param scene scg-editor scene.
+
+      @return If saving started, then return true. If previous saving is still running, then return false.
+      */
+    bool save(const QString &fileName, SCgScene *scene);
+
+    //! @return True, if saving is in progress.
+    bool isRunning() const;
+
+    //! Blocks until running save is finished. Signal finished() will be emitted later anyway.
+    void waitForFinished();
+
+    //! @return Name of file, that is saving now or was saved last.
+    const QString& fileName() const;
+
+    //! @return Saving progress in percents.
+    int progress() const;
+
+signals:
+    //! Emits while saving, when progress changes.
+    void progressChanged(int percent);
+
+    /*! Emits when saving finished.
+      @param result If file saved, then true, else - false.
+      @param errorString Description of error, if \p result is false.
+      */
+    void finished(bool result, const QString &errorString);
+
+private slots:
+    void processFinished();
+    void updateProgress();
+
+private:
+    Q_DISABLE_COPY(GWFAsyncFileWriter)
+
+    QFutureWatcher<bool> mWatcher;
+    //! Polls progress of worker thread.
+    QTimer mProgressTimer;
+
+    //! Writers used by worker thread.
+    GWFFileWriter mWriter;
+    GwbFileWriter mBinaryWriter;
+    //! True, if running save uses gwb format.
+    bool mIsBinary;
+    //! Number of objects written by worker thread.
+    QAtomicInt mWritten;
+    //! Number of objects in snapshot.
+    int mTotal;
+    //! Last reported progress.
+    int mProgress;
+
+    QString mFileName;
+};
+
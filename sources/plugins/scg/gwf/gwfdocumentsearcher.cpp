@@ -0,0 +1,131 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "gwfdocumentsearcher.h"
+#include "gwbobjectinforeader.h"
+#include "scgobjectsinfo.h"
+#include "scgcontent.h"
+
+#include <QFileInfo>
+#include <QXmlStreamReader>
+
+GwfDocumentSearcher::GwfDocumentSearcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+GwfDocumentSearcher::~GwfDocumentSearcher()
+{
+}
+
+QStringList GwfDocumentSearcher::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "gwf" << "gwb";
+    return res;
+}
+
+SearchHitList GwfDocumentSearcher::search(const QString &fileName, const QByteArray &data,
+                                          const SearchQuery &query) const
+{
+    if (QFileInfo(fileName).suffix().compare("gwb", Qt::CaseInsensitive) == 0)
+        return searchGwb(fileName, data, query);
+    return searchGwf(fileName, data, query);
+}
+
+SearchHitList GwfDocumentSearcher::searchGwf(const QString &fileName, const QByteArray &data,
+                                             const SearchQuery &query) const
+{
+    SearchHitList res;
+
+    // content element is inside of its node, so the last object with identifier is its owner
+    SearchHit owner;
+    owner.fileName = fileName;
+    QXmlStreamReader reader(data);
+    while (!reader.atEnd())
+    {
+        if (reader.readNext() != QXmlStreamReader::StartElement)
+            continue;
+
+        QXmlStreamAttributes attrs = reader.attributes();
+        if (attrs.hasAttribute("idtf"))
+        {
+            // nodes keep scene positions, so unnamed ones can be found by them
+            owner.identifier = attrs.value("idtf").toString();
+            owner.hasObjectPos = attrs.hasAttribute("x") && attrs.hasAttribute("y");
+            owner.objectPos = owner.hasObjectPos ? QPointF(attrs.value("x").toString().toDouble(),
+                                                           attrs.value("y").toString().toDouble())
+                                                 : QPointF();
+            if (!owner.identifier.isEmpty() && query.matches(owner.identifier))
+            {
+                SearchHit hit = owner;
+                hit.line = reader.lineNumber();
+                hit.column = reader.columnNumber();
+                hit.text = owner.identifier;
+                res.append(hit);
+            }
+        }
+        else if (reader.name() == "content")
+        {
+            int type = attrs.value("type").toString().toInt();
+            if (type == SCgContent::String || type == SCgContent::Int || type == SCgContent::Real)
+                searchContent(reader, owner, query, res);
+        }
+    }
+
+    return res;
+}
+
+void GwfDocumentSearcher::searchContent(QXmlStreamReader &reader, const SearchHit &owner,
+                                        const SearchQuery &query, SearchHitList &res) const
+{
+    Qt::CaseSensitivity cs = query.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+    while (reader.readNext() == QXmlStreamReader::Characters)
+    {
+        // reader is at the end of text, so lines are counted back from it
+        QStringList lines = reader.text().toString().split('\n');
+        int firstLine = reader.lineNumber() - (lines.size() - 1);
+
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            if (!lines[i].contains(query.text, cs))
+                continue;
+
+            SearchHit hit = owner;
+            hit.line = firstLine + i;
+            hit.text = lines[i].trimmed();
+            res.append(hit);
+        }
+    }
+}
+
+SearchHitList GwfDocumentSearcher::searchGwb(const QString &fileName, const QByteArray &data,
+                                             const SearchQuery &query) const
+{
+    SearchHitList res;
+
+    GwbObjectInfoReader reader;
+    if (!reader.read(reinterpret_cast<const uchar*>(data.constData()), data.size()))
+        return res;
+
+    GwbObjectInfoReader::TypeToObjectsMap::const_iterator it;
+    for (it = reader.objectsInfo().begin(); it != reader.objectsInfo().end(); ++it)
+    {
+        foreach (SCgObjectInfo *info, it.value())
+        {
+            if (info->idtfValue().isEmpty() || !query.matches(info->idtfValue()))
+                continue;
+
+            SearchHit hit;
+            hit.fileName = fileName;
+            hit.text = info->idtfValue();
+            hit.identifier = info->idtfValue();
+            res.append(hit);
+        }
+    }
+    return res;
+}
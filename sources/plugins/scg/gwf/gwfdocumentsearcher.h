@@ -0,0 +1,43 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/documentsearcherinterface.h"
+
+#include <QObject>
+
+class QXmlStreamReader;
+
+/*! Searches gwf and gwb files for find in project. In gwf files identifiers of objects
+ * and text contents (strings and numbers) are matched, binary contents are skipped.
+ * Gwb files are searched by identifiers only.
+ */
+class GwfDocumentSearcher : public QObject,
+                            public DocumentSearcherInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(DocumentSearcherInterface)
+
+public:
+    explicit GwfDocumentSearcher(QObject *parent = 0);
+    virtual ~GwfDocumentSearcher();
+
+    //! @copydoc DocumentSearcherInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+    //! @copydoc DocumentSearcherInterface::search
+    SearchHitList search(const QString &fileName, const QByteArray &data, const SearchQuery &query) const;
+
+private:
+    SearchHitList searchGwf(const QString &fileName, const QByteArray &data, const SearchQuery &query) const;
+    SearchHitList searchGwb(const QString &fileName, const QByteArray &data, const SearchQuery &query) const;
+
+    /*! Matches text of content element, reader is moved to its end.
+      @param owner Hit of node, that has content. Its file name, identifier and position are copied to hits.
+      */
+    void searchContent(QXmlStreamReader &reader, const SearchHit &owner,
+                       const SearchQuery &query, SearchHitList &res) const;
+};
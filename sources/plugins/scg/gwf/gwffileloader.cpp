@@ -7,9 +7,11 @@
 #include "gwffileloader.h"
 
 #include "scgdefaultobjectbuilder.h"
+#include "scgscenevirtualizer.h"
 #include "gwfobjectinforeader.h"
 #include "scgobject.h"
 #include "scgscene.h"
+#include "trace.h"
 
 #include <QMessageBox>
 #include <QApplication>
@@ -38,6 +40,7 @@ void GWFFileLoader::showGeneralError()
 
 bool GWFFileLoader::load(QString file_name, QObject *output)
 {
+    KBE_TRACE_SCOPE("io", "gwf.load", file_name);
     SCgScene *scene = qobject_cast<SCgScene*>(output);
 
     // read data from file
@@ -50,14 +53,19 @@ bool GWFFileLoader::load(QString file_name, QObject *output)
 
     mFileName = file_name;
 
-    if (!document.setContent(&file, &errorStr, &errorLine, &errorColumn))
+    bool parsed;
     {
-        QMessageBox::information(0, qAppName(),
-                                 QObject::tr("Error while opening file %1.\nParse error at line %2, column %3:\n%4")
-                                 .arg(file_name)
-                                 .arg(errorLine)
-                                 .arg(errorColumn)
-                                 .arg(errorStr));
+        KBE_TRACE_SCOPE("io", "gwf.parse");
+        parsed = document.setContent(&file, &errorStr, &errorLine, &errorColumn);
+    }
+    if (!parsed)
+    {
+        mLastError = QObject::tr("Error while opening file %1.\nParse error at line %2, column %3:\n%4")
+                     .arg(file_name)
+                     .arg(errorLine)
+                     .arg(errorColumn)
+                     .arg(errorStr);
+        QMessageBox::information(0, qAppName(), mLastError);
         return false;
     }
 
@@ -65,7 +73,12 @@ bool GWFFileLoader::load(QString file_name, QObject *output)
     /////////////////////////////////////////////
     // Read document
     GwfObjectInfoReader reader;
-    if (! reader.read(document))
+    bool read;
+    {
+        KBE_TRACE_SCOPE("io", "gwf.read");
+        read = reader.read(document);
+    }
+    if (!read)
     {
         mLastError = reader.lastError();
         showLastError();
@@ -74,6 +87,13 @@ bool GWFFileLoader::load(QString file_name, QObject *output)
     /////////////////////////////////////////////
     /////////////////////////////////////////////
     //Place objects to scene
+    if (scene && SCgSceneVirtualizer::isNeeded(AbstractSCgObjectBuilder::objectCount(reader.objectsInfo())))
+    {
+        // items of huge sheet are created only near viewport
+        scene->setVirtualModel(GwfSceneSnapshot::fromInfo(reader.objectsInfo()));
+        return true;
+    }
+
     DefaultSCgObjectBuilder objectBuilder(scene);
     objectBuilder.buildObjects(reader.objectsInfo());
     if (objectBuilder.hasErrors())
@@ -89,6 +109,18 @@ bool GWFFileLoader::load(QString file_name, QObject *output)
     return true;
 }
 
+QStringList GWFFileLoader::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "gwf";
+    return res;
+}
+
+const QString& GWFFileLoader::lastError() const
+{
+    return mLastError;
+}
+
 void GWFFileLoader::errorParse()
 {
     mLastError = QObject::tr("error to parse file '%1'").arg(mFileName);
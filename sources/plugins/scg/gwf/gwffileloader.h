@@ -13,10 +13,12 @@
 #include <QPointF>
 #include <QObject>
 
+#include "interfaces/fileloaderinterface.h"
+
 class SCgScene;
 class SCgObject;
 
-class GWFFileLoader
+class GWFFileLoader : public FileLoaderInterface
 
 {
 public:
@@ -30,6 +32,12 @@ public:
       */
     bool load(QString file_name, QObject *output);
 
+    //! @copydoc FileLoaderInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+
+    //! @copydoc FileLoaderInterface::lastError
+    const QString& lastError() const;
+
     /*! Show last error
       */
     void showLastError();
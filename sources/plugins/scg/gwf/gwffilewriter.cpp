@@ -6,13 +6,11 @@
 
 #include "gwffilewriter.h"
 #include "scgscene.h"
-#include "scgnode.h"
-#include "scgpair.h"
-#include "scgbus.h"
-#include "scgcontour.h"
+#include "scglazycontent.h"
+#include "trace.h"
 
 #include <QMessageBox>
-#include <QFile>
+#include <QSaveFile>
 #include <QTextCodec>
 #include <QApplication>
 
@@ -29,32 +27,78 @@ GWFFileWriter::~GWFFileWriter()
 
 bool GWFFileWriter::save(QString file_name, QObject *input)
 {
+#ifndef SCG_NO_SCENE
     SCgScene *scene = qobject_cast<SCgScene*>(input);
 
-        QFile fileOut(file_name);
-        if (!fileOut.open(QFile::WriteOnly | QFile::Text)) {
-                 QMessageBox::warning(0, qAppName(),
-                                      QObject::tr("File saving error.\nCannot write file %1:\n%2.")
-                                      .arg(file_name)
-                                      .arg(fileOut.errorString()));
-                 return false;
-             }
-        stream.setDevice(&fileOut);
-        stream.startWriting("UTF-8");
-
-        QList<QGraphicsItem *>	items = scene->items ();
-        QGraphicsItem * item;
-        foreach (item, items)
-        {
-            if(SCgObject::isSCgObjectType(item->type()) )
-            {
-                SCgObject *obj = static_cast<SCgObject*>(item);
-                stream.writeObject(obj);
-            }
-        }
-
-        stream.finishWriting();
-
-        fileOut.close();
-        return true;
+    if (!save(file_name, GwfSceneSnapshot::capture(scene)))
+    {
+        QMessageBox::warning(0, qAppName(), mErrorString);
+        return false;
+    }
+
+    return true;
+#else
+    // there are no scenes in builds without scene items
+    Q_UNUSED(file_name);
+    Q_UNUSED(input);
+    return false;
+#endif
+}
+
+bool GWFFileWriter::save(const QString &fileName, const GwfSceneSnapshot &snapshot, QAtomicInt *written)
+{
+    KBE_TRACE_SCOPE("io", "gwf.save", fileName);
+    mErrorString.clear();
+
+    QSaveFile fileOut(fileName);
+    if (!fileOut.open(QFile::WriteOnly | QFile::Text))
+    {
+        mErrorString = QObject::tr("File saving error.\nCannot write file %1:\n%2.")
+                       .arg(fileName)
+                       .arg(fileOut.errorString());
+        return false;
+    }
+
+    stream.setDevice(&fileOut);
+    // keep version 2.0 for documents, that don't benefit from shared contents
+    stream.setContentSharing(snapshot.hasSharedContents());
+    stream.startWriting("UTF-8");
+
+    int count = 0;
+    foreach (const GwfObjectSnapshot &obj, snapshot.objects())
+    {
+        stream.writeObject(obj);
+
+        if (written)
+            written->storeRelease(++count);
+    }
+
+    stream.finishWriting();
+    stream.setDevice(0);
+
+    // lazy contents must not refer to the file, that is going to be replaced
+    SCgContentSource::detachFile(fileName);
+
+    // replaces target file only if everything was written
+    if (!fileOut.commit())
+    {
+        mErrorString = QObject::tr("File saving error.\nCannot write file %1:\n%2.")
+                       .arg(fileName)
+                       .arg(fileOut.errorString());
+        return false;
+    }
+
+    return true;
+}
+
+QStringList GWFFileWriter::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "gwf";
+    return res;
+}
+
+const QString& GWFFileWriter::lastError() const
+{
+    return mErrorString;
 }
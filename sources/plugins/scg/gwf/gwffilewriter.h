@@ -7,13 +7,15 @@
 #pragma once
 
 #include "gwfstreamwriter.h"
+#include "gwfscenesnapshot.h"
+#include "interfaces/filewriterinterface.h"
 
-//! TODO: add error messages
+#include <QAtomicInt>
 
 class SCgObject;
 class SCgNode;
 
-class GWFFileWriter
+class GWFFileWriter : public FileWriterInterface
 {
 public:
     GWFFileWriter();
@@ -27,9 +29,28 @@ public:
       */
     bool save(QString file_name, QObject *input);
 
+    /*! Saves scene snapshot to file.
+      Document is written into temporary file, that replaces \p fileName only when
+      whole document was written, so existing file is never left half-written.
+      Doesn't show any messages, so it may be called from worker thread.
+      @param fileName Name of file.
+      @param snapshot Scene snapshot. @see GwfSceneSnapshot::capture
+      @param written If not null, then receives number of objects written so far.
+
+      @return If file saved, then return true, else - false. @see lastError()
+      */
+    bool save(const QString &fileName, const GwfSceneSnapshot &snapshot, QAtomicInt *written = 0);
+
+    //! @copydoc FileWriterInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+
+    //! @copydoc FileWriterInterface::lastError
+    const QString& lastError() const;
+
 private:
 
     GwfStreamWriter stream;
-};
 
+    QString mErrorString;
+};
 
@@ -0,0 +1,76 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "gwfidentifierscanner.h"
+#include "gwbobjectinforeader.h"
+#include "scgobjectsinfo.h"
+
+#include <QFileInfo>
+#include <QXmlStreamReader>
+
+GwfIdentifierScanner::GwfIdentifierScanner(QObject *parent)
+    : QObject(parent)
+{
+}
+
+GwfIdentifierScanner::~GwfIdentifierScanner()
+{
+}
+
+QStringList GwfIdentifierScanner::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "gwf" << "gwb";
+    return res;
+}
+
+IdentifierLocationList GwfIdentifierScanner::scan(const QString &fileName, const QByteArray &data) const
+{
+    if (QFileInfo(fileName).suffix().compare("gwb", Qt::CaseInsensitive) == 0)
+        return scanGwb(fileName, data);
+    return scanGwf(fileName, data);
+}
+
+IdentifierLocationList GwfIdentifierScanner::scanGwf(const QString &fileName, const QByteArray &data) const
+{
+    IdentifierLocationList res;
+
+    // every object element has idtf attribute, elements of other kinds don't have it
+    QXmlStreamReader reader(data);
+    while (!reader.atEnd())
+    {
+        if (reader.readNext() != QXmlStreamReader::StartElement)
+            continue;
+
+        QStringRef idtf = reader.attributes().value("idtf");
+        if (!idtf.isEmpty())
+            res.append(IdentifierLocation(idtf.toString(), fileName,
+                                          reader.lineNumber(), reader.columnNumber()));
+    }
+
+    // locations before error are still useful for incomplete files
+    return res;
+}
+
+IdentifierLocationList GwfIdentifierScanner::scanGwb(const QString &fileName, const QByteArray &data) const
+{
+    IdentifierLocationList res;
+
+    GwbObjectInfoReader reader;
+    if (!reader.read(reinterpret_cast<const uchar*>(data.constData()), data.size()))
+        return res;
+
+    GwbObjectInfoReader::TypeToObjectsMap::const_iterator it;
+    for (it = reader.objectsInfo().begin(); it != reader.objectsInfo().end(); ++it)
+    {
+        foreach (SCgObjectInfo *info, it.value())
+        {
+            if (!info->idtfValue().isEmpty())
+                res.append(IdentifierLocation(info->idtfValue(), fileName, 0, 0));
+        }
+    }
+    return res;
+}
@@ -0,0 +1,35 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/identifierscannerinterface.h"
+
+#include <QObject>
+
+/*! Finds identifiers of sc.g-objects in gwf and gwb files for project index.
+ * Gwf files are read with stream reader without building of DOM, so locations
+ * have line numbers. Gwb files don't have lines, their locations have line 0.
+ */
+class GwfIdentifierScanner : public QObject,
+                             public IdentifierScannerInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(IdentifierScannerInterface)
+
+public:
+    explicit GwfIdentifierScanner(QObject *parent = 0);
+    virtual ~GwfIdentifierScanner();
+
+    //! @copydoc IdentifierScannerInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+    //! @copydoc IdentifierScannerInterface::scan
+    IdentifierLocationList scan(const QString &fileName, const QByteArray &data) const;
+
+private:
+    IdentifierLocationList scanGwf(const QString &fileName, const QByteArray &data) const;
+    IdentifierLocationList scanGwb(const QString &fileName, const QByteArray &data) const;
+};
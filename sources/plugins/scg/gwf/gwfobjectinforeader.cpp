@@ -13,6 +13,8 @@
 #include "scgbus.h"
 #include "scgcontour.h"
 #include "scgpair.h"
+#include "scglazycontent.h"
+#include "scgblobstore.h"
 
 GwfObjectInfoReader::GwfObjectInfoReader(bool isOwner) :
     mIsOwner(isOwner),
@@ -248,6 +250,7 @@ bool GwfObjectInfoReader::read(const QDomDocument& document)
     if (mIsOwner)
         del();
     mLastError.clear();
+    mSharedContents.clear();
 
     QDomElement root = document.documentElement();
 
@@ -261,10 +264,10 @@ bool GwfObjectInfoReader::read(const QDomDocument& document)
         QStringList v_list = root.attribute("version").split(".");
         mVersion.first = v_list.first().toInt();
         mVersion.second = v_list.last().toInt();
-        if (mVersion != qMakePair(1, 6) && mVersion != qMakePair(2, 0))
+        if (mVersion != qMakePair(1, 6) && mVersion != qMakePair(2, 0) && mVersion != qMakePair(2, 1))
         {
             mLastError = QString(QObject::tr("Version %1 of GWF files not supported.\n"
-                                        "Just 1.6 and 2.0 versions supported.")).arg(root.attribute("version"));
+                                        "Just 1.6, 2.0 and 2.1 versions supported.")).arg(root.attribute("version"));
             return false;
         }
     }
@@ -407,9 +410,8 @@ bool GwfObjectInfoReader::parseNode(const QDomElement &element)
         {
             // get file name
             getAttributeString(contEl, "file_name", nodeInfo->contentFilenameRef());
-            QString cData = contEl.firstChild().nodeValue();
-            QByteArray arr = QByteArray::fromBase64(cData.toLocal8Bit());
-            nodeInfo->contentDataRef() = QVariant(arr);
+            if (!parseBinaryContent(contEl, nodeInfo->contentDataRef()))
+                return false;
         }else
         {
             mLastError = QObject::tr("Content type '%1' doesn't supported for now").arg(cType);
@@ -425,6 +427,50 @@ bool GwfObjectInfoReader::parseNode(const QDomElement &element)
     return true;
 }
 
+bool GwfObjectInfoReader::parseBinaryContent(const QDomElement &contEl, QVariant &result)
+{
+    QString cData = contEl.firstChild().nodeValue();
+    if (!contEl.hasAttribute("blob"))
+    {
+        // content is decoded, when it's needed
+        SCgLazyContent content(SCgContent::Data, cData.toLatin1(), SCgLazyContent::Base64);
+        result = QVariant::fromValue(content);
+        return true;
+    }
+
+    // version 2.1: equal contents are written once and referenced by hash
+    QByteArray ref = contEl.attribute("blob").toLatin1();
+    if (!cData.isEmpty())
+    {
+        // file could be changed by other tool with reference kept as is,
+        // so reference is used inside of file only and stored contents are found by real hash
+        QByteArray encoded = cData.toLatin1();
+        QByteArray hash = SCgBlobStore::hashOf(QByteArray::fromBase64(encoded));
+        SCgBlob blob = SCgBlobStore::instance()->find(hash);
+        if (!blob.isNull())
+        {
+            // content is already in memory, so decoded data isn't kept
+            result = QVariant::fromValue(blob);
+        }else
+        {
+            SCgLazyContent content(SCgContent::Data, encoded, SCgLazyContent::Base64);
+            content.setHash(hash);
+            result = QVariant::fromValue(content);
+        }
+        mSharedContents[ref] = result;
+        return true;
+    }
+
+    if (!mSharedContents.contains(ref))
+    {
+        mLastError = QObject::tr("Content blob '%1' not found").arg(QString::fromLatin1(ref));
+        return false;
+    }
+
+    result = mSharedContents[ref];
+    return true;
+}
+
 bool GwfObjectInfoReader::parsePair(const QDomElement &element)
 {
     std::auto_ptr<SCgPairInfo> pairInfo(new SCgPairInfo());
@@ -13,6 +13,7 @@
 #include <QPointF>
 #include <QMap>
 #include <QPair>
+#include <QVariant>
 
 class SCgObjectInfo;
 
@@ -80,8 +81,16 @@ private:
     bool parseArc(const QDomElement &element);
     bool parseBus(const QDomElement &element);
     bool parseContour(const QDomElement &element);
+    /*! Parses binary content, that may be shared between nodes in version 2.1.
+      @param contEl Content element.
+      @param result Reference to content data receiver.
+      */
+    bool parseBinaryContent(const QDomElement &contEl, QVariant &result);
     /**@}*/
 
+    //! Binary contents of current document by reference from file, they are written once.
+    QMap<QByteArray, QVariant> mSharedContents;
+
     /*! Gets string value of attribute
       @param element Element to get attribute value from.
       @param attribute Attribute name.
@@ -0,0 +1,263 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "gwfscenesnapshot.h"
+#include "scgscene.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+#include "scgtextitem.h"
+#include "scgobjectsinfo.h"
+#include "scglazycontent.h"
+#include "scgblobstore.h"
+#ifndef SCG_NO_SCENE
+#include "scgscenevirtualizer.h"
+#endif
+#include "trace.h"
+
+#include <QSet>
+#include <QHash>
+
+GwfObjectSnapshot::GwfObjectSnapshot()
+    : type(0)
+    , shapeColor(0)
+    , id(0)
+    , parentId(0)
+    , hasText(false)
+    , textColor(0)
+    , textAngle(0)
+    , fontSize(0)
+    , haveBus(false)
+    , idtfPos(0)
+    , contentType(0)
+    , contentVisible(false)
+    , beginId(0)
+    , endId(0)
+    , ownerId(0)
+    , beginDot(0)
+    , endDot(0)
+{
+}
+
+GwfObjectSnapshot GwfObjectSnapshot::fromInfo(const SCgObjectInfo *info)
+{
+    GwfObjectSnapshot res;
+
+    res.type = info->objectType();
+    res.typeAlias = info->typeAlias();
+    res.idtf = info->idtfValue();
+    res.shapeColor = info->shapeColor().value();
+    res.id = info->id().toULongLong();
+    res.parentId = info->parentId().toULongLong();
+
+    switch (res.type)
+    {
+    case SCgNode::Type:
+    {
+        const SCgNodeInfo *node = static_cast<const SCgNodeInfo*>(info);
+        res.pos = node->pos();
+        res.haveBus = node->haveBus();
+        res.idtfPos = node->idtfPos();
+        res.contentType = node->contentType();
+        res.contentMimeType = node->contentMimeType();
+        res.contentVisible = node->contentVisible();
+        res.contentFileName = node->contentFilename();
+        res.contentData = node->contentData();
+        break;
+    }
+    case SCgPair::Type:
+    {
+        const SCgPairInfo *pair = static_cast<const SCgPairInfo*>(info);
+        res.beginId = pair->beginObjectId().toULongLong();
+        res.endId = pair->endObjectId().toULongLong();
+        res.beginDot = pair->beginDot();
+        res.endDot = pair->endDot();
+        // first and last points are placeholders for pair ends
+        res.points = pair->points();
+        if (res.points.size() >= 2)
+        {
+            res.points.pop_back();
+            res.points.pop_front();
+        }
+        break;
+    }
+    case SCgBus::Type:
+    {
+        const SCgBusInfo *bus = static_cast<const SCgBusInfo*>(info);
+        res.ownerId = bus->ownerId().toULongLong();
+        res.points = bus->points();
+        if (res.points.size() >= 2)
+        {
+            res.beginPos = res.points.first();
+            res.endPos = res.points.last();
+            res.points.pop_back();
+            res.points.pop_front();
+        }
+        break;
+    }
+    case SCgContour::Type:
+        res.points = static_cast<const SCgContourInfo*>(info)->points();
+        break;
+    }
+
+    return res;
+}
+
+QByteArray GwfObjectSnapshot::contentHash() const
+{
+    if (SCgBlob::isBlob(contentData))
+        return contentData.value<SCgBlob>().hash();
+    if (SCgLazyContent::isLazy(contentData))
+        return contentData.value<SCgLazyContent>().hash();
+    return QByteArray();
+}
+
+// ---------------------
+GwfSceneSnapshot::GwfSceneSnapshot()
+{
+}
+
+GwfSceneSnapshot::GwfSceneSnapshot(const QVector<GwfObjectSnapshot> &objects)
+    : mObjects(objects)
+{
+}
+
+bool GwfSceneSnapshot::hasSharedContents() const
+{
+    QSet<QByteArray> hashes;
+    foreach (const GwfObjectSnapshot &obj, mObjects)
+    {
+        if (obj.contentType != SCgContent::Data)
+            continue;
+
+        QByteArray hash = obj.contentHash();
+        if (hash.isEmpty())
+            continue;
+        if (hashes.contains(hash))
+            return true;
+        hashes.insert(hash);
+    }
+    return false;
+}
+
+GwfSceneSnapshot GwfSceneSnapshot::fromInfo(const ObjectInfoMap &objects)
+{
+    GwfSceneSnapshot res;
+
+    // pairs store positions of their ends, that aren't known from pair info
+    QHash<quint64, QPointF> positions;
+    foreach (const SCgObjectInfo *info, objects.value(SCgNode::Type))
+        positions[info->id().toULongLong()] = static_cast<const SCgNodeInfo*>(info)->pos();
+
+    ObjectInfoMap::const_iterator it;
+    for (it = objects.begin(); it != objects.end(); ++it)
+        foreach (const SCgObjectInfo *info, it.value())
+        {
+            GwfObjectSnapshot obj = GwfObjectSnapshot::fromInfo(info);
+            if (obj.type == SCgPair::Type)
+            {
+                obj.beginPos = positions.value(obj.beginId);
+                obj.endPos = positions.value(obj.endId);
+            }
+            res.mObjects.append(obj);
+        }
+
+    return res;
+}
+
+// --- capture of scene items ---
+#ifndef SCG_NO_SCENE
+GwfObjectSnapshot GwfObjectSnapshot::fromObject(SCgObject *obj)
+{
+    GwfObjectSnapshot res;
+
+    res.type = obj->type();
+    res.typeAlias = obj->typeAlias();
+    res.idtf = obj->idtfValue();
+    res.shapeColor = obj->color().value();
+    res.id = obj->id();
+    res.parentId = obj->parentId();
+
+    const SCgTextItem *text = obj->textItem();
+    if (text)
+    {
+        res.hasText = true;
+        res.textRect = text->boundingRect();
+        res.textColor = text->defaultTextColor().value();
+        res.textAngle = text->rotation();
+        res.textFont = text->font().family();
+        res.fontSize = text->font().pointSize();
+    }
+
+    switch (res.type)
+    {
+    case SCgNode::Type:
+    {
+        SCgNode *node = static_cast<SCgNode*>(obj);
+        res.pos = node->scenePos();
+        res.haveBus = node->bus() != 0;
+        res.idtfPos = (int)node->idtfPos();
+        res.contentType = node->contentType();
+        res.contentMimeType = node->contentMimeType();
+        res.contentVisible = node->isContentVisible();
+        res.contentFileName = node->contentFileName();
+        res.contentData = node->contentRawData();
+        break;
+    }
+    case SCgPair::Type:
+    {
+        SCgPair *pair = static_cast<SCgPair*>(obj);
+        res.beginId = pair->beginObject()->id();
+        res.endId = pair->endObject()->id();
+        res.beginPos = pair->beginObject()->scenePos();
+        res.endPos = pair->endObject()->scenePos();
+        res.beginDot = pair->beginDot();
+        res.endDot = pair->endDot();
+        res.points = pair->scenePoints();
+        res.points.pop_back();
+        res.points.pop_front();
+        break;
+    }
+    case SCgBus::Type:
+    {
+        SCgBus *bus = static_cast<SCgBus*>(obj);
+        res.ownerId = bus->owner()->id();
+        res.points = bus->scenePoints();
+        res.beginPos = res.points.first();
+        res.endPos = res.points.last();
+        // do not save begin and end points
+        res.points.pop_back();
+        res.points.pop_front();
+        break;
+    }
+    case SCgContour::Type:
+        res.points = static_cast<SCgContour*>(obj)->scenePoints();
+        break;
+    }
+
+    return res;
+}
+
+GwfSceneSnapshot GwfSceneSnapshot::capture(SCgScene *scene)
+{
+    // most objects of virtual scene don't have items
+    if (scene->virtualizer())
+        return scene->virtualizer()->snapshot();
+
+    KBE_TRACE_SCOPE("scg", "capture");
+    GwfSceneSnapshot res;
+
+    QList<QGraphicsItem*> items = scene->items();
+    res.mObjects.reserve(items.size());
+
+    foreach (QGraphicsItem *item, items)
+        if (SCgObject::isSCgObjectType(item->type()))
+            res.mObjects.append(GwfObjectSnapshot::fromObject(static_cast<SCgObject*>(item)));
+
+    return res;
+}
+#endif
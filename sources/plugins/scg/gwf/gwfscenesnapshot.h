@@ -0,0 +1,125 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QVariant>
+#include <QMap>
+#include <QList>
+
+class SCgObject;
+class SCgObjectInfo;
+class SCgScene;
+
+//! Copy of sc.g-object data, that is needed to write it in gwf format.
+/*! Snapshot doesn't refer to scene items, so it can be written from any thread.
+  */
+struct GwfObjectSnapshot
+{
+    GwfObjectSnapshot();
+
+    /*! Collects object data.
+      @param obj sc.g-object to copy. Must be called from thread that owns the scene.
+      */
+    static GwfObjectSnapshot fromObject(SCgObject *obj);
+
+    /*! Collects object data from info, that was read from file.
+      Positions of pair ends are not set. @see GwfSceneSnapshot::fromInfo
+      */
+    static GwfObjectSnapshot fromInfo(const SCgObjectInfo *info);
+
+    //! Graphics item type of object. @see SCgNode::Type, SCgPair::Type, SCgBus::Type, SCgContour::Type
+    int type;
+
+    /*! @defgroup commonAttributes Common attributes
+     *  @{
+     */
+    QString typeAlias;
+    QString idtf;
+    int shapeColor;
+    quint64 id;
+    quint64 parentId;
+    /*! @}*/
+
+    /*! @defgroup textAttributes Identifier text attributes
+     *  @{
+     */
+    bool hasText;
+    QRectF textRect;
+    int textColor;
+    qreal textAngle;
+    QString textFont;
+    int fontSize;
+    /*! @}*/
+
+    /*! @defgroup nodeAttributes Node attributes
+     *  @{
+     */
+    QPointF pos;
+    bool haveBus;
+    int idtfPos;
+    int contentType;
+    QString contentMimeType;
+    bool contentVisible;
+    QString contentFileName;
+    //! Content data as it's stored in node, may hold SCgLazyContent or SCgBlob.
+    QVariant contentData;
+    //! @return Blob store hash of binary content, or empty array if it's unknown.
+    QByteArray contentHash() const;
+    /*! @}*/
+
+    /*! @defgroup pointObjectAttributes Pair, bus and contour attributes
+     *  @{
+     */
+    quint64 beginId;
+    quint64 endId;
+    quint64 ownerId;
+    QPointF beginPos;
+    QPointF endPos;
+    float beginDot;
+    float endDot;
+    //! Scene points. Pairs and buses keep only break points, contours keep all points.
+    QVector<QPointF> points;
+    /*! @}*/
+};
+
+//! Immutable copy of all sc.g-objects from scene, in the same order they are written.
+/*! Capturing is cheap: strings and content data are implicitly shared with the scene,
+    all encoding happens when snapshot is written.
+  */
+class GwfSceneSnapshot
+{
+public:
+    //! Objects info by type, as they are read by GwfObjectInfoReader and GwbObjectInfoReader.
+    typedef QMap<int, QList<SCgObjectInfo*> > ObjectInfoMap;
+
+    GwfSceneSnapshot();
+    //! Creates snapshot of prepared objects, for example generated ones.
+    explicit GwfSceneSnapshot(const QVector<GwfObjectSnapshot> &objects);
+
+    /*! Collects data of all sc.g-objects of scene.
+      @param scene scg-editor scene. Must be called from thread that owns the scene.
+      */
+    static GwfSceneSnapshot capture(SCgScene *scene);
+
+    /*! Collects data of objects, that were read from file. Scene isn't needed,
+      so it's used for conversion between formats.
+      */
+    static GwfSceneSnapshot fromInfo(const ObjectInfoMap &objects);
+
+    //! @return Objects in writing order.
+    const QVector<GwfObjectSnapshot>& objects() const { return mObjects; }
+
+    //! @return True, if at least two nodes have equal binary content.
+    bool hasSharedContents() const;
+
+private:
+    QVector<GwfObjectSnapshot> mObjects;
+};
@@ -9,22 +9,29 @@
 #include "scgpair.h"
 #include "scgcontour.h"
 #include "scgbus.h"
-#include "scgtextitem.h"
+#include "scglazycontent.h"
+#include "scgblobstore.h"
 
 #include <QTextCodec>
 
 GwfStreamWriter::GwfStreamWriter(): QXmlStreamWriter(),
-                                    isWritingStarted(false)
+                                    isWritingStarted(false),
+                                    mContentSharing(false),
+                                    mContentReferencesOnly(false)
 {
 }
 
 GwfStreamWriter::GwfStreamWriter(QIODevice* device):QXmlStreamWriter(device),
-                                                    isWritingStarted(false)
+                                                    isWritingStarted(false),
+                                                    mContentSharing(false),
+                                                    mContentReferencesOnly(false)
 {
 }
 
 GwfStreamWriter::GwfStreamWriter(QByteArray* array):QXmlStreamWriter(array),
-                                                    isWritingStarted(false)
+                                                    isWritingStarted(false),
+                                                    mContentSharing(false),
+                                                    mContentReferencesOnly(false)
 {
 }
 
@@ -38,6 +45,18 @@ void GwfStreamWriter::setDevice(QIODevice* device)
     QXmlStreamWriter::setDevice(device);
 }
 
+void GwfStreamWriter::setContentSharing(bool enabled)
+{
+    Q_ASSERT(!isWritingStarted);
+    mContentSharing = enabled;
+}
+
+void GwfStreamWriter::setContentReferencesOnly(bool enabled)
+{
+    Q_ASSERT(!isWritingStarted);
+    mContentReferencesOnly = enabled;
+}
+
 void GwfStreamWriter::startWriting(const char* encoding)
 {
     QTextCodec *codec = QTextCodec::codecForName(encoding);
@@ -45,8 +64,9 @@ void GwfStreamWriter::startWriting(const char* encoding)
     setAutoFormatting(true);
     writeStartDocument();
     writeStartElement("GWF");
-    writeAttribute("version", "2.0");
+    writeAttribute("version", mContentSharing || mContentReferencesOnly ? "2.1" : "2.0");
     writeStartElement("staticSector");
+    mWrittenContents.clear();
     isWritingStarted = true;
 }
 
@@ -57,13 +77,21 @@ void GwfStreamWriter::finishWriting()
     writeEndElement(); /*staticSector*/
     writeEndElement(); /*GWF*/
     writeEndDocument();
+    isWritingStarted = false;
 }
 
+#ifndef SCG_NO_SCENE
 void GwfStreamWriter::writeObject(SCgObject *object)
+{
+    writeObject(GwfObjectSnapshot::fromObject(object));
+}
+#endif
+
+void GwfStreamWriter::writeObject(const GwfObjectSnapshot &object)
 {
     Q_ASSERT(isWritingStarted);
 
-    switch (object->type())
+    switch (object.type)
     {
     case SCgNode::Type:
         writeNode(object);
@@ -80,43 +108,57 @@ void GwfStreamWriter::writeObject(SCgObject *object)
     }
 }
 
-void GwfStreamWriter::writeObjectAttributes(SCgObject *obj)
+void GwfStreamWriter::writeObjectAttributes(const GwfObjectSnapshot &obj)
 {
-    writeAttribute("type", obj->typeAlias());
-    writeAttribute("idtf", obj->idtfValue());
-    writeAttribute("shapeColor", QString::number(obj->color().value()));
-    writeAttribute("id", QString::number( obj->id() ));
-    writeAttribute("parent", QString::number( obj->parentId() ));
+    writeAttribute("type", obj.typeAlias);
+    writeAttribute("idtf", obj.idtf);
+    writeAttribute("shapeColor", QString::number(obj.shapeColor));
+    writeAttribute("id", QString::number(obj.id));
+    writeAttribute("parent", QString::number(obj.parentId));
     writeText(obj);
 }
 
-void GwfStreamWriter::writeNode( SCgObject *obj)
+void GwfStreamWriter::writeNode(const GwfObjectSnapshot &node)
 {
     writeStartElement("node");
-    writeObjectAttributes(obj);
-    writePosition(obj, "x", "y");
-
-    SCgNode *node = static_cast<SCgNode*>(obj);
+    writeObjectAttributes(node);
+    writePosition(node.pos, "x", "y");
 
-    writeAttribute("haveBus", node->bus() ? "true" : "false");
-    writeAttribute("idtf_pos", QString::number((int)node->idtfPos()));
+    writeAttribute("haveBus", node.haveBus ? "true" : "false");
+    writeAttribute("idtf_pos", QString::number(node.idtfPos));
 
     writeContent(node);
 
     writeEndElement();//node
 }
 
-void GwfStreamWriter::writeContent(SCgNode *node)
+void GwfStreamWriter::writeContent(const GwfObjectSnapshot &node)
 {
     writeStartElement("content");
 
-    int cType = node->contentType();
-    QString mimeType = node->contentMimeType();
+    int cType = node.contentType;
 
     writeAttribute("type",QString::number(cType));
-    writeAttribute("mime_type", node->contentMimeType());
-    writeAttribute("content_visibility", node->isContentVisible() ? "true" : "false");
-    writeAttribute("file_name", node->contentFileName());
+    writeAttribute("mime_type", node.contentMimeType);
+    writeAttribute("content_visibility", node.contentVisible ? "true" : "false");
+    writeAttribute("file_name", node.contentFileName);
+
+    if (cType == SCgContent::Data && (mContentSharing || mContentReferencesOnly))
+    {
+        QByteArray hash = node.contentHash();
+        if (!hash.isEmpty())
+        {
+            writeAttribute("blob", QString::fromLatin1(hash));
+            // not decoded lazy content may be absent in blob store, so it's written once anyway
+            bool inStore = SCgBlob::isBlob(node.contentData);
+            if ((mContentReferencesOnly && inStore) || mWrittenContents.contains(hash))
+            {
+                writeEndElement();//content
+                return;
+            }
+            mWrittenContents.insert(hash);
+        }
+    }
 
     switch(cType)
     {
@@ -124,13 +166,24 @@ void GwfStreamWriter::writeContent(SCgNode *node)
         case 2:
         case 3:
         {
-            writeCDATA((node->contentData()).toString());
+            writeCDATA(node.contentData.toString());
             break;
         }
         case 4:
         {
-            QByteArray arr = node->contentData().toByteArray().toBase64();
-            writeCDATA(arr);
+            QByteArray arr;
+            if (SCgLazyContent::isLazy(node.contentData))
+            {
+                // base64 data of not decoded content is written as is
+                SCgLazyContent content = node.contentData.value<SCgLazyContent>();
+                arr = content.encodedData();
+                if (content.encoding() != SCgLazyContent::Base64)
+                    arr = arr.toBase64();
+            }else if (SCgBlob::isBlob(node.contentData))
+                arr = node.contentData.value<SCgBlob>().data().toBase64();
+            else
+                arr = node.contentData.toByteArray().toBase64();
+            writeCDATA(QString::fromLatin1(arr));
             break;
         }
     }
@@ -138,72 +191,56 @@ void GwfStreamWriter::writeContent(SCgNode *node)
     writeEndElement();//content
 }
 
-void GwfStreamWriter::writePair(SCgObject *obj)
+void GwfStreamWriter::writePair(const GwfObjectSnapshot &pair)
 {
-    QString type = obj->typeAlias().mid(0,3);
+    QString type = pair.typeAlias.mid(0,3);
     if(type=="arc")
         writeStartElement(type);
     else
         writeStartElement("pair");
-    writeObjectAttributes(obj);
-    SCgPair* pair = static_cast<SCgPair*>(obj);
-    SCgObject* b = pair->beginObject();
-    SCgObject* e = pair->endObject();
-    writeAttribute("id_b", QString::number(b->id()));
-    writeAttribute("id_e", QString::number(e->id()));
-
-    writePosition(b,"b_x","b_y");
-    writePosition(e,"e_x","e_y");
-
-    writeAttribute("dotBBalance", QString::number(pair->beginDot()));
-    writeAttribute("dotEBalance", QString::number(pair->endDot()));
-    QVector<QPointF> points = pair->scenePoints();
-    points.pop_back();
-    points.pop_front();
-    writePoints(points);
+    writeObjectAttributes(pair);
+    writeAttribute("id_b", QString::number(pair.beginId));
+    writeAttribute("id_e", QString::number(pair.endId));
+
+    writePosition(pair.beginPos,"b_x","b_y");
+    writePosition(pair.endPos,"e_x","e_y");
+
+    writeAttribute("dotBBalance", QString::number(pair.beginDot));
+    writeAttribute("dotEBalance", QString::number(pair.endDot));
+    writePoints(pair.points);
     writeEndElement();
 }
 
-void GwfStreamWriter::writeBus(SCgObject *obj)
+void GwfStreamWriter::writeBus(const GwfObjectSnapshot &obj)
 {
     writeStartElement("bus");
     writeObjectAttributes(obj);
-    SCgBus* bus = static_cast<SCgBus*>(obj);
 
-    writeAttribute("owner", QString::number(bus->owner()->id()));
+    writeAttribute("owner", QString::number(obj.ownerId));
 
-    QVector<QPointF> points = bus->scenePoints();
-    writeAttribute("b_x", QString::number(points.first().x()));
-    writeAttribute("b_y", QString::number(points.first().y()));
-    writeAttribute("e_x", QString::number(points.last().x()));
-    writeAttribute("e_y", QString::number(points.last().y()));
+    writeAttribute("b_x", QString::number(obj.beginPos.x()));
+    writeAttribute("b_y", QString::number(obj.beginPos.y()));
+    writeAttribute("e_x", QString::number(obj.endPos.x()));
+    writeAttribute("e_y", QString::number(obj.endPos.y()));
 
-    // do not save begin and end points
-    points.pop_back();
-    points.pop_front();
-    writePoints(points);
+    writePoints(obj.points);
 
     writeEndElement();
 }
 
-void GwfStreamWriter::writeContour(SCgObject *obj)
+void GwfStreamWriter::writeContour(const GwfObjectSnapshot &obj)
 {
     writeStartElement("contour");
     writeObjectAttributes(obj);
-    SCgContour* contour = static_cast<SCgContour*>(obj);
-
-    QVector<QPointF> points(contour->scenePoints());
-    writePoints(points);
+    writePoints(obj.points);
 
     writeEndElement();
 }
 
-void GwfStreamWriter::writePosition(SCgObject *obj,const QString& x, const QString& y)
+void GwfStreamWriter::writePosition(const QPointF &pos, const QString& x, const QString& y)
 {
-    QPointF globPos = obj->scenePos();
-
-    writeAttribute(x, QString::number(globPos.x()));
-    writeAttribute(y, QString::number(globPos.y()));
+    writeAttribute(x, QString::number(pos.x()));
+    writeAttribute(y, QString::number(pos.y()));
 }
 
 void GwfStreamWriter::writePoints(const QVector<QPointF>& points)
@@ -220,19 +257,19 @@ void GwfStreamWriter::writePoints(const QVector<QPointF>& points)
     writeEndElement();
 }
 
-void GwfStreamWriter::writeText(SCgObject *obj)
+void GwfStreamWriter::writeText(const GwfObjectSnapshot &obj)
 {
-    if(obj->textItem())
+    if(obj.hasText)
     {
-        writeAttribute("left", QString::number(obj->textItem()->boundingRect().left()));
-        writeAttribute("top", QString::number(obj->textItem()->boundingRect().top()));
-        writeAttribute("right", QString::number(obj->textItem()->boundingRect().right()));
-        writeAttribute("bottom", QString::number(obj->textItem()->boundingRect().bottom()));
+        writeAttribute("left", QString::number(obj.textRect.left()));
+        writeAttribute("top", QString::number(obj.textRect.top()));
+        writeAttribute("right", QString::number(obj.textRect.right()));
+        writeAttribute("bottom", QString::number(obj.textRect.bottom()));
 
-        writeAttribute("textColor", QString::number(obj->textItem()->defaultTextColor().value()));
-        writeAttribute("text_angle", QString::number(obj->textItem()->rotation()));
+        writeAttribute("textColor", QString::number(obj.textColor));
+        writeAttribute("text_angle", QString::number(obj.textAngle));
 
-        writeAttribute("text_font", obj->textItem()->font().family());
-        writeAttribute("font_size", QString::number(obj->textItem()->font().pointSize()));
+        writeAttribute("text_font", obj.textFont);
+        writeAttribute("font_size", QString::number(obj.fontSize));
     }
 }
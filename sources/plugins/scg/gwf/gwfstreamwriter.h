@@ -10,9 +10,11 @@
 #include <QVector>
 #include <QPointF>
 #include <QMap>
+#include <QSet>
+
+#include "gwfscenesnapshot.h"
 
 class SCgObject;
-class SCgNode;
 
 //! Class for writing data in gwf format.
 /*! NOTE: First of all you have to specify device for storing information \
@@ -47,39 +49,60 @@ public:
     //! Analyzes type of object and writes it to specified device;
     void writeObject(SCgObject *object);
 
+    /*! Writes object snapshot to specified device.
+      Doesn't touch scene items, so may be used from worker thread.
+      */
+    void writeObject(const GwfObjectSnapshot &object);
+
+    /*! Enables writing of equal binary contents only once. Each content gets "blob" attribute
+      with its hash, and next nodes with the same content refer to it without data.
+      Such documents have version 2.1. Must be called before startWriting().
+      */
+    void setContentSharing(bool enabled);
+
+    /*! Enables writing of binary contents, that are held by SCgBlobStore, as hash references
+      only (implies content sharing). Document can be read back only in the same process, while
+      contents are alive, so it's suitable for clone data, but not for files or clipboard.
+      */
+    void setContentReferencesOnly(bool enabled);
+
 private:
     bool isWritingStarted;
+    bool mContentSharing;
+    bool mContentReferencesOnly;
+    //! Hashes of already written binary contents.
+    QSet<QByteArray> mWrittenContents;
     /*! Save sc.g-node.
-      @param node Element of sc.g-node type.
+      @param node Snapshot of sc.g-node.
       */
-    void writeNode(SCgObject *node);
+    void writeNode(const GwfObjectSnapshot &node);
 
     /*! Save sc.g-pair.
-      @param node Element of sc.g-pair.
+      @param pair Snapshot of sc.g-pair.
       */
-    void writePair(SCgObject *node);
+    void writePair(const GwfObjectSnapshot &pair);
 
     /*! Save sc.g-bus.
-      @param obj Element of sc.g-bus.
+      @param obj Snapshot of sc.g-bus.
       */
-    void writeBus(SCgObject *obj);
+    void writeBus(const GwfObjectSnapshot &obj);
 
     /*! Save sc.g-contour.
-      @param obj Element of sc.g-contour.
+      @param obj Snapshot of sc.g-contour.
       */
-    void writeContour(SCgObject *obj);
+    void writeContour(const GwfObjectSnapshot &obj);
 
     /*! Save sc.g-Object attributes.
-      @param obj Element of sc.g-object.
+      @param obj Snapshot of sc.g-object.
       */
-    void writeObjectAttributes(SCgObject *obj);
+    void writeObjectAttributes(const GwfObjectSnapshot &obj);
 
     /*! Save point position.
-      @param obj Element of sc.g-object.
+      @param pos Point in scene coordinates.
       @param x Name of attribute x-positions.
       @param y Name of attribute y-positions.
       */
-    void writePosition(SCgObject *obj,const QString& x, const QString& y);
+    void writePosition(const QPointF &pos, const QString& x, const QString& y);
 
     /*! Save points array.
       @param points Vector of points
@@ -87,14 +110,14 @@ private:
     void writePoints(const QVector<QPointF>& points);
 
     /*! Save text attribute.
-      @param obj Element of sc.g-object.
+      @param obj Snapshot of sc.g-object.
       */
-    void writeText(SCgObject *obj);
+    void writeText(const GwfObjectSnapshot &obj);
 
     /*! Save content in node.
-      @param node Element of sc.g-node type.
+      @param node Snapshot of sc.g-node.
       */
-    void writeContent(SCgNode *node);
+    void writeContent(const GwfObjectSnapshot &node);
 
     void createTypesMap();
 };
@@ -48,10 +48,13 @@ void SCgCloneMode::activate()
 {
     clean();
 
+    mScene->materializeSelection();
     QList<QGraphicsItem*> list = mScene->selectedItems();
 
     QByteArray clonedData;
     GwfStreamWriter writer(&clonedData);
+    // cloned nodes are built immediately, while source contents are alive
+    writer.setContentReferencesOnly(true);
     ////////////////////////////////////
     writer.startWriting();
 
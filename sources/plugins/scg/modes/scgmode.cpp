@@ -232,6 +232,7 @@ void SCgMode::keyPress(QKeyEvent *event)
             break;
         }
         SCgScene::ItemUndoInfo undoInfo;
+        mScene->materializeSelection();
         foreach(QGraphicsItem* item, mScene->selectedItems())
         {
             if(item->flags() & QGraphicsItem::ItemIsMovable && !movableAncestorIsSelected(item))
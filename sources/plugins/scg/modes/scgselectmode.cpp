@@ -47,9 +47,8 @@ void SCgSelectMode::mouseDoubleClick(QGraphicsSceneMouseEvent *event)
         QGraphicsItem *item = mScene->itemAt(mousePos);
         if(mCurrentPointObject)
         {
-            QPainterPath p = mCurrentPointObject->lineShape();
             QPointF itemPoint = mCurrentPointObject->mapFromScene(mousePos);
-            if(p.contains(itemPoint))
+            if(mCurrentPointObject->isOnLine(itemPoint))
             {
                 mScene->addPointCommand(mCurrentPointObject, mousePos);
                 event->accept();
@@ -77,6 +76,7 @@ void SCgSelectMode::mouseMove(QGraphicsSceneMouseEvent *event)
         //We should use there current event position (not mStartPos) because of the delay between mousePress and mouseMove events.
         //______________________________________________________//
         //Store start positions(before items moving)
+        mScene->materializeSelection();
         QList<QGraphicsItem*> items = mScene->selectedItems();
         QList<QGraphicsItem*>::const_iterator it = items.begin();
         while(it != items.end())
@@ -138,7 +138,7 @@ void SCgSelectMode::mousePress(QGraphicsSceneMouseEvent *event)
             if(item && SCgObject::isSCgPointObjectType(item->type()))
             {
                 mCurrentPointObject = static_cast<SCgPointObject*>(item);
-                if(mCurrentPointObject->shape().contains(mCurrentPointObject->mapFromScene(cur_pos)))
+                if(mCurrentPointObject->contains(mCurrentPointObject->mapFromScene(cur_pos)))
                     mCurrentPointObject->createPointObjects();
                 else
                     mCurrentPointObject = 0;
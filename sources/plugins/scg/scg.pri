@@ -0,0 +1,209 @@
+# Sources of sc.g-editor. They are included into scg plugin and into
+# tools, that work with scene without loading plugin (see kbe-bench).
+
+INCLUDEPATH += $$PWD
+
+RESOURCES += $$PWD/scg.qrc
+
+HEADERS += \
+    $$PWD/scgwindow.h \
+    $$PWD/scgview.h \
+    $$PWD/scgtemplateobjectbuilder.h \
+    $$PWD/scgscene.h \
+    $$PWD/scgpointobject.h \
+    $$PWD/scgpair.h \
+    $$PWD/scgobjectsinfodata.h \
+    $$PWD/scgobjectsinfo.h \
+    $$PWD/scgobject.h \
+    $$PWD/scgnode.h \
+    $$PWD/scgminimap.h \
+    $$PWD/scglayoutmanager.h \
+    $$PWD/scgfilewriterimage.h \
+    $$PWD/scgdefaultobjectbuilder.h \
+    $$PWD/scgcontour.h \
+    $$PWD/scgcontentviewer.h \
+    $$PWD/scgcontentstring.h \
+    $$PWD/scgcontentnumeric.h \
+    $$PWD/scgcontentimage.h \
+    $$PWD/scgimagecache.h \
+    $$PWD/scgcontentfactory.h \
+    $$PWD/scgcontentdialog.h \
+    $$PWD/scgcontentchangedialog.h \
+    $$PWD/scgcontent.h \
+    $$PWD/scgconfig.h \
+    $$PWD/scgbus.h \
+    $$PWD/scgalphabet.h \
+    $$PWD/scgabstractobjectbuilder.h \
+    $$PWD/scgpointgraphicsitem.h \
+    $$PWD/scgtextitem.h \
+    $$PWD/gwf/gwfstreamwriter.h \
+    $$PWD/gwf/gwfobjectinforeader.h \
+    $$PWD/gwf/gwffilewriter.h \
+    $$PWD/gwf/gwffileloader.h \
+    $$PWD/gwf/gwfscenesnapshot.h \
+    $$PWD/gwf/gwfasyncfilewriter.h \
+    $$PWD/gwf/gwbformat.h \
+    $$PWD/gwf/gwbfilewriter.h \
+    $$PWD/gwf/gwbobjectinforeader.h \
+    $$PWD/gwf/gwbfileloader.h \
+    $$PWD/gwf/gwfidentifierscanner.h \
+    $$PWD/gwf/gwfdocumentsearcher.h \
+    $$PWD/scgfindwidget.h \
+    $$PWD/scgundoviewmodel.h \
+    $$PWD/scgundoview.h \
+    $$PWD/scgundomemorymanager.h \
+    $$PWD/scgperfcounters.h \
+    $$PWD/scgstatisticswidget.h \
+    $$PWD/scgpairrouter.h \
+    $$PWD/scglazycontent.h \
+    $$PWD/scgblobstore.h \
+    $$PWD/scgcontentviewermanager.h \
+    $$PWD/scgscenevirtualizer.h \
+    $$PWD/commands/scgcommandselectedobjectmove.h \
+    $$PWD/commands/scgcommandpointschange.h \
+    $$PWD/commands/scgcommandapplypositions.h \
+    $$PWD/commands/scgcommandreroutepairs.h \
+    $$PWD/commands/scgcommandmarkroutedpairs.h \
+    $$PWD/commands/scgcommandpointmove.h \
+    $$PWD/commands/scgcommandobjectmove.h \
+    $$PWD/commands/scgcommandobjectdelete.h \
+    $$PWD/commands/scgcommandinsert.h \
+    $$PWD/commands/scgcommanddeletecontour.h \
+    $$PWD/commands/scgcommandcreatepair.h \
+    $$PWD/commands/scgcommandcreatenode.h \
+    $$PWD/commands/scgcommandcreatecontour.h \
+    $$PWD/commands/scgcommandcreatebus.h \
+    $$PWD/commands/scgcommandcontentvisibility.h \
+    $$PWD/commands/scgcommandcontentchange.h \
+    $$PWD/commands/scgcommandclone.h \
+    $$PWD/commands/scgcommandchangeincedentobject.h \
+    $$PWD/commands/scgbasecommand.h \
+    $$PWD/commands/scgcommandidtfmove.h \
+    $$PWD/commands/scgcommandobjectidtfchange.h \
+    $$PWD/commands/scgcommandobjecttypechange.h \
+    $$PWD/scgexportimage.h \
+    $$PWD/arrangers/scgarrangervertical.h \
+    $$PWD/arrangers/scgarrangertuple.h \
+    $$PWD/arrangers/scgarrangerhorizontal.h \
+    $$PWD/arrangers/scgarrangergrid.h \
+    $$PWD/arrangers/scgarranger.h \
+    $$PWD/arrangers/scgarrangerenergybased.h \
+    $$PWD/arrangers/scgforcecalculator.h \
+    $$PWD/arrangers/scgarrangerhierarchical.h \
+    $$PWD/arrangers/scglayeredlayout.h \
+    $$PWD/select/scgselectinputoutput.h \
+    $$PWD/select/scgselect.h \
+    $$PWD/select/scgselectsubgraph.h \
+    $$PWD/modes/scgselectmode.h \
+    $$PWD/modes/scgpairmode.h \
+    $$PWD/modes/scgmode.h \
+    $$PWD/modes/scginsertmode.h \
+    $$PWD/modes/scgcontourmode.h \
+    $$PWD/modes/scgclonemode.h \
+    $$PWD/modes/scgbusmode.h \
+    $$PWD/commands/scgcommandswappairorient.h \
+    $$PWD/commands/scgcommandremovebreakpoints.h \
+    $$PWD/commands/scgcommandminimizecontour.h \
+    $$PWD/scgnodetextitem.h \
+    $$PWD/scgtypedialog.h
+
+SOURCES += \
+    $$PWD/scgwindow.cpp \
+    $$PWD/scgview.cpp \
+    $$PWD/scgtemplateobjectbuilder.cpp \
+    $$PWD/scgscene.cpp \
+    $$PWD/scgpointobject.cpp \
+    $$PWD/scgpair.cpp \
+    $$PWD/scgobjectsinfodata.cpp \
+    $$PWD/scgobjectsinfo.cpp \
+    $$PWD/scgobject.cpp \
+    $$PWD/scgnode.cpp \
+    $$PWD/scgminimap.cpp \
+    $$PWD/scglayoutmanager.cpp \
+    $$PWD/scgfilewriterimage.cpp \
+    $$PWD/scgdefaultobjectbuilder.cpp \
+    $$PWD/scgcontour.cpp \
+    $$PWD/scgcontentviewer.cpp \
+    $$PWD/scgcontentstring.cpp \
+    $$PWD/scgcontentnumeric.cpp \
+    $$PWD/scgcontentimage.cpp \
+    $$PWD/scgimagecache.cpp \
+    $$PWD/scgcontentfactory.cpp \
+    $$PWD/scgcontentdialog.cpp \
+    $$PWD/scgcontentchangedialog.cpp \
+    $$PWD/scgcontent.cpp \
+    $$PWD/scgconfig.cpp \
+    $$PWD/scgbus.cpp \
+    $$PWD/scgalphabet.cpp \
+    $$PWD/scgabstractobjectbuilder.cpp \
+    $$PWD/scgpointgraphicsitem.cpp \
+    $$PWD/scgtextitem.cpp \
+    $$PWD/gwf/gwfstreamwriter.cpp \
+    $$PWD/gwf/gwfobjectinforeader.cpp \
+    $$PWD/gwf/gwffilewriter.cpp \
+    $$PWD/gwf/gwffileloader.cpp \
+    $$PWD/gwf/gwfscenesnapshot.cpp \
+    $$PWD/gwf/gwfasyncfilewriter.cpp \
+    $$PWD/gwf/gwbfilewriter.cpp \
+    $$PWD/gwf/gwbobjectinforeader.cpp \
+    $$PWD/gwf/gwbfileloader.cpp \
+    $$PWD/gwf/gwfidentifierscanner.cpp \
+    $$PWD/gwf/gwfdocumentsearcher.cpp \
+    $$PWD/scgfindwidget.cpp \
+    $$PWD/scgundoviewmodel.cpp \
+    $$PWD/scgundoview.cpp \
+    $$PWD/scgundomemorymanager.cpp \
+    $$PWD/scgperfcounters.cpp \
+    $$PWD/scgstatisticswidget.cpp \
+    $$PWD/scgpairrouter.cpp \
+    $$PWD/scglazycontent.cpp \
+    $$PWD/scgblobstore.cpp \
+    $$PWD/scgcontentviewermanager.cpp \
+    $$PWD/scgscenevirtualizer.cpp \
+    $$PWD/commands/scgcommandselectedobjectmove.cpp \
+    $$PWD/commands/scgcommandpointschange.cpp \
+    $$PWD/commands/scgcommandapplypositions.cpp \
+    $$PWD/commands/scgcommandreroutepairs.cpp \
+    $$PWD/commands/scgcommandmarkroutedpairs.cpp \
+    $$PWD/commands/scgcommandpointmove.cpp \
+    $$PWD/commands/scgcommandobjectmove.cpp \
+    $$PWD/commands/scgcommandobjectdelete.cpp \
+    $$PWD/commands/scgcommandinsert.cpp \
+    $$PWD/commands/scgcommanddeletecontour.cpp \
+    $$PWD/commands/scgcommandcreatepair.cpp \
+    $$PWD/commands/scgcommandcreatecontour.cpp \
+    $$PWD/commands/scgcommandcreatebus.cpp \
+    $$PWD/commands/scgcommandcontentvisibility.cpp \
+    $$PWD/commands/scgcommandcontentchange.cpp \
+    $$PWD/commands/scgcommandclone.cpp \
+    $$PWD/commands/scgcommandchangeincedentobject.cpp \
+    $$PWD/commands/scgbasecommand.cpp \
+    $$PWD/commands/scgcommandcreatenode.cpp \
+    $$PWD/commands/scgcommandidtfmove.cpp \
+    $$PWD/commands/scgcommandobjectidtfchange.cpp \
+    $$PWD/commands/scgcommandobjecttypechange.cpp \
+    $$PWD/scgexportimage.cpp \
+    $$PWD/arrangers/scgarrangervertical.cpp \
+    $$PWD/arrangers/scgarrangertuple.cpp \
+    $$PWD/arrangers/scgarrangerhorizontal.cpp \
+    $$PWD/arrangers/scgarrangergrid.cpp \
+    $$PWD/arrangers/scgarranger.cpp \
+    $$PWD/arrangers/scgarrangerenergybased.cpp \
+    $$PWD/arrangers/scgforcecalculator.cpp \
+    $$PWD/arrangers/scgarrangerhierarchical.cpp \
+    $$PWD/arrangers/scglayeredlayout.cpp \
+    $$PWD/select/scgselectinputoutput.cpp \
+    $$PWD/select/scgselect.cpp \
+    $$PWD/select/scgselectsubgraph.cpp \
+    $$PWD/modes/scgselectmode.cpp \
+    $$PWD/modes/scgpairmode.cpp \
+    $$PWD/modes/scgmode.cpp \
+    $$PWD/modes/scginsertmode.cpp \
+    $$PWD/modes/scgcontourmode.cpp \
+    $$PWD/modes/scgclonemode.cpp \
+    $$PWD/modes/scgbusmode.cpp \
+    $$PWD/commands/scgcommandswappairorient.cpp \
+    $$PWD/commands/scgcommandremovebreakpoints.cpp \
+    $$PWD/commands/scgcommandminimizecontour.cpp \
+    $$PWD/scgnodetextitem.cpp \
+    $$PWD/scgtypedialog.cpp
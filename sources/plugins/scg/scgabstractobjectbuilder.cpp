@@ -13,3 +13,12 @@ AbstractSCgObjectBuilder::AbstractSCgObjectBuilder()
 AbstractSCgObjectBuilder::~AbstractSCgObjectBuilder()
 {
 }
+
+int AbstractSCgObjectBuilder::objectCount(const TypeToObjectsMap& objects)
+{
+    int count = 0;
+    TypeToObjectsMap::const_iterator it;
+    for (it = objects.begin(); it != objects.end(); ++it)
+        count += it.value().size();
+    return count;
+}
@@ -46,6 +46,9 @@ public:
      * @return List of built objects.
      */
     virtual void buildObjects(const TypeToObjectsMap& objects) = 0;
+
+    //! @return Total number of objects in @p objects.
+    static int objectCount(const TypeToObjectsMap& objects);
 };
 
 
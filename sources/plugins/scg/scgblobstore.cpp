@@ -0,0 +1,244 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgblobstore.h"
+
+#include <QCryptographicHash>
+#include <QTemporaryFile>
+#include <QVariant>
+#include <QDir>
+
+//! Default size, starting from which blobs are mapped from file
+#define SCG_BLOB_MAP_THRESHOLD  (4 << 20)
+
+SCgBlob::SCgBlob()
+    : d(0)
+{
+}
+
+SCgBlob::SCgBlob(SCgBlobEntry *entry)
+    : d(entry)
+{
+}
+
+SCgBlob::SCgBlob(const SCgBlob &other)
+    : d(other.d)
+{
+    if (d)
+        d->ref.ref();
+}
+
+SCgBlob::~SCgBlob()
+{
+    if (d)
+    {
+        // entry may be deleted by other thread right after dereference
+        QByteArray hash = d->hash;
+        if (!d->ref.deref())
+            SCgBlobStore::instance()->release(hash, d);
+    }
+}
+
+SCgBlob& SCgBlob::operator=(const SCgBlob &other)
+{
+    if (other.d != d)
+    {
+        SCgBlob tmp(other);
+        qSwap(d, tmp.d);
+    }
+    return *this;
+}
+
+QByteArray SCgBlob::hash() const
+{
+    return d ? d->hash : QByteArray();
+}
+
+QByteArray SCgBlob::data() const
+{
+    return d ? d->data : QByteArray();
+}
+
+qint64 SCgBlob::size() const
+{
+    return d ? d->data.size() : 0;
+}
+
+qint64 SCgBlob::memoryUsage() const
+{
+    if (!d || d->file)
+        return 0;
+
+    return d->data.size() / qMax(1, d->ref.loadAcquire());
+}
+
+bool SCgBlob::isBlob(const QVariant &data)
+{
+    return data.userType() == qMetaTypeId<SCgBlob>();
+}
+
+// ---------------------
+SCgBlobStore::SCgBlobStore()
+    : mMapThreshold(SCG_BLOB_MAP_THRESHOLD)
+{
+}
+
+SCgBlobStore::~SCgBlobStore()
+{
+}
+
+SCgBlobStore* SCgBlobStore::instance()
+{
+    static SCgBlobStore store;
+    return &store;
+}
+
+QByteArray SCgBlobStore::hashOf(const QByteArray &data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+}
+
+SCgBlob SCgBlobStore::insert(const QByteArray &data)
+{
+    QByteArray hash = hashOf(data);
+
+    QMutexLocker locker(&mMutex);
+
+    HashToEntryMap::iterator it = mEntries.find(hash);
+    if (it != mEntries.end())
+    {
+        it.value()->ref.ref();
+        return SCgBlob(it.value());
+    }
+
+    SCgBlobEntry *entry = new SCgBlobEntry();
+    entry->ref.storeRelease(1);
+    entry->parked = 0;
+    entry->hash = hash;
+    entry->data = data;
+    entry->file = 0;
+
+    if (data.size() >= mMapThreshold)
+        map(entry);
+
+    mEntries.insert(hash, entry);
+    return SCgBlob(entry);
+}
+
+SCgBlob SCgBlobStore::find(const QByteArray &hash)
+{
+    QMutexLocker locker(&mMutex);
+
+    HashToEntryMap::iterator it = mEntries.find(hash);
+    if (it == mEntries.end())
+        return SCgBlob();
+
+    it.value()->ref.ref();
+    return SCgBlob(it.value());
+}
+
+QByteArray SCgBlobStore::park(const SCgBlob &blob)
+{
+    if (blob.isNull())
+        return QByteArray();
+
+    QMutexLocker locker(&mMutex);
+
+    ++blob.d->parked;
+    return blob.d->hash;
+}
+
+SCgBlob SCgBlobStore::unpark(const QByteArray &hash)
+{
+    QMutexLocker locker(&mMutex);
+
+    HashToEntryMap::iterator it = mEntries.find(hash);
+    if (it == mEntries.end())
+        return SCgBlob();
+
+    SCgBlobEntry *entry = it.value();
+    Q_ASSERT(entry->parked > 0);
+    if (entry->parked > 0)
+        --entry->parked;
+
+    entry->ref.ref();
+    return SCgBlob(entry);
+}
+
+void SCgBlobStore::release(const QByteArray &hash, SCgBlobEntry *entry)
+{
+    QMutexLocker locker(&mMutex);
+
+    // entry could be found again, or already deleted by other release
+    HashToEntryMap::iterator it = mEntries.find(hash);
+    if (it == mEntries.end() || it.value() != entry || entry->ref.loadAcquire() != 0)
+        return;
+
+    // parked data isn't needed until it's unparked, so it's kept in side store only
+    if (entry->parked > 0)
+    {
+        if (!entry->file)
+            map(entry);
+        return;
+    }
+
+    mEntries.erase(it);
+    delete entry->file;
+    delete entry;
+}
+
+bool SCgBlobStore::map(SCgBlobEntry *entry)
+{
+    QTemporaryFile *file = new QTemporaryFile(QDir::tempPath() + "/kbe_blob_XXXXXX");
+
+    uchar *mapped = 0;
+    if (file->open() && file->write(entry->data) == entry->data.size() && file->flush())
+        mapped = file->map(0, entry->data.size());
+
+    if (!mapped)
+    {
+        delete file;
+        return false;
+    }
+
+    entry->file = file;
+    entry->data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), entry->data.size());
+    return true;
+}
+
+int SCgBlobStore::count() const
+{
+    QMutexLocker locker(&mMutex);
+    return mEntries.size();
+}
+
+qint64 SCgBlobStore::memoryUsage() const
+{
+    QMutexLocker locker(&mMutex);
+
+    qint64 res = 0;
+    foreach (const SCgBlobEntry *entry, mEntries)
+        if (!entry->file)
+            res += entry->data.size();
+    return res;
+}
+
+qint64 SCgBlobStore::mappedSize() const
+{
+    QMutexLocker locker(&mMutex);
+
+    qint64 res = 0;
+    foreach (const SCgBlobEntry *entry, mEntries)
+        if (entry->file)
+            res += entry->data.size();
+    return res;
+}
+
+void SCgBlobStore::setMapThreshold(qint64 size)
+{
+    QMutexLocker locker(&mMutex);
+    mMapThreshold = size;
+}
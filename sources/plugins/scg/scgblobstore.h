@@ -0,0 +1,144 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QMetaType>
+
+class QTemporaryFile;
+class SCgBlobStore;
+
+//! Stored data of blob. @see SCgBlobStore
+struct SCgBlobEntry
+{
+    //! Number of SCgBlob handles
+    QAtomicInt ref;
+    //! Number of parked references, they keep entry without handles. @see SCgBlobStore::park
+    int parked;
+    //! Hex encoded hash of data
+    QByteArray hash;
+    //! Data in memory or raw data over mapped file
+    QByteArray data;
+    //! Side store for large data
+    QTemporaryFile *file;
+};
+
+//! Reference counted handle of data in SCgBlobStore.
+/*! Handles of equal data refer to the same entry, so data is kept in memory once.
+    Copies are cheap and may be passed to other threads.
+  */
+class SCgBlob
+{
+public:
+    SCgBlob();
+    SCgBlob(const SCgBlob &other);
+    ~SCgBlob();
+
+    SCgBlob& operator=(const SCgBlob &other);
+
+    //! @return True, if handle doesn't refer to any data.
+    bool isNull() const { return d == 0; }
+
+    //! @return Hex encoded hash of data, that identifies it in store.
+    QByteArray hash() const;
+
+    /*! @return Stored data.
+      @attention For large data it's raw data over mapped file, so it's valid only
+      while any handle to this blob exists.
+      */
+    QByteArray data() const;
+
+    //! @return Size of data in bytes.
+    qint64 size() const;
+
+    /*! @return Share of data memory, that is used by this handle.
+      Data of mapped blobs isn't counted.
+      */
+    qint64 memoryUsage() const;
+
+    //! @return True, if \p data holds SCgBlob.
+    static bool isBlob(const QVariant &data);
+
+private:
+    friend class SCgBlobStore;
+    //! Takes reference, that is already counted.
+    explicit SCgBlob(SCgBlobEntry *entry);
+
+    SCgBlobEntry *d;
+};
+
+Q_DECLARE_METATYPE(SCgBlob)
+
+
+//! Content addressed store of node contents.
+/*! Data is stored once for all equal contents and released with the last handle.
+    Large data is moved into temporary file, that is mapped into memory.
+    All methods are thread-safe.
+  */
+class SCgBlobStore
+{
+public:
+    static SCgBlobStore* instance();
+
+    /*! Adds data to store.
+      @return Handle of stored data. If equal data was stored already, then handle refers to it.
+      */
+    SCgBlob insert(const QByteArray &data);
+
+    /*! Finds stored data.
+      @param hash Hex encoded hash of data. @see SCgBlob::hash
+      @return Handle of stored data or null handle if there is no such data.
+      */
+    SCgBlob find(const QByteArray &hash);
+
+    /*! Keeps data of @p blob in store by hash, so caller can drop its handle. When the last
+      handle is dropped, parked data is moved into side store instead of being deleted,
+      so it doesn't take memory until it's unparked.
+      @return Hash, that must be passed to unpark once.
+      */
+    QByteArray park(const SCgBlob &blob);
+
+    /*! Takes back data, that was parked by park.
+      @return Handle of parked data or null handle if there is no such data.
+      */
+    SCgBlob unpark(const QByteArray &hash);
+
+    //! @return Hex encoded hash of data, that is used for addressing.
+    static QByteArray hashOf(const QByteArray &data);
+
+    //! @return Number of stored blobs.
+    int count() const;
+    //! @return Size of blobs, that are kept in memory.
+    qint64 memoryUsage() const;
+    //! @return Size of blobs, that are moved into mapped files.
+    qint64 mappedSize() const;
+
+    //! Sets size, starting from which data is moved into mapped file.
+    void setMapThreshold(qint64 size);
+
+private:
+    SCgBlobStore();
+    ~SCgBlobStore();
+    Q_DISABLE_COPY(SCgBlobStore)
+
+    friend class SCgBlob;
+    //! Deletes entry if it has no handles and isn't parked. Called when last handle was destroyed.
+    void release(const QByteArray &hash, SCgBlobEntry *entry);
+
+    //! Moves entry data into side store. @return If data mapped, then return true, else - false.
+    bool map(SCgBlobEntry *entry);
+
+    mutable QMutex mMutex;
+    typedef QHash<QByteArray, SCgBlobEntry*> HashToEntryMap;
+    HashToEntryMap mEntries;
+
+    qint64 mMapThreshold;
+};
+
@@ -10,8 +10,9 @@
 #include "scgnode.h"
 #include "scgtextitem.h"
 #include "scgpointgraphicsitem.h"
+#include "scgperfcounters.h"
 
-#include <QPainterPathStroker>
+#include <QPolygonF>
 #include <QVector2D>
 
 SCgBus::SCgBus() :
@@ -35,16 +36,6 @@ SCgBus::~SCgBus()
     }
 }
 
-QRectF SCgBus::boundingRect() const
-{
-    return mShape.boundingRect().adjusted(-5, -5, 5, 5);
-}
-
-QPainterPath SCgBus::shape() const
-{
-    return mShape;
-}
-
 void SCgBus::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
     SCgAlphabet::paintBus(painter, this);
@@ -65,9 +56,17 @@ QVariant SCgBus::itemChange(GraphicsItemChange change, const QVariant &value)
 }
 
 void SCgBus::positionChanged()
+{
+    SCgPerfCounters::increment(SCgPerfCounters::PositionChangedCalls);
+
+    if (updatePoints())
+        updateShape();
+}
+
+bool SCgBus::updatePoints()
 {
     // skip update if there are no points
-    if (mPoints.empty())    return;
+    if (mPoints.empty())    return false;
 
     if (mOwner)
     {
@@ -75,26 +74,23 @@ void SCgBus::positionChanged()
         mPoints.first() = mapFromScene(mOwner->cross(mapToScene(mPoints.at(1)), 0.f));
     }
 
-    updateShape();
+    return true;
 }
 
-void SCgBus::updateShape()
+SCgPointObject::Geometry SCgBus::buildGeometry(const PointFVector &points) const
 {
-    prepareGeometryChange();
+    // bus is drawn by points, so it has no normal path
+    Geometry res;
 
-    // creating shape
-    mShape = QPainterPath();
+    qreal margin = SCgAlphabet::lineWidthForShape() / 2 + 5;
+    res.boundingRect = QPolygonF(points).boundingRect().adjusted(-margin, -margin, margin, margin);
 
-    mShape.moveTo(mPoints.at(0));
-    for (int i = 1; i < mPoints.size(); i++)
-        mShape.lineTo(mPoints.at(i));
-
-    QPainterPathStroker path_stroker;
-    path_stroker.setJoinStyle(Qt::MiterJoin);
-    path_stroker.setWidth(SCgAlphabet::lineWidthForShape());
-    mShape = path_stroker.createStroke(mShape);
+    return res;
+}
 
-    mLineShape = mShape;
+void SCgBus::applyGeometry(const Geometry &geometry)
+{
+    assignGeometry(geometry);
 
     // update item
     update();
@@ -235,7 +231,8 @@ void SCgBus::setOwner(SCgNode *owner)
     }
     mOwner = owner;
     if (mOwner) mOwner->setBus(this);
-    positionChanged();
+    if (!isGeometryPropagationSuspended())
+        positionChanged();
 }
 
 SCgNode* SCgBus::owner() const
@@ -20,8 +20,6 @@ public:
     virtual ~SCgBus();
 
 protected:
-    QRectF boundingRect() const;
-    QPainterPath shape() const;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
     QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
@@ -37,8 +35,12 @@ public:
     void undel(SCgScene *scene);
 
     void positionChanged();
-    //! @see SCgPointObject::updateShape;
-    void updateShape();
+    //! @see SCgPointObject::buildGeometry
+    Geometry buildGeometry(const PointFVector &points) const;
+    //! @see SCgPointObject::applyGeometry
+    void applyGeometry(const Geometry &geometry);
+    //! Calculates first point as crossing with owner.
+    bool updatePoints();
     //! @see SCgObject::objectDelete;
     void objectDelete(SCgObject *object);
 
@@ -76,8 +78,6 @@ public:
     SCgObject* objectWithRole(IncidentRole role) const;
 
 private:
-    //! Path that represents shape
-    QPainterPath mShape;
     //! Width of bus
     float mWidth;
     //! Owner
@@ -58,6 +58,19 @@ void SCgConfig::initializeDefault()
     scg_cfg_set_default_value_color(scg_text_element_color_selected, QColor(234, 102, 244));
     scg_cfg_set_default_value_color(scg_text_element_color_highlight, QColor(155, 157, 69));
 
+    // --- undo ---
+    // memory limit for undo history in bytes
+    scg_cfg_set_default_value(scg_key_undo_memory_limit, qint64(64 * 1024 * 1024));
+
+    // --- content ---
+    // maximum number of content viewers, that exist at the same time
+    scg_cfg_set_default_value(scg_key_content_viewer_limit, 64);
+
+    // --- scene ---
+    // number of objects in file, from which scene keeps them as records and creates
+    // items only near viewport, 0 disables virtual scenes
+    scg_cfg_set_default_value(scg_key_virtual_scene_threshold, 100000);
+
     // copy default values to current
     mValues = mDefaultValues;
 }
@@ -38,6 +38,9 @@
 #define scg_text_element_color_normal QString("text/color/normal")
 #define scg_text_element_color_selected QString("text/color/selected")
 #define scg_text_element_color_highlight QString("text/color/highlight")
+#define scg_key_undo_memory_limit QString("undo/memory/limit")
+#define scg_key_content_viewer_limit QString("content/viewer/limit")
+#define scg_key_virtual_scene_threshold QString("scene/virtual/threshold")
 
 class SCgConfig : public QObject
 {
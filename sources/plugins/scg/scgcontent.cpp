@@ -5,6 +5,9 @@
  */
 
 #include "scgcontent.h"
+#include "scglazycontent.h"
+#include "scgblobstore.h"
+
 #include <QObject>
 
 SCgContent::SCgContent()
@@ -29,7 +32,11 @@ void SCgContent::setContent(const QString& mimeType, const QVariant& data,
 {
     mMimeType = mimeType;
     mData = data;
-    mType = cType;
+    mType = SCgLazyContent::isLazy(data) ? Lazy : cType;
+
+    // equal binary contents share one copy of data
+    if (mType == Data && data.type() == QVariant::ByteArray)
+        mData = QVariant::fromValue(SCgBlobStore::instance()->insert(data.toByteArray()));
 
     int slashPos = fileName.lastIndexOf('/');
     if(slashPos < 0)
@@ -37,7 +44,7 @@ void SCgContent::setContent(const QString& mimeType, const QVariant& data,
     else
         mFileName = fileName.mid(slashPos+1);
 
-    switch (cType)
+    switch (contentType())
     {
     case Empty:
         break;
@@ -60,6 +67,9 @@ void SCgContent::setContent(const QString& mimeType, const QVariant& data,
 
 SCgContent::ContType SCgContent::contentType() const
 {
+    if (mType == Lazy)
+        return mData.value<SCgLazyContent>().type();
+
     return mType;
 }
 
@@ -68,11 +78,40 @@ const QString& SCgContent::contentFormat() const
     return mFormat;
 }
 
-const QVariant& SCgContent::contentData() const
+QVariant SCgContent::contentData() const
+{
+    if (mType == Lazy)
+    {
+        SCgLazyContent lazy = mData.value<SCgLazyContent>();
+        mType = lazy.type();
+
+        if (mType == Data)
+        {
+            // there is no need to decode data, that is stored already
+            SCgBlob blob = SCgBlobStore::instance()->find(lazy.hash());
+            if (blob.isNull())
+                blob = SCgBlobStore::instance()->insert(lazy.data().toByteArray());
+            mData = QVariant::fromValue(blob);
+        }else
+            mData = lazy.data();
+    }
+
+    if (SCgBlob::isBlob(mData))
+        return QVariant(mData.value<SCgBlob>().data());
+
+    return mData;
+}
+
+const QVariant& SCgContent::contentRawData() const
 {
     return mData;
 }
 
+bool SCgContent::isContentLazy() const
+{
+    return mType == Lazy;
+}
+
 const QString& SCgContent::contentFileName() const
 {
     return mFileName;
@@ -88,5 +127,5 @@ void SCgContent::contentInfo(SCgContent::ContInfo &info)
     info.data = mData;
     info.mimeType = mMimeType;
     info.fileName = mFileName;
-    info.type = mType;
+    info.type = contentType();
 }
@@ -72,9 +72,11 @@ public:
     /*! Set content information and data
 
         @param  format Content format
-        @param  data Content data
+        @param  data Content data. If it holds SCgLazyContent, then content
+                becomes SCgContent::Lazy until data is requested. Binary data
+                is shared through SCgBlobStore.
         @param  fileName File name (if content has been loaded from file)
-        @param  cType   Content type
+        @param  cType   Content type of decoded data
      */
     virtual void setContent(const QString& mimeType, const QVariant& data,
                         const QString& fileName, ContType cType);
@@ -85,13 +87,23 @@ public:
       */
     const QString& contentFormat() const;
 
-    /*! Get contend data
+    /*! Get contend data. Lazy content is decoded on first call.
 
         @return Content data.
 
         @see SCgContent::setAllData()
       */
-    const QVariant& contentData() const;
+    QVariant contentData() const;
+
+    /*! Get content data as it's stored.
+
+        @return Content data, SCgBlob for binary content or SCgLazyContent for lazy content.
+      */
+    const QVariant& contentRawData() const;
+
+    /*! Check if content data isn't decoded yet.
+      */
+    bool isContentLazy() const;
 
     /*! Get content file name
 
@@ -99,7 +111,7 @@ public:
       */
     const QString& contentFileName() const;
 
-    /*! Get content type(1..4)
+    /*! Get content type(1..4). For lazy content returns type of decoded data.
 
         @return content type.
       */
@@ -119,11 +131,11 @@ public:
 protected:
     /*! Content type
       */
-    ContType mType;
+    mutable ContType mType;
 
     /*! Content data
       */
-    QVariant mData;
+    mutable QVariant mData;
 
     /*! Content format
       */
@@ -14,6 +14,8 @@
 #include <QVBoxLayout>
 #include <QToolButton>
 #include <QFileDialog>
+#include <QStyleOptionGraphicsItem>
+#include <QtConcurrentRun>
 #include "config.h"
 
 static const QSize resultSize(200, 200);
@@ -21,14 +23,21 @@ QString mPath;
 
 SCgContentImageViewer::SCgContentImageViewer(QGraphicsItem *parent) :
         SCgContentViewer(parent),
-        mImageLabel(0)
+        mImageLabel(0),
+        mLevel(-1),
+        mLoadingLevel(-1),
+        mPendingLevel(-1)
 {
     setMinimumSize(10, 10);
+    connect(&mWatcher, SIGNAL(finished()), this, SLOT(levelLoaded()));
 }
 
 SCgContentImageViewer::~SCgContentImageViewer()
 {
-
+    // loaded level isn't needed anymore, but task must not outlive viewer
+    disconnect(&mWatcher, SIGNAL(finished()), this, SLOT(levelLoaded()));
+    mWatcher.cancel();
+    mWatcher.waitForFinished();
 }
 
 void SCgContentImageViewer::setData(const QVariant &data)
@@ -38,19 +47,98 @@ void SCgContentImageViewer::setData(const QVariant &data)
     if (!mImageLabel)
     {
         mImageLabel = new QLabel();
+        // reduced levels are stretched to full image size
+        mImageLabel->setScaledContents(true);
+    }
+
+    mHash.clear();
+    mLevel = -1;
+    mImageSize = SCgImageCache::imageSize(data.toByteArray());
+    if (!mImageSize.isValid())
+    {
+        // format doesn't provide size in header, so image is decoded at once
+        SCgImageLevel full = SCgImageCache::loadLevel(data.toByteArray(), QByteArray(), 0);
+        mHash = full.hash;
+        mImageSize = full.image.size();
+        if (!full.image.isNull())
+        {
+            SCgImageCache::instance()->insert(full);
+            mImageLabel->setPixmap(QPixmap::fromImage(full.image));
+        }
+        mLevel = 0;
     }
 
-    QImage tempImage = QImage(resultSize, QImage::Format_ARGB32_Premultiplied);
-    if (tempImage.loadFromData(data.toByteArray()))
+    if (mImageSize.isValid())
     {
-        mImageLabel->setPixmap(QPixmap::fromImage(tempImage));
-        mImageLabel->setMinimumSize(tempImage.width(), tempImage.height());
-        mImageLabel->setFixedSize(tempImage.width(), tempImage.height());
+        mImageLabel->setMinimumSize(mImageSize);
+        mImageLabel->setFixedSize(mImageSize);
         mImageLabel->updateGeometry();
     }
     setWidget(mImageLabel);
 }
 
+void SCgContentImageViewer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    if (mImageSize.isValid())
+    {
+        qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+        requestLevel(SCgImageCache::levelForScale(mImageSize, scale));
+    }
+
+    SCgContentViewer::paint(painter, option, widget);
+}
+
+void SCgContentImageViewer::requestLevel(int level)
+{
+    if (level == mLevel || level == mLoadingLevel)
+        return;
+
+    if (!mHash.isEmpty())
+    {
+        QImage image = SCgImageCache::instance()->find(mHash, level);
+        if (!image.isNull())
+        {
+            mImageLabel->setPixmap(QPixmap::fromImage(image));
+            mLevel = level;
+            return;
+        }
+    }
+
+    if (mWatcher.isRunning())
+    {
+        mPendingLevel = level;
+        return;
+    }
+
+    mLoadingLevel = level;
+    mPendingLevel = -1;
+
+    // large data is a view over mapped file of blob store, that can be unmapped,
+    // when content is changed, so task decodes its own copy
+    const QByteArray data = mData.toByteArray();
+    mWatcher.setFuture(QtConcurrent::run(SCgImageCache::loadLevel, QByteArray(data.constData(), data.size()), mHash, level));
+}
+
+void SCgContentImageViewer::levelLoaded()
+{
+    SCgImageLevel res = mWatcher.result();
+    mLoadingLevel = -1;
+
+    mHash = res.hash;
+    // level isn't requested again, even if image can't be decoded
+    mLevel = res.level;
+    if (!res.image.isNull())
+    {
+        SCgImageCache::instance()->insert(res);
+        mImageLabel->setPixmap(QPixmap::fromImage(res.image));
+    }
+
+    int pending = mPendingLevel;
+    mPendingLevel = -1;
+    if (pending >= 0)
+        requestLevel(pending);
+}
+
 SCgContentImageDialog::SCgContentImageDialog(SCgNode *node, QWidget *parent) :
         SCgContentDialog(node, parent),
         mChooseButton(0)
@@ -60,8 +148,8 @@ SCgContentImageDialog::SCgContentImageDialog(SCgNode *node, QWidget *parent) :
     mChooseButton->setIconSize(resultSize);
     if (mNode->isContentData() && mNode->contentFormat() == "image")
     {
-        QImage tempImage = QImage(resultSize, QImage::Format_ARGB32_Premultiplied);
-        tempImage.loadFromData(mNode->contentData().toByteArray());
+        // preview uses reduced level of image
+        QImage tempImage = SCgImageCache::loadThumbnail(mNode->contentData().toByteArray(), resultSize);
         mChooseButton->setIcon(QPixmap::fromImage(tempImage));
     }
     else loadImage("", &sourceImage, mChooseButton);
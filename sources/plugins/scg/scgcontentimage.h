@@ -9,6 +9,9 @@
 #include "scgcontentdialog.h"
 #include "scgcontentfactory.h"
 #include "scgcontentviewer.h"
+#include "scgimagecache.h"
+
+#include <QFutureWatcher>
 
 
 class SCgNode;
@@ -23,13 +26,37 @@ public:
     explicit SCgContentImageViewer(QGraphicsItem *parent = 0);
     virtual ~SCgContentImageViewer();
 
+    //! Chooses image level for current scale. @see SCgImageCache
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+
 protected:
 
+    /*! Reads image size only, image is decoded asynchronously, when it's painted.
+      */
     void setData(const QVariant &data);
 
+    //! Shows level of image, if it's cached, otherwise starts its loading.
+    void requestLevel(int level);
+
     //! Widget to show image
     QLabel *mImageLabel;
 
+private slots:
+    void levelLoaded();
+
+private:
+    //! Size of full image
+    QSize mImageSize;
+    //! Hash of image data, it's known after first level loading
+    QByteArray mHash;
+    //! Shown level, -1 if there is no image yet
+    int mLevel;
+    //! Level, that is loading now, or -1
+    int mLoadingLevel;
+    //! Level, that is requested while other one is loading, or -1
+    int mPendingLevel;
+
+    QFutureWatcher<SCgImageLevel> mWatcher;
 };
 
 // ---------------------------------------------------
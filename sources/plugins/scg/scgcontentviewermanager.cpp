@@ -0,0 +1,206 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgcontentviewermanager.h"
+#include "scgnode.h"
+
+#include <QGraphicsView>
+#include <QGraphicsScene>
+#include <QPair>
+
+//! Default number of live viewers
+#define SCG_VIEWER_LIMIT            64
+//! Viewers are created in this part of viewport size around it
+#define SCG_VIEWER_LOAD_MARGIN      0.5
+//! Viewers are released out of this part of viewport size around it
+#define SCG_VIEWER_RELEASE_MARGIN   1.5
+//! Delay of merged updates in milliseconds
+#define SCG_VIEWER_UPDATE_DELAY     50
+
+SCgContentViewerManager::SCgContentViewerManager()
+    : mViewerLimit(SCG_VIEWER_LIMIT)
+{
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(SCG_VIEWER_UPDATE_DELAY);
+    connect(&mUpdateTimer, SIGNAL(timeout()), this, SLOT(updateViewers()));
+}
+
+SCgContentViewerManager* SCgContentViewerManager::instance()
+{
+    static SCgContentViewerManager manager;
+    return &manager;
+}
+
+void SCgContentViewerManager::setViewerLimit(int limit)
+{
+    mViewerLimit = limit;
+    scheduleUpdate();
+}
+
+int SCgContentViewerManager::viewerLimit() const
+{
+    return mViewerLimit;
+}
+
+int SCgContentViewerManager::viewerCount() const
+{
+    return mLiveViewers.size();
+}
+
+void SCgContentViewerManager::registerView(QGraphicsView *view)
+{
+    Q_ASSERT(view);
+    if (mViews.contains(view))
+        return;
+
+    mViews.append(view);
+    connect(view, SIGNAL(destroyed(QObject*)), this, SLOT(viewDestroyed(QObject*)));
+    scheduleUpdate();
+}
+
+void SCgContentViewerManager::unregisterView(QGraphicsView *view)
+{
+    if (mViews.removeOne(view))
+        disconnect(view, SIGNAL(destroyed(QObject*)), this, SLOT(viewDestroyed(QObject*)));
+    scheduleUpdate();
+}
+
+void SCgContentViewerManager::viewDestroyed(QObject *view)
+{
+    mViews.removeOne(static_cast<QGraphicsView*>(view));
+}
+
+void SCgContentViewerManager::loadViewers(QGraphicsScene *scene, const QRectF &rect)
+{
+    foreach (SCgNode *node, contentNodes(scene, rect))
+        node->loadContentViewer();
+
+    // extra viewers are released after rendering
+    scheduleUpdate();
+}
+
+void SCgContentViewerManager::viewerCreated(SCgNode *node)
+{
+    touch(node);
+    if (mViewerLimit > 0 && mLiveViewers.size() > mViewerLimit)
+        scheduleUpdate();
+}
+
+void SCgContentViewerManager::viewerDestroyed(SCgNode *node)
+{
+    mLiveViewers.removeOne(node);
+}
+
+void SCgContentViewerManager::scheduleUpdate()
+{
+    if (!mUpdateTimer.isActive())
+        mUpdateTimer.start();
+}
+
+QList<SCgNode*> SCgContentViewerManager::contentNodes(QGraphicsScene *scene, const QRectF &rect) const
+{
+    QList<SCgNode*> res;
+    foreach (QGraphicsItem *item, scene->items(rect, Qt::IntersectsItemBoundingRect))
+    {
+        if (item->type() != SCgNode::Type)
+            continue;
+
+        SCgNode *node = static_cast<SCgNode*>(item);
+        if (node->isContentVisible() && !node->isDead())
+            res.append(node);
+    }
+    return res;
+}
+
+void SCgContentViewerManager::touch(SCgNode *node)
+{
+    mLiveViewers.removeOne(node);
+    mLiveViewers.append(node);
+}
+
+void SCgContentViewerManager::updateViewers()
+{
+    mUpdateTimer.stop();
+
+    // visible areas and areas, where viewers are kept, by scene
+    typedef QPair<QGraphicsScene*, QRectF> SceneArea;
+    QList<SceneArea> visibleAreas, loadAreas, keepAreas;
+    foreach (QGraphicsView *view, mViews)
+    {
+        if (!view->scene() || !view->isVisible())
+            continue;
+
+        QRectF visible = view->mapToScene(view->viewport()->rect()).boundingRect();
+        qreal w = visible.width(), h = visible.height();
+        visibleAreas.append(qMakePair(view->scene(), visible));
+        loadAreas.append(qMakePair(view->scene(), visible.adjusted(-w * SCG_VIEWER_LOAD_MARGIN, -h * SCG_VIEWER_LOAD_MARGIN,
+                                                                    w * SCG_VIEWER_LOAD_MARGIN, h * SCG_VIEWER_LOAD_MARGIN)));
+        keepAreas.append(qMakePair(view->scene(), visible.adjusted(-w * SCG_VIEWER_RELEASE_MARGIN, -h * SCG_VIEWER_RELEASE_MARGIN,
+                                                                    w * SCG_VIEWER_RELEASE_MARGIN, h * SCG_VIEWER_RELEASE_MARGIN)));
+    }
+
+    // nodes, that need viewers, visible ones go first
+    QList<SCgNode*> wanted;
+    QSet<SCgNode*> wantedSet;
+    foreach (const SceneArea &area, visibleAreas + loadAreas)
+        foreach (SCgNode *node, contentNodes(area.first, area.second))
+            if (!wantedSet.contains(node))
+            {
+                wantedSet.insert(node);
+                wanted.append(node);
+            }
+
+    // release viewers of hidden content and far from all viewports
+    foreach (SCgNode *node, QList<SCgNode*>(mLiveViewers))
+    {
+        if (wantedSet.contains(node))
+            continue;
+
+        bool keep = false;
+        if (node->isContentVisible() && !node->isDead())
+        {
+            QRectF rect = node->sceneBoundingRect();
+            foreach (const SceneArea &area, keepAreas)
+                if (area.first == node->scene() && area.second.intersects(rect))
+                {
+                    keep = true;
+                    break;
+                }
+        }
+
+        if (!keep)
+            node->releaseContentViewer();
+    }
+
+    int limit = mViewerLimit > 0 ? mViewerLimit : wanted.size();
+    if (wanted.size() > limit)
+    {
+        wanted.erase(wanted.begin() + limit, wanted.end());
+        wantedSet = wanted.toSet();
+    }
+
+    // free room for wanted viewers, starting from the least recently seen
+    int needed = 0;
+    foreach (SCgNode *node, wanted)
+        if (!node->isContentViewerLoaded())
+            ++needed;
+
+    foreach (SCgNode *node, QList<SCgNode*>(mLiveViewers))
+    {
+        if (mLiveViewers.size() + needed <= limit)
+            break;
+        if (!wantedSet.contains(node))
+            node->releaseContentViewer();
+    }
+
+    foreach (SCgNode *node, wanted)
+    {
+        if (node->isContentViewerLoaded())
+            touch(node);
+        else if (mLiveViewers.size() < limit)
+            node->loadContentViewer();
+    }
+}
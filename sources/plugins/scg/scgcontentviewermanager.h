@@ -0,0 +1,83 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QList>
+#include <QSet>
+#include <QTimer>
+#include <QRectF>
+
+class QGraphicsView;
+class QGraphicsScene;
+class SCgNode;
+
+/*! Controls content viewers of all sc.g-nodes.
+ * Viewers are proxy widgets, so they are created only for visible content inside or near
+ * viewport of registered views, and released, when they are scrolled far away. Nodes keep
+ * size of released viewers, so scene geometry doesn't change.
+ * Number of live viewers is limited for all scenes: when limit is reached, viewers, that
+ * were seen the most long ago, are released first.
+ */
+class SCgContentViewerManager : public QObject
+{
+    Q_OBJECT
+public:
+    static SCgContentViewerManager* instance();
+
+    /*! Set limit of live viewers.
+      @param limit Maximum number of viewers. If it's less or equal to 0, then viewers aren't limited.
+      */
+    void setViewerLimit(int limit);
+    //! Get limit of live viewers.
+    int viewerLimit() const;
+
+    //! @return Number of live viewers.
+    int viewerCount() const;
+
+    /*! Starts tracking of view visible area. Viewers are created for its scene only.
+      View is unregistered automatically, when it's destroyed.
+      */
+    void registerView(QGraphicsView *view);
+    void unregisterView(QGraphicsView *view);
+
+    /*! Creates viewers of all visible content inside @p rect, limit isn't checked.
+      Used before rendering of scene outside of views (export, printing).
+      */
+    void loadViewers(QGraphicsScene *scene, const QRectF &rect);
+
+    //! Called by node, when its viewer was created.
+    void viewerCreated(SCgNode *node);
+    //! Called by node, when its viewer was destroyed.
+    void viewerDestroyed(SCgNode *node);
+
+public slots:
+    //! Requests update of viewers. Requests are merged and processed later.
+    void scheduleUpdate();
+
+    //! Creates viewers near viewports and releases far ones.
+    void updateViewers();
+
+private:
+    SCgContentViewerManager();
+    Q_DISABLE_COPY(SCgContentViewerManager)
+
+    //! @return Nodes with visible content, that intersect @p rect.
+    QList<SCgNode*> contentNodes(QGraphicsScene *scene, const QRectF &rect) const;
+    //! Moves node to the end of live viewers list, as the most recently seen.
+    void touch(SCgNode *node);
+
+private slots:
+    void viewDestroyed(QObject *view);
+
+private:
+    QList<QGraphicsView*> mViews;
+    //! Nodes with live viewers. The least recently seen are first.
+    QList<SCgNode*> mLiveViewers;
+    QTimer mUpdateTimer;
+    int mViewerLimit;
+};
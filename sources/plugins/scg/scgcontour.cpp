@@ -8,6 +8,7 @@
 #include "scgalphabet.h"
 
 #include "scgpointgraphicsitem.h"
+#include "scgperfcounters.h"
 #include "scgpair.h"
 #include "scgcontour.h"
 
@@ -34,14 +35,14 @@ SCgContour::~SCgContour()
 
 }
 
-QPainterPath SCgContour::shape() const
+qreal SCgContour::lineWidth() const
 {
-    return mShape;
+    return SCgAlphabet::lineWidthForShape() + 2;
 }
 
-QRectF SCgContour::boundingRect() const
+bool SCgContour::isClosed() const
 {
-    return mShape.boundingRect().adjusted(-5.f, -5.f, 5.f, 5.f);
+    return true;
 }
 
 bool SCgContour::contains(const QPointF &point) const
@@ -53,7 +54,7 @@ bool SCgContour::contains(const QPointF &point) const
             return true;
     }
 
-    return QGraphicsItem::contains(point);
+    return SCgPointObject::contains(point);
 }
 
 void SCgContour::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -83,9 +84,15 @@ void SCgContour::setPoints(const PointFVector &points)
 
 void SCgContour::positionChanged()
 {
+    SCgPerfCounters::increment(SCgPerfCounters::PositionChangedCalls);
     updateShape();
 }
 
+qreal SCgContour::borderDistance()
+{
+    return BorderDistance;
+}
+
 void SCgContour::minimize()
 {
     setPoints(minimizedPoints());
@@ -152,19 +159,17 @@ SCgPointObject::PointFVector SCgContour::minimizedPoints() const
     return newPoints;
 }
 
-void SCgContour::updateShape()
+SCgPointObject::Geometry SCgContour::buildGeometry(const PointFVector &contourPoints) const
 {
-    prepareGeometryChange();
-
-    mShape = QPainterPath();
+    Geometry res;
 
     // Generate control points to be used for path drawing
     PointFVector points;
-    quint32 pointsSize = mPoints.size();
+    quint32 pointsSize = contourPoints.size();
     for (quint32 i = 0; i < pointsSize; i++)
     {
-        QPointF p2 = mPoints[(i + 1) % pointsSize];
-        QPointF p1 = mPoints[i];
+        QPointF p2 = contourPoints[(i + 1) % pointsSize];
+        QPointF p1 = contourPoints[i];
 
         QVector2D dir(p2 - p1);
 
@@ -188,21 +193,21 @@ void SCgContour::updateShape()
     for (quint32 i = 0; i < psz3; i += 3)
     {
         if (i == 0)
-            mShape.moveTo(points[i + 1]);
-        mShape.lineTo(points[i + 2]);
-        mShape.quadTo(points[(i + 3) % psz3], points[(i + 4) % psz3]);
+            res.shapeNormal.moveTo(points[i + 1]);
+        res.shapeNormal.lineTo(points[i + 2]);
+        res.shapeNormal.quadTo(points[(i + 3) % psz3], points[(i + 4) % psz3]);
     }
-    mShape.closeSubpath();
-
-    mShapeNormal = mShape;
+    res.shapeNormal.closeSubpath();
 
-    QPainterPathStroker path_stroker;
-    path_stroker.setWidth(SCgAlphabet::lineWidthForShape() + 2);
-    mShape = path_stroker.createStroke(mShape);
+    qreal margin = (SCgAlphabet::lineWidthForShape() + 2) / 2 + 5;
+    res.boundingRect = QPolygonF(contourPoints).boundingRect().adjusted(-margin, -margin, margin, margin);
 
-    mLineShape = mShape;
+    return res;
+}
 
-    mShape = mShapeNormal.united(mShape);
+void SCgContour::applyGeometry(const Geometry &geometry)
+{
+    assignGeometry(geometry);
 
     updateConnected();
 
@@ -212,6 +217,9 @@ void SCgContour::updateShape()
 void SCgContour::updateConnected()
 {
     SCgPointObject::updateConnected();
+    if (isGeometryPropagationSuspended())
+        return;
+
     // update child items
     foreach(QGraphicsItem* grItem, childItems())
     {
@@ -229,6 +237,11 @@ void SCgContour::objectDelete(SCgObject *object)
     Q_UNUSED(object);
 }
 
+qint64 SCgContour::memoryUsage() const
+{
+    return SCgPointObject::memoryUsage() + pathMemoryUsage(mShapeDraw);
+}
+
 void SCgContour::del(QList<SCgObject*> &delList)
 {
     foreach(QGraphicsItem* grItem, childItems())
@@ -44,22 +44,23 @@ public:
       */
     PointFVector minimizedPoints() const;
 
-    //! @see SCgPointObject::updateShape;
-    void updateShape();
+    //! @see SCgPointObject::buildGeometry
+    Geometry buildGeometry(const PointFVector &points) const;
+    //! @see SCgPointObject::applyGeometry
+    void applyGeometry(const Geometry &geometry);
 
     //! @attention  points must be in local coordinates
     void setPoints(const PointFVector &points);
 
-    //! @see QGraphicsItem::shape()
-    QPainterPath shape() const;
-
-protected:
-    //! @see QGraphicsItem::boundingRect()
-    QRectF boundingRect() const;
-
     //! @see QGraphicsItem::contains
     bool contains(const QPointF &point) const;
 
+protected:
+    //! Contour border is wider than lines.
+    qreal lineWidth() const;
+    //! Contour interior belongs to it.
+    bool isClosed() const;
+
     /*! @see QGraphicsItem::paint
       */
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
@@ -80,12 +81,18 @@ public:
     //! @see SCgObject::updateConnected();
     void updateConnected();
 
+    //! @see SCgObject::memoryUsage
+    qint64 memoryUsage() const;
+
     //! @see SCgObject::del()
     void del(QList<SCgObject*> &delList);
 
     //! @see SCgPointObject::changePointPosition(int pointIndex, const QPointF& newPos)
     void changePointPosition(int pointIndex, const QPointF& newPos);
 
+    //! @return distance from border to content for minimized contour
+    static qreal borderDistance();
+
 protected:
     //! Corner radius for drawing shape
     static qreal CornerRadius;
@@ -93,9 +100,6 @@ protected:
     //! Distance from border to content for minimized contour:
     static qreal BorderDistance;
 
-    //! Contour shape
-    QPainterPath mShape;
-
     //! Drawable shape
     QPainterPath mShapeDraw;
 
@@ -8,11 +8,13 @@
 
 #include "scgdefaultobjectbuilder.h"
 #include "scgobjectsinfo.h"
+#include "scgscene.h"
 
 #include "scgnode.h"
 #include "scgbus.h"
 #include "scgcontour.h"
 #include "scgpair.h"
+#include "trace.h"
 
 DefaultSCgObjectBuilder::DefaultSCgObjectBuilder(QGraphicsScene* scene)
     : AbstractSCgObjectBuilder()
@@ -26,6 +28,19 @@ DefaultSCgObjectBuilder::~DefaultSCgObjectBuilder()
 
 void DefaultSCgObjectBuilder::buildObjects(const AbstractSCgObjectBuilder::TypeToObjectsMap& objects)
 {
+    KBE_TRACE_SCOPE("scg", "build");
+
+    // objects are added and wired without rebuilding of their geometry,
+    // it's calculated once when all of them are built
+    int count = objectCount(objects);
+    SCgScene *scene = qobject_cast<SCgScene*>(mScene);
+    if (scene)
+        scene->beginBulkInsert(count);
+
+    mIdIndex.reserve(count);
+    mObjects.reserve(count);
+    mParents.reserve(count);
+
     SCgObjectInfo* info;
     // parse nodes
     foreach(info, objects[SCgNode::Type])
@@ -41,16 +56,15 @@ void DefaultSCgObjectBuilder::buildObjects(const AbstractSCgObjectBuilder::TypeT
         buildContour(static_cast<SCgContourInfo*>(info));
 
     // set parents relation
-    ParentChildMap::iterator parentIt;
-    for (parentIt = mParentChild.begin(); parentIt != mParentChild.end(); parentIt++)
+    for (int i = 0; i < mObjects.size(); ++i)
     {
-        if (!mId2SCgObj.contains(parentIt.value()))
+        SCgObject *child = mObjects.at(i);
+        if (!child || mParents.at(i) < 0)
             continue;
 
-        SCgObject *parent = mId2SCgObj[parentIt.value()];
-        SCgObject *child = mId2SCgObj[parentIt.key()];
-
-        child->setParentItem(parent);
+        SCgObject *parent = mObjects.at(mParents.at(i));
+        if (parent)
+            child->setParentItem(parent);
     }
 
     // holds true, if there are errors while setting begin and end objects.
@@ -59,23 +73,25 @@ void DefaultSCgObjectBuilder::buildObjects(const AbstractSCgObjectBuilder::TypeT
     foreach(SCgObjectInfo* info, objects[SCgPair::Type])
     {
         SCgPairInfo* pairInfo = static_cast<SCgPairInfo*>(info);
-        SCgPair *pair = static_cast<SCgPair*>(mId2SCgObj[pairInfo->id()]);
+        int pairIndex = internId(pairInfo->id());
+        SCgPair *pair = static_cast<SCgPair*>(mObjects.at(pairIndex));
+        if (!pair)
+            continue;
+
+        SCgObject *begObject = findObject(pairInfo->beginObjectId());
+        SCgObject *endObject = findObject(pairInfo->endObjectId());
 
         // we can't build pair without begin or end objects
-        if (!mId2SCgObj.contains(pairInfo->beginObjectId()) ||
-            !mId2SCgObj.contains(pairInfo->endObjectId()))
+        if (!begObject || !endObject)
         {
             mErrors.append(QObject::tr("Can't find begin or end object for pair id=\"%1\"")
                                             .arg(pairInfo->id()));
-            mId2SCgObj.remove(pairInfo->id());
+            mObjects[pairIndex] = 0;
             isConnectedDuty = true;
             delete pair;
             continue;
         }
 
-        SCgObject *begObject = mId2SCgObj[pairInfo->beginObjectId()];
-        SCgObject *endObject = mId2SCgObj[pairInfo->endObjectId()];
-
         pair->setBeginObject(begObject);
         pair->setEndObject(endObject);
     }
@@ -88,13 +104,14 @@ void DefaultSCgObjectBuilder::buildObjects(const AbstractSCgObjectBuilder::TypeT
         foreach(SCgObjectInfo* info, objects[SCgPair::Type])
         {
             SCgPairInfo* pairInfo = static_cast<SCgPairInfo*>(info);
+            int pairIndex = internId(pairInfo->id());
 
-            bool isNotContainOne = !(mId2SCgObj.contains(pairInfo->beginObjectId()) &&
-                                     mId2SCgObj.contains(pairInfo->endObjectId()));
-            if (  mId2SCgObj.contains(pairInfo->id()) && isNotContainOne)
+            bool isNotContainOne = !(findObject(pairInfo->beginObjectId()) &&
+                                     findObject(pairInfo->endObjectId()));
+            if (mObjects.at(pairIndex) && isNotContainOne)
             {
-                SCgPair *pair = static_cast<SCgPair*>(mId2SCgObj[pairInfo->id()]);
-                mId2SCgObj.remove(pairInfo->id());
+                SCgPair *pair = static_cast<SCgPair*>(mObjects.at(pairIndex));
+                mObjects[pairIndex] = 0;
                 delete pair;
                 isConnectedDuty = true;
             }
@@ -105,9 +122,9 @@ void DefaultSCgObjectBuilder::buildObjects(const AbstractSCgObjectBuilder::TypeT
     foreach(SCgObjectInfo* info, objects[SCgBus::Type])
     {
         SCgBusInfo* busInfo = static_cast<SCgBusInfo*>(info);
-        SCgObject *objectOwner = 0;
+        SCgObject *objectOwner = findObject(busInfo->ownerId());
 
-        if (!mId2SCgObj.contains(busInfo->ownerId()))
+        if (!objectOwner)
         {
             SCgNode *node = new SCgNode;
 
@@ -115,8 +132,7 @@ void DefaultSCgObjectBuilder::buildObjects(const AbstractSCgObjectBuilder::TypeT
             node->setTypeAlias("node/const/general_node");
             objectOwner = node;
             mScene->addItem(node);
-        }else
-            objectOwner = mId2SCgObj[busInfo->ownerId()];
+        }
 
         // check type and set owner to bus
         if (objectOwner->type() != SCgNode::Type)
@@ -127,42 +143,74 @@ void DefaultSCgObjectBuilder::buildObjects(const AbstractSCgObjectBuilder::TypeT
             continue;
         }
 
-        SCgBus *bus = static_cast<SCgBus*>(mId2SCgObj[busInfo->id()]);
+        SCgBus *bus = static_cast<SCgBus*>(findObject(busInfo->id()));
         SCgNode *owner = static_cast<SCgNode*>(objectOwner);
 
         bus->setOwner(owner);
     }
+
+    if (scene)
+        scene->endBulkInsert(objects());
 }
 
 void DefaultSCgObjectBuilder::setObjectInfo(SCgObject* obj, SCgObjectInfo* info)
 {
+    // Adding item on scene first, so it doesn't rebuild geometry while it's set up
+    mScene->addItem(obj);
+
     obj->setTypeAlias(info->typeAlias());
     obj->setIdtfValue(info->idtfValue());
 
-    // store parent id
-    mParentChild[info->id()] = info->parentId();
+    // store for id mapping and parent id
+    int parent = internId(info->parentId());
+    int index = internId(info->id());
+    mObjects[index] = obj;
+    mParents[index] = parent;
+}
 
-    // store for id mapping
-    mId2SCgObj[info->id()] = obj;
+int DefaultSCgObjectBuilder::internId(const QString &id)
+{
+    IdIndexMap::const_iterator it = mIdIndex.constFind(id);
+    if (it != mIdIndex.constEnd())
+        return it.value();
+
+    int index = mObjects.size();
+    mIdIndex.insert(id, index);
+    mObjects.append(0);
+    mParents.append(-1);
+    return index;
+}
 
-    // Adding item on scene
-    mScene->addItem(obj);
+SCgObject* DefaultSCgObjectBuilder::findObject(const QString &id) const
+{
+    IdIndexMap::const_iterator it = mIdIndex.constFind(id);
+    return it != mIdIndex.constEnd() ? mObjects.at(it.value()) : 0;
+}
+
+QList<SCgObject*> DefaultSCgObjectBuilder::objects() const
+{
+    QList<SCgObject*> res;
+    res.reserve(mObjects.size());
+    foreach (SCgObject *obj, mObjects)
+        if (obj)
+            res.append(obj);
+    return res;
 }
 
 void DefaultSCgObjectBuilder::buildNode(SCgNodeInfo* info)
 {
-    if(!mId2SCgObj.contains(info->id()))
+    if(!findObject(info->id()))
     {
         SCgNode *node = new SCgNode;
+        setObjectInfo(node, info);
 
         node->setPos(info->pos());
         node->setContent(info->contentMimeType(),
                          info->contentData(),
                          info->contentFilename(),
                          (SCgContent::ContType)info->contentType());
-        if (!node->contentData().isNull() && info->contentVisible())
+        if (node->isContentData() && info->contentVisible())
             node->showContent();
-        setObjectInfo(node, info);
         node->setIdtfPos((SCgNode::IdentifierPosition)info->idtfPos());
 
     }
@@ -170,27 +218,25 @@ void DefaultSCgObjectBuilder::buildNode(SCgNodeInfo* info)
 
 void DefaultSCgObjectBuilder::buildPair(SCgPairInfo* info)
 {
-    if(!mId2SCgObj.contains(info->id()))
+    if(!findObject(info->id()))
     {
         SCgPair* pair = new SCgPair;
+        setObjectInfo(pair, info);
 
         pair->setBeginDot(info->beginDot());
         pair->setEndDot(info->endDot());
         pair->setPoints(info->points());
-
-        setObjectInfo(pair, info);
     }
 }
 
 void DefaultSCgObjectBuilder::buildBus(SCgBusInfo* info)
 {
-    if(!mId2SCgObj.contains(info->id()))
+    if(!findObject(info->id()))
     {
         SCgBus* bus = new SCgBus;
+        setObjectInfo(bus, info);
 
         bus->setPoints(info->points());
-
-        setObjectInfo(bus, info);
     }
 }
 
@@ -198,14 +244,13 @@ void DefaultSCgObjectBuilder::buildContour(SCgContourInfo* info)
 {
     if(info->points().size() > 2)
     {
-        if(!mId2SCgObj.contains(info->id()))
+        if(!findObject(info->id()))
         {
             SCgContour* contour = new SCgContour;
+            setObjectInfo(contour, info);
 
             contour->setPos(QPolygonF(info->points()).boundingRect().center());
             contour->setPoints(info->points());
-
-            setObjectInfo(contour, info);
         }
     }else
     {
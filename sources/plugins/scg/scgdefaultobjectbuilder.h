@@ -8,6 +8,9 @@
 
 #include "scgabstractobjectbuilder.h"
 
+#include <QHash>
+#include <QVector>
+
 class SCgNodeInfo;
 class SCgPairInfo;
 class SCgBusInfo;
@@ -15,6 +18,7 @@ class SCgContourInfo;
 
 //! @see AbstractSCgObjectBuilder.
 //! Simple create and place objects to scene.
+//! On SCgScene objects are built in bulk insertion mode. @see SCgScene::beginBulkInsert
 class DefaultSCgObjectBuilder: public AbstractSCgObjectBuilder
 {
 public:
@@ -23,10 +27,7 @@ public:
 
     void buildObjects(const TypeToObjectsMap& objects);
 
-    QList<SCgObject*> objects()const
-    {
-        return mId2SCgObj.values();
-    }
+    QList<SCgObject*> objects()const;
 
     bool hasErrors() const
     {
@@ -39,13 +40,20 @@ public:
     }
 
 protected:
-    typedef QMap<QString, SCgObject*> Id2SCgObjMap;
-    //! Map for elements id mapping
-    Id2SCgObjMap mId2SCgObj;
+    /*! @return Index of @p id. Ids of objects and of their references are interned,
+     * when they are met first time, so relations are stored as indexes.
+     */
+    int internId(const QString &id);
+    //! @return Built object with @p id or null, if there is no such object.
+    SCgObject* findObject(const QString &id) const;
 
-    typedef QMap<QString, QString> ParentChildMap;
-    //! Map for store parent-child  relationship
-    ParentChildMap mParentChild;
+    typedef QHash<QString, int> IdIndexMap;
+    //! Interned ids
+    IdIndexMap mIdIndex;
+    //! Built objects by id index, null if object with this id isn't built
+    QVector<SCgObject*> mObjects;
+    //! Parent id index by id index of object
+    QVector<int> mParents;
 
     /*! Sets up some object info (typeAlias, Idtf), store mapping information
      * and adding object to scene.
@@ -16,6 +16,7 @@
 #include <QLabel>
 #include <QCheckBox>
 #include <QHideEvent>
+#include <QFileInfo>
 
 SCgFindWidget::SCgFindWidget(QWidget *parent):
         QWidget(parent),
@@ -64,6 +65,10 @@ SCgFindWidget::SCgFindWidget(QWidget *parent):
     mWrappedLabel->hide();
     layout->addWidget(mWrappedLabel);
 
+    mProjectLabel = new QLabel(this);
+    mProjectLabel->hide();
+    layout->addWidget(mProjectLabel);
+
     layout->addStretch();
 
     hide();
@@ -112,6 +117,27 @@ void SCgFindWidget::setTextWrappedVisible(bool visible)
     mWrappedLabel->setVisible(visible);
 }
 
+void SCgFindWidget::setProjectMatches(const QStringList &files)
+{
+    if (files.isEmpty())
+    {
+        mProjectLabel->hide();
+        return;
+    }
+
+    // full list is in tooltip
+    const int maxNames = 5;
+    QStringList names;
+    for (int i = 0; i < files.size() && i < maxNames; ++i)
+        names << QFileInfo(files[i]).fileName();
+    if (files.size() > maxNames)
+        names << "...";
+
+    mProjectLabel->setText(tr("Found in project: %1").arg(names.join(", ")));
+    mProjectLabel->setToolTip(files.join("\n"));
+    mProjectLabel->show();
+}
+
 void SCgFindWidget::hideEvent(QHideEvent* event)
 {
     Q_UNUSED(event);
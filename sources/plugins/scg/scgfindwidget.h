@@ -36,6 +36,11 @@ public:
 
     void setTextWrappedVisible(bool visible);
 
+    /*! Shows other project files, that contain searched identifier.
+      @param files Absolute file names, label is hidden if it's empty.
+      */
+    void setProjectMatches(const QStringList &files);
+
 signals:
     void escapePressed();
 
@@ -63,6 +68,7 @@ private:
     QCheckBox *mCaseSensitivityChaeck;
     QLabel *mFindLabel;
     QLabel *mWrappedLabel;
+    QLabel *mProjectLabel;
     QToolButton *mFindNextButton;
     QToolButton *mCloseButton;
     QToolButton *mFindPreviousButton;
@@ -0,0 +1,162 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgimagecache.h"
+#include "scgblobstore.h"
+#include "trace.h"
+
+#include <QBuffer>
+#include <QImageReader>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+
+#include <climits>
+
+//! Images of smaller levels aren't created
+#define SCG_IMAGE_MIN_LEVEL_SIZE    64
+//! Default size of memory cache in bytes
+#define SCG_IMAGE_CACHE_MEMORY      (64 * 1024 * 1024)
+
+SCgImageCache::SCgImageCache()
+{
+    mImages.setMaxCost(SCG_IMAGE_CACHE_MEMORY);
+}
+
+SCgImageCache* SCgImageCache::instance()
+{
+    static SCgImageCache cache;
+    return &cache;
+}
+
+QImage SCgImageCache::find(const QByteArray &hash, int level)
+{
+    QImage *image = mImages.object(levelKey(hash, level));
+    return image ? *image : QImage();
+}
+
+void SCgImageCache::insert(const SCgImageLevel &level)
+{
+    if (level.image.isNull() || level.hash.isEmpty())
+        return;
+
+    mImages.insert(levelKey(level.hash, level.level), new QImage(level.image), level.image.byteCount());
+}
+
+void SCgImageCache::setMemoryLimit(qint64 limit)
+{
+    mImages.setMaxCost((int)qMin<qint64>(limit, INT_MAX));
+}
+
+qint64 SCgImageCache::memoryUsage() const
+{
+    return mImages.totalCost();
+}
+
+SCgImageLevel SCgImageCache::loadLevel(const QByteArray &data, QByteArray hash, int level)
+{
+    KBE_TRACE_SCOPE("scg", "image.decode");
+    SCgImageLevel res;
+    res.hash = hash.isEmpty() ? SCgBlobStore::hashOf(data) : hash;
+    res.level = level;
+
+    QString path = levelPath(res.hash, level);
+    if (level > 0 && QFile::exists(path) && res.image.load(path))
+    {
+        res.image = res.image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        return res;
+    }
+
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer);
+
+    // some formats (jpeg) decode reduced image much faster
+    QSize size = reader.size();
+    if (level > 0 && size.isValid())
+        reader.setScaledSize(levelSize(size, level));
+
+    if (!reader.read(&res.image))
+        return res;
+
+    res.image = res.image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    if (level > 0 && QDir().mkpath(QFileInfo(path).path()))
+    {
+        // concurrent loaders of the same level don't see partially written files
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly) && res.image.save(&file, "PNG"))
+            file.commit();
+    }
+
+    return res;
+}
+
+QImage SCgImageCache::loadThumbnail(const QByteArray &data, const QSize &maxSize)
+{
+    QSize size = imageSize(data);
+
+    int level = 0;
+    while (level + 1 < levelCount(size))
+    {
+        QSize next = levelSize(size, level + 1);
+        if (next.width() < maxSize.width() && next.height() < maxSize.height())
+            break;
+        ++level;
+    }
+
+    QImage image = loadLevel(data, QByteArray(), level).image;
+    if (!image.isNull() && (image.width() > maxSize.width() || image.height() > maxSize.height()))
+        image = image.scaled(maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    return image;
+}
+
+QSize SCgImageCache::imageSize(const QByteArray &data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    return QImageReader(&buffer).size();
+}
+
+int SCgImageCache::levelCount(const QSize &size)
+{
+    int count = 1;
+    int dim = qMax(size.width(), size.height());
+    while (dim / 2 >= SCG_IMAGE_MIN_LEVEL_SIZE)
+    {
+        dim /= 2;
+        ++count;
+    }
+    return count;
+}
+
+QSize SCgImageCache::levelSize(const QSize &size, int level)
+{
+    return QSize(qMax(1, size.width() >> level), qMax(1, size.height() >> level));
+}
+
+int SCgImageCache::levelForScale(const QSize &size, qreal scale)
+{
+    int level = 0;
+    int maxLevel = levelCount(size) - 1;
+    // next level is used, while it has at least one pixel per device pixel
+    while (level < maxLevel && scale * (1 << (level + 1)) <= 1.0)
+        ++level;
+    return level;
+}
+
+QString SCgImageCache::levelKey(const QByteArray &hash, int level)
+{
+    return QString("%1_%2").arg(QString::fromLatin1(hash)).arg(level);
+}
+
+QString SCgImageCache::levelPath(const QByteArray &hash, int level)
+{
+    static QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/scg-images";
+    return dir + "/" + levelKey(hash, level) + ".png";
+}
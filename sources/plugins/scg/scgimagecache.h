@@ -0,0 +1,86 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+//! Decoded image of one detail level. @see SCgImageCache
+struct SCgImageLevel
+{
+    SCgImageLevel() : level(0) {}
+
+    //! Hex encoded hash of image data. @see SCgBlobStore::hashOf
+    QByteArray hash;
+    int level;
+    QImage image;
+};
+
+/*! Multi-resolution cache of image contents.
+ * Level 0 is the full image, each next level is two times smaller, down to
+ * SCG_IMAGE_MIN_LEVEL_SIZE pixels. Images are identified by hash of their data.
+ * Decoded levels are kept in memory with limited total size, and reduced levels
+ * are also stored on disk, so they aren't decoded again in next sessions.
+ *
+ * Cache itself is used from GUI thread only, levels are loaded by static loadLevel(),
+ * that may be run in worker thread.
+ */
+class SCgImageCache
+{
+public:
+    static SCgImageCache* instance();
+
+    /*! Finds decoded level in memory.
+      @return Null image, if level isn't cached.
+      */
+    QImage find(const QByteArray &hash, int level);
+    //! Puts decoded level to memory cache.
+    void insert(const SCgImageLevel &level);
+
+    //! Set limit of memory cache in bytes.
+    void setMemoryLimit(qint64 limit);
+    //! @return Size of decoded levels in memory cache.
+    qint64 memoryUsage() const;
+
+    /*! Decodes level of image. Reduced levels are read from disk cache, if they exist,
+      otherwise they are decoded and written to disk cache. Full image isn't cached on disk,
+      it's always decoded from data. Thread safe.
+      @param data Encoded image.
+      @param hash Hash of @p data. If it's empty, then it's calculated.
+      @param level Level to load.
+      */
+    static SCgImageLevel loadLevel(const QByteArray &data, QByteArray hash, int level);
+
+    /*! Decodes image, that fits into @p maxSize, using the smallest suitable level.
+      Used for previews.
+      */
+    static QImage loadThumbnail(const QByteArray &data, const QSize &maxSize);
+
+    //! @return Size of image, read from its header without decoding. Invalid size, if it's unknown.
+    static QSize imageSize(const QByteArray &data);
+    //! @return Number of levels of image with full size @p size.
+    static int levelCount(const QSize &size);
+    //! @return Size of image @p level.
+    static QSize levelSize(const QSize &size, int level);
+    /*! @return The smallest level, that has enough details to be shown with @p scale.
+      @param scale Device pixels per image pixel.
+      */
+    static int levelForScale(const QSize &size, qreal scale);
+
+private:
+    SCgImageCache();
+    Q_DISABLE_COPY(SCgImageCache)
+
+    static QString levelKey(const QByteArray &hash, int level);
+    //! @return Path of reduced level in disk cache.
+    static QString levelPath(const QByteArray &hash, int level);
+
+    QCache<QString, QImage> mImages;
+};
@@ -0,0 +1,169 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scglazycontent.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryFile>
+#include <QDir>
+
+//! Size of block used to copy source into side store
+#define SCG_CONTENT_COPY_BLOCK  (1 << 20)
+
+QMutex SCgContentSource::mSourcesMutex;
+SCgContentSource::SourceList SCgContentSource::mSources;
+
+SCgContentSource::SCgContentSource()
+    : mFile(0)
+    , mData(0)
+    , mSize(0)
+{
+}
+
+SCgContentSource::~SCgContentSource()
+{
+    {
+        QMutexLocker locker(&mSourcesMutex);
+        mSources.removeOne(this);
+    }
+
+    delete mFile;
+}
+
+QSharedPointer<SCgContentSource> SCgContentSource::open(const QString &fileName)
+{
+    QSharedPointer<SCgContentSource> source(new SCgContentSource());
+
+    QFile *file = new QFile(fileName);
+    if (!file->open(QFile::ReadOnly) || !source->map(file))
+    {
+        delete file;
+        return QSharedPointer<SCgContentSource>();
+    }
+    source->mFileName = QFileInfo(fileName).canonicalFilePath();
+
+    QMutexLocker locker(&mSourcesMutex);
+    mSources.append(source.data());
+
+    return source;
+}
+
+bool SCgContentSource::map(QFile *file)
+{
+    uchar *data = file->size() > 0 ? file->map(0, file->size()) : 0;
+    if (!data)
+        return false;
+
+    delete mFile;
+    mFile = file;
+    mData = data;
+    mSize = file->size();
+
+    return true;
+}
+
+QByteArray SCgContentSource::read(quint64 offset, quint64 size)
+{
+    QMutexLocker locker(&mMutex);
+
+    if (offset > mSize || size > mSize - offset)
+        return QByteArray();
+
+    return QByteArray(reinterpret_cast<const char*>(mData + offset), size);
+}
+
+void SCgContentSource::detachFile(const QString &fileName)
+{
+    QString canonicalName = QFileInfo(fileName).canonicalFilePath();
+    if (canonicalName.isEmpty())
+        return;
+
+    QMutexLocker locker(&mSourcesMutex);
+    foreach (SCgContentSource *source, mSources)
+        if (source->mFileName == canonicalName)
+            source->detach();
+}
+
+void SCgContentSource::detach()
+{
+    QMutexLocker locker(&mMutex);
+
+    QTemporaryFile *store = new QTemporaryFile(QDir::tempPath() + "/kbe_content_XXXXXX");
+    bool res = store->open();
+    for (quint64 pos = 0; res && pos < mSize; pos += SCG_CONTENT_COPY_BLOCK)
+    {
+        qint64 size = qMin<quint64>(SCG_CONTENT_COPY_BLOCK, mSize - pos);
+        res = store->write(reinterpret_cast<const char*>(mData + pos), size) == size;
+    }
+
+    if (res && store->flush() && map(store))
+    {
+        mFileName.clear();
+        return;
+    }
+
+    // keep original file, it's better than loosing contents
+    delete store;
+}
+
+// ---------------------
+SCgLazyContent::SCgLazyContent()
+    : mType(SCgContent::Empty)
+    , mEncoding(Raw)
+    , mOffset(0)
+    , mSize(0)
+{
+}
+
+SCgLazyContent::SCgLazyContent(SCgContent::ContType type, const QByteArray &data, Encoding encoding)
+    : mType(type)
+    , mEncoding(encoding)
+    , mData(data)
+    , mOffset(0)
+    , mSize(0)
+{
+}
+
+SCgLazyContent::SCgLazyContent(SCgContent::ContType type, const QSharedPointer<SCgContentSource> &source,
+                               quint64 offset, quint64 size, Encoding encoding)
+    : mType(type)
+    , mEncoding(encoding)
+    , mSource(source)
+    , mOffset(offset)
+    , mSize(size)
+{
+}
+
+QByteArray SCgLazyContent::encodedData() const
+{
+    if (mSource)
+        return mSource->read(mOffset, mSize);
+
+    return mData;
+}
+
+QVariant SCgLazyContent::data() const
+{
+    QByteArray data = encodedData();
+    if (mEncoding == Base64)
+        data = QByteArray::fromBase64(data);
+
+    if (mType == SCgContent::Data)
+        return QVariant(data);
+
+    return QVariant(QString::fromUtf8(data));
+}
+
+qint64 SCgLazyContent::memoryUsage() const
+{
+    return sizeof(SCgLazyContent) + mData.size();
+}
+
+bool SCgLazyContent::isLazy(const QVariant &data)
+{
+    return data.userType() == qMetaTypeId<SCgLazyContent>();
+}
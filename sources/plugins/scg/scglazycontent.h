@@ -0,0 +1,138 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "scgcontent.h"
+
+#include <QSharedPointer>
+#include <QMetaType>
+#include <QMutex>
+
+class QFile;
+class QTemporaryFile;
+
+//! Read-only file, that holds encoded contents of nodes.
+/*! File is mapped into memory and stays mapped while any content refers to it.
+    Before the file gets overwritten, call detachFile(): all sources of that file
+    move their data into temporary side store. All methods are thread-safe.
+  */
+class SCgContentSource
+{
+public:
+    ~SCgContentSource();
+
+    /*! Opens source file.
+      @param fileName Name of file.
+      @return Pointer to opened source or null pointer if file can't be mapped.
+      */
+    static QSharedPointer<SCgContentSource> open(const QString &fileName);
+
+    /*! Reads range of file.
+      @return Read bytes or empty array if range is out of file.
+      */
+    QByteArray read(quint64 offset, quint64 size);
+
+    /*! Makes all sources, opened for \p fileName, independent from that file.
+      Must be called before file gets replaced.
+      */
+    static void detachFile(const QString &fileName);
+
+private:
+    SCgContentSource();
+    Q_DISABLE_COPY(SCgContentSource)
+
+    //! Maps \p file. @return If file mapped, then return true, else - false.
+    bool map(QFile *file);
+    //! Copies mapped data into side store and maps it.
+    void detach();
+
+    QMutex mMutex;
+    //! Canonical name of source file, empty after detach.
+    QString mFileName;
+    QFile *mFile;
+    uchar *mData;
+    quint64 mSize;
+
+    typedef QList<SCgContentSource*> SourceList;
+    static QMutex mSourcesMutex;
+    //! All living sources.
+    static SourceList mSources;
+};
+
+
+//! Node content, that isn't decoded yet.
+/*! Stored as node content data with SCgContent::Lazy type. Encoded data is kept
+    in memory or as a byte range in SCgContentSource, and decoded on demand.
+    Copies are cheap, so lazy content can be passed to worker threads.
+  */
+class SCgLazyContent
+{
+public:
+    //! Encoding of stored data
+    enum Encoding
+    {
+        Raw = 0,
+        Base64
+    };
+
+    SCgLazyContent();
+
+    /*! Creates content from encoded data in memory.
+      @param type Content type of decoded data.
+      @param data Encoded data.
+      @param encoding Encoding of data.
+      */
+    SCgLazyContent(SCgContent::ContType type, const QByteArray &data, Encoding encoding);
+
+    /*! Creates content from range of source file.
+      @param type Content type of decoded data.
+      @param source Source file.
+      @param offset Offset of encoded data in file.
+      @param size Size of encoded data.
+      @param encoding Encoding of data.
+      */
+    SCgLazyContent(SCgContent::ContType type, const QSharedPointer<SCgContentSource> &source,
+                   quint64 offset, quint64 size, Encoding encoding);
+
+    //! @return Content type of decoded data.
+    SCgContent::ContType type() const { return mType; }
+
+    //! @return Encoding of stored data.
+    Encoding encoding() const { return mEncoding; }
+
+    //! @return Hash of decoded data, if it's known. @see SCgBlobStore::hashOf
+    const QByteArray& hash() const { return mHash; }
+
+    //! Sets hash of decoded data. It must be computed from data, not taken from file.
+    void setHash(const QByteArray &hash) { mHash = hash; }
+
+    //! @return Stored data as is. Reads source file, if content refers to it.
+    QByteArray encodedData() const;
+
+    //! @return Decoded data in the same form, as it's used for not lazy content.
+    QVariant data() const;
+
+    //! @return Amount of memory used by data, that isn't in source file.
+    qint64 memoryUsage() const;
+
+    //! @return True, if \p data holds lazy content.
+    static bool isLazy(const QVariant &data);
+
+private:
+    SCgContent::ContType mType;
+    Encoding mEncoding;
+    QByteArray mHash;
+
+    QByteArray mData;
+
+    QSharedPointer<SCgContentSource> mSource;
+    quint64 mOffset;
+    quint64 mSize;
+};
+
+Q_DECLARE_METATYPE(SCgLazyContent)
+
@@ -8,10 +8,14 @@
 
 #include "scgcontentfactory.h"
 #include "scgcontentviewer.h"
+#include "scgcontentviewermanager.h"
+#include "scglazycontent.h"
+#include "scgblobstore.h"
 #include "scgbus.h"
 #include "scgview.h"
 #include "scgnodetextitem.h"
 #include "scgconfig.h"
+#include "scgperfcounters.h"
 
 #include <QPainter>
 #include <QVector2D>
@@ -20,6 +24,11 @@
 
 #define DEFAULT_IDTF_POS BottomRight
 
+//! Approximate size of content viewer (proxy widget with embedded widget)
+#define SCG_CONTENT_VIEWER_MEMORY   65536
+//! Size of visible content, which viewer wasn't created yet
+#define SCG_CONTENT_PLACEHOLDER_SIZE    QSizeF(64.f, 64.f)
+
 SCgNode::SCgNode(QGraphicsItem *parent) :
     SCgObject(parent),
     SCgContent(),
@@ -37,11 +46,11 @@ SCgNode::SCgNode(QGraphicsItem *parent) :
 SCgNode::~SCgNode()
 {
     //Q_ASSERT(!mBus);    // must be deleted before
-    if (mContentViewer)
-    {
-        delete mContentViewer;
-        mContentViewer = 0;
-    }
+    releaseContentViewer();
+
+    // parked data is released with handle, that is returned
+    if (!mCompactedBlob.isEmpty())
+        SCgBlobStore::instance()->unpark(mCompactedBlob);
 
     if (mBus)
     {
@@ -88,9 +97,11 @@ QRectF SCgNode::boundingRect() const
         res = QRectF(-mSize.width() / 2.f, -mSize.height() / 2.f, mSize.width(), mSize.height());
     }else
     {
-        Q_ASSERT(mContentViewer);
+        // released viewer keeps its place
+        QSizeF size = mContentViewer ? mContentViewer->size() : mContentSize;
+        if (!size.isValid())
+            size = SCG_CONTENT_PLACEHOLDER_SIZE;
 
-        QSizeF size = mContentViewer->size();
         res = QRectF(0, 0, size.width(), size.height());
         res.moveCenter(QPointF(0.f, 0.f));
         res.adjust(-5, -5, 5, 5);
@@ -148,6 +159,7 @@ QVariant SCgNode::itemChange(GraphicsItemChange change, const QVariant &value)
 
 void SCgNode::positionChanged()
 {
+    SCgPerfCounters::increment(SCgPerfCounters::PositionChangedCalls);
 }
 
 void SCgNode::objectDelete(SCgObject *object)
@@ -159,8 +171,7 @@ void SCgNode::objectDelete(SCgObject *object)
 
 void SCgNode::del(QList<SCgObject*> &delList)
 {
-    if(mIsContentVisible)
-        mContentViewer->hide();
+    releaseContentViewer();
 
     if(mBus)
         mBus->del(delList);
@@ -175,7 +186,7 @@ void SCgNode::undel(SCgScene* scene)
 
     SCgObject::undel(scene);
     if(mIsContentVisible)
-        mContentViewer->show();
+        SCgContentViewerManager::instance()->scheduleUpdate();
 }
 
 QPointF SCgNode::cross(const QPointF &from, float dot) const
@@ -295,6 +306,9 @@ void SCgNode::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, Q
 void SCgNode::updateConnected()
 {
     SCgObject::updateConnected();
+    if (isGeometryPropagationSuspended())
+        return;
+
     if (mBus && !mBus->isDead())
         mBus->positionChanged();
 }
@@ -309,27 +323,31 @@ void SCgNode::setContent(const QString& mimeType, const QVariant& data,
 
 void SCgNode::showContent()
 {
-    Q_ASSERT(!mIsContentVisible && mContentViewer);
+    Q_ASSERT(!mIsContentVisible && isContentData());
 
     prepareGeometryChange();
 
     mIsContentVisible = true;
     updateConnected();
 
-    mContentViewer->show();
+    // viewer is created, when node is near viewport
+    if (mContentViewer)
+        mContentViewer->show();
+    else
+        SCgContentViewerManager::instance()->scheduleUpdate();
     update();
 }
 
 void SCgNode::hideContent()
 {
-    Q_ASSERT(mIsContentVisible && mContentViewer);
+    Q_ASSERT(mIsContentVisible);
 
     prepareGeometryChange();
 
     mIsContentVisible = false;
     updateConnected();
 
-    mContentViewer->hide();
+    releaseContentViewer();
     update();
 }
 
@@ -346,32 +364,71 @@ void SCgNode::updateContentViewer()
     if(isCntVis)
         hideContent();
 
-    if (mContentViewer != 0)
-    {
-        delete mContentViewer;
-        mContentViewer = 0;
-    }
+    releaseContentViewer();
+    // size of new content is known after its viewer creation
+    mContentSize = QSizeF();
 
-    if (!contentType() == SCgContent::Empty)
-    {
-        // creating new viewer
-        if (!mContentViewer) mContentViewer = SCgContentFactory::createViewer(contentFormat());
-        Q_ASSERT(mContentViewer);
+    if (contentType() != SCgContent::Empty && isCntVis)
+        showContent();
+
+    update();
+}
 
-        mContentViewer->setData(contentData());
-        mContentViewer->setParentItem(this);
+void SCgNode::createContentViewer()
+{
+    Q_ASSERT(!mContentViewer);
+
+    mContentViewer = SCgContentFactory::createViewer(contentFormat());
+    Q_ASSERT(mContentViewer);
+
+    // lazy content is decoded, when viewer is created first time
+    mContentViewer->setData(contentData());
+    mContentViewer->setParentItem(this);
+    mContentSize = mContentViewer->size();
+
+    SCgContentViewerManager::instance()->viewerCreated(this);
+}
 
-        if (isCntVis)
-            showContent();
+void SCgNode::loadContentViewer()
+{
+    if (mContentViewer || contentType() == SCgContent::Empty)
+        return;
+
+    QSizeF oldSize = mContentSize;
+    prepareGeometryChange();
+    createContentViewer();
+
+    if (mIsContentVisible)
+    {
+        mContentViewer->show();
+        if (oldSize != mContentSize)
+            updateConnected();
     }
     update();
 }
 
-bool SCgNode::isContentData() const
+void SCgNode::releaseContentViewer()
+{
+    if (!mContentViewer)
+        return;
+
+    mContentSize = mContentViewer->size();
+    delete mContentViewer;
+    mContentViewer = 0;
+
+    SCgContentViewerManager::instance()->viewerDestroyed(this);
+}
+
+bool SCgNode::isContentViewerLoaded() const
 {
     return mContentViewer != 0;
 }
 
+bool SCgNode::isContentData() const
+{
+    return contentType() != SCgContent::Empty;
+}
+
 SCgBus* SCgNode::bus() const
 {
     return mBus;
@@ -439,3 +496,87 @@ void SCgNode::setIdtfPos(IdentifierPosition pos)
     if (pItem)
         pItem->setNodeTextPos(pos);
 }
+
+qint64 SCgNode::memoryUsage() const
+{
+    qint64 size = SCgObject::memoryUsage();
+
+    size += sizeof(SCgNode) - sizeof(SCgObject);
+    size += (mMimeType.size() + mFileName.size() + mFormat.size()) * sizeof(QChar);
+
+    if (mData.type() == QVariant::ByteArray)
+        size += mData.toByteArray().size();
+    else if (mData.type() == QVariant::String)
+        size += mData.toString().size() * sizeof(QChar);
+    else if (isContentLazy())
+        size += mData.value<SCgLazyContent>().memoryUsage();
+    else if (SCgBlob::isBlob(mData))
+        size += mData.value<SCgBlob>().memoryUsage();
+
+    if (SCgLazyContent::isLazy(mCompactedContent))
+        size += mCompactedContent.value<SCgLazyContent>().memoryUsage();
+
+    if (mContentViewer)
+        size += SCG_CONTENT_VIEWER_MEMORY;
+
+    return size;
+}
+
+void SCgNode::compactState(QDataStream &stream)
+{
+    stream << (int)idtfPos();
+    stream << mIsContentVisible;
+
+    // lazy content and blob handles can't be streamed: lazy content is kept as is,
+    // blob is parked in store, so its data doesn't take memory of compacted node
+    bool isHandle = isContentLazy() || SCgBlob::isBlob(mData);
+    stream << isHandle;
+    if (isHandle)
+    {
+        if (SCgBlob::isBlob(mData))
+            mCompactedBlob = SCgBlobStore::instance()->park(mData.value<SCgBlob>());
+        else
+            mCompactedContent = mData;
+        stream << mMimeType << mFileName << (int)contentType();
+    }else
+        stream << mMimeType << mData << mFileName << (int)mType;
+
+    SCgObject::compactState(stream);
+
+    if (mIsContentVisible)
+        hideContent();
+
+    releaseContentViewer();
+    SCgContent::setContent("", QVariant(), "", SCgContent::Empty);
+}
+
+void SCgNode::expandState(QDataStream &stream)
+{
+    int idtfPos, contType;
+    bool isContentVisible, isHandle;
+    QString mimeType, fileName;
+    QVariant data;
+
+    stream >> idtfPos;
+    stream >> isContentVisible;
+    stream >> isHandle;
+    if (isHandle)
+    {
+        stream >> mimeType >> fileName >> contType;
+        if (!mCompactedBlob.isEmpty())
+        {
+            data = QVariant::fromValue(SCgBlobStore::instance()->unpark(mCompactedBlob));
+            mCompactedBlob.clear();
+        }else
+            data = mCompactedContent;
+        mCompactedContent = QVariant();
+    }else
+        stream >> mimeType >> data >> fileName >> contType;
+
+    SCgObject::expandState(stream);
+    setIdtfPos((IdentifierPosition)idtfPos);
+
+    setContent(mimeType, data, fileName, (SCgContent::ContType)contType);
+    if (isContentVisible && isContentData())
+        showContent();
+}
@@ -107,6 +107,18 @@ public:
       */
     bool isContentData() const;
 
+    /*! Creates viewer of content, if it doesn't exist.
+      Viewers are created on demand by SCgContentViewerManager, when content gets near viewport.
+      */
+    void loadContentViewer();
+
+    /*! Destroys content viewer. Node keeps viewer size, so visible content holds its place.
+      */
+    void releaseContentViewer();
+
+    //! @return True, if content viewer exists.
+    bool isContentViewerLoaded() const;
+
     /*! Check if node have bus
         \return If node have bus, then return true, else - false.
       */
@@ -115,7 +127,15 @@ public:
     //! Update (repaint) connected objects
     void updateConnected();
 
+    //! @see SCgObject::memoryUsage
+    qint64 memoryUsage() const;
+
 protected:
+    //! @see SCgObject::compactState
+    void compactState(QDataStream &stream);
+    //! @see SCgObject::expandState
+    void expandState(QDataStream &stream);
+
     /*! Set scg-bus.
         \param bus  Pointer to scg-bus.
       */
@@ -130,6 +150,10 @@ protected:
       */
     void updateContentViewer();
 
+    /*! Creates content viewer for current content. Decodes lazy content.
+      */
+    void createContentViewer();
+
 private:
     QSizeF mSize;
 
@@ -144,6 +168,18 @@ private:
       */
     SCgContentViewer *mContentViewer;
 
+    /*! Size of last content viewer, it's used while viewer isn't created.
+      */
+    QSizeF mContentSize;
+
+    /*! Lazy content of compacted node. @see SCgNode::compactState
+      */
+    QVariant mCompactedContent;
+
+    /*! Hash of blob, that is parked in SCgBlobStore while node is compacted.
+      */
+    QByteArray mCompactedBlob;
+
     /*! Pointer to bus
       */
     SCgBus* mBus;
@@ -15,11 +15,19 @@
 
 #include "scgpointgraphicsitem.h"
 #include "scgconfig.h"
+#include "scgperfcounters.h"
+#include "scgscenevirtualizer.h"
 
 #include <QCursor>
 #include <QVector2D>
 #include <QGraphicsScene>
 #include <QApplication>
+#include <QBuffer>
+
+//! Approximate size of QGraphicsTextItem with its QTextDocument and layout
+#define SCG_TEXT_ITEM_MEMORY_BASE   4096
+//! Approximate size of laid out text per character
+#define SCG_TEXT_ITEM_MEMORY_CHAR   16
 
 SCgObject::SCgObject(QGraphicsItem *parent)
     : QGraphicsItem(parent)
@@ -29,6 +37,7 @@ SCgObject::SCgObject(QGraphicsItem *parent)
     , mTextItem(0)
     , mIsDead(false)
     , mParentChanging(false)
+    , mIsCompacted(false)
 {
     mColor = scg_cfg_get_value_color(scg_key_element_color_normal);
 
@@ -46,6 +55,8 @@ SCgObject::~SCgObject()
         (*it)->objectDelete(this);
 
     if (mTextItem)  delete mTextItem;
+
+    SCgSceneVirtualizer::objectDestroyed(this);
 }
 
 bool SCgObject::isSCgObjectType(int type)
@@ -62,6 +73,7 @@ void SCgObject::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 {
     Q_UNUSED(widget);
     Q_UNUSED(option);
+    SCgPerfCounters::increment(SCgPerfCounters::PaintedItems);
     if (mIsBoundingBoxVisible)
     {
         QPen pen(QBrush(Qt::red, Qt::SolidPattern), 1.f, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
@@ -188,8 +200,17 @@ SCgObject::SCgObjectList SCgObject::connectedObjects() const
     return mConnectedObjects;
 }
 
+bool SCgObject::isGeometryPropagationSuspended() const
+{
+    SCgScene *s = qobject_cast<SCgScene*>(scene());
+    return s && s->isGeometryPropagationSuspended();
+}
+
 void SCgObject::updateConnected()
 {
+    if (isGeometryPropagationSuspended())
+        return;
+
     SCgObjectList::iterator it;
     for (it = mConnectedObjects.begin(); it != mConnectedObjects.end(); it++)
     {
@@ -225,7 +246,8 @@ void SCgObject::setIdtfValue(const QString &idtf)
         mTextItem = 0;
     }
 
-    positionChanged();
+    if (!isGeometryPropagationSuspended())
+        positionChanged();
 }
 
 QString SCgObject::idtfValue() const
@@ -303,3 +325,77 @@ QPointF SCgObject::idtfPos() const
 {
     return mTextItem->textPos();
 }
+
+qint64 SCgObject::textItemMemoryUsage(const QString &text)
+{
+    return SCG_TEXT_ITEM_MEMORY_BASE + text.size() * SCG_TEXT_ITEM_MEMORY_CHAR;
+}
+
+qint64 SCgObject::memoryUsage() const
+{
+    qint64 size = sizeof(SCgObject);
+
+    size += (mIdtfValue.size() + mTypeAlias.size()) * sizeof(QChar);
+    size += mConnectedObjects.size() * sizeof(SCgObject*);
+    size += mSnapshot.size();
+
+    if (mTextItem)
+        size += textItemMemoryUsage(mIdtfValue);
+
+    return size;
+}
+
+void SCgObject::compact()
+{
+    if (!mIsDead || mIsCompacted)   return;
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    QDataStream stream(&buffer);
+
+    compactState(stream);
+
+    buffer.close();
+    mSnapshot = qCompress(buffer.data());
+    mIsCompacted = true;
+}
+
+void SCgObject::expand()
+{
+    if (!mIsCompacted)  return;
+
+    QByteArray data = qUncompress(mSnapshot);
+    mSnapshot.clear();
+    mIsCompacted = false;
+
+    QDataStream stream(data);
+    expandState(stream);
+}
+
+bool SCgObject::isCompacted() const
+{
+    return mIsCompacted;
+}
+
+void SCgObject::compactState(QDataStream &stream)
+{
+    stream << mIdtfValue;
+    stream << (mTextItem ? mTextItem->textPos() : QPointF());
+
+    if (mTextItem)
+    {
+        delete mTextItem;
+        mTextItem = 0;
+    }
+}
+
+void SCgObject::expandState(QDataStream &stream)
+{
+    QString idtf;
+    QPointF textPos;
+    stream >> idtf >> textPos;
+
+    setIdtfValue(idtf);
+    if (mTextItem)
+        mTextItem->setTextPos(textPos);
+}
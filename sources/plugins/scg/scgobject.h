@@ -8,6 +8,7 @@
 
 #include <QObject>
 #include <QGraphicsItem>
+#include <QDataStream>
 
 #include "scgalphabet.h"
 
@@ -50,6 +51,11 @@ public:
     //! Update (repaint) connected objects
     virtual void updateConnected();
 
+    /*! Check if geometry propagation is suspended on object's scene.
+      @see SCgScene::setGeometryPropagationSuspended
+      */
+    bool isGeometryPropagationSuspended() const;
+
     /*! Method to update object position.
       It calls when object need to recalculate it position.
       */
@@ -173,6 +179,40 @@ public:
         return ((SCgObject*)parentItem())->id();
     }
 
+    /*! Get approximate amount of memory used by object.
+      @return Memory size in bytes (object itself, identifier item, geometry and content).
+      */
+    virtual qint64 memoryUsage() const;
+
+    /*! Release memory-heavy parts of dead object (identifier item, content viewer, content data).
+      Released state is stored into compressed snapshot. Object stays alive, so all
+      commands, that hold pointer to it, remain valid.
+      @note Works only for dead objects.
+      @see SCgObject::expand
+      */
+    void compact();
+
+    /*! Restore object state from snapshot, that was made by SCgObject::compact.
+      */
+    void expand();
+
+    //! Check if object is compacted
+    bool isCompacted() const;
+
+protected:
+    /*! Write state, that can be released, into \p stream and release it.
+      @see SCgObject::compact
+      */
+    virtual void compactState(QDataStream &stream);
+
+    /*! Read state, that was written by SCgObject::compactState, from \p stream.
+      @see SCgObject::expand
+      */
+    virtual void expandState(QDataStream &stream);
+
+    //! Approximate amount of memory used by text item with specified text
+    static qint64 textItemMemoryUsage(const QString &text);
+
 protected:
     //! Main color
     QColor mColor;
@@ -195,8 +235,13 @@ protected:
     //! true, if parent about to change.
     bool mParentChanging;
 
+    //! Compressed snapshot of released state. @see SCgObject::compact
+    QByteArray mSnapshot;
+    //! Compacted flag
+    bool mIsCompacted;
+
 protected:
-    friend class GwfStreamWriter;
+    friend struct GwfObjectSnapshot;
     const SCgTextItem* textItem() const{return mTextItem;}
 
 };
@@ -7,11 +7,6 @@
 #include "scgobjectsinfo.h"
 #include "scgobjectsinfodata.h"
 
-SCgObjectInfo::SCgObjectInfo(const SCgObject* obj)
-{
-    d = new SCgObjectInfoData (obj);
-}
-
 SCgObjectInfo::SCgObjectInfo(const SCgObjectInfo &other): d(other.d)
 {
 
@@ -76,11 +71,6 @@ QString& SCgObjectInfo::parentIdRef()
 }
 
 //________________________________________________
-SCgNodeInfo::SCgNodeInfo(const SCgNode* obj)
-{
-    d = new SCgNodeInfoData (obj);
-}
-
 SCgNodeInfo::SCgNodeInfo(const SCgNodeInfo &other): SCgObjectInfo(other)
 {
 
@@ -172,11 +162,6 @@ int& SCgNodeInfo::idtfPosRef()
 }
 
 //________________________________________________
-SCgPairInfo::SCgPairInfo(const SCgPair* obj)
-{
-    d = new SCgPairInfoData (obj);
-}
-
 SCgPairInfo::SCgPairInfo(const SCgPairInfo &other): SCgObjectInfo(other)
 {
 
@@ -238,11 +223,6 @@ double& SCgPairInfo::endDotRef()
     return d->mEndDot;
 }
 //________________________________________________
-SCgBusInfo::SCgBusInfo(const SCgBus* obj)
-{
-    d = new SCgBusInfoData (obj);
-}
-
 SCgBusInfo::SCgBusInfo(const SCgBusInfo &other): SCgObjectInfo(other)
 {
 
@@ -281,11 +261,6 @@ QString& SCgBusInfo::ownerIdRef()
     return d->mOwnerId;
 }
 //________________________________________________
-SCgContourInfo::SCgContourInfo(const SCgContour* obj)
-{
-    d = new SCgContourInfoData (obj);
-}
-
 SCgContourInfo::SCgContourInfo(const SCgContourInfo &other): SCgObjectInfo(other)
 {
 
@@ -315,3 +290,33 @@ QVector<QPointF>& SCgContourInfo::pointsRef()
 {
     return d->mPoints;
 }
+
+// --- construction from scene objects ---
+#ifndef SCG_NO_SCENE
+
+SCgObjectInfo::SCgObjectInfo(const SCgObject* obj)
+{
+    d = new SCgObjectInfoData (obj);
+}
+
+SCgNodeInfo::SCgNodeInfo(const SCgNode* obj)
+{
+    d = new SCgNodeInfoData (obj);
+}
+
+SCgPairInfo::SCgPairInfo(const SCgPair* obj)
+{
+    d = new SCgPairInfoData (obj);
+}
+
+SCgBusInfo::SCgBusInfo(const SCgBus* obj)
+{
+    d = new SCgBusInfoData (obj);
+}
+
+SCgContourInfo::SCgContourInfo(const SCgContour* obj)
+{
+    d = new SCgContourInfoData (obj);
+}
+
+#endif
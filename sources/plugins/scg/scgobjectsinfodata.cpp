@@ -6,15 +6,6 @@
 
 #include "scgobjectsinfodata.h"
 
-SCgObjectInfoData::SCgObjectInfoData(const SCgObject* obj):mTypeAlias(obj->typeAlias()),
-                                    mIdtfValue(obj->idtfValue()),
-                                    mShapeColor(obj->color()),
-                                    mId(QString::number(obj->id())),
-                                    mParentId(QString::number(obj->parentId()))
-{
-
-}
-
 SCgObjectInfoData::SCgObjectInfoData(const SCgObjectInfoData &other): QSharedData(other),
                                     mTypeAlias(other.mTypeAlias),
                                     mIdtfValue(other.mIdtfValue),
@@ -37,18 +28,6 @@ SCgObjectInfoData::~SCgObjectInfoData()
 
 //________________________________________________
 
-SCgNodeInfoData::SCgNodeInfoData(const SCgNode* obj): mPos(obj->scenePos()),
-                                    mHaveBus(obj->bus()),
-                                    mContentType(obj->contentType()),
-                                    mContentMimeType(obj->contentMimeType()),
-                                    mContentVisible(obj->isContentVisible()),
-                                    mContentFilename(obj->contentFileName()),
-                                    mContentData(obj->contentData()),
-                                    mIdtfPos((int)obj->idtfPos())
-{
-
-}
-
 SCgNodeInfoData::SCgNodeInfoData(const SCgNodeInfoData &other): QSharedData(other),
                                     mPos(other.mPos),
                                     mHaveBus(other.mHaveBus),
@@ -74,15 +53,6 @@ SCgNodeInfoData::~SCgNodeInfoData()
 
 //_______________________________________________
 
-SCgPairInfoData::SCgPairInfoData(const SCgPair* obj):  mPoints(obj->points()),
-                                    mBeginObjectId(QString::number(obj->beginObject()->id())),
-                                    mEndObjectId(QString::number(obj->endObject()->id())),
-                                    mBeginDot(obj->beginDot()),
-                                    mEndDot(obj->endDot())
-{
-
-}
-
 SCgPairInfoData::SCgPairInfoData(const SCgPairInfoData &other): QSharedData(other),
                                     mPoints(other.mPoints),
                                     mBeginObjectId(other.mBeginObjectId),
@@ -105,11 +75,6 @@ SCgPairInfoData::~SCgPairInfoData()
 
 //____________________________________________________
 
-SCgContourInfoData::SCgContourInfoData(const SCgContour* obj): mPoints(obj->points())
-{
-
-}
-
 SCgContourInfoData::SCgContourInfoData(const SCgContourInfoData &other): QSharedData(other),
                                         mPoints(other.mPoints)
 {
@@ -128,12 +93,6 @@ SCgContourInfoData::~SCgContourInfoData()
 //____________________________________________________
 
 
-SCgBusInfoData::SCgBusInfoData(const SCgBus* obj): mPoints(obj->points()),
-                                    mOwnerId(QString::number( obj->owner()->id() ))
-{
-
-}
-
 SCgBusInfoData::SCgBusInfoData(const SCgBusInfoData &other): QSharedData(other),
                                         mPoints(other.mPoints),
                                         mOwnerId(other.mOwnerId)
@@ -150,3 +109,50 @@ SCgBusInfoData::~SCgBusInfoData()
 {
 
 }
+
+// --- construction from scene objects ---
+// they are excluded from builds without scene items (see kbe-cli.pro)
+#ifndef SCG_NO_SCENE
+
+SCgObjectInfoData::SCgObjectInfoData(const SCgObject* obj):mTypeAlias(obj->typeAlias()),
+                                    mIdtfValue(obj->idtfValue()),
+                                    mShapeColor(obj->color()),
+                                    mId(QString::number(obj->id())),
+                                    mParentId(QString::number(obj->parentId()))
+{
+
+}
+
+SCgNodeInfoData::SCgNodeInfoData(const SCgNode* obj): mPos(obj->scenePos()),
+                                    mHaveBus(obj->bus()),
+                                    mContentType(obj->contentType()),
+                                    mContentMimeType(obj->contentMimeType()),
+                                    mContentVisible(obj->isContentVisible()),
+                                    mContentFilename(obj->contentFileName()),
+                                    mContentData(obj->contentRawData()),
+                                    mIdtfPos((int)obj->idtfPos())
+{
+
+}
+
+SCgPairInfoData::SCgPairInfoData(const SCgPair* obj):  mPoints(obj->points()),
+                                    mBeginObjectId(QString::number(obj->beginObject()->id())),
+                                    mEndObjectId(QString::number(obj->endObject()->id())),
+                                    mBeginDot(obj->beginDot()),
+                                    mEndDot(obj->endDot())
+{
+
+}
+
+SCgContourInfoData::SCgContourInfoData(const SCgContour* obj): mPoints(obj->points())
+{
+
+}
+
+SCgBusInfoData::SCgBusInfoData(const SCgBus* obj): mPoints(obj->points()),
+                                    mOwnerId(QString::number( obj->owner()->id() ))
+{
+
+}
+
+#endif
@@ -8,8 +8,10 @@
 #include "scgbus.h"
 #include "scgtextitem.h"
 #include "scgpointgraphicsitem.h"
+#include "scgperfcounters.h"
 
 #include <QPainter>
+#include <QPolygonF>
 #include <QVector2D>
 
 SCgPair::SCgPair() :
@@ -41,16 +43,6 @@ SCgPair::~SCgPair()
         mEndObject->removeConnectedObject(this);
 }
 
-QRectF SCgPair::boundingRect() const
-{
-    return mShape.boundingRect().adjusted(-11, -11, 11, 11);
-}
-
-QPainterPath SCgPair::shape() const
-{
-    return mShape;
-}
-
 void SCgPair::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
 
@@ -69,23 +61,24 @@ void SCgPair::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, Q
     SCgObject::paint(painter, option, widget);
 }
 
-void SCgPair::updateShape()
+SCgPointObject::Geometry SCgPair::buildGeometry(const PointFVector &points) const
 {
-    prepareGeometryChange();
+    Geometry res;
 
-    // Rebuilding shape
-    mShapeNormal = QPainterPath();
+    res.shapeNormal.moveTo(points.at(0));
+    for (int i = 1; i < points.size(); i++)
+        res.shapeNormal.lineTo(points.at(i));
 
-    mShapeNormal.moveTo(mPoints.at(0));
-    for (int i = 1; i < mPoints.size(); i++)
-        mShapeNormal.lineTo(mPoints.at(i));
+    // arrows and marks are drawn outside of line
+    qreal margin = SCgAlphabet::lineWidthForShape() / 2 + 11;
+    res.boundingRect = QPolygonF(points).boundingRect().adjusted(-margin, -margin, margin, margin);
 
-    QPainterPathStroker path_stroker;
-    path_stroker.setJoinStyle(Qt::MiterJoin);
-    path_stroker.setWidth(SCgAlphabet::lineWidthForShape());
-    mShape = path_stroker.createStroke(mShapeNormal);
+    return res;
+}
 
-    mLineShape = mShape;
+void SCgPair::applyGeometry(const Geometry &geometry)
+{
+    assignGeometry(geometry);
 
     // updating pair
     update();
@@ -104,8 +97,16 @@ void SCgPair::updateShape()
 
 void SCgPair::positionChanged()
 {
-    // this notifies the scene of the imminent change, so that it can update its item geometry index.
-    if (!mBeginObject || !mEndObject)   return;
+    SCgPerfCounters::increment(SCgPerfCounters::PositionChangedCalls);
+
+    // update shape with new points.
+    if (updatePoints())
+        updateShape();
+}
+
+bool SCgPair::updatePoints()
+{
+    if (!mBeginObject || !mEndObject)   return false;
 
     mPoints.front() = mapFromScene(mBeginObject->scenePos());
     mPoints.last() = mapFromScene(mEndObject->scenePos());
@@ -129,8 +130,7 @@ void SCgPair::positionChanged()
     else if (mEndObject->isSelected() && mEndObject->parentItem() != parentItem())
         setParentItem(mEndObject->parentItem());
 
-    // update shape with new points.
-    updateShape();
+    return true;
 }
 
 void SCgPair::objectDelete(SCgObject *object)
@@ -278,7 +278,8 @@ void SCgPair::setBeginObject(SCgObject *object)
     if (mBeginObject)
         mBeginObject->addConnectedObject(this);
 
-    positionChanged();
+    if (!isGeometryPropagationSuspended())
+        positionChanged();
 }
 
 SCgObject* SCgPair::beginObject() const
@@ -296,7 +297,8 @@ void SCgPair::setEndObject(SCgObject *object)
     if (mEndObject)
         mEndObject->addConnectedObject(this);
 
-    positionChanged();
+    if (!isGeometryPropagationSuspended())
+        positionChanged();
 }
 
 SCgObject* SCgPair::endObject() const
@@ -307,7 +309,8 @@ SCgObject* SCgPair::endObject() const
 void SCgPair::setBeginDot(float pos)
 {
     mBeginDot = pos;
-    positionChanged();
+    if (!isGeometryPropagationSuspended())
+        positionChanged();
 }
 
 float SCgPair::beginDot() const
@@ -318,7 +321,8 @@ float SCgPair::beginDot() const
 void SCgPair::setEndDot(float pos)
 {
     mEndDot = pos;
-    positionChanged();
+    if (!isGeometryPropagationSuspended())
+        positionChanged();
 }
 
 float SCgPair::endDot() const
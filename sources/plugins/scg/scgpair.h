@@ -40,8 +40,12 @@ public:
     //! Swap begin and end elements
     void swap();
 
-    //! @see SCgPointObject::updateShape;
-    void updateShape();
+    //! @see SCgPointObject::buildGeometry
+    Geometry buildGeometry(const PointFVector &points) const;
+    //! @see SCgPointObject::applyGeometry
+    void applyGeometry(const Geometry &geometry);
+    //! Calculates end points as crossings with begin and end objects.
+    bool updatePoints();
 
     /*! Changes point position by specified index of this point.
      *
@@ -68,10 +72,6 @@ public:
     }
 
 protected:
-    //! @copydoc QGraphicsItem::boundingRect
-    QRectF boundingRect() const;
-    //! @copydoc QGraphicsItem::shape()
-    QPainterPath shape() const;
     //! @copydoc QGraphicsItem::paint()
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
     //! @see SCgObject::objectDelete(). DEPRECATED
@@ -84,6 +84,7 @@ protected:
 
 
 public:
+
     int type() const { return Type; }
 
 private:
@@ -116,10 +117,6 @@ private:
     float mBeginDot;
     SCgObject *mEndObject;
     float mEndDot;
-    //! Cached value of bounding box
-    QRectF mBoundRect;
-    //! Path that represents shape
-    QPainterPath mShape;
 
     //! Flag for a end arrow
     bool mEndArrow;
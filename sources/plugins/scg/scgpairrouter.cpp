@@ -0,0 +1,380 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgpairrouter.h"
+
+#include "scgscene.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+
+#include <QSet>
+#include <QtCore/qmath.h>
+
+#include <queue>
+#include <vector>
+#include <functional>
+
+//! Size of spatial index cell
+#define SCG_ROUTER_INDEX_CELL_SIZE 128
+//! Additional cost of bend in route (one step costs 1)
+#define SCG_ROUTER_BEND_COST 4
+//! Maximal number of grid cells in search window
+#define SCG_ROUTER_MAX_CELLS 250000
+//! Number of grid steps, that search window is wider than pair ends bounding rectangle
+#define SCG_ROUTER_WINDOW_STEPS 8
+
+namespace
+{
+
+// move directions: right, down, left, up
+const int DirectionDx[4] = { 1, 0, -1, 0 };
+const int DirectionDy[4] = { 0, 1, 0, -1 };
+
+}
+
+SCgPairRouter::SCgPairRouter(SCgScene *scene) :
+    QObject(scene),
+    mScene(scene),
+    mGridStep(10),
+    mMargin(10),
+    mIndexCellSize(SCG_ROUTER_INDEX_CELL_SIZE)
+{
+}
+
+SCgPairRouter::~SCgPairRouter()
+{
+}
+
+void SCgPairRouter::setGridStep(qreal step)
+{
+    Q_ASSERT(step > 0);
+    mGridStep = step;
+}
+
+qreal SCgPairRouter::gridStep() const
+{
+    return mGridStep;
+}
+
+void SCgPairRouter::setMargin(qreal margin)
+{
+    mMargin = margin;
+}
+
+qreal SCgPairRouter::margin() const
+{
+    return mMargin;
+}
+
+QMap<SCgPair*, QVector<QPointF> > SCgPairRouter::route(const QList<SCgPair*> &pairs)
+{
+    QMap<SCgPair*, QVector<QPointF> > result;
+
+    buildIndex();
+
+    foreach (SCgPair *pair, pairs)
+    {
+        if (pair->isDead() || !pair->beginObject() || !pair->endObject())
+            continue;
+
+        QVector<QPointF> points = pair->scenePoints();
+        QPointF start = endPoint(pair->beginObject(), points.first());
+        QPointF end = endPoint(pair->endObject(), points.last());
+
+        QRectF bounds = QRectF(start, end).normalized();
+        qreal extent = mGridStep * SCG_ROUTER_WINDOW_STEPS + mMargin;
+
+        // try small window at first, most of routes are found there
+        QVector<QPointF> route;
+        if (!findRoute(pair, bounds.adjusted(-extent, -extent, extent, extent), route)
+            && !findRoute(pair, bounds.adjusted(-extent * 4, -extent * 4, extent * 4, extent * 4), route))
+        {
+            route.clear();
+            route << points.first() << points.last();
+        }
+
+        result.insert(pair, route);
+    }
+
+    mObstacles.clear();
+    mIndex.clear();
+
+    return result;
+}
+
+void SCgPairRouter::setRouted(SCgPair *pair, bool routed)
+{
+    Q_ASSERT(pair != 0);
+
+    if (routed == mRoutedPairs.contains(pair))
+        return;
+
+    if (routed)
+    {
+        mRoutedPairs.insert(pair, pair);
+        connect(pair, SIGNAL(destroyed(QObject*)), this, SLOT(pairDestroyed(QObject*)));
+    }
+    else
+    {
+        mRoutedPairs.remove(pair);
+        disconnect(pair, SIGNAL(destroyed(QObject*)), this, SLOT(pairDestroyed(QObject*)));
+    }
+}
+
+bool SCgPairRouter::isRouted(SCgPair *pair) const
+{
+    return mRoutedPairs.contains(pair);
+}
+
+QList<SCgPair*> SCgPairRouter::routedPairsFor(const QList<SCgObject*> &objects) const
+{
+    QList<SCgPair*> result;
+    if (objects.isEmpty())
+        return result;
+
+    QSet<QGraphicsItem*> moved;
+    foreach (SCgObject *obj, objects)
+        moved.insert(obj);
+
+    foreach (SCgPair *pair, mRoutedPairs)
+    {
+        if (pair->isDead())
+            continue;
+
+        SCgObject *ends[2] = { pair->beginObject(), pair->endObject() };
+        bool isAffected = false;
+
+        for (int i = 0; i < 2 && !isAffected; ++i)
+        {
+            SCgObject *obj = ends[i];
+            if (obj && obj->type() == SCgBus::Type && static_cast<SCgBus*>(obj)->owner())
+                obj = static_cast<SCgBus*>(obj)->owner();
+
+            // object is moved, if it or any of its parents is moved
+            for (QGraphicsItem *item = obj; item && !isAffected; item = item->parentItem())
+                isAffected = moved.contains(item);
+        }
+
+        if (isAffected)
+            result.append(pair);
+    }
+
+    return result;
+}
+
+void SCgPairRouter::pairDestroyed(QObject *obj)
+{
+    mRoutedPairs.remove(obj);
+}
+
+void SCgPairRouter::buildIndex()
+{
+    mObstacles.clear();
+    mIndex.clear();
+
+    foreach (QGraphicsItem *item, mScene->items())
+    {
+        if (item->type() != SCgNode::Type && item->type() != SCgContour::Type)
+            continue;
+
+        SCgObject *obj = static_cast<SCgObject*>(item);
+        if (obj->isDead())
+            continue;
+
+        Obstacle obstacle;
+        obstacle.rect = obj->sceneBoundingRect();
+        obstacle.object = obj;
+
+        int index = mObstacles.size();
+        mObstacles.append(obstacle);
+
+        int left = qFloor(obstacle.rect.left() / mIndexCellSize);
+        int right = qFloor(obstacle.rect.right() / mIndexCellSize);
+        int top = qFloor(obstacle.rect.top() / mIndexCellSize);
+        int bottom = qFloor(obstacle.rect.bottom() / mIndexCellSize);
+
+        for (int x = left; x <= right; ++x)
+            for (int y = top; y <= bottom; ++y)
+                mIndex[qMakePair(x, y)].append(index);
+    }
+}
+
+QList<int> SCgPairRouter::obstaclesIn(const QRectF &rect) const
+{
+    QSet<int> found;
+
+    int left = qFloor(rect.left() / mIndexCellSize);
+    int right = qFloor(rect.right() / mIndexCellSize);
+    int top = qFloor(rect.top() / mIndexCellSize);
+    int bottom = qFloor(rect.bottom() / mIndexCellSize);
+
+    for (int x = left; x <= right; ++x)
+        for (int y = top; y <= bottom; ++y)
+        {
+            QHash<QPair<int, int>, QVector<int> >::const_iterator it = mIndex.constFind(qMakePair(x, y));
+            if (it == mIndex.constEnd())
+                continue;
+
+            foreach (int index, it.value())
+                if (mObstacles[index].rect.intersects(rect))
+                    found.insert(index);
+        }
+
+    return found.toList();
+}
+
+QPointF SCgPairRouter::endPoint(SCgObject *obj, const QPointF &pairPoint) const
+{
+    // routes go from node centers, pair will cut them by node border
+    if (obj && obj->type() == SCgNode::Type)
+        return obj->scenePos();
+
+    return pairPoint;
+}
+
+bool SCgPairRouter::findRoute(SCgPair *pair, const QRectF &window, QVector<QPointF> &points) const
+{
+    SCgObject *begin = pair->beginObject();
+    SCgObject *end = pair->endObject();
+    QVector<QPointF> pairPoints = pair->scenePoints();
+    QPointF start = endPoint(begin, pairPoints.first());
+    QPointF finish = endPoint(end, pairPoints.last());
+
+    // grid inside window
+    QPointF origin(qFloor(window.left() / mGridStep) * mGridStep, qFloor(window.top() / mGridStep) * mGridStep);
+    int cols = qCeil((window.right() - origin.x()) / mGridStep) + 1;
+    int rows = qCeil((window.bottom() - origin.y()) / mGridStep) + 1;
+    if (cols * rows > SCG_ROUTER_MAX_CELLS)
+        return false;
+
+    QVector<bool> blocked(cols * rows, false);
+    foreach (int index, obstaclesIn(window))
+    {
+        const Obstacle &obstacle = mObstacles[index];
+        SCgObject *obj = obstacle.object;
+
+        // pair can go through its ends and contours, that contain them
+        if (obj == begin || obj == end || obj->isAncestorOf(begin) || obj->isAncestorOf(end))
+            continue;
+
+        QRectF rect = obstacle.rect.adjusted(-mMargin, -mMargin, mMargin, mMargin);
+        int left = qMax(0, qCeil((rect.left() - origin.x()) / mGridStep));
+        int right = qMin(cols - 1, qFloor((rect.right() - origin.x()) / mGridStep));
+        int top = qMax(0, qCeil((rect.top() - origin.y()) / mGridStep));
+        int bottom = qMin(rows - 1, qFloor((rect.bottom() - origin.y()) / mGridStep));
+
+        for (int y = top; y <= bottom; ++y)
+            for (int x = left; x <= right; ++x)
+                blocked[y * cols + x] = true;
+    }
+
+    int startX = qBound(0, qRound((start.x() - origin.x()) / mGridStep), cols - 1);
+    int startY = qBound(0, qRound((start.y() - origin.y()) / mGridStep), rows - 1);
+    int finishX = qBound(0, qRound((finish.x() - origin.x()) / mGridStep), cols - 1);
+    int finishY = qBound(0, qRound((finish.y() - origin.y()) / mGridStep), rows - 1);
+    int startCell = startY * cols + startX;
+    int finishCell = finishY * cols + finishX;
+    blocked[startCell] = false;
+    blocked[finishCell] = false;
+
+    // A* search, state is (cell, direction of the last move)
+    typedef std::pair<int, int> QueueItem; // estimated cost, state
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > queue;
+    QVector<int> cost(cols * rows * 4, -1);
+    QVector<int> previous(cols * rows * 4, -1);
+
+    for (int d = 0; d < 4; ++d)
+    {
+        cost[startCell * 4 + d] = 0;
+        queue.push(QueueItem(qAbs(finishX - startX) + qAbs(finishY - startY), startCell * 4 + d));
+    }
+
+    int found = -1;
+    while (!queue.empty())
+    {
+        QueueItem item = queue.top();
+        queue.pop();
+
+        int state = item.second;
+        int cell = state / 4;
+        int dir = state % 4;
+        int x = cell % cols;
+        int y = cell / cols;
+
+        // skip outdated queue items
+        if (item.first - qAbs(finishX - x) - qAbs(finishY - y) > cost[state])
+            continue;
+
+        if (cell == finishCell)
+        {
+            found = state;
+            break;
+        }
+
+        for (int d = 0; d < 4; ++d)
+        {
+            // don't go back
+            if (d == (dir + 2) % 4)
+                continue;
+
+            int nx = x + DirectionDx[d];
+            int ny = y + DirectionDy[d];
+            if (nx < 0 || ny < 0 || nx >= cols || ny >= rows || blocked[ny * cols + nx])
+                continue;
+
+            int nextState = (ny * cols + nx) * 4 + d;
+            int nextCost = cost[state] + 1 + (d != dir && cell != startCell ? SCG_ROUTER_BEND_COST : 0);
+            if (cost[nextState] >= 0 && cost[nextState] <= nextCost)
+                continue;
+
+            cost[nextState] = nextCost;
+            previous[nextState] = state;
+            queue.push(QueueItem(nextCost + qAbs(finishX - nx) + qAbs(finishY - ny), nextState));
+        }
+    }
+
+    if (found < 0)
+        return false;
+
+    // collect cells, where route changes its direction
+    QVector<int> corners;
+    int firstDirection = found % 4;
+    int lastDirection = found % 4;
+    for (int state = found; previous[state] >= 0; state = previous[state])
+    {
+        int prev = previous[state];
+        if (prev / 4 == startCell)
+            firstDirection = state % 4;
+        else if (prev % 4 != state % 4)
+            corners.prepend(prev / 4);
+    }
+
+    points.clear();
+    points << start;
+    for (int i = 0; i < corners.size(); ++i)
+        points << origin + QPointF((corners[i] % cols) * mGridStep, (corners[i] / cols) * mGridStep);
+    points << finish;
+
+    // align the first and the last segments with route ends, that are not on the grid
+    if (corners.size() > 0)
+    {
+        bool firstHorizontal = DirectionDy[firstDirection] == 0;
+        if (firstHorizontal)
+            points[1].setY(start.y());
+        else
+            points[1].setX(start.x());
+
+        bool lastHorizontal = DirectionDy[lastDirection] == 0;
+        if (lastHorizontal)
+            points[points.size() - 2].setY(finish.y());
+        else
+            points[points.size() - 2].setX(finish.x());
+    }
+
+    return true;
+}
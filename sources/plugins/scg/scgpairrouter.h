@@ -0,0 +1,105 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <QHash>
+#include <QMap>
+
+class SCgScene;
+class SCgObject;
+class SCgPair;
+
+/*! Calculates orthogonal routes for pairs around obstacles (nodes and contours).
+ *  Routes are found with A* search on a grid inside a window around pair ends.
+ *  Search state includes direction, so each bend costs extra and routes have few bends.
+ *  Obstacles are stored in a uniform grid spatial index, so only obstacles near
+ *  the route window are rasterized.
+ *  Router also remembers routed pairs, so their routes can be recalculated
+ *  when their ends are moved (@see SCgScene::moveSelectedCommand).
+ *  Routed pairs are known for session only: flag isn't saved, so loaded pairs
+ *  keep their points, but they aren't rerouted until they are routed again.
+ */
+class SCgPairRouter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SCgPairRouter(SCgScene *scene);
+    virtual ~SCgPairRouter();
+
+    //! Set distance between neighbour route lines
+    void setGridStep(qreal step);
+    //! @return distance between neighbour route lines
+    qreal gridStep() const;
+
+    //! Set minimal distance between routes and obstacles
+    void setMargin(qreal margin);
+    //! @return minimal distance between routes and obstacles
+    qreal margin() const;
+
+    /*! Calculate routes for pairs @p pairs. Spatial index of obstacles is built once for all pairs.
+     * @return Map of pairs to their new points (scene coordinates). If route for some pair
+     *         can't be found, then it will be straight.
+     */
+    QMap<SCgPair*, QVector<QPointF> > route(const QList<SCgPair*> &pairs);
+
+    /*! Mark pair @p pair as routed (or not routed) automatically.
+     * Routes of marked pairs are recalculated, when their ends are moved.
+     */
+    void setRouted(SCgPair *pair, bool routed);
+    //! @return true, if pair @p pair is routed automatically
+    bool isRouted(SCgPair *pair) const;
+
+    //! @return routed pairs, that are incident to objects @p objects or to their content
+    QList<SCgPair*> routedPairsFor(const QList<SCgObject*> &objects) const;
+
+private slots:
+    //! Removes destroyed pair from routed ones
+    void pairDestroyed(QObject *obj);
+
+private:
+    //! Obstacle for routes
+    struct Obstacle
+    {
+        QRectF rect;
+        SCgObject *object;
+    };
+
+    //! Collects obstacles from scene and builds spatial index
+    void buildIndex();
+
+    //! @return indexes of obstacles, that intersect rectangle @p rect
+    QList<int> obstaclesIn(const QRectF &rect) const;
+
+    //! @return point, where route of pair starts (ends) for incident object @p obj
+    QPointF endPoint(SCgObject *obj, const QPointF &pairPoint) const;
+
+    /*! Find route for pair @p pair.
+     * @param window Search area in scene coordinates.
+     * @param points Found points (scene coordinates), including start and end.
+     * @return true, if route was found.
+     */
+    bool findRoute(SCgPair *pair, const QRectF &window, QVector<QPointF> &points) const;
+
+    //! Scene, where pairs are routed
+    SCgScene *mScene;
+    //! Distance between neighbour route lines
+    qreal mGridStep;
+    //! Minimal distance between routes and obstacles
+    qreal mMargin;
+    //! Size of spatial index cell
+    qreal mIndexCellSize;
+    //! Obstacles, that were collected by buildIndex()
+    QVector<Obstacle> mObstacles;
+    //! Spatial index: cell -> obstacles, that intersect it
+    QHash<QPair<int, int>, QVector<int> > mIndex;
+    //! Pairs, that are routed automatically (keys are used to remove destroyed pairs)
+    QHash<QObject*, SCgPair*> mRoutedPairs;
+};
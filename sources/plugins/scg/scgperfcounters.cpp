@@ -0,0 +1,28 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgperfcounters.h"
+
+int SCgPerfCounters::msUsers = 0;
+QAtomicInt SCgPerfCounters::msCounters[SCgPerfCounters::CounterCount];
+
+int SCgPerfCounters::take(Counter counter)
+{
+    return msCounters[counter].fetchAndStoreRelaxed(0);
+}
+
+void SCgPerfCounters::addUser()
+{
+    ++msUsers;
+}
+
+void SCgPerfCounters::removeUser()
+{
+    Q_ASSERT(msUsers > 0);
+    if (--msUsers == 0)
+        for (int i = 0; i < CounterCount; ++i)
+            msCounters[i].store(0);
+}
@@ -0,0 +1,46 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QAtomicInt>
+
+/*! Counters of expensive scene operations, that are shown by performance overlay of SCgView.
+ * Counters are incremented only while any overlay is visible.
+ */
+class SCgPerfCounters
+{
+public:
+    enum Counter
+    {
+        PaintedItems = 0,
+        UpdateShapeCalls,
+        PositionChangedCalls,
+        CounterCount
+    };
+
+    //! Increments counter \p counter, if counting is enabled.
+    static void increment(Counter counter)
+    {
+        if (msUsers > 0)
+            msCounters[counter].ref();
+    }
+
+    //! @return Value of counter \p counter and resets it.
+    static int take(Counter counter);
+
+    /*! @defgroup counting Enabling of counting.
+     *  Counting is enabled, while there is at least one user.
+     *  @{
+     */
+    static void addUser();
+    static void removeUser();
+    /*! @}*/
+
+private:
+    static int msUsers;
+    static QAtomicInt msCounters[CounterCount];
+};
@@ -6,6 +6,8 @@
 
 #include "scgplugin.h"
 #include "scgwindow.h"
+#include "gwf/gwfidentifierscanner.h"
+#include "gwf/gwfdocumentsearcher.h"
 
 #include "scgcontentfactory.h"
 #include "scgcontentimage.h"
@@ -17,6 +19,8 @@
 #include "arrangers/scgarrangerhorizontal.h"
 #include "arrangers/scgarrangertuple.h"
 #include "arrangers/scgarrangervertical.h"
+#include "arrangers/scgarrangerenergybased.h"
+#include "arrangers/scgarrangerhierarchical.h"
 
 #include <QTranslator>
 #include <QApplication>
@@ -55,6 +59,8 @@ QList<QObject*> const & SCgPlugin::interfaces() const
 void SCgPlugin::initialize()
 {
     mInterfaces.push_back(new SCgWindowFactory(this));
+    mInterfaces.push_back(new GwfIdentifierScanner(this));
+    mInterfaces.push_back(new GwfDocumentSearcher(this));
 
     SCgContentFactory::registerFactory("string", new SCgContentStringFactory);
     SCgContentFactory::registerFactory("image", new SCgContentImageFactory);
@@ -64,6 +70,8 @@ void SCgPlugin::initialize()
     SCgLayoutManager::instance().addArranger(new SCgVerticalArranger(this));
     SCgLayoutManager::instance().addArranger(new SCgHorizontalArranger(this));
     SCgLayoutManager::instance().addArranger(new SCgTupleArranger(this));
+    SCgLayoutManager::instance().addArranger(new SCgEnergyBasedArranger(this));
+    SCgLayoutManager::instance().addArranger(new SCgHierarchicalArranger(this));
 
     qApp->installTranslator(mTranslator);
 }
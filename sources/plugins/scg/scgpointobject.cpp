@@ -6,12 +6,19 @@
 
 #include "scgpointobject.h"
 #include "scgpointgraphicsitem.h"
+#include "scgalphabet.h"
+#include "scgperfcounters.h"
 
 #include <QVector2D>
+#include <QPainterPath>
+#include <QPainterPathStroker>
+#include <QPolygonF>
+#include <QLineF>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 SCgPointObject::SCgPointObject(QGraphicsItem *parent)
     : SCgObject(parent)
+    , mIsStrokeValid(false)
 {
 
 }
@@ -69,6 +76,169 @@ void SCgPointObject::changePointPosition(int pointIndex, const QPointF& newPos)
 }
 
 
+void SCgPointObject::updateShape()
+{
+    applyGeometry(buildGeometry(mPoints));
+}
+
+bool SCgPointObject::updatePoints()
+{
+    return !mPoints.isEmpty();
+}
+
+void SCgPointObject::assignGeometry(const Geometry &geometry)
+{
+    SCgPerfCounters::increment(SCgPerfCounters::UpdateShapeCalls);
+    prepareGeometryChange();
+
+    mShapeNormal = geometry.shapeNormal;
+    mBoundingRect = geometry.boundingRect;
+
+    mIsStrokeValid = false;
+    mLineShape = QPainterPath();
+    mStrokeShape = QPainterPath();
+}
+
+qreal SCgPointObject::lineWidth() const
+{
+    return SCgAlphabet::lineWidthForShape();
+}
+
+bool SCgPointObject::isClosed() const
+{
+    return false;
+}
+
+void SCgPointObject::ensureStroke() const
+{
+    if (mIsStrokeValid)
+        return;
+
+    QPainterPath line = mShapeNormal;
+    if (line.isEmpty() && !mPoints.isEmpty())
+    {
+        line.moveTo(mPoints.at(0));
+        for (int i = 1; i < mPoints.size(); i++)
+            line.lineTo(mPoints.at(i));
+    }
+
+    QPainterPathStroker path_stroker;
+    if (!isClosed())
+        path_stroker.setJoinStyle(Qt::MiterJoin);
+    path_stroker.setWidth(lineWidth());
+    mLineShape = path_stroker.createStroke(line);
+
+    mStrokeShape = isClosed() ? line.united(mLineShape) : mLineShape;
+    mIsStrokeValid = true;
+}
+
+QPainterPath SCgPointObject::lineShape() const
+{
+    ensureStroke();
+    return mLineShape;
+}
+
+QPainterPath SCgPointObject::shape() const
+{
+    ensureStroke();
+    return mStrokeShape;
+}
+
+QRectF SCgPointObject::boundingRect() const
+{
+    return mBoundingRect;
+}
+
+bool SCgPointObject::isOnLine(const QPointF &point) const
+{
+    if (mPoints.size() < 2)
+        return false;
+
+    qreal tolerance = lineWidth() / 2;
+    return distanceToLine(mPoints, point, isClosed()) <= tolerance * tolerance;
+}
+
+bool SCgPointObject::contains(const QPointF &point) const
+{
+    if (!mBoundingRect.contains(point))
+        return false;
+
+    if (isOnLine(point))
+        return true;
+
+    return isClosed() && QPolygonF(mPoints).containsPoint(point, Qt::OddEvenFill);
+}
+
+bool SCgPointObject::collidesWithPath(const QPainterPath &path, Qt::ItemSelectionMode mode) const
+{
+    if (mode == Qt::IntersectsItemBoundingRect || mode == Qt::ContainsItemBoundingRect)
+        return QGraphicsItem::collidesWithPath(path, mode);
+
+    if (mPoints.isEmpty() || path.isEmpty())
+        return false;
+
+    QPolygonF polygon = path.toFillPolygon();
+    Qt::FillRule rule = path.fillRule();
+
+    if (mode == Qt::ContainsItemShape)
+    {
+        foreach (const QPointF &p, mPoints)
+        {
+            if (!polygon.containsPoint(p, rule))
+                return false;
+        }
+        return !lineCrosses(mPoints, isClosed(), polygon);
+    }
+
+    foreach (const QPointF &p, mPoints)
+    {
+        if (polygon.containsPoint(p, rule))
+            return true;
+    }
+
+    // path is near the line or inside closed object
+    foreach (const QPointF &p, polygon)
+    {
+        if (contains(p))
+            return true;
+    }
+
+    return lineCrosses(mPoints, isClosed(), polygon);
+}
+
+qreal SCgPointObject::distanceToLine(const PointFVector& points, const QPointF& p, bool closed)
+{
+    qreal minDist = -1.f;
+    for (int i = 1; i < points.size(); i++)
+    {
+        qreal curDist = distanceToSubpath(points.at(i - 1), points.at(i), p);
+        if (minDist < 0 || minDist > curDist)
+            minDist = curDist;
+    }
+
+    if (closed && points.size() > 2)
+        minDist = qMin(minDist, distanceToSubpath(points.last(), points.first(), p));
+
+    return minDist;
+}
+
+bool SCgPointObject::lineCrosses(const PointFVector& points, bool closed, const QPolygonF& polygon)
+{
+    int count = closed ? points.size() : points.size() - 1;
+    for (int i = 0; i < count; i++)
+    {
+        QLineF line(points.at(i), points.at((i + 1) % points.size()));
+        for (int j = 0; j < polygon.size(); j++)
+        {
+            QLineF edge(polygon.at(j), polygon.at((j + 1) % polygon.size()));
+            if (line.intersect(edge, 0) == QLineF::BoundedIntersection)
+                return true;
+        }
+    }
+
+    return false;
+}
+
 void SCgPointObject::setPoints(const PointFVector &points)
 {
     if (points.size() < 2)
@@ -85,7 +255,9 @@ void SCgPointObject::setPoints(const PointFVector &points)
         createPointObjects();
     }
 
-    positionChanged();
+    // shape will be rebuilt, when propagation will be resumed
+    if (!isGeometryPropagationSuspended())
+        positionChanged();
 }
 
 qreal SCgPointObject::distanceToSubpath(const QPointF& p0, const QPointF& p1, const QPointF& p)
@@ -178,6 +350,25 @@ SCgObject* SCgPointObject::objectWithRole(SCgPointObject::IncidentRole role) con
     return 0;
 }
 
+qint64 SCgPointObject::pathMemoryUsage(const QPainterPath &path)
+{
+    return path.elementCount() * sizeof(QPainterPath::Element);
+}
+
+qint64 SCgPointObject::memoryUsage() const
+{
+    qint64 size = SCgObject::memoryUsage();
+
+    size += sizeof(SCgPointObject) - sizeof(SCgObject);
+    size += mPoints.size() * sizeof(QPointF);
+    size += pathMemoryUsage(mShapeNormal);
+    size += pathMemoryUsage(mLineShape);
+    if (isClosed())
+        size += pathMemoryUsage(mStrokeShape);
+
+    return size;
+}
+
 qreal SCgPointObject::dotAtRole(SCgPointObject::IncidentRole role) const
 {
     Q_ASSERT_X(role >= 0 && role < SCgPointObject::IncidentRolesCount,
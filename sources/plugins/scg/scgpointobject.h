@@ -64,8 +64,33 @@ public:
     //! Returns point at specified index (in THIS ITEM coordinates).
     QPointF pointAt(int index) const;
 
+    //! Geometry, that is built from object points. @see SCgPointObject::buildGeometry
+    struct Geometry
+    {
+        //! @see SCgPointObject::shapeNormal
+        QPainterPath shapeNormal;
+        //! @see QGraphicsItem::boundingRect
+        QRectF boundingRect;
+    };
+
+    /*! Builds paths of object for given points. Object state isn't used,
+      so it may be called from worker thread. @see SCgScene::rebuildGeometry
+      @param points Points in this item's coordinates.
+      */
+    virtual Geometry buildGeometry(const PointFVector &points) const = 0;
+
+    /*! Sets paths, that were built for current points, then updates item
+      and objects connected to it.
+      */
+    virtual void applyGeometry(const Geometry &geometry) = 0;
+
     //! updates shape of object without changing its points.
-    virtual void updateShape() = 0;
+    void updateShape();
+
+    /*! Recalculates points, that depend on other objects (e.g. pair ends), without rebuilding shape.
+      @return False, if object has no shape yet (e.g. pair without begin or end object).
+      */
+    virtual bool updatePoints();
 
     //! Returns normal path, without pen width affected.
     QPainterPath shapeNormal() const
@@ -73,11 +98,28 @@ public:
         return mShapeNormal;
     }
 
-    //! Return line shape, used to work with points
-    QPainterPath lineShape() const
-    {
-        return mLineShape;
-    }
+    //! Return line shape, used to work with points. It's built on request.
+    QPainterPath lineShape() const;
+
+    /*! Stroked outline of object. Hit-testing doesn't use it, so it's built
+      only on request, if points were changed since previous one.
+      @see QGraphicsItem::shape
+      */
+    QPainterPath shape() const;
+
+    //! @see QGraphicsItem::boundingRect
+    QRectF boundingRect() const;
+
+    /*! Checks, that @p point is closer to object line than half of line width.
+      @param point Point in this item's coordinates.
+      */
+    bool isOnLine(const QPointF &point) const;
+
+    //! Analytic hit-test by object points. @see QGraphicsItem::contains
+    bool contains(const QPointF &point) const;
+
+    //! Analytic hit-test by object points. @see QGraphicsItem::collidesWithPath
+    bool collidesWithPath(const QPainterPath &path, Qt::ItemSelectionMode mode = Qt::IntersectsItemShape) const;
 
     /*! Returns true, if @p obj is acceptable for specified role.
      * e.g. this object can be begin or end object of pair, or owner for bus.
@@ -104,9 +146,25 @@ public:
      */
     static int indexForPoint(const PointFVector& v, const QPointF& point,bool closed = false);
 
+    //! @see SCgObject::memoryUsage
+    qint64 memoryUsage() const;
+
+    //! Approximate amount of memory used by painter path
+    static qint64 pathMemoryUsage(const QPainterPath &path);
+
 protected:
     //! Factory method;
     virtual SCgPointGraphicsItem* createPointItem(int pointIndex) = 0;
+
+    //! @return Width of line, that is used for hit-testing and stroked shape.
+    virtual qreal lineWidth() const;
+    //! @return True, if points form closed polygon, which interior belongs to object.
+    virtual bool isClosed() const;
+
+    /*! Sets geometry to object and drops stroked shapes. Notifies scene about
+      geometry change, so it must be called from applyGeometry().
+      */
+    void assignGeometry(const Geometry &geometry);
     //! List of created point graphics items.
     QList<SCgPointGraphicsItem*> mPointItems;
     //! Vector of object points
@@ -115,10 +173,24 @@ protected:
     qreal mDefaultZValue;
     //! Path that represents shape without any stroke (used for drawing)
     QPainterPath mShapeNormal;
-    //! Line shape used to process contains function to line
-    QPainterPath mLineShape;
+    //! Bounding rect of current geometry
+    QRectF mBoundingRect;
 
 private:
+    //! Builds stroked shapes, if they were dropped.
+    void ensureStroke() const;
+
+    //! Stroked line, built on request. @see SCgPointObject::lineShape
+    mutable QPainterPath mLineShape;
+    //! Stroked shape, built on request. @see SCgPointObject::shape
+    mutable QPainterPath mStrokeShape;
+    //! True, if stroked shapes match current geometry
+    mutable bool mIsStrokeValid;
+
     static qreal distanceToSubpath(const QPointF& p0, const QPointF& p1, const QPointF& p);
+    //! @return Squared distance from @p p to line through @p points.
+    static qreal distanceToLine(const PointFVector& points, const QPointF& p, bool closed);
+    //! @return True, if line through @p points crosses any edge of @p polygon.
+    static bool lineCrosses(const PointFVector& points, bool closed, const QPolygonF& polygon);
 };
 
@@ -14,7 +14,10 @@
 #include "scgtextitem.h"
 #include "scgpointgraphicsitem.h"
 #include "scgcontentfactory.h"
+#include "scgcontentviewermanager.h"
 #include "scgnodetextitem.h"
+#include "scgpairrouter.h"
+#include "scgscenevirtualizer.h"
 
 #include "modes/scgbusmode.h"
 #include "modes/scgpairmode.h"
@@ -44,7 +47,10 @@
 #include "commands/scgcommandidtfmove.h"
 #include "commands/scgcommandswappairorient.h"
 #include "commands/scgcommandremovebreakpoints.h"
+#include "commands/scgcommandmarkroutedpairs.h"
 #include "commands/scgcommandminimizecontour.h"
+#include "commands/scgcommandapplypositions.h"
+#include "commands/scgcommandreroutepairs.h"
 
 #include <QUrl>
 #include <QFile>
@@ -57,14 +63,37 @@
 #include <QGraphicsProxyWidget>
 #include <QCursor>
 #include <QMimeData>
+#include <QtAlgorithms>
+#include <QSet>
+#include <QPainter>
+#include <QtCore/qmath.h>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+
+//! Minimal number of objects, which shapes are built in parallel.
+#define SCG_PARALLEL_GEOMETRY_MIN 64
+//! Minimal distance between grid lines in device pixels.
+#define SCG_GRID_MIN_SPACING 4
 
 SCgScene::SCgScene(QUndoStack *undoStack, QObject *parent) :
     QGraphicsScene(parent),
     mMode(0),
     mUndoStack(undoStack),
     mIsGridDrawn(false),
+    mXStep(20),
+    mYStep(20),
+    mGridTileMultiplier(0),
+    mGridTileBucket(0),
     mIsIdtfModelDirty(true),
-    mCursor(0,0)
+    mCursor(0,0),
+    mIsGeometryPropagationSuspended(false),
+    mBulkInsertDepth(0),
+    mBulkWasSuspended(false),
+    mBulkIndexDisabled(false),
+    mBulkIndexMethod(BspTreeIndex),
+    mPairRouter(0),
+    mVirtualizer(0)
 {
     mSceneModes.fill(0,(int)Mode_Count);
 
@@ -75,6 +104,8 @@ SCgScene::SCgScene(QUndoStack *undoStack, QObject *parent) :
     mSceneModes[Mode_InsertTemplate] = new SCgInsertMode(this);
     mSceneModes[Mode_Clone] = new SCgCloneMode(this);
 
+    mPairRouter = new SCgPairRouter(this);
+
     setEditMode(Mode_Select);
 }
 
@@ -123,6 +154,9 @@ SCgObject* SCgScene::objectAt(const QPointF &point) const
 
 void SCgScene::renderToImage(QPainter *painter, const QRectF &target, const QRectF &source, Qt::AspectRatioMode aspectRatioMode)
 {
+    // content out of views has no viewers
+    SCgContentViewerManager::instance()->loadViewers(this, source.isNull() ? sceneRect() : source);
+
     QBrush brush = backgroundBrush();
     setBackgroundBrush(QBrush(Qt::NoBrush));
     render(painter, target, source, aspectRatioMode);
@@ -140,6 +174,9 @@ void SCgScene::updateIdtfList()
                 mIdtfList.append(idtf);
         }
 
+    if (mVirtualizer)
+        mIdtfList.append(mVirtualizer->idleIdtfList());
+
     mIdtfList.removeDuplicates();
 
     //    mIsIdtfModelDirty = false;
@@ -284,6 +321,7 @@ SCgContour* SCgScene::createSCgContour(const QVector<QPointF> &points)
 
 SCgBaseCommand* SCgScene::deleteSelObjectsCommand(SCgBaseCommand* parentCmd, bool addToStack)
 {
+    materializeSelection();
     QList<QGraphicsItem*> selObjects = selectedItems();
     QList<QGraphicsItem*>::iterator it = selObjects.begin();
 
@@ -595,6 +633,15 @@ SCgBaseCommand* SCgScene::moveSelectedCommand(const ItemUndoInfo& undoInfo, SCgB
             cmd = new SCgCommandSelectedObjectMove(this, objUndoInfo, parentCmd);
         else
             new SCgCommandSelectedObjectMove(this, objUndoInfo, cmd);
+
+        // reroute automatically routed pairs, whose ends are moved
+        QList<SCgObject*> moved;
+        foreach(QGraphicsItem* item, objUndoInfo.keys())
+            moved.append(static_cast<SCgObject*>(item));
+
+        QList<SCgPair*> routed = mPairRouter->routedPairsFor(moved);
+        if(!routed.isEmpty())
+            new SCgCommandReroutePairs(this, routed, cmd);
     }
 
     if(cmd && addToStack)
@@ -741,6 +788,31 @@ SCgBaseCommand* SCgScene::changeObjectPointsCommand(SCgPointObject* obj,
     return cmd;
 }
 
+SCgCommandApplyPositions* SCgScene::applyPositionsCommand(SCgBaseCommand* parentCmd)
+{
+    return new SCgCommandApplyPositions(this, parentCmd);
+}
+
+SCgBaseCommand* SCgScene::routePairsCommand(const QList<SCgPair*> &pairs,
+                                            SCgBaseCommand* parentCmd,
+                                            bool addToStack)
+{
+    SCgBaseCommand* cmd = new SCgBaseCommand(this, 0, parentCmd);
+    cmd->setText(tr("Route pairs"));
+
+    QMap<SCgPair*, QVector<QPointF> > routes = mPairRouter->route(pairs);
+    QMap<SCgPair*, QVector<QPointF> >::const_iterator it;
+    for(it = routes.constBegin(); it != routes.constEnd(); ++it)
+        changeObjectPointsCommand(it.key(), it.value(), cmd, false);
+
+    new SCgCommandMarkRoutedPairs(this, routes.keys(), true, cmd);
+
+    if(addToStack)
+        mUndoStack->push(cmd);
+
+    return cmd;
+}
+
 void SCgScene::addCommandToStack(SCgBaseCommand* cmd)
 {
     Q_ASSERT_X(cmd != 0,
@@ -756,28 +828,51 @@ void SCgScene::setDrawGrid(bool draw, QColor color, int xStep, int yStep)
     mYStep = yStep;
     mIsGridDrawn = draw;
     mGridColor = color;
+    mGridTile = QPixmap();
     update();
 }
 
-void SCgScene::drawBackground(QPainter* painter, const QRectF& rect)
+void SCgScene::updateGridTile(int multiplier, int bucket)
 {
-    if(mIsGridDrawn)
-    {
-        qreal left = int(rect.left()) - (int(rect.left()) % mXStep);
-        qreal top = int(rect.top()) - (int(rect.top()) % mYStep);
+    // tile is rendered in device pixels of the bucket scale, so lines stay sharp
+    qreal scale = qPow(2, bucket);
+    QSize size(qMax(1, qRound(mXStep * multiplier * scale)),
+               qMax(1, qRound(mYStep * multiplier * scale)));
 
-        painter->setPen(mGridColor);
+    mGridTile = QPixmap(size);
+    mGridTile.fill(Qt::transparent);
 
-        QVector<QLineF> linesX;
-        for (qreal x = left; x < rect.right(); x += mXStep)
-            linesX.append(QLineF(x, rect.top(), x, rect.bottom()));
+    QPainter painter(&mGridTile);
+    painter.setPen(QPen(mGridColor, 0));
+    painter.drawLine(0, 0, size.width(), 0);
+    painter.drawLine(0, 0, 0, size.height());
 
-        QVector<QLineF> linesY;
-        for (qreal y = top; y < rect.bottom(); y += mYStep)
-            linesY.append(QLineF(rect.left(), y, rect.right(), y));
+    mGridTileMultiplier = multiplier;
+    mGridTileBucket = bucket;
+}
 
-        painter->drawLines(linesX);
-        painter->drawLines(linesY);
+void SCgScene::drawBackground(QPainter* painter, const QRectF& rect)
+{
+    if(mIsGridDrawn && mXStep > 0 && mYStep > 0)
+    {
+        qreal scale = qSqrt(qAbs(painter->worldTransform().determinant()));
+        if (qFuzzyIsNull(scale))
+            return;
+
+        // skip grid lines, that would be closer than a few device pixels
+        int multiplier = 1;
+        while (qMin(mXStep, mYStep) * multiplier * scale < SCG_GRID_MIN_SPACING)
+            multiplier *= 2;
+
+        int bucket = qRound(qLn(scale) / M_LN2);
+        if (mGridTile.isNull() || multiplier != mGridTileMultiplier || bucket != mGridTileBucket)
+            updateGridTile(multiplier, bucket);
+
+        // tile covers one grid cell in scene coordinates, lines are at multiples of step
+        QBrush brush(mGridTile);
+        brush.setTransform(QTransform::fromScale(qreal(mXStep * multiplier) / mGridTile.width(),
+                                                 qreal(mYStep * multiplier) / mGridTile.height()));
+        painter->fillRect(rect, brush);
     }
     else
         QGraphicsScene::drawBackground(painter, rect);
@@ -789,14 +884,31 @@ void SCgScene::setCursorPos(const QPointF& cursor)
     mCursor = cursor;
 }
 
+QPointF SCgScene::findPos(SCgObject *obj) const
+{
+    int record = mVirtualizer ? mVirtualizer->itemRecord(obj) : -1;
+    return record >= 0 ? mVirtualizer->searchPos(record) : obj->sceneBoundingRect().topLeft();
+}
 
-//! @return true if first item @p it1 lies left and above to item @p it2
-bool topToBottomleftToRightSortingPredicate(SCgObject* it1, SCgObject* it2)
+
+namespace
+{
+//! Object, that is checked by find. Records of virtual scene get items only when they are found.
+struct FindCandidate
 {
-    Q_ASSERT(it1 && it2);
-    bool isLeft = it1->sceneBoundingRect().x() < it2->sceneBoundingRect().x();
-    bool isAbove = it1->sceneBoundingRect().y() < it2->sceneBoundingRect().y();
-    bool haveSameY = it1->sceneBoundingRect().y() == it2->sceneBoundingRect().y();
+    QPointF pos;
+    QString idtf;
+    SCgObject *object;
+    int record;
+};
+}
+
+//! @return true if first item @p c1 lies left and above to item @p c2
+static bool topToBottomleftToRightSortingPredicate(const FindCandidate &c1, const FindCandidate &c2)
+{
+    bool isLeft = c1.pos.x() < c2.pos.x();
+    bool isAbove = c1.pos.y() < c2.pos.y();
+    bool haveSameY = c1.pos.y() == c2.pos.y();
 
     return isAbove || (isLeft && haveSameY);
 }
@@ -806,45 +918,68 @@ SCgObject* SCgScene::find(const QString &ttf, FindFlags flg)
     if(ttf.isEmpty())
         return 0;
 
-    // only SCgObjects
-    QList<SCgObject*> list;
+    // only SCgObjects, records of virtual scene are checked whether they have items or not
+    QVector<FindCandidate> list;
     foreach(QGraphicsItem* it, items())
     {
         if(SCgObject::isSCgObjectType(it->type()))
-            list.append(static_cast<SCgObject*>(it));
+        {
+            SCgObject *obj = static_cast<SCgObject*>(it);
+            if (mVirtualizer && mVirtualizer->itemRecord(obj) >= 0)
+                continue;
+            FindCandidate candidate = { obj->sceneBoundingRect().topLeft(), obj->idtfValue(), obj, -1 };
+            list.append(candidate);
+        }
     }
 
-    if(list.isEmpty())
-        return 0;
-
     //for providing the same order in different calls of this function
     //we sort itemList by scene positions of items.
     qSort(list.begin(), list.end(), topToBottomleftToRightSortingPredicate);
-    QList<SCgObject*>::const_iterator beginIt = list.begin();
+
+    // records are already sorted by their positions in file, that don't change
+    if (mVirtualizer)
+    {
+        QVector<FindCandidate> records;
+        foreach (int record, mVirtualizer->searchOrder())
+        {
+            SCgObject *obj = mVirtualizer->recordItem(record);
+            FindCandidate candidate = { mVirtualizer->searchPos(record),
+                                        obj ? obj->idtfValue() : mVirtualizer->recordIdtf(record), obj, record };
+            records.append(candidate);
+        }
+
+        QVector<FindCandidate> merged(list.size() + records.size());
+        std::merge(records.constBegin(), records.constEnd(), list.constBegin(), list.constEnd(),
+                   merged.begin(), topToBottomleftToRightSortingPredicate);
+        list = merged;
+    }
+
+    if(list.isEmpty())
+        return 0;
+    QVector<FindCandidate>::const_iterator beginIt = list.constBegin();
 
     //Finds item (rather iterator), that lies closer to mCursor. From this position find process begins.
     while (true)
     {
-        SCgObject *curr = *beginIt;
-        bool isRight = curr->sceneBoundingRect().x() >= mCursor.x();
-        bool isBelow = curr->sceneBoundingRect().y() >= mCursor.y();
+        bool isRight = beginIt->pos.x() >= mCursor.x();
+        bool isBelow = beginIt->pos.y() >= mCursor.y();
         if (isRight && isBelow)
             break;
 
         ++beginIt;
-        if(beginIt == list.end())
+        if(beginIt == list.constEnd())
             break;
     }
 
     //If we don't have to check item under mCursor
     //then we'll change iterator position corresponding to search direction
-    if(beginIt != list.end())
+    if(beginIt != list.constEnd())
     {
-        if( !(flg & CheckCurrent) && (*beginIt)->sceneBoundingRect().topLeft() == mCursor)
+        if( !(flg & CheckCurrent) && beginIt->pos == mCursor)
         {
             if(flg & FindForward)
                 ++beginIt;
-            else if( beginIt != list.begin())
+            else if( beginIt != list.constBegin())
                 --beginIt;
             else
                 return 0;
@@ -855,33 +990,35 @@ SCgObject* SCgScene::find(const QString &ttf, FindFlags flg)
     else
         --beginIt;
 
-    SCgObject* result = 0;
+    const FindCandidate* result = 0;
 
     //iterate over all
-    QList<SCgObject*>::const_iterator it = beginIt;
-    while(true)
+    QVector<FindCandidate>::const_iterator it = beginIt;
+    while(it != list.constEnd())
     {
-        if( (*it)->idtfValue().startsWith(ttf, ((flg & CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive)))
+        if(it->idtf.startsWith(ttf, ((flg & CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive)))
         {
-            result = *it;
+            result = &*it;
             break;
         }
 
         if (flg & FindForward)
         {
             ++it;
-            if(it == list.end())
-                break;
         }
         else
         {
-            if(it == list.begin())
+            if(it == list.constBegin())
                 break;
             --it;
         }
     }
 
-    return result;
+    if (!result)
+        return 0;
+
+    // found record is shown, so it gets item
+    return result->object ? result->object : mVirtualizer->materializeRecord(result->record);
 }
 
 void SCgScene::dropEvent(QGraphicsSceneDragDropEvent *event)
@@ -940,3 +1077,186 @@ QGraphicsItem* SCgScene::itemAt(const QPointF & point) const
     Q_ASSERT(views().size() > 0);
     return QGraphicsScene::itemAt(point, views().first()->transform());
 }
+
+void SCgScene::setGeometryPropagationSuspended(bool suspended)
+{
+    mIsGeometryPropagationSuspended = suspended;
+}
+
+bool SCgScene::isGeometryPropagationSuspended() const
+{
+    return mIsGeometryPropagationSuspended;
+}
+
+//! Points of object, which shape is built in worker thread. @see SCgScene::rebuildGeometry
+struct SCgGeometryTask
+{
+    SCgPointObject *object;
+    SCgPointObject::PointFVector points;
+};
+
+static SCgPointObject::Geometry buildGeometryFn(const SCgGeometryTask &task)
+{
+    return task.object->buildGeometry(task.points);
+}
+
+void SCgScene::rebuildGeometry(const QList<SCgObject*> &objects)
+{
+    bool wasSuspended = mIsGeometryPropagationSuspended;
+    mIsGeometryPropagationSuspended = true;
+
+    QHash<SCgObject*, int> depths;
+    QList< QPair<int, SCgObject*> > order;
+    foreach (SCgObject *obj, objects)
+    {
+        int type = obj->type();
+        if (type == SCgPair::Type || type == SCgBus::Type || type == SCgContour::Type)
+            order.append(qMakePair(dependencyDepth(obj, depths), obj));
+    }
+    qStableSort(order.begin(), order.end());
+
+    // crossing points depend only on points of connected objects, that are updated before
+    QVector<SCgGeometryTask> tasks;
+    tasks.reserve(order.size());
+    for (int i = 0; i < order.size(); ++i)
+    {
+        SCgPointObject *obj = static_cast<SCgPointObject*>(order[i].second);
+        if (!obj->updatePoints())
+            continue;
+
+        SCgGeometryTask task;
+        task.object = obj;
+        task.points = obj->points();
+        tasks.append(task);
+    }
+
+    // paths don't depend on other objects
+    QVector<SCgPointObject::Geometry> geometry;
+    if (tasks.size() >= SCG_PARALLEL_GEOMETRY_MIN)
+    {
+        geometry = QtConcurrent::blockingMapped<QVector<SCgPointObject::Geometry> >(tasks, buildGeometryFn);
+    }else
+    {
+        geometry.reserve(tasks.size());
+        foreach (const SCgGeometryTask &task, tasks)
+            geometry.append(buildGeometryFn(task));
+    }
+
+    for (int i = 0; i < tasks.size(); ++i)
+        tasks[i].object->applyGeometry(geometry[i]);
+
+    mIsGeometryPropagationSuspended = wasSuspended;
+}
+
+int SCgScene::dependencyDepth(SCgObject *obj, QHash<SCgObject*, int> &depths)
+{
+    if (!obj)
+        return 0;
+
+    QHash<SCgObject*, int>::const_iterator it = depths.constFind(obj);
+    if (it != depths.constEnd())
+        return it.value();
+
+    // prevents infinite recursion on cyclic connections
+    depths.insert(obj, 0);
+
+    int depth = 0;
+    if (obj->type() == SCgPair::Type)
+    {
+        SCgPair *pair = static_cast<SCgPair*>(obj);
+        depth = 1 + qMax(dependencyDepth(pair->beginObject(), depths),
+                         dependencyDepth(pair->endObject(), depths));
+    }
+    else if (obj->type() == SCgBus::Type)
+    {
+        depth = 1 + dependencyDepth(static_cast<SCgBus*>(obj)->owner(), depths);
+    }
+
+    depths.insert(obj, depth);
+    return depth;
+}
+
+void SCgScene::beginBulkInsert(int objectCount)
+{
+    if (mBulkInsertDepth++ > 0)
+        return;
+
+    mBulkWasSuspended = mIsGeometryPropagationSuspended;
+    mIsGeometryPropagationSuspended = true;
+
+    // inserting a few objects into large scene is cheaper with index updates,
+    // than with rebuilding of the whole index
+    mBulkIndexMethod = itemIndexMethod();
+    mBulkIndexDisabled = mBulkIndexMethod != NoIndex && objectCount >= items().size();
+    if (mBulkIndexDisabled)
+        setItemIndexMethod(NoIndex);
+}
+
+void SCgScene::endBulkInsert(const QList<SCgObject*> &objects)
+{
+    Q_ASSERT(mBulkInsertDepth > 0);
+
+    mBulkObjects.append(objects);
+    if (--mBulkInsertDepth > 0)
+        return;
+
+    // nested sections usually pass the same objects, as the outermost one
+    QList<SCgObject*> inserted;
+    QSet<SCgObject*> unique;
+    foreach (SCgObject *obj, mBulkObjects)
+    {
+        if (unique.contains(obj))
+            continue;
+        unique.insert(obj);
+        inserted.append(obj);
+    }
+    mBulkObjects.clear();
+    rebuildGeometry(inserted);
+
+    mIsGeometryPropagationSuspended = mBulkWasSuspended;
+    if (mBulkIndexDisabled)
+        setItemIndexMethod(mBulkIndexMethod);
+    mBulkIndexDisabled = false;
+}
+
+SCgPairRouter* SCgScene::pairRouter() const
+{
+    return mPairRouter;
+}
+
+QUndoStack* SCgScene::undoStack() const
+{
+    return mUndoStack;
+}
+
+void SCgScene::setVirtualModel(const GwfSceneSnapshot &model)
+{
+    delete mVirtualizer;
+    mVirtualizer = new SCgSceneVirtualizer(this, model);
+
+    // scene rectangle doesn't grow by items anymore, so views can scroll to records
+    setSceneRect(mVirtualizer->modelRect().united(itemsBoundingRect()));
+    connect(this, SIGNAL(changed(QList<QRectF>)), this, SLOT(growSceneRect(QList<QRectF>)), Qt::UniqueConnection);
+    setIdtfDirtyFlag();
+}
+
+SCgSceneVirtualizer* SCgScene::virtualizer() const
+{
+    return mVirtualizer;
+}
+
+void SCgScene::materializeSelection()
+{
+    if (mVirtualizer)
+        mVirtualizer->materializeSelection();
+}
+
+void SCgScene::growSceneRect(const QList<QRectF> &region)
+{
+    QRectF rect = sceneRect();
+    foreach (const QRectF &r, region)
+        rect = rect.united(r);
+
+    if (rect != sceneRect())
+        setSceneRect(rect);
+}
@@ -10,6 +10,8 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsPathItem>
 #include <QStringList>
+#include <QHash>
+#include <QPixmap>
 
 #include "scgobject.h"
 #include "scgcontent.h"
@@ -22,7 +24,11 @@ class SCgBus;
 class SCgContour;
 class QGraphicsItemGroup;
 class SCgBaseCommand;
+class SCgCommandApplyPositions;
+class SCgPairRouter;
 class SCgPointObject;
+class SCgSceneVirtualizer;
+class GwfSceneSnapshot;
 
 class QUndoStack;
 
@@ -111,6 +117,11 @@ public:
      */
     void setCursorPos(const QPointF& cursor);
 
+    /*! @return Position of @p obj, that find uses to order objects. Objects of virtual scene
+     * keep positions, that they had in file. @see setCursorPos
+     */
+    QPointF findPos(SCgObject *obj) const;
+
     //! @return List of used identifiers on this scene.
     QStringList idtfList();
 
@@ -339,6 +350,25 @@ public:
                                               SCgBaseCommand* parentCmd = 0,
                                               bool addToStack = true);
 
+    /*! Create undo/redo command to change positions and points of many objects at once.
+     * Changes should be added into created command, before it will be pushed into stack.
+     * @param parentCmd Pointer to parend undo/redo command
+     * @see SCgCommandApplyPositions
+     */
+    SCgCommandApplyPositions* applyPositionsCommand(SCgBaseCommand* parentCmd = 0);
+
+    /*! Create undo/redo command to route pairs around obstacles.
+     * Routed pairs are rerouted automatically, when their ends are moved.
+     * Routed flag is kept by undo/redo, but it isn't saved into files.
+     * @param pairs List of pairs to route
+     * @param parentCmd Pointer to parend undo/redo command
+     * @param addToStack Flag to add created command into stack
+     * @see SCgPairRouter
+     */
+    SCgBaseCommand* routePairsCommand(const QList<SCgPair*> &pairs,
+                                      SCgBaseCommand* parentCmd = 0,
+                                      bool addToStack = true);
+
     /*! @} */
 
     //! Adds given command @p cmd to scene's undoStack.
@@ -362,6 +392,59 @@ public:
 
     QGraphicsItem* itemAt(const QPointF & point) const;
 
+    /*! Suspend/resume geometry propagation between objects.
+     * While propagation is suspended, objects don't update connected objects
+     * and don't rebuild shapes when their positions or points are changed.
+     * It's used to apply a lot of geometry changes at once.
+     * @see SCgCommandApplyPositions
+     */
+    void setGeometryPropagationSuspended(bool suspended);
+
+    //! @return true, if geometry propagation is suspended
+    bool isGeometryPropagationSuspended() const;
+
+    /*! Rebuilds pairs, buses and contours from @p objects exactly once, in order of
+     * their dependencies: objects, that pair or bus is connected to, are rebuilt before it.
+     * Other objects are skipped. Geometry propagation is suspended while rebuilding.
+     */
+    void rebuildGeometry(const QList<SCgObject*> &objects);
+
+    /*! Starts bulk insertion of objects. Geometry propagation is suspended, so objects
+     * can be added, parented and connected without rebuilding anything after each change.
+     * If inserted objects are not fewer than items on scene, item index is disabled too,
+     * and it's rebuilt once in endBulkInsert(). Calls may be nested.
+     * @param objectCount Expected number of inserted objects.
+     * @see DefaultSCgObjectBuilder
+     */
+    void beginBulkInsert(int objectCount);
+
+    /*! Finishes bulk insertion, started by beginBulkInsert().
+     * @param objects Inserted objects. Geometry of objects from all nested calls
+     * is rebuilt once, when the outermost call ends.
+     */
+    void endBulkInsert(const QList<SCgObject*> &objects);
+
+    //! @return router, that is used to route pairs on this scene
+    SCgPairRouter* pairRouter() const;
+
+    //! @return Undo stack, that commands of this scene are pushed to.
+    QUndoStack* undoStack() const;
+
+    /*! Keeps objects of @p model as records, their items are created only near viewports
+     * of views. Scene rectangle covers all objects. Used for huge sheets instead of builder.
+     * @see SCgSceneVirtualizer
+     */
+    void setVirtualModel(const GwfSceneSnapshot &model);
+
+    //! @return Virtualizer of scene objects, or null if all objects are items.
+    SCgSceneVirtualizer* virtualizer() const;
+
+    /*! Creates items of selected objects, that are kept only as records of virtual scene.
+     * Must be called before selectedItems() is used to change whole selection.
+     * @see SCgSceneVirtualizer::selectRecords
+     */
+    void materializeSelection();
+
 private:
     QVector<SCgMode*> mSceneModes;
     //! Current edit mode
@@ -375,6 +458,20 @@ private:
     int mXStep, mYStep;
     QColor mGridColor;
 
+    /*! @defgroup gridTile Cached grid tile. @see SCgScene::drawBackground
+     *  @{
+     */
+    //! One grid cell, that is rendered for current zoom bucket
+    QPixmap mGridTile;
+    //! Number of grid steps in one tile cell
+    int mGridTileMultiplier;
+    //! Zoom bucket (power of two), that tile is rendered for
+    int mGridTileBucket;
+    /*! @}*/
+
+    //! Renders grid tile for given density and zoom bucket.
+    void updateGridTile(int multiplier, int bucket);
+
     //! Holds true if some identifiers were changed during the editing KB(and after creating new SCgScene).
     bool mIsIdtfModelDirty;
     //! Holds list of identifiers. @see mIdtfModelIsDirty, @see idtfList().
@@ -386,6 +483,32 @@ private:
     //! @see SCgScene::find(const QString &ttf, FindFlags flg). Find process begins from this position.
     QPointF mCursor;
 
+    //! @see SCgScene::setGeometryPropagationSuspended
+    bool mIsGeometryPropagationSuspended;
+
+    /*! @defgroup bulkInsert Bulk insertion state. @see SCgScene::beginBulkInsert
+     *  @{
+     */
+    int mBulkInsertDepth;
+    bool mBulkWasSuspended;
+    bool mBulkIndexDisabled;
+    ItemIndexMethod mBulkIndexMethod;
+    //! Objects of all nested sections, they are rebuilt, when the outermost one ends.
+    QList<SCgObject*> mBulkObjects;
+    /*! @}*/
+
+    /*! Calculates dependency depth of object. Nodes and contours have zero depth,
+     * pairs and buses are deeper than objects they are connected to.
+     * @param depths Cache of already calculated depths.
+     */
+    static int dependencyDepth(SCgObject *obj, QHash<SCgObject*, int> &depths);
+
+    //! @see SCgScene::pairRouter
+    SCgPairRouter *mPairRouter;
+
+    //! @see SCgScene::virtualizer
+    SCgSceneVirtualizer *mVirtualizer;
+
 private:
     //! previous edit mode
     EditMode mPreviousEditMode;
@@ -416,5 +539,7 @@ public slots:
     void setIdtfDirtyFlag();
 private slots:
     void ensureSelectedItemVisible();
+    //! Extends fixed scene rectangle of virtual scene by changed areas.
+    void growSceneRect(const QList<QRectF> &region);
 };
 
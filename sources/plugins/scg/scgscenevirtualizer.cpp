@@ -0,0 +1,906 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgscenevirtualizer.h"
+#include "scgscene.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+#include "scgconfig.h"
+#include "commands/scgbasecommand.h"
+#include "trace.h"
+
+#include <QGraphicsView>
+#include <QApplication>
+#include <QUndoStack>
+#include <QPolygonF>
+#include <QPair>
+#include <QtAlgorithms>
+#include <QtCore/qmath.h>
+
+#include <algorithm>
+
+//! Size of spatial index cell in scene coordinates
+#define SCG_VIRTUAL_CELL_SIZE       512
+//! Records, that cover more cells, are checked for every query instead of indexing
+#define SCG_VIRTUAL_MAX_CELLS       64
+//! Half size of node bounds. Identifiers and contents are covered by load margin
+#define SCG_VIRTUAL_NODE_EXTENT     16
+//! Items are created in this part of viewport size around it
+#define SCG_VIRTUAL_LOAD_MARGIN     0.5
+//! Items are released out of this part of viewport size around it
+#define SCG_VIRTUAL_RELEASE_MARGIN  1.5
+//! Delay of merged updates in milliseconds
+#define SCG_VIRTUAL_UPDATE_DELAY    50
+
+QList<SCgSceneVirtualizer*> SCgSceneVirtualizer::msInstances;
+
+//! @return Record id for object id from file, or 0 if there is no such object.
+static quint64 recordId(const QHash<quint64, int> &ids, quint64 id)
+{
+    QHash<quint64, int>::const_iterator it = ids.constFind(id);
+    return it != ids.constEnd() ? quint64(it.value() + 1) : 0;
+}
+
+SCgSceneVirtualizer::SCgSceneVirtualizer(SCgScene *scene, const GwfSceneSnapshot &model)
+    : QObject(scene)
+    , mScene(scene)
+    , mRecords(model.objects())
+    , mLiveCount(0)
+    , mSelectedCount(0)
+    , mSelecting(false)
+    , mPinnedDirty(true)
+{
+    Q_ASSERT(scene);
+    KBE_TRACE_SCOPE("scg", "virtual.index");
+
+    int count = mRecords.size();
+    mStates.fill(Idle, count);
+
+    // ids from file are replaced with record numbers, so they never match ids of live items
+    QHash<quint64, int> ids;
+    ids.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        // objects with duplicated ids are skipped like builder does
+        if (ids.contains(mRecords.at(i).id))
+            mStates[i] = Removed;
+        else
+            ids.insert(mRecords.at(i).id, i);
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        GwfObjectSnapshot &rec = mRecords[i];
+        rec.id = i + 1;
+        rec.parentId = recordId(ids, rec.parentId);
+        rec.beginId = recordId(ids, rec.beginId);
+        rec.endId = recordId(ids, rec.endId);
+        rec.ownerId = recordId(ids, rec.ownerId);
+    }
+
+    // check objects the same way, as DefaultSCgObjectBuilder does
+    for (int i = 0; i < count; ++i)
+    {
+        if (mStates.at(i) == Removed)
+            continue;
+
+        GwfObjectSnapshot &rec = mRecords[i];
+        if (rec.type == SCgContour::Type && rec.points.size() < 3)
+            mStates[i] = Removed;
+
+        if (rec.type == SCgBus::Type)
+        {
+            int owner = recordIndex(rec.ownerId);
+            if (owner < 0)
+            {
+                GwfObjectSnapshot node;
+                node.type = SCgNode::Type;
+                node.typeAlias = "node/const/general_node";
+                node.pos = rec.beginPos;
+                node.id = mRecords.size() + 1;
+                rec.ownerId = node.id;
+                // reference is invalidated by append
+                mRecords.append(node);
+                mStates.append(Idle);
+            }
+            else if (mRecords.at(owner).type != SCgNode::Type)
+                mStates[i] = Removed;
+        }
+    }
+    count = mRecords.size();
+
+    // pairs can be connected to removed pairs, so it's repeated until nothing changes
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int i = 0; i < count; ++i)
+        {
+            const GwfObjectSnapshot &rec = mRecords.at(i);
+            if (rec.type != SCgPair::Type || mStates.at(i) == Removed)
+                continue;
+
+            int begin = recordIndex(rec.beginId);
+            int end = recordIndex(rec.endId);
+            if (begin < 0 || end < 0 || mStates.at(begin) == Removed || mStates.at(end) == Removed)
+            {
+                mStates[i] = Removed;
+                changed = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        GwfObjectSnapshot &rec = mRecords[i];
+        int parent = recordIndex(rec.parentId);
+        if (parent >= 0 && mStates.at(parent) == Removed)
+            rec.parentId = 0;
+    }
+
+    // file keeps positions of node ends only, other ends are placed at middle of their objects
+    for (int pass = 0; pass < 2; ++pass)
+        for (int i = 0; i < count; ++i)
+        {
+            GwfObjectSnapshot &rec = mRecords[i];
+            if (rec.type != SCgPair::Type || mStates.at(i) == Removed)
+                continue;
+
+            const GwfObjectSnapshot &begin = mRecords.at(recordIndex(rec.beginId));
+            if (begin.type != SCgNode::Type)
+                rec.beginPos = recordBounds(begin).center();
+            const GwfObjectSnapshot &end = mRecords.at(recordIndex(rec.endId));
+            if (end.type != SCgNode::Type)
+                rec.endPos = recordBounds(end).center();
+        }
+
+    mItems.fill(0, count);
+    mSelected.fill(false, count);
+    mBounds.resize(count);
+    for (int i = 0; i < count; ++i)
+        if (mStates.at(i) != Removed)
+        {
+            indexRecord(i);
+            mModelRect = mModelRect.united(mBounds.at(i));
+        }
+
+    // bounds change when items are released, so find uses positions from file
+    mSearchPos.resize(count);
+    QVector<QPair<qreal, QPair<qreal, int> > > order;
+    order.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        mSearchPos[i] = mBounds.at(i).topLeft();
+        order.append(qMakePair(mSearchPos.at(i).y(), qMakePair(mSearchPos.at(i).x(), i)));
+    }
+    qSort(order);
+    mSearchOrder.reserve(count);
+    for (int i = 0; i < count; ++i)
+        mSearchOrder.append(order.at(i).second.second);
+
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(SCG_VIRTUAL_UPDATE_DELAY);
+    connect(&mUpdateTimer, SIGNAL(timeout()), this, SLOT(updateItems()));
+    connect(mScene->undoStack(), SIGNAL(indexChanged(int)), this, SLOT(undoStackChanged()));
+    connect(mScene, SIGNAL(selectionChanged()), this, SLOT(sceneSelectionChanged()));
+
+    msInstances.append(this);
+    scheduleUpdate();
+}
+
+SCgSceneVirtualizer::~SCgSceneVirtualizer()
+{
+    msInstances.removeOne(this);
+}
+
+bool SCgSceneVirtualizer::isNeeded(int objectCount)
+{
+    int threshold = scg_cfg_get_value(scg_key_virtual_scene_threshold).toInt();
+    return threshold > 0 && objectCount >= threshold;
+}
+
+int SCgSceneVirtualizer::recordCount() const
+{
+    return mRecords.size();
+}
+
+int SCgSceneVirtualizer::liveCount() const
+{
+    return mLiveCount;
+}
+
+QRectF SCgSceneVirtualizer::modelRect() const
+{
+    return mModelRect;
+}
+
+QRectF SCgSceneVirtualizer::recordBounds(const GwfObjectSnapshot &rec)
+{
+    switch (rec.type)
+    {
+    case SCgNode::Type:
+        return QRectF(rec.pos.x() - SCG_VIRTUAL_NODE_EXTENT, rec.pos.y() - SCG_VIRTUAL_NODE_EXTENT,
+                      2 * SCG_VIRTUAL_NODE_EXTENT, 2 * SCG_VIRTUAL_NODE_EXTENT);
+    case SCgPair::Type:
+    case SCgBus::Type:
+    {
+        // straight lines have empty bounds, that don't intersect anything
+        QRectF bounds = QPolygonF(QVector<QPointF>() << rec.beginPos << rec.points << rec.endPos).boundingRect();
+        return bounds.adjusted(-1, -1, 1, 1);
+    }
+    case SCgContour::Type:
+        return QPolygonF(rec.points).boundingRect();
+    }
+    return QRectF();
+}
+
+int SCgSceneVirtualizer::recordIndex(quint64 id) const
+{
+    return (id > 0 && id <= quint64(mRecords.size())) ? int(id - 1) : -1;
+}
+
+void SCgSceneVirtualizer::dependencies(int record, QVector<int> &res) const
+{
+    const GwfObjectSnapshot &rec = mRecords.at(record);
+    int parent = recordIndex(rec.parentId);
+    if (parent >= 0)
+        res.append(parent);
+
+    if (rec.type == SCgPair::Type)
+    {
+        res.append(recordIndex(rec.beginId));
+        res.append(recordIndex(rec.endId));
+    }
+    else if (rec.type == SCgBus::Type)
+        res.append(recordIndex(rec.ownerId));
+}
+
+void SCgSceneVirtualizer::itemDependencies(SCgObject *obj, QVector<int> &res) const
+{
+    QList<QGraphicsItem*> deps;
+    deps << obj->parentItem();
+    if (obj->type() == SCgPair::Type)
+    {
+        SCgPair *pair = static_cast<SCgPair*>(obj);
+        deps << pair->beginObject() << pair->endObject();
+    }
+    else if (obj->type() == SCgBus::Type)
+        deps << static_cast<SCgBus*>(obj)->owner();
+
+    foreach (QGraphicsItem *item, deps)
+    {
+        if (!item || !SCgObject::isSCgObjectType(item->type()))
+            continue;
+
+        QHash<SCgObject*, int>::const_iterator it = mItemRecords.constFind(static_cast<SCgObject*>(item));
+        if (it != mItemRecords.constEnd())
+            res.append(it.value());
+        else
+            itemDependencies(static_cast<SCgObject*>(item), res);
+    }
+}
+
+void SCgSceneVirtualizer::closure(QVector<int> &records, QVector<bool> &marks) const
+{
+    QVector<int> stack = records;
+    records.clear();
+    QVector<int> deps;
+    while (!stack.isEmpty())
+    {
+        int record = stack.last();
+        stack.pop_back();
+        if (marks.at(record))
+            continue;
+
+        marks[record] = true;
+        records.append(record);
+
+        deps.clear();
+        dependencies(record, deps);
+        foreach (int dep, deps)
+            if (!marks.at(dep))
+                stack.append(dep);
+    }
+}
+
+bool SCgSceneVirtualizer::isAlive(int record, QVector<char> &cache) const
+{
+    char &cached = cache[record];
+    if (cached >= 0)
+        return cached;
+
+    bool alive;
+    switch (mStates.at(record))
+    {
+    case Removed:
+        alive = false;
+        break;
+    case Live:
+        alive = !mItems.at(record)->isDead();
+        break;
+    default:
+    {
+        // object was deleted together with item, that it's connected to
+        cache[record] = 1;
+        QVector<int> deps;
+        dependencies(record, deps);
+        alive = true;
+        foreach (int dep, deps)
+            if (!isAlive(dep, cache))
+            {
+                alive = false;
+                break;
+            }
+    }
+    }
+
+    cache[record] = alive ? 1 : 0;
+    return alive;
+}
+
+SCgObject* SCgSceneVirtualizer::createItem(const GwfObjectSnapshot &rec)
+{
+    SCgObject *obj = 0;
+    switch (rec.type)
+    {
+    case SCgNode::Type:
+    {
+        SCgNode *node = new SCgNode;
+        mScene->addItem(node);
+        node->setPos(rec.pos);
+        node->setContent(rec.contentMimeType, rec.contentData, rec.contentFileName,
+                         (SCgContent::ContType)rec.contentType);
+        if (node->isContentData() && rec.contentVisible)
+            node->showContent();
+        node->setIdtfPos((SCgNode::IdentifierPosition)rec.idtfPos);
+        obj = node;
+        break;
+    }
+    case SCgPair::Type:
+    {
+        SCgPair *pair = new SCgPair;
+        mScene->addItem(pair);
+        pair->setBeginDot(rec.beginDot);
+        pair->setEndDot(rec.endDot);
+        pair->setPoints(QVector<QPointF>() << rec.beginPos << rec.points << rec.endPos);
+        obj = pair;
+        break;
+    }
+    case SCgBus::Type:
+    {
+        SCgBus *bus = new SCgBus;
+        mScene->addItem(bus);
+        bus->setPoints(QVector<QPointF>() << rec.beginPos << rec.points << rec.endPos);
+        obj = bus;
+        break;
+    }
+    case SCgContour::Type:
+    {
+        SCgContour *contour = new SCgContour;
+        mScene->addItem(contour);
+        contour->setPos(QPolygonF(rec.points).boundingRect().center());
+        contour->setPoints(rec.points);
+        obj = contour;
+        break;
+    }
+    }
+
+    Q_ASSERT(obj);
+    obj->setTypeAlias(rec.typeAlias);
+    obj->setIdtfValue(rec.idtf);
+    return obj;
+}
+
+void SCgSceneVirtualizer::createItems(const QVector<int> &records)
+{
+    if (records.isEmpty())
+        return;
+
+    KBE_TRACE_SCOPE("scg", "virtual.create");
+    mScene->beginBulkInsert(records.size());
+
+    QList<SCgObject*> created;
+    created.reserve(records.size());
+    foreach (int record, records)
+    {
+        SCgObject *obj = createItem(mRecords.at(record));
+        mItems[record] = obj;
+        mStates[record] = Live;
+        mItemRecords.insert(obj, record);
+        created.append(obj);
+    }
+    mLiveCount += records.size();
+
+    // connections are set when all items exist, scene keeps positions of parented items
+    foreach (int record, records)
+    {
+        const GwfObjectSnapshot &rec = mRecords.at(record);
+        SCgObject *obj = mItems.at(record);
+
+        int parent = recordIndex(rec.parentId);
+        if (parent >= 0)
+            obj->setParentItem(mItems.at(parent));
+
+        if (rec.type == SCgPair::Type)
+        {
+            SCgPair *pair = static_cast<SCgPair*>(obj);
+            pair->setBeginObject(mItems.at(recordIndex(rec.beginId)));
+            pair->setEndObject(mItems.at(recordIndex(rec.endId)));
+        }
+        else if (rec.type == SCgBus::Type)
+            static_cast<SCgBus*>(obj)->setOwner(static_cast<SCgNode*>(mItems.at(recordIndex(rec.ownerId))));
+    }
+
+    mScene->endBulkInsert(created);
+
+    // selection of records moves to their items
+    if (mSelectedCount > 0)
+    {
+        mSelecting = true;
+        foreach (int record, records)
+            if (mSelected.at(record))
+            {
+                mSelected[record] = false;
+                --mSelectedCount;
+                mItems.at(record)->setSelected(true);
+            }
+        mSelecting = false;
+    }
+}
+
+GwfObjectSnapshot SCgSceneVirtualizer::itemSnapshot(SCgObject *obj) const
+{
+    GwfObjectSnapshot res = GwfObjectSnapshot::fromObject(obj);
+
+    quint64 *ids[] = { &res.id, &res.parentId, &res.beginId, &res.endId, &res.ownerId };
+    for (uint i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i)
+    {
+        if (*ids[i] == 0)
+            continue;
+
+        QHash<SCgObject*, int>::const_iterator it = mItemRecords.constFind(reinterpret_cast<SCgObject*>(quintptr(*ids[i])));
+        if (it != mItemRecords.constEnd())
+            *ids[i] = it.value() + 1;
+    }
+    return res;
+}
+
+void SCgSceneVirtualizer::releaseItems(const QVector<int> &records)
+{
+    if (records.isEmpty())
+        return;
+
+    KBE_TRACE_SCOPE("scg", "virtual.release");
+
+    // records are updated while all connections are alive
+    foreach (int record, records)
+    {
+        unindexRecord(record);
+        mRecords[record] = itemSnapshot(mItems.at(record));
+        indexRecord(record);
+    }
+
+    // connected objects and children are destroyed before objects they depend on,
+    // level of object is greater than levels of all its dependencies
+    QHash<int, int> levels;
+    QVector<QPair<int, int> > order;
+    order.reserve(records.size());
+    QVector<int> deps;
+    foreach (int record, records)
+    {
+        QVector<int> stack;
+        stack.append(record);
+        while (!stack.isEmpty())
+        {
+            int current = stack.last();
+            if (levels.contains(current))
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            deps.clear();
+            dependencies(current, deps);
+            int level = 0;
+            bool ready = true;
+            foreach (int dep, deps)
+            {
+                QHash<int, int>::const_iterator it = levels.constFind(dep);
+                if (it == levels.constEnd())
+                {
+                    stack.append(dep);
+                    ready = false;
+                }
+                else
+                    level = qMax(level, it.value() + 1);
+            }
+
+            if (ready)
+            {
+                levels.insert(current, level);
+                stack.pop_back();
+            }
+        }
+        order.append(qMakePair(-levels.value(record), record));
+    }
+    qSort(order);
+
+    for (int i = 0; i < order.size(); ++i)
+    {
+        int record = order.at(i).second;
+        SCgObject *obj = mItems.at(record);
+        mItems[record] = 0;
+        mStates[record] = Idle;
+        mItemRecords.remove(obj);
+        --mLiveCount;
+        delete obj;
+    }
+}
+
+SCgObject* SCgSceneVirtualizer::materializeRecord(int record)
+{
+    Q_ASSERT(record >= 0 && record < mRecords.size());
+    if (mStates.at(record) == Idle)
+    {
+        QVector<int> records;
+        records.append(record);
+        QVector<bool> marks(mRecords.size(), false);
+        closure(records, marks);
+
+        QVector<int> idle;
+        foreach (int r, records)
+            if (mStates.at(r) == Idle)
+                idle.append(r);
+        createItems(idle);
+    }
+    return mItems.at(record);
+}
+
+void SCgSceneVirtualizer::materialize(const QRectF &rect)
+{
+    QVector<int> records = recordsIn(rect);
+    QVector<bool> marks(mRecords.size(), false);
+    closure(records, marks);
+
+    QVector<char> alive(mRecords.size(), -1);
+    QVector<int> idle;
+    foreach (int record, records)
+        if (mStates.at(record) == Idle && isAlive(record, alive))
+            idle.append(record);
+
+    createItems(idle);
+}
+
+void SCgSceneVirtualizer::selectIdleRecords(const QVector<int> &records)
+{
+    QVector<char> alive(mRecords.size(), -1);
+    foreach (int record, records)
+        if (!mSelected.at(record) && mStates.at(record) == Idle && isAlive(record, alive))
+        {
+            mSelected[record] = true;
+            ++mSelectedCount;
+        }
+}
+
+void SCgSceneVirtualizer::selectRecords(const QRectF &rect)
+{
+    selectIdleRecords(recordsIn(rect));
+}
+
+void SCgSceneVirtualizer::selectAllRecords()
+{
+    selectIdleRecords(idleRecords());
+}
+
+int SCgSceneVirtualizer::selectedRecordCount() const
+{
+    return mSelectedCount;
+}
+
+void SCgSceneVirtualizer::materializeSelection()
+{
+    if (mSelectedCount == 0)
+        return;
+
+    // objects connected to items, that were deleted after selection, don't exist anymore
+    QVector<int> records;
+    records.reserve(mSelectedCount);
+    QVector<char> alive(mRecords.size(), -1);
+    for (int i = 0; i < mSelected.size(); ++i)
+        if (mSelected.at(i))
+        {
+            if (isAlive(i, alive))
+                records.append(i);
+            else
+            {
+                mSelected[i] = false;
+                --mSelectedCount;
+            }
+        }
+
+    QVector<bool> marks(mRecords.size(), false);
+    closure(records, marks);
+
+    QVector<int> idle;
+    foreach (int record, records)
+        if (mStates.at(record) == Idle)
+            idle.append(record);
+    createItems(idle);
+}
+
+GwfSceneSnapshot SCgSceneVirtualizer::snapshot() const
+{
+    KBE_TRACE_SCOPE("scg", "virtual.snapshot");
+
+    QVector<GwfObjectSnapshot> objects;
+    objects.reserve(mRecords.size());
+
+    QVector<char> alive(mRecords.size(), -1);
+    for (int i = 0; i < mRecords.size(); ++i)
+    {
+        if (!isAlive(i, alive))
+            continue;
+        objects.append(mItems.at(i) ? itemSnapshot(mItems.at(i)) : mRecords.at(i));
+    }
+
+    // objects, that were created by user
+    foreach (QGraphicsItem *item, mScene->items())
+        if (SCgObject::isSCgObjectType(item->type()) && !mItemRecords.contains(static_cast<SCgObject*>(item)))
+            objects.append(itemSnapshot(static_cast<SCgObject*>(item)));
+
+    return GwfSceneSnapshot(objects);
+}
+
+QVector<int> SCgSceneVirtualizer::idleRecords() const
+{
+    QVector<int> res;
+    QVector<char> alive(mRecords.size(), -1);
+    for (int i = 0; i < mRecords.size(); ++i)
+        if (mStates.at(i) == Idle && isAlive(i, alive))
+            res.append(i);
+    return res;
+}
+
+QVector<int> SCgSceneVirtualizer::searchOrder() const
+{
+    QVector<int> res;
+    res.reserve(mSearchOrder.size());
+    QVector<char> alive(mRecords.size(), -1);
+    foreach (int record, mSearchOrder)
+        if (isAlive(record, alive))
+            res.append(record);
+    return res;
+}
+
+QPointF SCgSceneVirtualizer::searchPos(int record) const
+{
+    return mSearchPos.at(record);
+}
+
+QString SCgSceneVirtualizer::recordIdtf(int record) const
+{
+    return mRecords.at(record).idtf;
+}
+
+SCgObject* SCgSceneVirtualizer::recordItem(int record) const
+{
+    return mItems.at(record);
+}
+
+int SCgSceneVirtualizer::itemRecord(SCgObject *obj) const
+{
+    return mItemRecords.value(obj, -1);
+}
+
+QStringList SCgSceneVirtualizer::idleIdtfList() const
+{
+    QStringList res;
+    foreach (int record, idleRecords())
+        if (!mRecords.at(record).idtf.isEmpty())
+            res.append(mRecords.at(record).idtf);
+    return res;
+}
+
+void SCgSceneVirtualizer::objectDestroyed(SCgObject *obj)
+{
+    foreach (SCgSceneVirtualizer *virtualizer, msInstances)
+    {
+        QHash<SCgObject*, int>::iterator it = virtualizer->mItemRecords.find(obj);
+        if (it == virtualizer->mItemRecords.end())
+            continue;
+
+        int record = it.value();
+        virtualizer->mItemRecords.erase(it);
+        virtualizer->mItems[record] = 0;
+        virtualizer->mStates[record] = Removed;
+        virtualizer->unindexRecord(record);
+        --virtualizer->mLiveCount;
+    }
+}
+
+void SCgSceneVirtualizer::undoStackChanged()
+{
+    // commands are added or removed only when index changes
+    mPinnedDirty = true;
+}
+
+void SCgSceneVirtualizer::sceneSelectionChanged()
+{
+    if (mSelecting || mSelectedCount == 0)
+        return;
+
+    mSelected.fill(false);
+    mSelectedCount = 0;
+}
+
+void SCgSceneVirtualizer::scheduleUpdate()
+{
+    if (!mUpdateTimer.isActive())
+        mUpdateTimer.start();
+}
+
+void SCgSceneVirtualizer::updateItems()
+{
+    mUpdateTimer.stop();
+    KBE_TRACE_SCOPE("scg", "virtual.update");
+
+    QList<QRectF> keepAreas;
+    foreach (QGraphicsView *view, mScene->views())
+    {
+        if (!view->isVisible())
+            continue;
+
+        QRectF visible = view->mapToScene(view->viewport()->rect()).boundingRect();
+        qreal w = visible.width(), h = visible.height();
+        materialize(visible.adjusted(-w * SCG_VIRTUAL_LOAD_MARGIN, -h * SCG_VIRTUAL_LOAD_MARGIN,
+                                      w * SCG_VIRTUAL_LOAD_MARGIN, h * SCG_VIRTUAL_LOAD_MARGIN));
+        keepAreas.append(visible.adjusted(-w * SCG_VIRTUAL_RELEASE_MARGIN, -h * SCG_VIRTUAL_RELEASE_MARGIN,
+                                           w * SCG_VIRTUAL_RELEASE_MARGIN, h * SCG_VIRTUAL_RELEASE_MARGIN));
+    }
+
+    // edit modes keep pointers to items, so items are released only between edits
+    if (keepAreas.isEmpty() || mScene->editMode() != SCgScene::Mode_Select
+            || QApplication::mouseButtons() != Qt::NoButton)
+        return;
+
+    QVector<int> kept;
+
+    // undo commands refer to items directly, such items and their dependencies are pinned
+    if (mPinnedDirty)
+    {
+        mPinned.clear();
+        QUndoStack *stack = mScene->undoStack();
+        for (int i = 0; i < stack->count(); ++i)
+        {
+            const SCgBaseCommand *cmd = dynamic_cast<const SCgBaseCommand*>(stack->command(i));
+            if (cmd)
+                cmd->collectObjects(mPinned);
+        }
+        mPinnedDirty = false;
+    }
+    foreach (SCgObject *obj, mPinned)
+    {
+        // commands keep their objects alive, deleted ones are removed from scene
+        QHash<SCgObject*, int>::const_iterator it = mItemRecords.constFind(obj);
+        if (it != mItemRecords.constEnd())
+            kept.append(it.value());
+        else
+            itemDependencies(obj, kept);
+    }
+    foreach (QGraphicsItem *item, mScene->items())
+    {
+        if (!SCgObject::isSCgObjectType(item->type()))
+            continue;
+
+        SCgObject *obj = static_cast<SCgObject*>(item);
+        QHash<SCgObject*, int>::const_iterator it = mItemRecords.constFind(obj);
+        if (it == mItemRecords.constEnd())
+        {
+            itemDependencies(obj, kept);
+            continue;
+        }
+
+        bool keep = obj->isSelected();
+        if (!keep)
+        {
+            QRectF rect = obj->sceneBoundingRect();
+            foreach (const QRectF &area, keepAreas)
+                if (area.intersects(rect))
+                {
+                    keep = true;
+                    break;
+                }
+        }
+        if (keep)
+            kept.append(it.value());
+    }
+
+    QVector<bool> marks(mRecords.size(), false);
+    closure(kept, marks);
+
+    QVector<int> released;
+    for (QHash<SCgObject*, int>::const_iterator it = mItemRecords.constBegin(); it != mItemRecords.constEnd(); ++it)
+        if (!marks.at(it.value()) && !it.key()->isDead())
+            released.append(it.value());
+    releaseItems(released);
+}
+
+quint64 SCgSceneVirtualizer::cellKey(int x, int y)
+{
+    return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+void SCgSceneVirtualizer::indexRecord(int record)
+{
+    QRectF bounds = recordBounds(mRecords.at(record));
+    mBounds[record] = bounds;
+
+    int x0 = qFloor(bounds.left() / SCG_VIRTUAL_CELL_SIZE), x1 = qFloor(bounds.right() / SCG_VIRTUAL_CELL_SIZE);
+    int y0 = qFloor(bounds.top() / SCG_VIRTUAL_CELL_SIZE), y1 = qFloor(bounds.bottom() / SCG_VIRTUAL_CELL_SIZE);
+    if (qint64(x1 - x0 + 1) * (y1 - y0 + 1) > SCG_VIRTUAL_MAX_CELLS)
+    {
+        mLargeRecords.append(record);
+        return;
+    }
+
+    for (int x = x0; x <= x1; ++x)
+        for (int y = y0; y <= y1; ++y)
+            mCells[cellKey(x, y)].append(record);
+}
+
+void SCgSceneVirtualizer::unindexRecord(int record)
+{
+    const QRectF &bounds = mBounds.at(record);
+    int x0 = qFloor(bounds.left() / SCG_VIRTUAL_CELL_SIZE), x1 = qFloor(bounds.right() / SCG_VIRTUAL_CELL_SIZE);
+    int y0 = qFloor(bounds.top() / SCG_VIRTUAL_CELL_SIZE), y1 = qFloor(bounds.bottom() / SCG_VIRTUAL_CELL_SIZE);
+    if (qint64(x1 - x0 + 1) * (y1 - y0 + 1) > SCG_VIRTUAL_MAX_CELLS)
+    {
+        mLargeRecords.removeOne(record);
+        return;
+    }
+
+    for (int x = x0; x <= x1; ++x)
+        for (int y = y0; y <= y1; ++y)
+        {
+            QHash<quint64, QVector<int> >::iterator it = mCells.find(cellKey(x, y));
+            if (it == mCells.end())
+                continue;
+
+            it.value().removeOne(record);
+            if (it.value().isEmpty())
+                mCells.erase(it);
+        }
+}
+
+QVector<int> SCgSceneVirtualizer::recordsIn(const QRectF &rect) const
+{
+    QVector<int> res;
+    int x0 = qFloor(rect.left() / SCG_VIRTUAL_CELL_SIZE), x1 = qFloor(rect.right() / SCG_VIRTUAL_CELL_SIZE);
+    int y0 = qFloor(rect.top() / SCG_VIRTUAL_CELL_SIZE), y1 = qFloor(rect.bottom() / SCG_VIRTUAL_CELL_SIZE);
+
+    for (int x = x0; x <= x1; ++x)
+        for (int y = y0; y <= y1; ++y)
+        {
+            QHash<quint64, QVector<int> >::const_iterator it = mCells.constFind(cellKey(x, y));
+            if (it == mCells.constEnd())
+                continue;
+
+            foreach (int record, it.value())
+                if (mBounds.at(record).intersects(rect))
+                    res.append(record);
+        }
+
+    foreach (int record, mLargeRecords)
+        if (mBounds.at(record).intersects(rect))
+            res.append(record);
+
+    // records, that cover several cells, are found several times
+    qSort(res);
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
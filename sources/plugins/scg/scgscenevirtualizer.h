@@ -0,0 +1,197 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "gwf/gwfscenesnapshot.h"
+
+#include <QObject>
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <QRectF>
+#include <QStringList>
+
+class SCgScene;
+class SCgObject;
+
+/*! Keeps sc.g-objects of huge sheets as compact records and creates graphics items
+ * only near viewports of scene views. Items, that are scrolled far away, are written
+ * back to their records and destroyed, so number of live items depends on viewport
+ * size, not on sheet size.
+ *
+ * Objects, that items are connected to (pair ends, bus owner, parent contour), are
+ * created together with them. Selected items are never released, and neither are items,
+ * that undo commands refer to (@see SCgBaseCommand::collectObjects).
+ *
+ * Select all and rubber band select records without items too (@see selectRecords). Such
+ * records get selected items, when they are shown or when command needs whole selection.
+ *
+ * Objects created by user don't have records, they stay on scene. Save, find and
+ * identifiers list work with records and live items together. @see SCgScene::virtualizer
+ */
+class SCgSceneVirtualizer : public QObject
+{
+    Q_OBJECT
+public:
+    /*! Creates virtualizer of @p scene, that becomes its parent.
+      @param model Objects read from file. Their ids are replaced with record numbers.
+      */
+    SCgSceneVirtualizer(SCgScene *scene, const GwfSceneSnapshot &model);
+    virtual ~SCgSceneVirtualizer();
+
+    //! @return True, if sheet with @p objectCount objects should be virtualized. @see scg_key_virtual_scene_threshold
+    static bool isNeeded(int objectCount);
+
+    //! @return Number of records, including ones with live items.
+    int recordCount() const;
+    //! @return Number of records, that have live items.
+    int liveCount() const;
+
+    //! @return Bounding rectangle of all records in scene coordinates.
+    QRectF modelRect() const;
+
+    /*! Collects all objects: records without live items as they are, and live
+      items as they are now. Must be called from thread that owns the scene.
+      */
+    GwfSceneSnapshot snapshot() const;
+
+    //! @return Records, that don't have live items, in no particular order.
+    QVector<int> idleRecords() const;
+    /*! @return Existing records, live or not, sorted top to bottom and left to right by
+      their positions in file. Order doesn't change when items are moved, created or released.
+      @see searchPos
+      */
+    QVector<int> searchOrder() const;
+    //! @return Top left corner of record bounds, that it had when sheet was loaded.
+    QPointF searchPos(int record) const;
+    //! @return Identifier of record.
+    QString recordIdtf(int record) const;
+    //! @return Live item of @p record or null.
+    SCgObject* recordItem(int record) const;
+    //! @return Record of @p obj or -1 for objects created by user.
+    int itemRecord(SCgObject *obj) const;
+
+    //! @return Identifiers of records without live items. Live items are listed by scene.
+    QStringList idleIdtfList() const;
+
+    //! Creates item of @p record with items it depends on. @return Created or already live item.
+    SCgObject* materializeRecord(int record);
+
+    //! Creates items of all records, that intersect @p rect.
+    void materialize(const QRectF &rect);
+
+    /*! Selects existing records without live items, that intersect @p rect. Selection of
+      records is dropped, when selection of scene is changed by anything else.
+      */
+    void selectRecords(const QRectF &rect);
+    //! Selects all existing records without live items. @see selectRecords
+    void selectAllRecords();
+    //! @return Number of selected records without live items.
+    int selectedRecordCount() const;
+    //! Creates items of selected records, so selectedItems() of scene returns whole selection.
+    void materializeSelection();
+
+    //! Called by destructor of every sc.g-object, forgets it in all virtualizers.
+    static void objectDestroyed(SCgObject *obj);
+
+public slots:
+    //! Requests update of live items. Requests are merged and processed later.
+    void scheduleUpdate();
+
+    //! Creates items near viewports and releases far ones.
+    void updateItems();
+
+private slots:
+    //! Marks items, that are pinned by undo commands, to be collected again.
+    void undoStackChanged();
+    //! Drops selection of records, if selection wasn't changed by virtualizer.
+    void sceneSelectionChanged();
+
+private:
+    //! Record object states.
+    enum State
+    {
+        Idle = 0,   //!< Object is kept only in record
+        Live,       //!< Object has live item
+        Removed     //!< Item was destroyed outside of virtualizer, object doesn't exist
+    };
+
+    //! @return Bounding rectangle of object, that is indexed.
+    static QRectF recordBounds(const GwfObjectSnapshot &rec);
+
+    //! @return Record index by record id or -1.
+    int recordIndex(quint64 id) const;
+    //! Appends records, that @p record depends on, to @p res.
+    void dependencies(int record, QVector<int> &res) const;
+    //! Appends records, that item depends on, to @p res. Used for items without records.
+    void itemDependencies(SCgObject *obj, QVector<int> &res) const;
+    //! Extends @p records with all their dependencies, @p marks is set for every result record.
+    void closure(QVector<int> &records, QVector<bool> &marks) const;
+    /*! @return False, if object was removed or deleted by user. Objects connected to
+      deleted ones are deleted too, even if they don't have items.
+      @param cache Results by record, -1 for unknown ones.
+      */
+    bool isAlive(int record, QVector<char> &cache) const;
+
+    //! Selects given records, if they are idle and alive.
+    void selectIdleRecords(const QVector<int> &records);
+
+    //! Creates items of given idle records and connects them.
+    void createItems(const QVector<int> &records);
+    //! Creates single item without connections.
+    SCgObject* createItem(const GwfObjectSnapshot &rec);
+
+    //! Writes items back to their records and destroys them.
+    void releaseItems(const QVector<int> &records);
+    //! Copies item into record snapshot form, ids of items are replaced with record ids.
+    GwfObjectSnapshot itemSnapshot(SCgObject *obj) const;
+
+    /*! @defgroup spatialIndex Uniform grid of records. Records with too large
+     *  bounds are kept in separate list, that is checked for every query.
+     *  @{
+     */
+    void indexRecord(int record);
+    void unindexRecord(int record);
+    QVector<int> recordsIn(const QRectF &rect) const;
+    static quint64 cellKey(int x, int y);
+    /*! @}*/
+
+private:
+    SCgScene *mScene;
+    QVector<GwfObjectSnapshot> mRecords;
+    QVector<char> mStates;
+    //! Live item of record or null.
+    QVector<SCgObject*> mItems;
+    //! Record of live item. Dead items, that are kept by undo commands, are here too.
+    QHash<SCgObject*, int> mItemRecords;
+    //! Indexed bounds of records.
+    QVector<QRectF> mBounds;
+    //! All records sorted by search positions. @see searchOrder
+    QVector<int> mSearchOrder;
+    QVector<QPointF> mSearchPos;
+    QHash<quint64, QVector<int> > mCells;
+    QVector<int> mLargeRecords;
+    QRectF mModelRect;
+    int mLiveCount;
+
+    //! Selected records without items. Items of them are selected when created.
+    QVector<bool> mSelected;
+    int mSelectedCount;
+    //! True, while virtualizer changes selection of scene.
+    bool mSelecting;
+
+    //! Items, that undo commands refer to. Collected again after undo stack changes.
+    QSet<SCgObject*> mPinned;
+    bool mPinnedDirty;
+
+    QTimer mUpdateTimer;
+
+    //! All virtualizers, to forget destroyed objects. @see objectDestroyed
+    static QList<SCgSceneVirtualizer*> msInstances;
+};
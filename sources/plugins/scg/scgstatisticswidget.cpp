@@ -0,0 +1,165 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgstatisticswidget.h"
+#include "scgscene.h"
+#include "scgnode.h"
+#include "scgpair.h"
+#include "scgbus.h"
+#include "scgcontour.h"
+#include "scgblobstore.h"
+#include "scglazycontent.h"
+#include "scgimagecache.h"
+#include "scgcontentviewermanager.h"
+#include "scgundomemorymanager.h"
+#include "scgundoviewmodel.h"
+#include "scgscenevirtualizer.h"
+
+#include <QFormLayout>
+#include <QLabel>
+#include <QTimer>
+#include <QUndoStack>
+
+//! Statistics refresh interval in milliseconds.
+#define SCG_STATISTICS_INTERVAL 1000
+
+SCgStatisticsWidget::SCgStatisticsWidget(SCgScene *scene, QUndoStack *stack,
+                                         SCgUndoMemoryManager *undoMemoryManager, QWidget *parent)
+    : QWidget(parent)
+    , mScene(scene)
+    , mUndoStack(stack)
+    , mUndoMemoryManager(undoMemoryManager)
+    , mTimer(0)
+    , mLayout(0)
+{
+    Q_ASSERT(mScene);
+
+    mLayout = new QFormLayout(this);
+    mLayout->setFieldGrowthPolicy(QFormLayout::AllNonFixedFieldsGrow);
+
+    mNodes = addRow(tr("Nodes:"));
+    mPairs = addRow(tr("Pairs:"));
+    mBuses = addRow(tr("Buses:"));
+    mContours = addRow(tr("Contours:"));
+    mContents = addRow(tr("Nodes with content:"));
+    mContentMemory = addRow(tr("Content memory:"));
+    mBlobMemory = addRow(tr("Blob store memory:"));
+    mBlobMapped = addRow(tr("Blob store mapped:"));
+    mImageMemory = addRow(tr("Decoded images:"));
+    mViewers = addRow(tr("Content viewers:"));
+    mUndoMemory = addRow(tr("Undo memory:"));
+    mUndoCommands = addRow(tr("Undo commands:"));
+    mIndex = addRow(tr("Scene index:"));
+    mSceneRect = addRow(tr("Scene rect:"));
+    mVirtual = addRow(tr("Virtual records:"));
+
+    mTimer = new QTimer(this);
+    mTimer->setInterval(SCG_STATISTICS_INTERVAL);
+    connect(mTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+}
+
+SCgStatisticsWidget::~SCgStatisticsWidget()
+{
+}
+
+QLabel* SCgStatisticsWidget::addRow(const QString &title)
+{
+    QLabel *label = new QLabel(this);
+    label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    mLayout->addRow(title, label);
+    return label;
+}
+
+void SCgStatisticsWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    refresh();
+    mTimer->start();
+}
+
+void SCgStatisticsWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+
+    mTimer->stop();
+}
+
+void SCgStatisticsWidget::refresh()
+{
+    int nodes = 0, pairs = 0, buses = 0, contours = 0, contents = 0;
+    qint64 contentMemory = 0;
+
+    QList<QGraphicsItem*> items = mScene->items();
+    foreach (QGraphicsItem *item, items)
+    {
+        switch (item->type())
+        {
+        case SCgNode::Type:
+        {
+            ++nodes;
+            SCgNode *node = static_cast<SCgNode*>(item);
+            if (node->contentType() == SCgContent::Empty)
+                break;
+
+            ++contents;
+            // binary data is counted by blob store
+            const QVariant &data = node->contentRawData();
+            if (SCgLazyContent::isLazy(data))
+                contentMemory += data.value<SCgLazyContent>().memoryUsage();
+            else if (data.type() == QVariant::String)
+                contentMemory += data.toString().size() * sizeof(QChar);
+            break;
+        }
+        case SCgPair::Type:
+            ++pairs;
+            break;
+        case SCgBus::Type:
+            ++buses;
+            break;
+        case SCgContour::Type:
+            ++contours;
+            break;
+        }
+    }
+
+    mNodes->setText(QString::number(nodes));
+    mPairs->setText(QString::number(pairs));
+    mBuses->setText(QString::number(buses));
+    mContours->setText(QString::number(contours));
+    mContents->setText(QString::number(contents));
+    mContentMemory->setText(SCgUndoViewModel::memorySizeToString(contentMemory));
+
+    SCgBlobStore *store = SCgBlobStore::instance();
+    mBlobMemory->setText(tr("%1 in %2 blobs").arg(SCgUndoViewModel::memorySizeToString(store->memoryUsage()))
+                                             .arg(store->count()));
+    mBlobMapped->setText(SCgUndoViewModel::memorySizeToString(store->mappedSize()));
+    mImageMemory->setText(SCgUndoViewModel::memorySizeToString(SCgImageCache::instance()->memoryUsage()));
+
+    SCgContentViewerManager *viewers = SCgContentViewerManager::instance();
+    mViewers->setText(tr("%1 of %2").arg(viewers->viewerCount()).arg(viewers->viewerLimit()));
+
+    if (mUndoMemoryManager)
+        mUndoMemory->setText(tr("%1 of %2").arg(SCgUndoViewModel::memorySizeToString(mUndoMemoryManager->memoryUsage()))
+                                            .arg(SCgUndoViewModel::memorySizeToString(mUndoMemoryManager->memoryLimit())));
+    if (mUndoStack)
+        mUndoCommands->setText(QString::number(mUndoStack->count()));
+
+    if (mScene->itemIndexMethod() == QGraphicsScene::BspTreeIndex)
+        mIndex->setText(tr("BSP tree, depth %1, %2 items").arg(mScene->bspTreeDepth()).arg(items.size()));
+    else
+        mIndex->setText(tr("No index, %1 items").arg(items.size()));
+
+    QRectF rect = mScene->sceneRect();
+    mSceneRect->setText(tr("%1, %2, %3 x %4").arg(rect.x(), 0, 'f', 0).arg(rect.y(), 0, 'f', 0)
+                                              .arg(rect.width(), 0, 'f', 0).arg(rect.height(), 0, 'f', 0));
+
+    SCgSceneVirtualizer *virtualizer = mScene->virtualizer();
+    if (virtualizer)
+        mVirtual->setText(tr("%1 live of %2").arg(virtualizer->liveCount()).arg(virtualizer->recordCount()));
+    else
+        mVirtual->setText(tr("off"));
+}
@@ -0,0 +1,69 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QWidget>
+
+class SCgScene;
+class SCgUndoMemoryManager;
+
+class QFormLayout;
+class QLabel;
+class QTimer;
+class QUndoStack;
+
+//! Shows statistics of opened sc.g-text: object counts, memory usage and scene index state.
+/*! Statistics is collected by timer, and only while widget is visible,
+    so hidden dock doesn't cost anything.
+  */
+class SCgStatisticsWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    SCgStatisticsWidget(SCgScene *scene, QUndoStack *stack,
+                        SCgUndoMemoryManager *undoMemoryManager, QWidget *parent = 0);
+    virtual ~SCgStatisticsWidget();
+
+protected:
+    void showEvent(QShowEvent *event);
+    void hideEvent(QHideEvent *event);
+
+private slots:
+    //! Collects statistics and updates labels.
+    void refresh();
+
+private:
+    //! Creates value label in form.
+    QLabel* addRow(const QString &title);
+
+    SCgScene *mScene;
+    QUndoStack *mUndoStack;
+    SCgUndoMemoryManager *mUndoMemoryManager;
+
+    QTimer *mTimer;
+    QFormLayout *mLayout;
+
+    /*! @defgroup statValues Value labels
+     *  @{
+     */
+    QLabel *mNodes;
+    QLabel *mPairs;
+    QLabel *mBuses;
+    QLabel *mContours;
+    QLabel *mContents;
+    QLabel *mContentMemory;
+    QLabel *mBlobMemory;
+    QLabel *mBlobMapped;
+    QLabel *mImageMemory;
+    QLabel *mViewers;
+    QLabel *mUndoMemory;
+    QLabel *mUndoCommands;
+    QLabel *mIndex;
+    QLabel *mSceneRect;
+    QLabel *mVirtual;
+    /*! @}*/
+};
@@ -6,6 +6,7 @@
 
 #include "scgtemplateobjectbuilder.h"
 #include "scgdefaultobjectbuilder.h"
+#include "scgscene.h"
 
 #include "scgobject.h"
 #include "scgnode.h"
@@ -13,6 +14,7 @@
 
 TemplateSCgObjectsBuilder::TemplateSCgObjectsBuilder(QGraphicsScene* scene) :
         AbstractSCgObjectBuilder()
+      , mScene(qobject_cast<SCgScene*>(scene))
 {
     mDecoratedBuilder = new DefaultSCgObjectBuilder(scene);
 }
@@ -24,6 +26,10 @@ TemplateSCgObjectsBuilder::~TemplateSCgObjectsBuilder()
 
 void TemplateSCgObjectsBuilder::buildObjects(const TypeToObjectsMap& objects)
 {
+    // built objects are moved below, so their geometry is rebuilt once after that
+    if (mScene)
+        mScene->beginBulkInsert(objectCount(objects));
+
     mDecoratedBuilder->buildObjects(objects);
     QList<SCgObject*> l = mDecoratedBuilder->objects();
 
@@ -42,6 +48,12 @@ void TemplateSCgObjectsBuilder::buildObjects(const TypeToObjectsMap& objects)
                 obj->setPos(obj->scenePos() - bounds.topLeft());
     }
 
+    if (mScene)
+    {
+        mScene->endBulkInsert(l);
+        return;
+    }
+
     foreach(SCgObject* obj, l)
     {
         if( obj->type() == QGraphicsItem::UserType + 3 )      // type SCgPair
@@ -8,6 +8,8 @@
 
 #include "scgabstractobjectbuilder.h"
 
+class SCgScene;
+
 //! @see DefaultObjectBuilder
 class TemplateSCgObjectsBuilder: public AbstractSCgObjectBuilder
 {
@@ -25,6 +27,8 @@ public:
 
 protected:
     AbstractSCgObjectBuilder* mDecoratedBuilder;
+    //! Scene, that objects are built on, or null if it isn't SCgScene.
+    SCgScene* mScene;
 };
 
 
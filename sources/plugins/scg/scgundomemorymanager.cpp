@@ -0,0 +1,81 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scgundomemorymanager.h"
+#include "commands/scgbasecommand.h"
+
+#include <QUndoStack>
+#include <QVector>
+
+SCgUndoMemoryManager::SCgUndoMemoryManager(QUndoStack *stack, QObject *parent)
+    : QObject(parent)
+    , mStack(stack)
+    , mMemoryLimit(0)
+{
+    Q_ASSERT(mStack);
+    connect(mStack, SIGNAL(indexChanged(int)), this, SLOT(compactStack()));
+}
+
+SCgUndoMemoryManager::~SCgUndoMemoryManager()
+{
+
+}
+
+void SCgUndoMemoryManager::setMemoryLimit(qint64 limit)
+{
+    mMemoryLimit = limit;
+    compactStack();
+}
+
+qint64 SCgUndoMemoryManager::memoryLimit() const
+{
+    return mMemoryLimit;
+}
+
+qint64 SCgUndoMemoryManager::memoryUsage() const
+{
+    qint64 size = 0;
+    for (int i = 0; i < mStack->count(); ++i)
+        size += SCgBaseCommand::commandMemoryUsage(mStack->command(i));
+
+    return size;
+}
+
+void SCgUndoMemoryManager::compactStack()
+{
+    if (mMemoryLimit <= 0)
+        return;
+
+    int count = mStack->count();
+    QVector<qint64> usage(count);
+    qint64 total = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        usage[i] = SCgBaseCommand::commandMemoryUsage(mStack->command(i));
+        total += usage[i];
+    }
+
+    // walk from the most far commands on both sides of current index,
+    // so next undo and redo never need to restore objects
+    int index = mStack->index();
+    int left = 0;
+    int right = count - 1;
+    while (total > mMemoryLimit && (left < index - 1 || right > index))
+    {
+        int i;
+        if (left < index - 1 && (right <= index || index - 1 - left >= right - index))
+            i = left++;
+        else
+            i = right--;
+
+        SCgBaseCommand *cmd = dynamic_cast<SCgBaseCommand*>(const_cast<QUndoCommand*>(mStack->command(i)));
+        if (!cmd)
+            continue;
+
+        cmd->compact();
+        total -= usage[i] - cmd->memoryUsage();
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QObject>
+
+class QUndoStack;
+
+/*! Keeps memory, used by undo history, in specified limit.
+ * When history memory exceeds limit, commands that are the most far from
+ * current stack index are compacted (@see SCgBaseCommand::compact).
+ * Compacted commands restore their objects when undo/redo reaches them.
+ */
+class SCgUndoMemoryManager : public QObject
+{
+    Q_OBJECT
+public:
+    /*! Constructor
+      @param stack  Pointer to undo stack, which memory will be controlled
+      @param parent Pointer to parent object
+      */
+    explicit SCgUndoMemoryManager(QUndoStack *stack, QObject *parent = 0);
+    virtual ~SCgUndoMemoryManager();
+
+    /*! Set memory limit for undo history.
+      @param limit Memory limit in bytes. If it's less or equal to 0, then history isn't limited.
+      */
+    void setMemoryLimit(qint64 limit);
+    //! Get memory limit for undo history in bytes
+    qint64 memoryLimit() const;
+
+    //! Get approximate amount of memory used by all commands in stack
+    qint64 memoryUsage() const;
+
+public slots:
+    //! Compacts commands until history memory is in limit.
+    void compactStack();
+
+private:
+    //! Pointer to controlled undo stack
+    QUndoStack *mStack;
+    //! Memory limit in bytes
+    qint64 mMemoryLimit;
+};
@@ -5,6 +5,7 @@
  */
 
 #include "scgundoviewmodel.h"
+#include "commands/scgbasecommand.h"
 
 #include <QUndoStack>
 #include <QItemSelectionModel>
@@ -140,7 +141,21 @@ QVariant SCgUndoViewModel::data(const QModelIndex &index, int role) const
     {
         if (index.row() == 0)
             return m_emty_label;
-        return m_stack->text(index.row() - 1);
+
+        const QUndoCommand *cmd = m_stack->command(index.row() - 1);
+        return QString("%1 [%2]").arg(m_stack->text(index.row() - 1))
+                                 .arg(memorySizeToString(SCgBaseCommand::commandMemoryUsage(cmd)));
+    } else if (role == Qt::ToolTipRole)
+    {
+        if (index.row() == 0)
+            return QVariant();
+
+        const QUndoCommand *cmd = m_stack->command(index.row() - 1);
+        const SCgBaseCommand *scgCmd = dynamic_cast<const SCgBaseCommand*>(cmd);
+        QString tip = tr("Memory: %1").arg(memorySizeToString(SCgBaseCommand::commandMemoryUsage(cmd)));
+        if (scgCmd && scgCmd->isCompacted())
+            tip += "\n" + tr("Compacted");
+        return tip;
     } else if (role == Qt::DecorationRole)
     {
         if (index.row() == m_stack->cleanIndex() && !m_clean_icon.isNull())
@@ -175,3 +190,12 @@ QIcon SCgUndoViewModel::cleanIcon() const
 {
     return m_clean_icon;
 }
+
+QString SCgUndoViewModel::memorySizeToString(qint64 size)
+{
+    if (size < 1024)
+        return tr("%1 B").arg(size);
+    if (size < 1024 * 1024)
+        return tr("%1 KB").arg(size / 1024.0, 0, 'f', 1);
+    return tr("%1 MB").arg(size / (1024.0 * 1024.0), 0, 'f', 1);
+}
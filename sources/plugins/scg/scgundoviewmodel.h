@@ -39,6 +39,9 @@ public:
     void setCleanIcon(const QIcon &icon);
     QIcon cleanIcon() const;
 
+    //! Represents memory size as human readable string
+    static QString memorySizeToString(qint64 size);
+
 public slots:
     void setStack(QUndoStack *stack);
 
@@ -12,6 +12,9 @@
 #include "scgcontentchangedialog.h"
 #include "scgwindow.h"
 #include "scgtypedialog.h"
+#include "scgcontentviewermanager.h"
+#include "scgscenevirtualizer.h"
+#include "trace.h"
 
 #include <math.h>
 #include <QUrl>
@@ -27,6 +30,10 @@
 #include <QUndoStack>
 #include <QCompleter>
 #include <QFileInfo>
+#include <QElapsedTimer>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QTimer>
 
 SCgView::SCgView(QWidget *parent, SCgWindow *window) :
     QGraphicsView(parent),
@@ -43,11 +50,20 @@ SCgView::SCgView(QWidget *parent, SCgWindow *window) :
     mActionCut(0),
     mActionPaste(0),
     mActionSelectAll(0),
+    mActionShowHud(0),
     mContextMenu(0),
     mContextObject(0),
     mWindow(window),
-    isSceneRectControlled(false)
+    isSceneRectControlled(false),
+    mHudVisible(false),
+    mHudFrameTime(0),
+    mHudFrameAverage(0),
+    mHudTimer(0),
+    mHudRefreshPending(false)
 {
+    for (int i = 0; i < SCgPerfCounters::CounterCount; ++i)
+        mHudCounters[i] = 0;
+
     setCacheMode(CacheNone);//CacheBackground);
     setViewportUpdateMode(BoundingRectViewportUpdate);
     setRenderHint(QPainter::Antialiasing);
@@ -55,15 +71,23 @@ SCgView::SCgView(QWidget *parent, SCgWindow *window) :
     setResizeAnchor(AnchorViewCenter);
     setOptimizationFlag(DontAdjustForAntialiasing);
     setDragMode(QGraphicsView::RubberBandDrag);
+    connect(this, SIGNAL(rubberBandChanged(QRect,QPointF,QPointF)), this, SLOT(updateRubberBand(QRect,QPointF,QPointF)));
     setAcceptDrops(true);
     connect(mWindow->undoStack(), SIGNAL(indexChanged(int)), this, SLOT(updateActionsState(int)) );
     createActions();
+
+    SCgContentViewerManager::instance()->registerView(this);
+    connect(this, SIGNAL(scaleChanged(qreal)), SCgContentViewerManager::instance(), SLOT(scheduleUpdate()));
+    connect(this, SIGNAL(scaleChanged(qreal)), this, SLOT(scheduleVirtualUpdate()));
 }
 
 SCgView::~SCgView()
 {
     if (mContextMenu)   delete mContextMenu;
     mContextObject = 0;
+
+    if (mHudVisible)
+        SCgPerfCounters::removeUser();
 }
 
 void SCgView::createActions()
@@ -139,6 +163,12 @@ void SCgView::createActions()
     mWindow->addAction(mActionSelectAll);
     connect(mActionSelectAll, SIGNAL(triggered()), this, SLOT(selectAllCommand()));
 
+    mActionShowHud = new QAction(tr("Performance overlay"), this);
+    mActionShowHud->setCheckable(true);
+    mActionShowHud->setShortcut(QKeySequence(tr("Ctrl+Shift+P")));
+    mWindow->addAction(mActionShowHud);
+    connect(mActionShowHud, SIGNAL(toggled(bool)), this, SLOT(setHudVisible(bool)));
+
     mActionsList.append(mActionChangeType);
     mActionsList.append(mActionChangeContent);
     mActionsList.append(mActionShowContent);
@@ -300,6 +330,11 @@ void SCgView::selectAllCommand() const
     QList<QGraphicsItem*>::iterator it = list.begin();
     for(; it != list.end(); ++it)
         (*it)->setSelected(true);
+
+    // objects, that don't have items, are selected as records
+    SCgScene *s = qobject_cast<SCgScene*>(scene());
+    if (s && s->virtualizer())
+        s->virtualizer()->selectAllRecords();
 }
 
 void SCgView::keyPressEvent(QKeyEvent *event)
@@ -381,6 +416,119 @@ void SCgView::wheelEvent(QWheelEvent *event)
         QGraphicsView::wheelEvent(event);
 }
 
+void SCgView::scrollContentsBy(int dx, int dy)
+{
+    QGraphicsView::scrollContentsBy(dx, dy);
+    SCgContentViewerManager::instance()->scheduleUpdate();
+    scheduleVirtualUpdate();
+}
+
+void SCgView::resizeEvent(QResizeEvent *event)
+{
+    QGraphicsView::resizeEvent(event);
+    SCgContentViewerManager::instance()->scheduleUpdate();
+    scheduleVirtualUpdate();
+}
+
+void SCgView::paintEvent(QPaintEvent *event)
+{
+    KBE_TRACE_SCOPE("scg", "view.paint");
+
+    if (!mHudVisible)
+    {
+        QGraphicsView::paintEvent(event);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QGraphicsView::paintEvent(event);
+
+    if (mHudRefreshPending)
+    {
+        // items under overlay aren't a frame
+        mHudRefreshPending = false;
+        SCgPerfCounters::take(SCgPerfCounters::PaintedItems);
+    }else
+    {
+        mHudFrameTime = timer.nsecsElapsed() / 1000000.0;
+        mHudFrameAverage = mHudFrameAverage > 0 ? mHudFrameAverage * 0.9 + mHudFrameTime * 0.1 : mHudFrameTime;
+        for (int i = 0; i < SCgPerfCounters::CounterCount; ++i)
+            mHudCounters[i] = SCgPerfCounters::take((SCgPerfCounters::Counter)i);
+
+        if (!event->rect().contains(hudRect()))
+            mHudTimer->start();
+    }
+
+    QPainter painter(viewport());
+    paintHud(&painter);
+}
+
+bool SCgView::isHudVisible() const
+{
+    return mHudVisible;
+}
+
+void SCgView::setHudVisible(bool visible)
+{
+    if (mHudVisible == visible)
+        return;
+
+    mHudVisible = visible;
+    mActionShowHud->setChecked(visible);
+
+    if (visible)
+    {
+        SCgPerfCounters::addUser();
+        if (!mHudTimer)
+        {
+            mHudTimer = new QTimer(this);
+            mHudTimer->setSingleShot(true);
+            mHudTimer->setInterval(100);
+            connect(mHudTimer, SIGNAL(timeout()), this, SLOT(refreshHud()));
+        }
+        mHudFrameAverage = 0;
+    }else
+    {
+        SCgPerfCounters::removeUser();
+        mHudTimer->stop();
+        mHudRefreshPending = false;
+    }
+
+    viewport()->update();
+}
+
+void SCgView::refreshHud()
+{
+    mHudRefreshPending = true;
+    viewport()->update(hudRect());
+}
+
+QRect SCgView::hudRect() const
+{
+    QFontMetrics metrics(font());
+    return QRect(8, 8, metrics.width("positionChanged: 0000000") + 16, metrics.lineSpacing() * 4 + 12);
+}
+
+void SCgView::paintHud(QPainter *painter)
+{
+    QRect rect = hudRect();
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(0, 0, 0, 160));
+    painter->drawRoundedRect(rect, 4, 4);
+
+    QStringList lines;
+    lines << tr("Frame: %1 ms (avg %2)").arg(mHudFrameTime, 0, 'f', 1).arg(mHudFrameAverage, 0, 'f', 1)
+          << tr("Items painted: %1").arg(mHudCounters[SCgPerfCounters::PaintedItems])
+          << tr("updateShape: %1").arg(mHudCounters[SCgPerfCounters::UpdateShapeCalls])
+          << tr("positionChanged: %1").arg(mHudCounters[SCgPerfCounters::PositionChangedCalls]);
+
+    painter->setPen(Qt::white);
+    painter->setFont(font());
+    painter->drawText(rect.adjusted(8, 6, -8, -6), Qt::AlignLeft | Qt::AlignTop, lines.join("\n"));
+}
+
 void SCgView::deleteSelected()
 {
     static_cast<SCgScene*>(scene())->deleteSelObjectsCommand();
@@ -580,6 +728,28 @@ void SCgView::updateSceneRect(const QRectF& rect)
     }
 }
 
+void SCgView::scheduleVirtualUpdate()
+{
+    SCgScene *s = qobject_cast<SCgScene*>(scene());
+    if (s && s->virtualizer())
+        s->virtualizer()->scheduleUpdate();
+}
+
+void SCgView::updateRubberBand(const QRect &viewportRect, const QPointF &fromScenePoint, const QPointF &toScenePoint)
+{
+    if (!viewportRect.isNull())
+    {
+        mRubberBandRect = QRectF(fromScenePoint, toScenePoint).normalized();
+        return;
+    }
+
+    // rubber band selects only live items, records in it are selected when it's released
+    SCgScene *s = qobject_cast<SCgScene*>(scene());
+    if (s && s->virtualizer() && !mRubberBandRect.isNull())
+        s->virtualizer()->selectRecords(mRubberBandRect);
+    mRubberBandRect = QRectF();
+}
+
 void SCgView::editModeChanged(int mode)
 {
     setContextMenuPolicy(mode == SCgScene::Mode_Select ? Qt::DefaultContextMenu : Qt::NoContextMenu);
@@ -8,6 +8,8 @@
 
 #include <QGraphicsView>
 
+#include "scgperfcounters.h"
+
 class SCgWindow;
 class SCgObject;
 class SCgScene;
@@ -15,6 +17,7 @@ class QContextMenuEvent;
 class QMenu;
 class QKeyEvent;
 class QAction;
+class QTimer;
 
 class SCgView : public QGraphicsView
 {
@@ -27,6 +30,9 @@ public:
     //! Actions, provided by this view.
     QList<QAction*> actions() const;
 
+    //! @return True, if performance overlay is shown.
+    bool isHudVisible() const;
+
 protected:
     void contextMenuEvent(QContextMenuEvent *event);
 
@@ -46,6 +52,12 @@ protected:
 
     void wheelEvent(QWheelEvent *event);
 
+    //! Updates content viewers, when visible area is changed. @see SCgContentViewerManager
+    void scrollContentsBy(int dx, int dy);
+    void resizeEvent(QResizeEvent *event);
+    //! Paints scene and performance overlay, if it's visible.
+    void paintEvent(QPaintEvent *event);
+
 private:
     /**
      * \defgroup menu Actions
@@ -69,6 +81,8 @@ private:
     QAction* mActionPaste;
     //! Select All action
     QAction* mActionSelectAll;
+    //! Performance overlay action
+    QAction* mActionShowHud;
 
     QList<QAction*> mActionsList;
     void createActions();
@@ -93,6 +107,30 @@ private:
     SCgWindow *mWindow;
 
     bool isSceneRectControlled;
+    //! Scene rectangle of rubber band, while it's dragged. @see updateRubberBand
+    QRectF mRubberBandRect;
+
+    /**
+     * \defgroup hud Performance overlay
+     * @{
+     */
+    //! Paints overlay over viewport.
+    void paintHud(QPainter *painter);
+    //! @return Rectangle of overlay in viewport coordinates.
+    QRect hudRect() const;
+
+    bool mHudVisible;
+    //! Duration of the last frame in milliseconds.
+    qreal mHudFrameTime;
+    //! Moving average of frame duration in milliseconds.
+    qreal mHudFrameAverage;
+    //! Counters of the last frame. @see SCgPerfCounters
+    int mHudCounters[SCgPerfCounters::CounterCount];
+    //! Repaints overlay, when frame didn't cover it.
+    QTimer *mHudTimer;
+    //! True, if the next paint event only refreshes overlay.
+    bool mHudRefreshPending;
+    /**@}*/
 
 signals:
     //! Emitted, when scale factor is changed.
@@ -111,7 +149,15 @@ public slots:
     //! Overrides QGraphicsView::setScene().
     void setScene(SCgScene* scene);
 
+    /*! Shows overlay with frame time, number of painted items and number of
+      geometry updates per frame.
+      */
+    void setHudVisible(bool visible);
+
 private slots:
+    //! Repaints performance overlay without counting it as frame.
+    void refreshHud();
+
     //! Delete selected sc.g-elements
     void deleteSelected();
 
@@ -140,6 +186,12 @@ private slots:
 
     void updateSceneRect(const QRectF& rect);
 
+    //! Requests update of live items, if scene is virtual. @see SCgSceneVirtualizer
+    void scheduleVirtualUpdate();
+
+    //! Selects records of virtual scene, that rubber band covers, when it's released.
+    void updateRubberBand(const QRect &viewportRect, const QPointF &fromScenePoint, const QPointF &toScenePoint);
+
     //! Edit mode changed slot @see SCgScene::editModeChanged
     void editModeChanged(int mode);
 };
@@ -21,12 +21,17 @@
 #include <QMenu>
 #include <QToolButton>
 #include <QFileDialog>
+#include <QMessageBox>
+#include <QFileInfo>
+#include <QDir>
 
 #include "scglayoutmanager.h"
 #include "arrangers/scgarrangervertical.h"
 #include "arrangers/scgarrangerhorizontal.h"
 #include "arrangers/scgarrangergrid.h"
 #include "arrangers/scgarrangertuple.h"
+#include "arrangers/scgarrangerenergybased.h"
+#include "arrangers/scgarrangerhierarchical.h"
 
 #include "select/scgselectinputoutput.h"
 #include "select/scgselectsubgraph.h"
@@ -36,13 +41,23 @@
 
 #include "scgfindwidget.h"
 #include "scgview.h"
+#include "scgpair.h"
+#include "scgnode.h"
+#include "scgscenevirtualizer.h"
 #include "scgminimap.h"
 #include "gwf/gwffileloader.h"
-#include "gwf/gwffilewriter.h"
+#include "gwf/gwbfileloader.h"
+#include "gwf/gwfasyncfilewriter.h"
 #include "gwf/gwfobjectinforeader.h"
 #include "scgtemplateobjectbuilder.h"
 #include "config.h"
+#include "projectindex.h"
+#include "interfaces/documentsearcherinterface.h"
 #include "scgundoview.h"
+#include "scgstatisticswidget.h"
+#include "scgundomemorymanager.h"
+#include "scgcontentviewermanager.h"
+#include "scgconfig.h"
 
 
 const QString SCgWindow::SupportedPasteMimeType = "text/KBE-gwf";
@@ -62,9 +77,14 @@ SCgWindow::SCgWindow(const QString& _windowTitle, QWidget *parent)
     , mZoomFactorLine(0)
     , mMinimap(0)
     , mUndoView(0)
+    , mStatistics(0)
     , mFindWidget(0)
     , mToolBar(0)
     , mUndoStack(0)
+    , mUndoMemoryManager(0)
+    , mFileWriter(0)
+    , mCleanStateLost(false)
+    , mUndoIndex(0)
     , mEditMenu(0)
     , mActionUndo(0)
     , mActionRedo(0)
@@ -73,6 +93,12 @@ SCgWindow::SCgWindow(const QString& _windowTitle, QWidget *parent)
     Q_UNUSED(_windowTitle);
 
     mUndoStack = new QUndoStack(this);
+    mUndoMemoryManager = new SCgUndoMemoryManager(mUndoStack, this);
+    mUndoMemoryManager->setMemoryLimit(scg_cfg_get_value(scg_key_undo_memory_limit).toLongLong());
+    SCgContentViewerManager::instance()->setViewerLimit(scg_cfg_get_value(scg_key_content_viewer_limit).toInt());
+    mFileWriter = new GWFAsyncFileWriter(this);
+    connect(mFileWriter, SIGNAL(progressChanged(int)), this, SLOT(onSaveProgress(int)));
+    connect(mFileWriter, SIGNAL(finished(bool,QString)), this, SLOT(onSaveFinished(bool,QString)));
     /////////////////////////////////////////////////
     //Creating main environment
     mView = new SCgView(0, this);
@@ -93,6 +119,7 @@ SCgWindow::SCgWindow(const QString& _windowTitle, QWidget *parent)
 
     setAttribute(Qt::WA_DeleteOnClose);
     connect(mUndoStack, SIGNAL(cleanChanged(bool)), this, SLOT(stackCleanStateChanged(bool)));
+    connect(mUndoStack, SIGNAL(indexChanged(int)), this, SLOT(stackIndexChanged(int)));
 
     /////////////////////////////////////////////////
 
@@ -106,11 +133,18 @@ SCgWindow::SCgWindow(const QString& _windowTitle, QWidget *parent)
 
 SCgWindow::~SCgWindow()
 {
+    if (ProjectIndex::instance() && !mFileName.isEmpty())
+        ProjectIndex::instance()->documentClosed(mFileName);
+
+    // snapshot doesn't depend on scene, but file has to be written completely
+    delete mFileWriter;
     delete mToolBar;
     delete mView;
     delete mUndoView;
+    delete mStatistics;
     delete mMinimap;
     delete mFindWidget;
+    delete mUndoMemoryManager;
     delete mUndoStack;
 }
 
@@ -159,9 +193,14 @@ void SCgWindow::createWidgetsForDocks()
     mUndoView->setWindowTitle(tr("History"));
     mUndoView->setObjectName("History");
 
+    mStatistics = new SCgStatisticsWidget(mScene, mUndoStack, mUndoMemoryManager);
+    mStatistics->setWindowTitle(tr("Statistics"));
+    mStatistics->setObjectName("Statistics");
+
     //Register this widgets
     mWidgetsForDocks.push_back(mUndoView);
     mWidgetsForDocks.push_back(mMinimap);
+    mWidgetsForDocks.push_back(mStatistics);
 }
 
 
@@ -248,6 +287,27 @@ void SCgWindow::createToolBar()
     alignButton->addAction(action);
     connect(action, SIGNAL(triggered()), this, SLOT(onHorizontalAlignment()));
 
+    //Energy-based layout
+    action = new QAction(findIcon("tool-align.png"), tr("Energy-based layout"), mToolBar);
+    action->setCheckable(false);
+    action->setShortcut(QKeySequence(tr("9", "Energy-based layout")));
+    alignButton->addAction(action);
+    connect(action, SIGNAL(triggered()), this, SLOT(onEnergyBasedLayout()));
+
+    //Hierarchical layout
+    action = new QAction(findIcon("tool-align.png"), tr("Hierarchical layout"), mToolBar);
+    action->setCheckable(false);
+    action->setShortcut(QKeySequence(tr("L", "Hierarchical layout")));
+    alignButton->addAction(action);
+    connect(action, SIGNAL(triggered()), this, SLOT(onHierarchicalLayout()));
+
+    //Pairs routing
+    action = new QAction(findIcon("tool-align.png"), tr("Route pairs"), mToolBar);
+    action->setCheckable(false);
+    action->setToolTip(tr("Route selected pairs (or all pairs) around nodes and contours"));
+    alignButton->addAction(action);
+    connect(action, SIGNAL(triggered()), this, SLOT(onRoutePairs()));
+
     // selection group button
     QToolButton *selectButton = new QToolButton(mToolBar);
     selectButton->setIcon(findIcon("tool-select-group.png"));
@@ -323,12 +383,19 @@ QIcon SCgWindow::icon() const
 
 bool SCgWindow::loadFromFile(const QString &fileName)
 {
-    GWFFileLoader loader;
+    GWFFileLoader gwfLoader;
+    GwbFileLoader gwbLoader;
+
+    FileLoaderInterface *loader = &gwfLoader;
+    if (gwbLoader.supportedFormatsExt().contains(QFileInfo(fileName).suffix(), Qt::CaseInsensitive))
+        loader = &gwbLoader;
 
-    if (loader.load(fileName, mView->scene()))
+    if (loader->load(fileName, mView->scene()))
     {
         mFileName = fileName;
         setWindowTitle(mFileName);
+        if (ProjectIndex::instance())
+            ProjectIndex::instance()->documentOpened(mFileName);
         emitEvent(EditorObserverInterface::ContentLoaded);
         return true;
     }else
@@ -337,20 +404,50 @@ bool SCgWindow::loadFromFile(const QString &fileName)
 
 bool SCgWindow::saveToFile(const QString &fileName)
 {
-    GWFFileWriter writer;
+    // keep saves in order, so the last one always wins
+    if (mFileWriter->isRunning())
+        mFileWriter->waitForFinished();
 
-    if (writer.save(fileName, mView->scene()))
+    if (mFileWriter->save(fileName, mScene))
     {
+        // document is indexed under new name, when it's written
+        if (ProjectIndex::instance() && !mFileName.isEmpty() && mFileName != fileName)
+            ProjectIndex::instance()->documentClosed(mFileName);
         mFileName = fileName;
-        setWindowTitle(mFileName);
+        // file gets content of the current command, changes made while saving go after it
+        mCleanStateLost = false;
         mUndoStack->setClean();
-        emitEvent(EditorObserverInterface::ContentSaved);
+        onSaveProgress(0);
 
         return true;
     }else
         return false;
 }
 
+void SCgWindow::onSaveProgress(int percent)
+{
+    setWindowTitle(tr("%1 (saving %2%)").arg(mFileName).arg(percent));
+}
+
+void SCgWindow::onSaveFinished(bool result, const QString &errorString)
+{
+    setWindowTitle(mFileName);
+
+    if (!result)
+    {
+        // clean state of undo stack was set, when save started
+        mCleanStateLost = true;
+        QMessageBox::warning(this, qAppName(), errorString);
+        emitEvent(EditorObserverInterface::ContentChanged);
+        return;
+    }
+
+    if (ProjectIndex::instance())
+        ProjectIndex::instance()->documentOpened(mFileName);
+
+    emitEvent(EditorObserverInterface::ContentSaved);
+}
+
 void SCgWindow::_update()
 {
     if (mView->cacheMode() != QGraphicsView::CacheNone)
@@ -407,6 +504,34 @@ void SCgWindow::onHorizontalAlignment()
     SCgLayoutManager::instance().arrange(mView, SCgHorizontalArranger::Type);
 }
 
+void SCgWindow::onEnergyBasedLayout()
+{
+    SCgLayoutManager::instance().arrange(mView, SCgEnergyBasedArranger::Type);
+}
+
+void SCgWindow::onHierarchicalLayout()
+{
+    SCgLayoutManager::instance().arrange(mView, SCgHierarchicalArranger::Type);
+}
+
+void SCgWindow::onRoutePairs()
+{
+    mScene->materializeSelection();
+    QList<QGraphicsItem*> items = mScene->selectedItems();
+    if (items.isEmpty())
+        items = mScene->items();
+
+    QList<SCgPair*> pairs;
+    foreach (QGraphicsItem *item, items)
+    {
+        if (item->type() == SCgPair::Type && !static_cast<SCgPair*>(item)->isDead())
+            pairs.append(static_cast<SCgPair*>(item));
+    }
+
+    if (!pairs.isEmpty())
+        mScene->routePairsCommand(pairs);
+}
+
 void SCgWindow::onSelectInputOutput()
 {
     SCgSelectInputOutput select;
@@ -502,9 +627,11 @@ void SCgWindow::copy() const
 {
     QByteArray copiedData;
     GwfStreamWriter writer(&copiedData);
+    writer.setContentSharing(true);
     ////////////////////////////////////
     writer.startWriting();
 
+    mScene->materializeSelection();
     QList<QGraphicsItem *>  items = mView->scene()->selectedItems();
     if (items.isEmpty())
         return;
@@ -591,13 +718,83 @@ void SCgWindow::find(const QString &ttf, bool forward, bool checkCurrent)
     else
         mFindWidget->setPalette(found);
 
+    mFindWidget->setProjectMatches(found || ttf.isEmpty() ? QStringList() : projectFilesWith(ttf));
+
     if(found)
+        showFound(found);
+}
+
+void SCgWindow::showFound(SCgObject *found)
+{
+    mView->ensureVisible(found, 300, 300);
+    mScene->clearSelection();
+    found->setSelected(true);
+    mScene->setCursorPos(mScene->findPos(found));
+}
+
+void SCgWindow::showSearchHit(const SearchHit &hit)
+{
+    // content of unnamed node is found by position of node
+    if (hit.hasObjectPos)
+    {
+        if (mScene->virtualizer())
+            mScene->virtualizer()->materialize(QRectF(hit.objectPos, QSizeF()).adjusted(-1, -1, 1, 1));
+
+        foreach (QGraphicsItem *item, mScene->items(hit.objectPos))
+        {
+            if (item->type() != SCgNode::Type)
+                continue;
+
+            SCgObject *obj = static_cast<SCgObject*>(item);
+            // file keeps rounded positions
+            if (QLineF(obj->scenePos(), hit.objectPos).length() < 1 && obj->idtfValue() == hit.identifier)
+            {
+                showFound(obj);
+                return;
+            }
+        }
+    }
+
+    if (hit.identifier.isEmpty())
+        return;
+
+    // scene finds identifiers by prefix, so search goes on until equal one is found
+    SCgScene::FindFlags flg = SCgScene::FindForward | SCgScene::CaseSensitive;
+    mScene->setCursorPos(mScene->sceneRect().topLeft());
+    SCgObject *first = mScene->find(hit.identifier, flg | SCgScene::CheckCurrent);
+    if (!first)
+        return;
+
+    SCgObject *found = first;
+    while (found && found->idtfValue() != hit.identifier)
+    {
+        mScene->setCursorPos(mScene->findPos(found));
+        SCgObject *next = mScene->find(hit.identifier, flg);
+        found = (next == first || next == found) ? 0 : next;
+    }
+
+    showFound(found ? found : first);
+}
+
+QStringList SCgWindow::projectFilesWith(const QString &ttf) const
+{
+    QStringList res;
+    ProjectIndexInterface *index = ProjectIndex::instance();
+    if (!index)
+        return res;
+
+    // index answers without scanning, so it's queried on every key press
+    const int maxIdentifiers = 100;
+    QString ownFile = QDir::cleanPath(QFileInfo(mFileName).absoluteFilePath());
+    foreach (const QString &idtf, index->identifiers(ttf, maxIdentifiers))
     {
-        mView->ensureVisible(found, 300, 300);
-        mView->scene()->clearSelection();
-        found->setSelected(true);
-        scene->setCursorPos(found->sceneBoundingRect().topLeft());
+        foreach (const IdentifierLocation &loc, index->locations(idtf))
+        {
+            if (loc.fileName != ownFile && !res.contains(loc.fileName))
+                res << loc.fileName;
+        }
     }
+    return res;
 }
 
 void SCgWindow::activate(QMainWindow *window)
@@ -643,13 +840,13 @@ QList<QWidget*> SCgWindow::widgetsForDocks()
 
 bool SCgWindow::isSaved() const
 {
-    return mUndoStack->isClean();
+    return !mCleanStateLost && mUndoStack->isClean();
 }
 
 QStringList SCgWindow::supportedFormatsExt() const
 {
     QStringList res;
-    res << "gwf";
+    res << "gwf" << "gwb";
     return res;
 }
 
@@ -686,6 +883,18 @@ void SCgWindow::stackCleanStateChanged(bool value)
     emitEvent(EditorObserverInterface::ContentChanged);
 }
 
+void SCgWindow::stackIndexChanged(int index)
+{
+    // index doesn't change, when new command is merged into current one,
+    // so clean command gets changes, that aren't in file
+    if (index > 0 && index == mUndoIndex && mUndoStack->isClean() && !mCleanStateLost)
+    {
+        mCleanStateLost = true;
+        emitEvent(EditorObserverInterface::ContentChanged);
+    }
+    mUndoIndex = index;
+}
+
 
 // ---------------------
 SCgWindowFactory::SCgWindowFactory(QObject *parent) :
@@ -712,7 +921,7 @@ EditorInterface* SCgWindowFactory::createInstance()
 QStringList SCgWindowFactory::supportedFormatsExt()
 {
     QStringList res;
-    res << "gwf";
+    res << "gwf" << "gwb";
     return res;
 }
 
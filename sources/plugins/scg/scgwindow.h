@@ -13,8 +13,12 @@
 #include <QMap>
 
 class SCgMinimap;
+class SCgObject;
 class SCgView;
 class SCgUndoView;
+class SCgStatisticsWidget;
+class SCgUndoMemoryManager;
+class GWFAsyncFileWriter;
 
 class QToolBar;
 class QLineEdit;
@@ -41,7 +45,10 @@ public:
     //! @copydoc EditorInterface::loadFromFile
     bool loadFromFile(const QString &fileName);
 
-    //! @copydoc EditorInterface::saveToFile
+    /*! Starts saving content to file in background.
+      Window is marked as saved when writing finishes, if there were no changes since saving started.
+      @copydoc EditorInterface::saveToFile
+      */
     bool saveToFile(const QString &fileName);
 
     /*! Update window immediately
@@ -76,6 +83,8 @@ protected:
     bool isSaved() const;
     //! @copydoc EditorInterface::supportedFormatsExt
     QStringList supportedFormatsExt() const;
+    //! Selects object with identifier of hit. @copydoc EditorInterface::showSearchHit
+    void showSearchHit(const SearchHit &hit);
 
 private:
     //! List of scales.
@@ -103,6 +112,12 @@ private:
      */
     void find(const QString &ttf, bool forward, bool checkCurrent = false);
 
+    //! @return Other project files, that have identifiers starting with @p ttf. @see ProjectIndex
+    QStringList projectFilesWith(const QString &ttf) const;
+
+    //! Scrolls view to found object and selects it.
+    void showFound(SCgObject *found);
+
     //! Graphics view
     SCgView *mView;
     SCgScene *mScene;
@@ -123,6 +138,9 @@ private:
     //! Undo view widget
     SCgUndoView *mUndoView;
 
+    //! Scene statistics widget
+    SCgStatisticsWidget *mStatistics;
+
     //! Find widget
     SCgFindWidget *mFindWidget;
 
@@ -132,6 +150,18 @@ private:
     //! Undo stack
     QUndoStack *mUndoStack;
 
+    //! Keeps undo history memory in limit
+    SCgUndoMemoryManager *mUndoMemoryManager;
+
+    //! Writes scene snapshots to file in background
+    GWFAsyncFileWriter *mFileWriter;
+    /*! True, if clean command of undo stack doesn't match file: the last save failed
+      (stack is marked clean, when save starts) or command was merged with new one.
+      */
+    bool mCleanStateLost;
+    //! Index of undo stack, that is used to find merged commands.
+    int mUndoIndex;
+
     //! Widgets, which will be placed into dock area of main window.
     QList<QWidget*> mWidgetsForDocks;
 
@@ -184,6 +214,12 @@ private slots:
     void onVerticalAlignment();
     //! Slot to handle a horizontal alignment action
     void onHorizontalAlignment();
+    //! Slot to handle an energy-based layout action
+    void onEnergyBasedLayout();
+    //! Slot to handle a hierarchical layout action
+    void onHierarchicalLayout();
+    //! Slot to handle a pairs routing action
+    void onRoutePairs();
     //! Slot to handle select input/output action
     void onSelectInputOutput();
     //! Slot to handle select subgraph action
@@ -228,6 +264,13 @@ private slots:
     void deleteSelected();
 
     void stackCleanStateChanged(bool value);
+    //! Marks file as unsaved, if clean command was merged with new one.
+    void stackIndexChanged(int index);
+
+    //! Shows save progress in window title.
+    void onSaveProgress(int percent);
+    //! Handles finish of background save.
+    void onSaveFinished(bool result, const QString &errorString);
 };
 
 class SCgWindowFactory : public QObject,
@@ -23,6 +23,7 @@ void SCgSelectInputOutput::doSelection(SCgScene *scene)
     Q_ASSERT(scene != 0);
 
     // get all selected objects
+    scene->materializeSelection();
     QList<QGraphicsItem*> items = scene->selectedItems();
     QGraphicsItem *item = 0;
     foreach(item, items)
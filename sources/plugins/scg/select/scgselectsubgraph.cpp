@@ -25,6 +25,7 @@ void SCgSelectSubGraph::doSelection(SCgScene *scene)
 {
     Q_ASSERT(scene != 0);
 
+    scene->materializeSelection();
     QList<QGraphicsItem*> items = scene->selectedItems();
     QGraphicsItem *item = 0;
     foreach(item, items)
@@ -35,3 +35,8 @@ QTextCharFormat SCsAbstractHighlightingRule::format()
 {
     return mFormat;
 }
+
+bool SCsAbstractHighlightingRule::affectsBlockState() const
+{
+    return false;
+}
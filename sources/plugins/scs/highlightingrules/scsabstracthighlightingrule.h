@@ -21,6 +21,8 @@ public:
     void setFormat(QTextCharFormat format);
     ~SCsAbstractHighlightingRule();
     virtual void assignFormat(SCsSyntaxHighlighter* highlighter, const QString& text);
+    //! @return True, if rule sets state of block, that is passed to next block.
+    virtual bool affectsBlockState() const;
 
 private:
     QTextCharFormat mFormat;
@@ -41,3 +41,8 @@ void SCsMultiLineCommentHighlightingRule::assignFormat(SCsSyntaxHighlighter *hig
                                   startIndex + commentLength);
      }
 }
+
+bool SCsMultiLineCommentHighlightingRule::affectsBlockState() const
+{
+    return true;
+}
@@ -13,6 +13,7 @@ class SCsMultiLineCommentHighlightingRule : public SCsAbstractHighlightingRule
 public:
     SCsMultiLineCommentHighlightingRule(QRegExp start, QRegExp end, QTextCharFormat format);
     virtual void assignFormat(SCsSyntaxHighlighter *highlighter, const QString &text);
+    virtual bool affectsBlockState() const;
 
 private:
     QRegExp mStart;
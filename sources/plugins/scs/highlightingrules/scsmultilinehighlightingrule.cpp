@@ -42,3 +42,8 @@ void SCsMultiLinetHighlightingRule::assignFormat(SCsSyntaxHighlighter *highlight
 	}
 
 }
+
+bool SCsMultiLinetHighlightingRule::affectsBlockState() const
+{
+	return true;
+}
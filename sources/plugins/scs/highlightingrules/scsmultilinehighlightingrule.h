@@ -23,6 +23,7 @@ public:
 
 	SCsMultiLinetHighlightingRule(QRegExp start, QRegExp end, QTextCharFormat format, BlockRuleState state);
 	virtual void assignFormat(SCsSyntaxHighlighter *highlighter, const QString &text);
+	virtual bool affectsBlockState() const;
 
 private:
 	BlockRuleState mState;
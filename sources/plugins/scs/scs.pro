@@ -53,6 +53,8 @@ HEADERS += \
     scsparser/SCsCParser.h \
     scsparser/scscparserdefs.h \
     scsparser/scsasynchparser.h \
+    scsparser/scsastnodes.h \
+    scsparser/scssyntaxtree.h \
     scswindow.h \
     scsplugin.h \
     scscodeerroranalyzer.h \
@@ -62,7 +64,11 @@ HEADERS += \
     scsfindwidget.h \
     scssyntaxhighlighter.h \
     scscodeanalyzer.h \
-    scscodecompleter.h
+    scscodecompleter.h \
+    scsidentifiermodel.h \
+    scssymboltable.h \
+    scsidentifierscanner.h \
+    scsdocumentsearcher.h
 
 
 SOURCES += \
@@ -77,6 +83,7 @@ SOURCES += \
     scsparser/SCsCParser.c \
     scsparser/scscparserdefs.c \
     scsparser/scsasynchparser.cpp \
+    scsparser/scssyntaxtree.cpp \
     scswindow.cpp \
     scserrortablewidget.cpp \
     scscodeeditor.cpp \
@@ -86,7 +93,11 @@ SOURCES += \
     scserrortablewidgetitem.cpp \
     scscodeanalyzer.cpp \
     scssyntaxhighlighter.cpp \
-    scscodecompleter.cpp
+    scscodecompleter.cpp \
+    scsidentifiermodel.cpp \
+    scssymboltable.cpp \
+    scsidentifierscanner.cpp \
+    scsdocumentsearcher.cpp
 
 OTHER_FILES += \
     scsplugin.json
@@ -7,8 +7,11 @@
 #include "scscodeanalyzer.h"
 #include "scsparserwrapper.h"
 #include "scsasynchparser.h"
+#include "projectindex.h"
+#include "scsidentifiermodel.h"
 
-#include <QStandardItemModel>
+#include <algorithm>
+#include <iterator>
 
 const QRegExp SCsCodeAnalyzer::msIdentifierExp("([A-Za-z0-9_.#]+)");
 
@@ -24,20 +27,32 @@ SCsCodeAnalyzer::SCsCodeAnalyzer(QObject *parent) :
 }
 
 
-void SCsCodeAnalyzer::fillModel(QStandardItemModel *model, const QSet<QString> &idtfs)
+void SCsCodeAnalyzer::fillModel(SCsIdentifierModel *model, const QSet<QString> &idtfs)
 {
 	Q_CHECK_PTR(model);
 
 	if (!model)
 		return;
 
-	model->clear();
-
+	QVector<QString> documentIdtfs;
+	documentIdtfs.reserve(idtfs.size());
 	foreach (const QString &id, idtfs)
-	{
-		QStandardItem *item = new QStandardItem(id);
-		model->appendRow(item);
-	}
+		documentIdtfs.append(id);
+	std::sort(documentIdtfs.begin(), documentIdtfs.end());
+
+	// identifiers of other documents and project files are taken from index, it returns them sorted
+	QStringList projectIdtfs;
+	if (ProjectIndex::instance())
+		projectIdtfs = ProjectIndex::instance()->identifiers(QString(), 0);
+
+	QVector<QString> allIdtfs;
+	allIdtfs.reserve(documentIdtfs.size() + projectIdtfs.size());
+	std::set_union(documentIdtfs.constBegin(), documentIdtfs.constEnd(),
+	               projectIdtfs.constBegin(), projectIdtfs.constEnd(),
+	               std::back_inserter(allIdtfs));
+
+	// model applies only differences, so opened completer popup isn't reset
+	model->setIdentifiers(allIdtfs);
 }
 
 void SCsCodeAnalyzer::ignoreUpdate(const QString &identifier)
@@ -57,7 +72,7 @@ bool SCsCodeAnalyzer::isIdentifier(const QString &text)
 
 
 
-void SCsCodeAnalyzer::update(const QString &text, QStandardItemModel *model)
+void SCsCodeAnalyzer::update(const QString &text, SCsIdentifierModel *model)
 {
     if (mIsBusy)
 		return;
@@ -72,7 +87,7 @@ void SCsCodeAnalyzer::update(const QString &text, QStandardItemModel *model)
 }
 
 
-void SCsCodeAnalyzer::asynchUpdate(const QString &text, QStandardItemModel *model)
+void SCsCodeAnalyzer::asynchUpdate(const QString &text, SCsIdentifierModel *model)
 {
 	if (mIsBusy)
 		return;
@@ -88,7 +103,7 @@ void SCsCodeAnalyzer::asynchUpdate(const QString &text, QStandardItemModel *mode
 
 }
 
-void SCsCodeAnalyzer::parse(const QString &text, QStandardItemModel *model)
+void SCsCodeAnalyzer::parse(const QString &text, SCsIdentifierModel *model)
 {
 	if (mIsBusy)
 		return;
@@ -15,7 +15,7 @@
 #include <QSet>
 #include <QMap>
 
-class QStandardItemModel;
+class SCsIdentifierModel;
 class SCsParseExtractIdftAsynchTask;
 class SCsAsynchParser;
 
@@ -32,15 +32,15 @@ public:
       * @param text String that contains sc.s-text
       * @param model Pointer to autocomplete item model
       */
-    void parse(const QString &text, QStandardItemModel *model);
+    void parse(const QString &text, SCsIdentifierModel *model);
 
     /*! Update autocompleter's model according to changes in document made by user
       * @param text String that contains sc.s-text of edited document
       * @param model Pointer to autocomplete item model
       */
-    void update(const QString &text, QStandardItemModel *model);
+    void update(const QString &text, SCsIdentifierModel *model);
 
-	void asynchUpdate(const QString &text, QStandardItemModel *model);
+	void asynchUpdate(const QString &text, SCsIdentifierModel *model);
 
     /*! Force to ignore the addition of an \p identifier during the next update
       * (identifier wouldn't be added to autocomleter item model)
@@ -54,7 +54,7 @@ public:
     static bool isIdentifier(const QString &text);
 
 protected:
-    void fillModel(QStandardItemModel *model, const QSet<QString> &idtfs);
+    void fillModel(SCsIdentifierModel *model, const QSet<QString> &idtfs);
 	void extractIdentifiers(const QString &text, QSet<QString> &identifiers);
 
 private slots:
@@ -64,7 +64,7 @@ private:
 	const static QRegExp msIdentifierExp;
     QSet<QString> mDocumentIdentifiers;
     QSet<QString> mIgnoreIdentifiers;
-	QStandardItemModel* mUpdateModel;
+	SCsIdentifierModel* mUpdateModel;
     SCsAsynchParser* mAsynchParser;
     bool mIsBusy;
 };
@@ -5,14 +5,14 @@
  */
 
 #include "scscodecompleter.h"
-#include "QStandardItemModel"
+#include "scsidentifiermodel.h"
 #include <QAbstractItemView>
 
 SCsCodeCompleter::SCsCodeCompleter(QObject *parent) :
     QCompleter(parent)
 {
-    QStandardItemModel *_mItemModel = new QStandardItemModel(parent);
-    setModel(_mItemModel);
+    mIdentifierModel = new SCsIdentifierModel(this);
+    setModel(mIdentifierModel);
     popup()->setIconSize(QSize(16, 16));
 }
 
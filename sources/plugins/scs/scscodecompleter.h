@@ -9,6 +9,8 @@
 #include <QObject>
 #include <QCompleter>
 
+class SCsIdentifierModel;
+
 class SCsCodeCompleter : public QCompleter
 {
     Q_OBJECT
@@ -17,12 +19,17 @@ public:
     explicit SCsCodeCompleter(QObject *parent = 0);
     virtual ~SCsCodeCompleter();
 
+    //! @return Model of completer. It filters identifiers by prefix itself.
+    SCsIdentifierModel* identifierModel() const { return mIdentifierModel; }
+
     static const int MinCompletetionLength = 3;
 
 signals:
 
 public slots:
 
+private:
+    SCsIdentifierModel *mIdentifierModel;
 };
 
 
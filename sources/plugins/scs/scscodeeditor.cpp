@@ -10,13 +10,14 @@
 #include <QTextBlock>
 #include <QAbstractItemView>
 #include <QScrollBar>
-#include <QStandardItemModel>
 #include <QDebug>
 #include "scscodeanalyzer.h"
 #include "scscodecompleter.h"
+#include "scsidentifiermodel.h"
 #include "scsfindwidget.h"
 #include "scserrortablewidget.h"
 #include "scscodeerroranalyzer.h"
+#include "scssymboltable.h"
 
 #include "scsparserwrapper.h"
 
@@ -25,6 +26,9 @@
 SCsCodeEditor::SCsCodeEditor(QWidget *parent, SCsErrorTableWidget *errorTable)
     : QPlainTextEdit(parent)
     , mErrorTable(errorTable)
+    , mSymbolsLineCount(0)
+    , mSymbolsRevision(-1)
+    , mSymbolsBuilt(false)
     , mLastCursorPosition(0)
     , mIsTextInsert(false)
 {
@@ -32,11 +36,13 @@ SCsCodeEditor::SCsCodeEditor(QWidget *parent, SCsErrorTableWidget *errorTable)
 	mAnalyzer = new SCsCodeAnalyzer(this);
     mCompleter = new SCsCodeCompleter(this);
     mErrorAnalyzer = new SCsCodeErrorAnalyzer(this, mErrorTable);
+    mSymbolTable = new SCsSymbolTable();
 
     mCompleter->setWidget(this);
-    mCompleter->setCompletionMode(QCompleter::PopupCompletion);
+    // model filters identifiers by prefix, so completer shows all its rows
+    mCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
     mCompleter->setCaseSensitivity(Qt::CaseSensitive);
-    mCompleter->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
+    mCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
 
     mErrorPixmap = QPixmap(":scs/media/icons/error.png").scaledToHeight(15);
 
@@ -46,6 +52,8 @@ SCsCodeEditor::SCsCodeEditor(QWidget *parent, SCsErrorTableWidget *errorTable)
     connect(this, SIGNAL(updateRequest(QRect,int)), this, SLOT(updateLineNumberArea(QRect,int)));
     connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(highlightCurrentLine()));
     connect(this, SIGNAL(textChanged()), this, SLOT(updateAnalyzer()));
+    // connected before highlighter is created, so symbols are updated before formats are applied
+    connect(document(), SIGNAL(contentsChange(int,int,int)), this, SLOT(updateSymbols(int,int,int)));
 	connect(mErrorAnalyzer,SIGNAL(errorLines(QSet<int>)),this,SLOT(setErrorsLines(QSet<int>)));
 
     if (mErrorTable != NULL)
@@ -57,10 +65,15 @@ SCsCodeEditor::SCsCodeEditor(QWidget *parent, SCsErrorTableWidget *errorTable)
     setLineWrapMode(QPlainTextEdit::NoWrap);
 }
 
+SCsCodeEditor::~SCsCodeEditor()
+{
+    delete mSymbolTable;
+}
+
 void SCsCodeEditor::setDocumentPath(const QString &path)
 {
-    Q_UNUSED(path);
-	mAnalyzer->parse(toPlainText(), (QStandardItemModel*)mCompleter->model());
+    mDocumentPath = path;
+	mAnalyzer->parse(toPlainText(), mCompleter->identifierModel());
 }
 
 int SCsCodeEditor::lineNumberAreaWidth()
@@ -119,6 +132,7 @@ void SCsCodeEditor::highlightCurrentLine()
 		extraSelections.append(selection);
 	}
 
+	extraSelections.append(mReferenceSelections);
 	setExtraSelections(extraSelections);
 }
 
@@ -177,6 +191,15 @@ void SCsCodeEditor::keyPressEvent(QKeyEvent *e)
 	if (e->modifiers() == Qt::ControlModifier && e->key() == Qt::Key_R)
         updateErrorAnalyzer();
 
+    if (e->key() == Qt::Key_F2)
+    {
+        if (e->modifiers() == Qt::ShiftModifier)
+            highlightReferences();
+        else if (e->modifiers() == Qt::NoModifier)
+            goToDefinition();
+        return;
+    }
+
     if (mCompleter->popup()->isVisible())
     {
         switch (e->key())
@@ -221,6 +244,7 @@ void SCsCodeEditor::keyPressEvent(QKeyEvent *e)
      }
 
      if (completionPrefix != mCompleter->completionPrefix()) {
+         mCompleter->identifierModel()->setPrefix(completionPrefix);
          mCompleter->setCompletionPrefix(completionPrefix);
          mCompleter->popup()->setCurrentIndex(mCompleter->completionModel()->index(0, 0));
      }
@@ -247,9 +271,6 @@ void SCsCodeEditor::insertCompletion(QModelIndex index)
 
 void SCsCodeEditor::updateAnalyzer()
 {
-
-    QStandardItemModel* completerModel = static_cast<QStandardItemModel*>(mCompleter->model());
-
     QTextCursor tc = textCursor();
 
     tc.select( QTextCursor::WordUnderCursor );
@@ -258,7 +279,7 @@ void SCsCodeEditor::updateAnalyzer()
     mLastCursorPosition = tc.position();
     mAnalyzer->ignoreUpdate(currentWord);
 
-    mAnalyzer->asynchUpdate(toPlainText(), completerModel);
+    mAnalyzer->asynchUpdate(toPlainText(), mCompleter->identifierModel());
 }
 
 void SCsCodeEditor::updateErrorAnalyzer()
@@ -309,3 +330,136 @@ void SCsCodeEditor::moveTextCursor(int line, int charPos)
 	setTextCursor(cursor);
 	setFocus(Qt::ShortcutFocusReason);
 }
+
+
+void SCsCodeEditor::updateSymbols(int position, int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(charsRemoved);
+
+    // highlighter reports formats as content changes, they don't change revision and lines
+    if (document()->revision() == mSymbolsRevision && blockCount() == mSymbolsLineCount)
+        return;
+    mSymbolsRevision = document()->revision();
+
+    const int lastPosition = qMin(position + charsAdded, document()->characterCount() - 1);
+    const int fromLine = document()->findBlock(position).blockNumber() + 1;
+    const int addedLines = document()->findBlock(lastPosition).blockNumber() + 1 - fromLine;
+    const int removedLines = addedLines - (blockCount() - mSymbolsLineCount);
+    mSymbolsLineCount = blockCount();
+
+    // whole text is replaced, when document is loaded, its table is built when it's needed
+    const bool wholeText = position == 0 && lastPosition == document()->characterCount() - 1;
+    if (wholeText || fromLine <= 0 || addedLines < 0 || removedLines < 0)
+    {
+        mSymbolTable->clear();
+        mSymbolsBuilt = false;
+    }
+    else if (mSymbolsBuilt)
+        mSymbolTable->update(document(), fromLine, removedLines, addedLines);
+
+    if (!mReferenceSelections.isEmpty())
+    {
+        mReferenceSelections.clear();
+        highlightCurrentLine();
+    }
+}
+
+const SCsSymbolTable* SCsCodeEditor::symbolTable()
+{
+    if (!mSymbolsBuilt)
+    {
+        mSymbolTable->build(toPlainText());
+        mSymbolsBuilt = true;
+    }
+    return mSymbolTable;
+}
+
+bool SCsCodeEditor::symbolUnderCursor(SCsSymbol &symbol)
+{
+    QTextCursor cursor = textCursor();
+    QTextBlock block = cursor.block();
+
+    // lexer counts position in bytes of utf-8
+    const int column = block.text().left(cursor.positionInBlock()).toUtf8().size();
+    return symbolTable()->symbolAt(block.blockNumber() + 1, column, symbol);
+}
+
+void SCsCodeEditor::moveToSymbol(const SCsSymbol &symbol)
+{
+    QTextBlock block = document()->findBlockByNumber(symbol.line - 1);
+    if (!block.isValid())
+        return;
+
+    const int column = QString::fromUtf8(block.text().toUtf8().left(symbol.column)).length();
+
+    QTextCursor cursor(block);
+    cursor.setPosition(block.position() + column);
+    setTextCursor(cursor);
+    centerCursor();
+}
+
+void SCsCodeEditor::goToDefinition()
+{
+    SCsSymbol symbol;
+    if (!symbolUnderCursor(symbol))
+        return;
+
+    SCsSymbolList definitions = mSymbolTable->definitions(symbol.identifier);
+    if (definitions.isEmpty())
+        return;
+
+    // from definition cursor goes to next one, so all of them can be visited
+    int next = 0;
+    for (int i = 0; i < definitions.size(); ++i)
+    {
+        if (definitions.at(i).line == symbol.line && definitions.at(i).column == symbol.column)
+        {
+            next = (i + 1) % definitions.size();
+            break;
+        }
+    }
+
+    moveToSymbol(definitions.at(next));
+}
+
+void SCsCodeEditor::highlightReferences()
+{
+    mReferenceSelections.clear();
+
+    SCsSymbol symbol;
+    if (!symbolUnderCursor(symbol))
+    {
+        highlightCurrentLine();
+        return;
+    }
+
+    SCsSymbolList symbols = mSymbolTable->symbols(symbol.identifier);
+
+    QTextCharFormat format;
+    format.setBackground(QColor(Qt::cyan).lighter(170));
+
+    int next = 0;
+    for (int i = 0; i < symbols.size(); ++i)
+    {
+        const SCsSymbol &s = symbols.at(i);
+        QTextBlock block = document()->findBlockByNumber(s.line - 1);
+        if (!block.isValid())
+            continue;
+
+        const int begin = block.position() + QString::fromUtf8(block.text().toUtf8().left(s.column)).length();
+
+        QTextEdit::ExtraSelection selection;
+        selection.format = format;
+        selection.cursor = QTextCursor(block);
+        selection.cursor.setPosition(begin);
+        selection.cursor.setPosition(begin + s.identifier.length(), QTextCursor::KeepAnchor);
+        mReferenceSelections.append(selection);
+
+        if (s.line == symbol.line && s.column == symbol.column)
+            next = (i + 1) % symbols.size();
+    }
+
+    if (!symbols.isEmpty())
+        moveToSymbol(symbols.at(next));
+    highlightCurrentLine();
+}
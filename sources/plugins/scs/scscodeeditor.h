@@ -17,16 +17,25 @@ class SCsCodeCompleter;
 class SCsFindWidget;
 class SCsErrorTableWidget;
 class SCsCodeErrorAnalyzer;
+class SCsSymbolTable;
+struct SCsSymbol;
 
 class SCsCodeEditor : public QPlainTextEdit
 {
     Q_OBJECT
 public:
     SCsCodeEditor(QWidget* parent = 0, SCsErrorTableWidget *errorTable = 0);
+    virtual ~SCsCodeEditor();
     void lineNumberAreaPaintEvent(QPaintEvent* event);
     int lineNumberAreaWidth();
 
     void setDocumentPath(const QString &path);
+    const QString& documentPath() const { return mDocumentPath; }
+
+    /*! @return Symbol table, that is kept up to date with text. Table of loaded text
+      is built by the first call, so big documents are opened without parsing them.
+      */
+    const SCsSymbolTable* symbolTable();
    
 protected:
     void resizeEvent(QResizeEvent *event);
@@ -37,6 +46,14 @@ protected:
 
     void updateErrorAnalyzer();
 
+    //! Finds symbol under text cursor, symbol table is built if needed. @return True, if it's found.
+    bool symbolUnderCursor(SCsSymbol &symbol);
+    void moveToSymbol(const SCsSymbol &symbol);
+    //! Moves cursor to next definition of identifier under cursor.
+    void goToDefinition();
+    //! Highlights all occurrences of identifier under cursor and moves cursor to next one.
+    void highlightReferences();
+
 public slots:
 	void setErrorsLines(const QSet<int> &lines);
 
@@ -47,6 +64,7 @@ private slots:
     void insertCompletion(QModelIndex index);
     void updateAnalyzer();
 	void moveTextCursor(int line, int charPos);
+    void updateSymbols(int position, int charsRemoved, int charsAdded);
 
 private:
     QWidget *mLineNumberArea;
@@ -54,6 +72,14 @@ private:
     SCsCodeCompleter *mCompleter;
     SCsErrorTableWidget *mErrorTable;
 	SCsCodeErrorAnalyzer *mErrorAnalyzer;
+    SCsSymbolTable *mSymbolTable;
+    //! Number of lines and revision of document, that symbol table corresponds to.
+    int mSymbolsLineCount;
+    int mSymbolsRevision;
+    //! False, until symbol table of loaded text is requested. @see symbolTable
+    bool mSymbolsBuilt;
+    QList<QTextEdit::ExtraSelection> mReferenceSelections;
+    QString mDocumentPath;
 
     QSet<int> mErrorLines;
     QPixmap mErrorPixmap;
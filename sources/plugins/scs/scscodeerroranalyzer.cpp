@@ -9,6 +9,11 @@
 
 #include "scserrortablewidget.h"
 #include "scsasynchparser.h"
+#include "scssymboltable.h"
+#include "projectindex.h"
+
+#include <QFileInfo>
+
 #include <antlr3exception.h>
 
 SCsCodeErrorAnalyzer::SCsCodeErrorAnalyzer(SCsCodeEditor* editor, SCsErrorTableWidget *errorTable)
@@ -48,14 +53,43 @@ void SCsCodeErrorAnalyzer::showError(const QVector<SCsParserException> &exceptio
         mErrorTable->addError(description, it->line(), it->positionInLine());
 	}
 
+    // sc.s doesn't require definitions, so identifiers, that aren't defined anywhere in
+    // project, are only warnings. Without project other files can't be checked.
+    int warningCount = 0;
+    if (ProjectIndex::instance())
+    {
+        const QString documentPath = QFileInfo(mEditor->documentPath()).absoluteFilePath();
+        foreach (const SCsSymbol &symbol, mEditor->symbolTable()->undefinedSymbols())
+        {
+            if (isDefinedInProject(symbol.identifier, documentPath))
+                continue;
+
+            QString description = tr("Identifier %1 isn't defined in project").arg(symbol.identifier);
+            mErrorTable->addWarning(description, symbol.line, symbol.column);
+            ++warningCount;
+        }
+    }
+
+    // warnings alone don't open table
 	if (!exceptions.isEmpty())
 		mErrorTable->show();
-	else
+	else if (warningCount == 0)
 		mErrorTable->hide();
 
 }
 
 
+bool SCsCodeErrorAnalyzer::isDefinedInProject(const QString &identifier, const QString &documentPath) const
+{
+    foreach (const IdentifierLocation &location, ProjectIndex::instance()->locations(identifier))
+    {
+        if (QFileInfo(location.fileName).absoluteFilePath() != documentPath)
+            return true;
+    }
+    return false;
+}
+
+
 QString SCsCodeErrorAnalyzer::getErrorDescription(const SCsParserException &ex) const
 {
 	QString descr;
@@ -26,6 +26,8 @@ public:
 private:
 	void showError(const QVector<SCsParserException> &exceptions) const;
 	QString getErrorDescription(const SCsParserException &ex) const;
+    //! @return True, if @p identifier occurs in project files other than @p documentPath. Project index must exist.
+    bool isDefinedInProject(const QString &identifier, const QString &documentPath) const;
 
     SCsAsynchParser* mAsynchParser;
 
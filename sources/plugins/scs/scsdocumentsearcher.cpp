@@ -0,0 +1,51 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scsdocumentsearcher.h"
+#include "scsparserwrapper.h"
+#include "SCsCParser.h"
+
+SCsDocumentSearcher::SCsDocumentSearcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SCsDocumentSearcher::~SCsDocumentSearcher()
+{
+}
+
+QStringList SCsDocumentSearcher::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "scs";
+    return res;
+}
+
+SearchHitList SCsDocumentSearcher::search(const QString &fileName, const QByteArray &data,
+                                          const SearchQuery &query) const
+{
+    QString text = QString::fromUtf8(data);
+
+    SCsParser parser;
+    QSharedPointer<SCsParserTokenArray> tokens = parser.getTokens(text);
+
+    SearchHitList res;
+    SCsParserTokenArray::iterator it;
+    for (it = tokens->begin(); it != tokens->end(); ++it)
+    {
+        if (it->tokenType() != NAME || !query.matches(it->tokenText()))
+            continue;
+
+        SearchHit hit;
+        hit.fileName = fileName;
+        hit.line = it->line();
+        hit.column = it->positionInLine() + 1;
+        hit.text = it->tokenText();
+        hit.identifier = it->tokenText();
+        res.append(hit);
+    }
+    return res;
+}
@@ -0,0 +1,28 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/documentsearcherinterface.h"
+
+#include <QObject>
+
+//! Searches identifier tokens of scs files for find in project.
+class SCsDocumentSearcher : public QObject,
+                            public DocumentSearcherInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(DocumentSearcherInterface)
+
+public:
+    explicit SCsDocumentSearcher(QObject *parent = 0);
+    virtual ~SCsDocumentSearcher();
+
+    //! @copydoc DocumentSearcherInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+    //! @copydoc DocumentSearcherInterface::search
+    SearchHitList search(const QString &fileName, const QByteArray &data, const SearchQuery &query) const;
+};
@@ -64,6 +64,17 @@ void SCsErrorTableWidget::addError(QString &description, int line, int charPos)
 
 }
 
+void SCsErrorTableWidget::addWarning(QString &description, int line, int charPos)
+{
+    int row = rowCount();
+    addError(description, line, charPos);
+    if (rowCount() == row)
+        return;
+
+    for (int col = 0; col < columnCount(); ++col)
+        item(row, col)->setForeground(palette().color(QPalette::Disabled, QPalette::Text));
+}
+
 void SCsErrorTableWidget::clear()
 {
 	QTableWidget::clear();
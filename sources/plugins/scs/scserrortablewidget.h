@@ -17,6 +17,8 @@ class SCsErrorTableWidget : public QTableWidget
 public:
     explicit SCsErrorTableWidget(QWidget *parent = 0);
 	void addError(QString &description, int line, int charPos);
+    //! Adds row, that is shown dimmer than errors.
+    void addWarning(QString &description, int line, int charPos);
 	void clear();
     void resizeEvent(QResizeEvent *event);
     void show();
@@ -0,0 +1,214 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scsidentifiermodel.h"
+
+#include <QPair>
+
+#include <algorithm>
+
+//! Compares prefix with beginning of identifier, so range of identifiers with prefix is found.
+struct PrefixLess
+{
+    bool operator()(const QString &prefix, const QString &value) const
+    {
+        return prefix.compare(value.leftRef(prefix.size())) < 0;
+    }
+};
+
+SCsIdentifierModel::SCsIdentifierModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , mBegin(0)
+    , mEnd(0)
+{
+}
+
+SCsIdentifierModel::~SCsIdentifierModel()
+{
+}
+
+int SCsIdentifierModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return mEnd - mBegin;
+}
+
+QVariant SCsIdentifierModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= mEnd - mBegin)
+        return QVariant();
+
+    if (role == Qt::DisplayRole || role == Qt::EditRole)
+        return mIdentifiers.at(mBegin + index.row());
+
+    return QVariant();
+}
+
+void SCsIdentifierModel::setIdentifiers(const QVector<QString> &identifiers)
+{
+    // runs of removed identifiers [from, to) in current vector
+    QVector< QPair<int, int> > removed;
+    // runs of inserted identifiers with their positions in vector without removed ones
+    QVector< QPair<int, QVector<QString> > > inserted;
+
+    const int oldSize = mIdentifiers.size();
+    const int newSize = identifiers.size();
+    int i = 0, j = 0, common = 0, changes = 0;
+    while (i < oldSize || j < newSize)
+    {
+        if (j >= newSize || (i < oldSize && mIdentifiers.at(i) < identifiers.at(j)))
+        {
+            if (!removed.isEmpty() && removed.last().second == i)
+                removed.last().second = i + 1;
+            else
+                removed.append(qMakePair(i, i + 1));
+            ++i;
+            ++changes;
+        }
+        else if (i >= oldSize || identifiers.at(j) < mIdentifiers.at(i))
+        {
+            if (inserted.isEmpty() || inserted.last().first != common)
+                inserted.append(qMakePair(common, QVector<QString>()));
+            inserted.last().second.append(identifiers.at(j));
+            ++j;
+            ++changes;
+        }
+        else
+        {
+            ++i;
+            ++j;
+            ++common;
+        }
+    }
+
+    if (changes == 0)
+        return;
+
+    // row by row signals cost more than reset, when most of identifiers are changed
+    if (changes > oldSize / 2)
+    {
+        beginResetModel();
+        mIdentifiers = identifiers;
+        findPrefixRange(mPrefix, mBegin, mEnd);
+        endResetModel();
+        return;
+    }
+
+    // runs are applied from the end, so positions of previous runs stay valid
+    for (int k = removed.size() - 1; k >= 0; --k)
+        removeIdentifiers(removed.at(k).first, removed.at(k).second);
+    for (int k = inserted.size() - 1; k >= 0; --k)
+        insertIdentifiers(inserted.at(k).first, inserted.at(k).second);
+
+    Q_ASSERT(mIdentifiers == identifiers);
+}
+
+void SCsIdentifierModel::setPrefix(const QString &prefix)
+{
+    if (prefix == mPrefix)
+        return;
+
+    mPrefix = prefix;
+
+    int begin, end;
+    findPrefixRange(mPrefix, begin, end);
+
+    if (mBegin == mEnd && begin == end)
+    {
+        mBegin = begin;
+        mEnd = end;
+        return;
+    }
+
+    if (begin >= mEnd || end <= mBegin)
+    {
+        beginResetModel();
+        mBegin = begin;
+        mEnd = end;
+        endResetModel();
+        return;
+    }
+
+    // ranges overlap, so only rows at their ends are changed
+    if (end < mEnd)
+    {
+        beginRemoveRows(QModelIndex(), end - mBegin, mEnd - mBegin - 1);
+        mEnd = end;
+        endRemoveRows();
+    }
+    else if (end > mEnd)
+    {
+        beginInsertRows(QModelIndex(), mEnd - mBegin, end - mBegin - 1);
+        mEnd = end;
+        endInsertRows();
+    }
+
+    if (begin > mBegin)
+    {
+        beginRemoveRows(QModelIndex(), 0, begin - mBegin - 1);
+        mBegin = begin;
+        endRemoveRows();
+    }
+    else if (begin < mBegin)
+    {
+        beginInsertRows(QModelIndex(), 0, mBegin - begin - 1);
+        mBegin = begin;
+        endInsertRows();
+    }
+}
+
+void SCsIdentifierModel::findPrefixRange(const QString &prefix, int &begin, int &end) const
+{
+    QVector<QString>::const_iterator first = std::lower_bound(mIdentifiers.constBegin(),
+                                                              mIdentifiers.constEnd(), prefix);
+    QVector<QString>::const_iterator last = std::upper_bound(first, mIdentifiers.constEnd(),
+                                                             prefix, PrefixLess());
+    begin = first - mIdentifiers.constBegin();
+    end = last - mIdentifiers.constBegin();
+}
+
+void SCsIdentifierModel::removeIdentifiers(int from, int to)
+{
+    const int first = qMax(from, mBegin);
+    const int last = qMin(to, mEnd);
+    const bool visible = first < last;
+
+    if (visible)
+        beginRemoveRows(QModelIndex(), first - mBegin, last - mBegin - 1);
+
+    mIdentifiers.remove(from, to - from);
+
+    const int before = qMax(0, qMin(to, mBegin) - from);
+    mBegin -= before;
+    mEnd -= before + (visible ? last - first : 0);
+
+    if (visible)
+        endRemoveRows();
+}
+
+void SCsIdentifierModel::insertIdentifiers(int pos, const QVector<QString> &values)
+{
+    // values are sorted, so they are split into ones before prefix range, in it and after it
+    const int before = std::lower_bound(values.constBegin(), values.constEnd(), mPrefix) - values.constBegin();
+    int after = before;
+    while (after < values.size() && values.at(after).startsWith(mPrefix))
+        ++after;
+    const int count = after - before;
+
+    // matching values are inserted at the beginning of range or inside it
+    if (count > 0)
+        beginInsertRows(QModelIndex(), pos - mBegin, pos - mBegin + count - 1);
+
+    mIdentifiers.insert(pos, values.size(), QString());
+    std::copy(values.constBegin(), values.constEnd(), mIdentifiers.begin() + pos);
+
+    mBegin += before;
+    mEnd += before + count;
+
+    if (count > 0)
+        endInsertRows();
+}
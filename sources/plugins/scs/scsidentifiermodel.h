@@ -0,0 +1,56 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QString>
+
+/*! List model of identifiers for code completer. Identifiers are kept in sorted vector
+ * without duplicates, rows are identifiers, that start with current prefix. Prefix range
+ * is found by binary search, so model itself does filtering instead of QCompleter.
+ *
+ * Identifiers are updated by differences: only inserted and removed rows are signaled,
+ * so views aren't reset when analyzer refreshes identifiers.
+ */
+class SCsIdentifierModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    explicit SCsIdentifierModel(QObject *parent = 0);
+    virtual ~SCsIdentifierModel();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    /*! Replaces identifiers. Rows of removed and inserted identifiers are signaled separately.
+      @param identifiers Identifiers sorted by QString::operator< without duplicates.
+      */
+    void setIdentifiers(const QVector<QString> &identifiers);
+    //! @return All identifiers, including ones that don't match prefix.
+    const QVector<QString>& identifiers() const { return mIdentifiers; }
+
+    //! Sets prefix of identifiers, that are shown as rows. Empty prefix shows all identifiers.
+    void setPrefix(const QString &prefix);
+    const QString& prefix() const { return mPrefix; }
+
+private:
+    //! Finds range [begin, end) of identifiers, that start with @p prefix.
+    void findPrefixRange(const QString &prefix, int &begin, int &end) const;
+
+    //! Removes identifiers [from, to) of mIdentifiers.
+    void removeIdentifiers(int from, int to);
+    //! Inserts sorted @p values before identifier at @p pos.
+    void insertIdentifiers(int pos, const QVector<QString> &values);
+
+private:
+    QVector<QString> mIdentifiers;
+    QString mPrefix;
+    //! Range of mIdentifiers, that is shown as rows.
+    int mBegin;
+    int mEnd;
+};
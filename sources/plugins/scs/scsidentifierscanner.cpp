@@ -0,0 +1,42 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scsidentifierscanner.h"
+#include "scsparserwrapper.h"
+#include "SCsCParser.h"
+
+SCsIdentifierScanner::SCsIdentifierScanner(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SCsIdentifierScanner::~SCsIdentifierScanner()
+{
+}
+
+QStringList SCsIdentifierScanner::supportedFormatsExt() const
+{
+    QStringList res;
+    res << "scs";
+    return res;
+}
+
+IdentifierLocationList SCsIdentifierScanner::scan(const QString &fileName, const QByteArray &data) const
+{
+    QString text = QString::fromUtf8(data);
+
+    SCsParser parser;
+    QSharedPointer<SCsParserTokenArray> tokens = parser.getTokens(text);
+
+    IdentifierLocationList res;
+    SCsParserTokenArray::iterator it;
+    for (it = tokens->begin(); it != tokens->end(); ++it)
+    {
+        if (it->tokenType() == NAME)
+            res.append(IdentifierLocation(it->tokenText(), fileName, it->line(), it->positionInLine() + 1));
+    }
+    return res;
+}
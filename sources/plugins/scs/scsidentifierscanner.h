@@ -0,0 +1,28 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "interfaces/identifierscannerinterface.h"
+
+#include <QObject>
+
+//! Finds identifiers in scs files for project index. Identifiers are NAME tokens of lexer.
+class SCsIdentifierScanner : public QObject,
+                             public IdentifierScannerInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(IdentifierScannerInterface)
+
+public:
+    explicit SCsIdentifierScanner(QObject *parent = 0);
+    virtual ~SCsIdentifierScanner();
+
+    //! @copydoc IdentifierScannerInterface::supportedFormatsExt
+    QStringList supportedFormatsExt() const;
+    //! @copydoc IdentifierScannerInterface::scan
+    IdentifierLocationList scan(const QString &fileName, const QByteArray &data) const;
+};
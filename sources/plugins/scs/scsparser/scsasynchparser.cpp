@@ -6,12 +6,14 @@
 
 #include "scsasynchparser.h"
 #include "scsparserwrapper.h"
+#include "trace.h"
 
 #include <QtCore>
 #include <QtConcurrentRun>
 
 QSharedPointer<SCsParserExceptionArray> parseExceptionsFn(const QString &text)
 {
+    KBE_TRACE_SCOPE("scs", "parse.exceptions");
 	SCsParser psr;
     QSharedPointer<SCsParserExceptionArray> array = psr.getExceptions(text);
 	return array;
@@ -19,6 +21,7 @@ QSharedPointer<SCsParserExceptionArray> parseExceptionsFn(const QString &text)
 
 QSharedPointer<SCsParserIdtfArray> parseIdentifiersFn(const QString &text)
 {
+    KBE_TRACE_SCOPE("scs", "parse.identifiers");
 	SCsParser psr;
 	QSharedPointer<SCsParserIdtfArray> array = psr.getIdentifier(text);
 	return array;
@@ -26,6 +29,7 @@ QSharedPointer<SCsParserIdtfArray> parseIdentifiersFn(const QString &text)
 
 QSharedPointer<SCsParserTokenArray> parseTokensFn(const QString &text)
 {
+    KBE_TRACE_SCOPE("scs", "parse.tokens");
     SCsParser psr;
     QSharedPointer<SCsParserTokenArray> array = psr.getTokens(text);
     return array;
@@ -33,6 +37,7 @@ QSharedPointer<SCsParserTokenArray> parseTokensFn(const QString &text)
 
 QSharedPointer<SCsParserErrorLinesArray> parseErrorLinesFn(const QString &text)
 {
+    KBE_TRACE_SCOPE("scs", "parse.errorLines");
     SCsParser psr;
     QSharedPointer<SCsParserErrorLinesArray> array = psr.getErrorLines(text);
     return array;
@@ -6,10 +6,18 @@
 
 #include "scscparserdefs.h"
 
-_ParserException *SCsCParserHeadException = NULL;
-_LexerException *SCsCLexerHeadException  = NULL;
-ANTLR3_BOOLEAN _ParserNeedReturn = ANTLR3_FALSE;
-ANTLR3_BOOLEAN _ParserNeedRecover = ANTLR3_FALSE;
+// every thread lexes and parses with its own error state, so editor and
+// background workers don't wait for each other
+#if defined(_MSC_VER)
+#define SCS_THREAD_LOCAL __declspec(thread)
+#else
+#define SCS_THREAD_LOCAL __thread
+#endif
+
+SCS_THREAD_LOCAL _ParserException *SCsCParserHeadException = NULL;
+SCS_THREAD_LOCAL _LexerException *SCsCLexerHeadException  = NULL;
+SCS_THREAD_LOCAL ANTLR3_BOOLEAN _ParserNeedReturn = ANTLR3_FALSE;
+SCS_THREAD_LOCAL ANTLR3_BOOLEAN _ParserNeedRecover = ANTLR3_FALSE;
 
 void ParserExceptionHandler(pANTLR3_BASE_RECOGNIZER recognizer,
 	pANTLR3_UINT8 * tokenNames)
@@ -57,10 +57,10 @@ public:
 	SCsParserToken& operator=(const SCsParserToken& copy);
 	virtual ~SCsParserToken();
 
-	inline int tokenType(){ return mTokenType; }
-	inline QString tokenText(){ return mTokenText; }
-	inline int line(){ return mLine; }
-	inline int positionInLine(){ return mPositionInLine; }
+	inline int tokenType() const { return mTokenType; }
+	inline QString tokenText() const { return mTokenText; }
+	inline int line() const { return mLine; }
+	inline int positionInLine() const { return mPositionInLine; }
 
 private:
 	QString mTokenText;
@@ -45,7 +45,6 @@ pANTLR3_INPUT_STREAM SCsParser::createInputStream(const std::string &text) const
 
 QSharedPointer<SCsParserErrorLinesArray> SCsParser::getErrorLines(const QString &text) const
 {
-
 	QSharedPointer<SCsParserErrorLinesArray> errorLines = QSharedPointer<SCsParserErrorLinesArray>(new SCsParserErrorLinesArray());
 
 	pANTLR3_INPUT_STREAM    input;
@@ -120,7 +119,6 @@ QSharedPointer<SCsParserErrorLinesArray> SCsParser::getErrorLines(const QString
 
 QSharedPointer<SCsParserExceptionArray> SCsParser::getExceptions(const QString &text) const
 {
-
 	QSharedPointer<SCsParserExceptionArray> exceptions = QSharedPointer<SCsParserExceptionArray>(new SCsParserExceptionArray());
 
 	pANTLR3_INPUT_STREAM    input;
@@ -191,9 +189,8 @@ QSharedPointer<SCsParserExceptionArray> SCsParser::getExceptions(const QString &
 }
 
 
-QSharedPointer<SCsParserTokenArray> SCsParser::getTokens(const QString &text) const
+QSharedPointer<SCsParserTokenArray> SCsParser::getTokens(const QString &text, bool *hasLexerErrors) const
 {
-
 	QSharedPointer<SCsParserTokenArray> token = QSharedPointer<SCsParserTokenArray>(new SCsParserTokenArray());
 	pANTLR3_INPUT_STREAM    input;
 	pSCsCLexer lxr;
@@ -235,6 +232,9 @@ QSharedPointer<SCsParserTokenArray> SCsParser::getTokens(const QString &text) co
 		token->append(SCsParserToken(tok->getType(tok), QString((char*)tokText->chars), tok->getLine(tok), tok->getCharPositionInLine(tok)));
 	}
 
+	if (hasLexerErrors)
+		*hasLexerErrors = LexerHeadException() != 0;
+
 	freeLexerExceptionList();
 	freeParserExceptionList();
 
@@ -16,6 +16,7 @@
 
 #include <antlr3defs.h>
 
+//! Lexes and parses sc.s-text. Error state is kept per thread, so workers can parse at the same time.
 class SCsParser : public QObject
 {
     Q_OBJECT
@@ -23,7 +24,10 @@ public:
     explicit SCsParser(QObject *parent = 0);
     ~SCsParser();
 	QSharedPointer<SCsParserErrorLinesArray> getErrorLines(const QString &text) const;
-	QSharedPointer<SCsParserTokenArray> getTokens(const QString &text) const;
+	/*! @return All tokens of @p text, including whitespaces and comments.
+	  @param hasLexerErrors If it isn't null, then it's set to true, when some characters aren't recognized.
+	  */
+	QSharedPointer<SCsParserTokenArray> getTokens(const QString &text, bool *hasLexerErrors = 0) const;
 	QSharedPointer<SCsParserIdtfArray> getIdentifier(const QString &text) const;
 	QSharedPointer<SCsParserExceptionArray> getExceptions(const QString &text) const;
 
@@ -0,0 +1,362 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scssyntaxtree.h"
+#include "SCsCParser.h"
+
+using namespace SCsAST;
+
+SCsSyntaxTree::SCsSyntaxTree()
+    : mPos(0)
+    , mLastConsumed(InvalidIndex)
+{
+}
+
+void SCsSyntaxTree::clear()
+{
+    mNodes.clear();
+    mTokens.clear();
+    mPos = 0;
+    mLastConsumed = InvalidIndex;
+}
+
+void SCsSyntaxTree::build(const SCsParserTokenArray &tokens)
+{
+    clear();
+    mTokens = tokens;
+    // usual sentence has about three nodes per four tokens
+    mNodes.reserve(mTokens.size());
+
+    skipComments();
+    const int root = addNode(SYNTAX, InvalidIndex);
+
+    while (mPos < mTokens.size())
+    {
+        if (typeAt(0) == KEYWORD)
+        {
+            consume();
+            continue;
+        }
+
+        const int sentence = addNode(SENTANCE_WITH_SEPARATOR, root);
+
+        if (parseSentence(sentence) && typeAt(0) == SENTSEP)
+        {
+            mNodes[sentence].token = consume();
+            finishNode(sentence);
+            continue;
+        }
+
+        // nodes of wrong sentence are dropped and its tokens are skipped up to separator
+        mNodes.resize(sentence + 1);
+        Node &node = mNodes[sentence];
+        node.firstChild = node.lastChild = InvalidIndex;
+        node.hasException = true;
+
+        while (mPos < mTokens.size() && mTokens.at(mPos).tokenType() != SENTSEP)
+            ++mPos;
+
+        if (mPos < mTokens.size())
+            node.token = consume();
+        else
+            mLastConsumed = mTokens.size() - 1;
+        finishNode(sentence);
+    }
+
+    finishNode(root);
+}
+
+int SCsSyntaxTree::subtreeEnd(int index) const
+{
+    // next sibling of node or of its nearest ancestor follows subtree
+    for (int i = index; i != InvalidIndex; i = mNodes.at(i).parent)
+    {
+        if (mNodes.at(i).nextSibling != InvalidIndex)
+            return mNodes.at(i).nextSibling;
+    }
+    return mNodes.size();
+}
+
+int SCsSyntaxTree::addNode(ASTNodeType type, int parent)
+{
+    Node node;
+    node.type = type;
+    node.parent = parent;
+    node.firstChild = InvalidIndex;
+    node.lastChild = InvalidIndex;
+    node.nextSibling = InvalidIndex;
+    node.firstToken = mPos;
+    node.lastToken = mPos;
+    node.token = mPos;
+    node.hasException = false;
+
+    const int index = mNodes.size();
+    mNodes.append(node);
+
+    if (parent != InvalidIndex)
+    {
+        Node &p = mNodes[parent];
+        if (p.lastChild == InvalidIndex)
+            p.firstChild = index;
+        else
+            mNodes[p.lastChild].nextSibling = index;
+        p.lastChild = index;
+    }
+
+    return index;
+}
+
+void SCsSyntaxTree::finishNode(int index)
+{
+    mNodes[index].lastToken = mLastConsumed;
+}
+
+int SCsSyntaxTree::typeAt(int ahead) const
+{
+    for (int i = mPos; i < mTokens.size(); ++i)
+    {
+        const int type = mTokens.at(i).tokenType();
+        if (type == COMMENT)
+            continue;
+        if (ahead == 0)
+            return type;
+        --ahead;
+    }
+    return InvalidIndex;
+}
+
+int SCsSyntaxTree::consume()
+{
+    Q_ASSERT(mPos < mTokens.size());
+
+    mLastConsumed = mPos++;
+    skipComments();
+    return mLastConsumed;
+}
+
+void SCsSyntaxTree::skipComments()
+{
+    while (mPos < mTokens.size() && mTokens.at(mPos).tokenType() == COMMENT)
+        ++mPos;
+}
+
+bool SCsSyntaxTree::expect(int type)
+{
+    if (typeAt(0) != type)
+        return false;
+
+    consume();
+    return true;
+}
+
+bool SCsSyntaxTree::isSimpleIdtf(int type)
+{
+    return type == NAME || type == URL;
+}
+
+bool SCsSyntaxTree::parseSentence(int parent)
+{
+    if (isSimpleIdtf(typeAt(0)) && typeAt(1) == TRIPLESEP)
+        return parseSentenceLvl1(parent);
+
+    return parseSentenceLvl23456(parent);
+}
+
+bool SCsSyntaxTree::parseSentenceLvl1(int parent)
+{
+    const int node = addNode(SENTENCE_LVL1, parent);
+
+    if (!parseSimpleIdtf(node) || !expect(TRIPLESEP)
+            || !parseSimpleIdtf(node) || !expect(TRIPLESEP)
+            || !parseSimpleIdtf(node))
+        return false;
+
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseSentenceLvl23456(int parent)
+{
+    const int node = addNode(SENTENCE_LVL23456, parent);
+
+    if (!parseIdtf(node) || typeAt(0) != CONNECTORS)
+        return false;
+    mNodes[node].token = consume();
+
+    if (!parseAttributesList(node) || !parseObjectList(node))
+        return false;
+
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseAttributesList(int parent)
+{
+    const int node = addNode(ATRIBUTES_LIST, parent);
+
+    while (isSimpleIdtf(typeAt(0)) && typeAt(1) == ATTRSEP)
+    {
+        parseSimpleIdtf(node);
+        consume();
+    }
+
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseObjectList(int parent)
+{
+    const int node = addNode(OBJECT_LIST, parent);
+
+    if (!parseIdtfWithInternal(node))
+        return false;
+
+    while (typeAt(0) == OBJSEP)
+    {
+        consume();
+        if (!parseIdtfWithInternal(node))
+            return false;
+    }
+
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseIdtfWithInternal(int parent)
+{
+    const int node = addNode(IDTF_WITH_INT, parent);
+
+    if (!parseIdtf(node))
+        return false;
+
+    if (typeAt(0) == LPAR_INT && !parseInternal(node))
+        return false;
+
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseInternal(int parent)
+{
+    const int node = addNode(INTERNAL, parent);
+    consume();
+
+    do
+    {
+        const int sentence = addNode(INTERNAL_SENTENCE, node);
+        if (typeAt(0) != CONNECTORS)
+            return false;
+        mNodes[sentence].token = consume();
+
+        if (!parseAttributesList(sentence) || !parseObjectList(sentence))
+            return false;
+        finishNode(sentence);
+
+        if (!expect(SENTSEP))
+            return false;
+    }
+    while (typeAt(0) == CONNECTORS);
+
+    if (!expect(RPAR_INT))
+        return false;
+
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseIdtf(int parent)
+{
+    switch (typeAt(0))
+    {
+    case NAME:
+    case URL:
+        return parseSimpleIdtf(parent);
+
+    case CONTENT:
+    {
+        const int node = addNode(ANY_IDENTIFIER, parent);
+        consume();
+        finishNode(node);
+        return true;
+    }
+
+    case ALIASNONAME:
+    {
+        const int node = addNode(ALIAS, parent);
+        consume();
+        finishNode(node);
+        return true;
+    }
+
+    case LPAR:
+        return parseTriple(parent);
+
+    case LPAR_SET:
+        return parseSet(parent, SET_IDENTIFIER, RPAR_SET);
+
+    case LPAR_OSET:
+        return parseSet(parent, OSET_IDENTIFIER, RPAR_OSET);
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+bool SCsSyntaxTree::parseSimpleIdtf(int parent)
+{
+    if (!isSimpleIdtf(typeAt(0)))
+        return false;
+
+    const int node = addNode(SIMPLE_IDENTIFIER, parent);
+    consume();
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseTriple(int parent)
+{
+    const int node = addNode(TRIPLE, parent);
+    consume();
+
+    if (!parseIdtf(node))
+        return false;
+
+    // grammar names connector of triple as CONTENT, but lexer gives CONNECTORS for it
+    const int type = typeAt(0);
+    if (type != CONNECTORS && type != CONTENT)
+        return false;
+    mNodes[node].token = consume();
+
+    if (!parseIdtf(node) || !expect(RPAR))
+        return false;
+
+    finishNode(node);
+    return true;
+}
+
+bool SCsSyntaxTree::parseSet(int parent, ASTNodeType type, int closeToken)
+{
+    const int node = addNode(type, parent);
+    consume();
+
+    if (!parseAttributesList(node) || !parseIdtfWithInternal(node))
+        return false;
+
+    while (typeAt(0) == OBJSEP)
+    {
+        consume();
+        if (!parseAttributesList(node) || !parseIdtfWithInternal(node))
+            return false;
+    }
+
+    if (!expect(closeToken))
+        return false;
+
+    finishNode(node);
+    return true;
+}
@@ -0,0 +1,95 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "scsparserexception.h"
+#include "scsastnodes.h"
+
+#include <QVector>
+
+/*! Compact syntax tree of sc.s-text. It has the same node types as SCsAST classes, but all
+ * nodes are kept in one vector, that is used as arena: nodes are linked by indices and
+ * refer to tokens by indices, so tree of whole document takes a few allocations.
+ *
+ * Nodes are stored in preorder, so subtree of any node is continuous range of vector.
+ */
+class SCsSyntaxTree
+{
+public:
+    struct Node
+    {
+        SCsAST::ASTNodeType type;
+        int parent;
+        int firstChild;
+        int lastChild;
+        int nextSibling;
+        //! Tokens of node are [firstToken, lastToken], they include comments inside of node.
+        int firstToken;
+        int lastToken;
+        /*! Main token of node: name of SIMPLE_IDENTIFIER, content of ANY_IDENTIFIER,
+          connector of sentence, separator of SENTANCE_WITH_SEPARATOR. Otherwise it's first token.
+          */
+        int token;
+        //! Sentence isn't recognized, it doesn't have children and ends at sentence separator.
+        bool hasException;
+    };
+
+    static const int InvalidIndex = -1;
+
+    SCsSyntaxTree();
+
+    /*! Builds tree of @p tokens, that must not contain whitespaces. Comments are skipped.
+      Root node is SYNTAX, its children are SENTANCE_WITH_SEPARATOR nodes.
+      */
+    void build(const SCsParserTokenArray &tokens);
+    void clear();
+
+    //! @return Index of root node, or InvalidIndex if tree isn't built.
+    int root() const { return mNodes.isEmpty() ? InvalidIndex : 0; }
+    int nodeCount() const { return mNodes.size(); }
+    const Node& node(int index) const { return mNodes.at(index); }
+
+    const SCsParserTokenArray& tokens() const { return mTokens; }
+    const SCsParserToken& token(int index) const { return mTokens.at(index); }
+
+    //! @return Index of node after subtree of @p index.
+    int subtreeEnd(int index) const;
+
+private:
+    int addNode(SCsAST::ASTNodeType type, int parent);
+    //! Sets last token of node to last consumed token.
+    void finishNode(int index);
+
+    //! @return Type of token @p ahead tokens after current one, comments are skipped.
+    int typeAt(int ahead) const;
+    //! Consumes current token and following comments. @return Index of consumed token.
+    int consume();
+    void skipComments();
+    //! Consumes token of @p type, if it's current one.
+    bool expect(int type);
+
+    bool parseSentence(int parent);
+    bool parseSentenceLvl1(int parent);
+    bool parseSentenceLvl23456(int parent);
+    bool parseAttributesList(int parent);
+    bool parseObjectList(int parent);
+    bool parseIdtfWithInternal(int parent);
+    bool parseInternal(int parent);
+    bool parseIdtf(int parent);
+    bool parseSimpleIdtf(int parent);
+    bool parseTriple(int parent);
+    bool parseSet(int parent, SCsAST::ASTNodeType type, int closeToken);
+
+    static bool isSimpleIdtf(int type);
+
+private:
+    QVector<Node> mNodes;
+    SCsParserTokenArray mTokens;
+    //! Current token.
+    int mPos;
+    int mLastConsumed;
+};
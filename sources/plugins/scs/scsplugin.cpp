@@ -6,6 +6,8 @@
 
 #include "scsplugin.h"
 #include "scswindow.h"
+#include "scsidentifierscanner.h"
+#include "scsdocumentsearcher.h"
 
 #include <QDir>
 
@@ -38,6 +40,8 @@ const QList<QObject*>& SCsPlugin::interfaces() const
 void SCsPlugin::initialize()
 {
     mInterfaces.push_back(new SCsWindowFactory(this));
+    mInterfaces.push_back(new SCsIdentifierScanner(this));
+    mInterfaces.push_back(new SCsDocumentSearcher(this));
 }
 
 void SCsPlugin::shutdown()
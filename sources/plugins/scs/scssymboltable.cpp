@@ -0,0 +1,507 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "scssymboltable.h"
+#include "scsparserwrapper.h"
+#include "scssyntaxtree.h"
+#include "SCsCParser.h"
+#include "trace.h"
+
+#include <QTextDocument>
+#include <QTextBlock>
+
+#include <algorithm>
+
+//! Removes one occurrence of @p value from @p vector.
+template <typename T>
+static void removeOnce(QVector<T> &vector, const T &value)
+{
+    const int index = vector.indexOf(value);
+    if (index >= 0)
+        vector.remove(index);
+}
+
+//! @return Line of last character of @p token.
+static int lastLineOf(const SCsParserToken &token)
+{
+    const QString text = token.tokenText();
+    // single line comment ends with line break
+    int breaks = text.count(QLatin1Char('\n'));
+    if (text.endsWith(QLatin1Char('\n')))
+        --breaks;
+    return token.line() + qMax(breaks, 0);
+}
+
+bool SCsSymbolTable::Entry::isEmpty() const
+{
+    return definitions.isEmpty() && references.isEmpty() && aliases.isEmpty() && contents.isEmpty();
+}
+
+SCsSymbolTable::SCsSymbolTable()
+{
+}
+
+SCsSymbolTable::~SCsSymbolTable()
+{
+    clear();
+}
+
+void SCsSymbolTable::clear()
+{
+    qDeleteAll(mChunks);
+    mChunks.clear();
+    mEntries.clear();
+}
+
+void SCsSymbolTable::build(const QString &text)
+{
+    KBE_TRACE_SCOPE("scs", "symbols.build");
+
+    clear();
+
+    bool complete = true;
+    mChunks = parseChunks(text, 1, complete);
+    foreach (const Chunk *chunk, mChunks)
+        addChunk(chunk);
+}
+
+void SCsSymbolTable::update(const QTextDocument *document, int fromLine, int removedLines, int addedLines)
+{
+    if (mChunks.isEmpty())
+    {
+        build(document->toPlainText());
+        return;
+    }
+
+    KBE_TRACE_SCOPE("scs", "symbols.update");
+
+    const int delta = addedLines - removedLines;
+
+    // changed lines in old text
+    int startLine = fromLine;
+    int endLine = fromLine + removedLines;
+
+    // chunks [first, last] intersect changed lines, they are parsed again
+    int first = std::lower_bound(mChunks.constBegin(), mChunks.constEnd(), startLine, endsBefore) - mChunks.constBegin();
+    int last = std::upper_bound(mChunks.constBegin(), mChunks.constEnd(), endLine, startsAfter) - mChunks.constBegin() - 1;
+
+    if (first <= last)
+    {
+        startLine = qMin(startLine, mChunks.at(first)->firstLine);
+        endLine = qMax(endLine, mChunks.at(last)->lastLine);
+    }
+
+    // text is lexed by whole lines, so chunks at the same lines are parsed too
+    while (first > 0 && mChunks.at(first - 1)->lastLine >= startLine)
+    {
+        --first;
+        startLine = qMin(startLine, mChunks.at(first)->firstLine);
+    }
+    while (last + 1 < mChunks.size() && mChunks.at(last + 1)->firstLine <= endLine)
+    {
+        ++last;
+        endLine = qMax(endLine, mChunks.at(last)->lastLine);
+    }
+
+    QList<Chunk*> chunks;
+    int extension = 1;
+    forever
+    {
+        // lines after changed ones are moved by delta
+        bool complete = true;
+        chunks = parseChunks(linesOf(document, startLine, endLine + delta), startLine, complete);
+        if (complete || last + 1 >= mChunks.size())
+            break;
+
+        // sentence or comment isn't finished, so it goes on in following chunks
+        qDeleteAll(chunks);
+        last = qMin(last + extension, mChunks.size() - 1);
+        endLine = qMax(endLine, mChunks.at(last)->lastLine);
+        while (last + 1 < mChunks.size() && mChunks.at(last + 1)->firstLine <= endLine)
+            ++last;
+        endLine = qMax(endLine, mChunks.at(last)->lastLine);
+        extension *= 2;
+    }
+
+    for (int i = first; i <= last; ++i)
+    {
+        removeChunk(mChunks.at(i));
+        delete mChunks.at(i);
+    }
+
+    QList<Chunk*> tail = mChunks.mid(last + 1);
+    foreach (Chunk *chunk, tail)
+    {
+        chunk->firstLine += delta;
+        chunk->lastLine += delta;
+    }
+
+    mChunks = mChunks.mid(0, first) + chunks + tail;
+
+    foreach (const Chunk *chunk, chunks)
+        addChunk(chunk);
+}
+
+bool SCsSymbolTable::contains(const QString &identifier) const
+{
+    return mEntries.contains(identifier);
+}
+
+bool SCsSymbolTable::isDefined(const QString &identifier) const
+{
+    QHash<QString, Entry>::const_iterator it = mEntries.constFind(identifier);
+    return it != mEntries.constEnd() && !it->definitions.isEmpty();
+}
+
+SCsSymbolList SCsSymbolTable::definitions(const QString &identifier) const
+{
+    QHash<QString, Entry>::const_iterator it = mEntries.constFind(identifier);
+    if (it == mEntries.constEnd())
+        return SCsSymbolList();
+
+    return collect(it->definitions, identifier, SCsSymbol::Definition);
+}
+
+SCsSymbolList SCsSymbolTable::references(const QString &identifier) const
+{
+    QHash<QString, Entry>::const_iterator it = mEntries.constFind(identifier);
+    if (it == mEntries.constEnd())
+        return SCsSymbolList();
+
+    return collect(it->references, identifier, SCsSymbol::Reference);
+}
+
+SCsSymbolList SCsSymbolTable::symbols(const QString &identifier) const
+{
+    SCsSymbolList res = definitions(identifier) + references(identifier);
+    std::sort(res.begin(), res.end(), positionLess);
+    return res;
+}
+
+QString SCsSymbolTable::alias(const QString &identifier) const
+{
+    QHash<QString, Entry>::const_iterator it = mEntries.constFind(identifier);
+    if (it == mEntries.constEnd())
+        return QString();
+
+    // the first assignment in document is used
+    const Chunk *found = 0;
+    foreach (const Chunk *chunk, it->aliases)
+    {
+        if (!found || chunk->firstLine < found->firstLine)
+            found = chunk;
+    }
+
+    if (found)
+    {
+        for (int i = 0; i < found->aliases.size(); ++i)
+        {
+            if (found->aliases.at(i).first == identifier)
+                return found->aliases.at(i).second;
+        }
+    }
+    return QString();
+}
+
+QString SCsSymbolTable::content(const QString &identifier) const
+{
+    QHash<QString, Entry>::const_iterator it = mEntries.constFind(identifier);
+    if (it == mEntries.constEnd())
+        return QString();
+
+    const Chunk *found = 0;
+    foreach (const Chunk *chunk, it->contents)
+    {
+        if (!found || chunk->firstLine < found->firstLine)
+            found = chunk;
+    }
+
+    if (found)
+    {
+        for (int i = 0; i < found->contents.size(); ++i)
+        {
+            if (found->contents.at(i).first == identifier)
+                return found->contents.at(i).second;
+        }
+    }
+    return QString();
+}
+
+bool SCsSymbolTable::symbolAt(int line, int column, SCsSymbol &symbol) const
+{
+    // chunks before found one start at line or earlier, the ones, that reach line, are checked
+    QList<Chunk*>::const_iterator it = std::upper_bound(mChunks.constBegin(), mChunks.constEnd(), line, startsAfter);
+    while (it != mChunks.constBegin())
+    {
+        --it;
+        const Chunk *chunk = *it;
+        if (chunk->lastLine < line)
+            break;
+
+        foreach (const SCsSymbol &s, chunk->symbols)
+        {
+            if (s.line + chunk->firstLine == line && column >= s.column
+                    && column <= s.column + s.identifier.length())
+            {
+                symbol = s;
+                symbol.line = line;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+SCsSymbolList SCsSymbolTable::undefinedSymbols() const
+{
+    SCsSymbolList res;
+
+    QHash<QString, Entry>::const_iterator it;
+    for (it = mEntries.constBegin(); it != mEntries.constEnd(); ++it)
+    {
+        if (!it->definitions.isEmpty() || it->references.isEmpty())
+            continue;
+
+        SCsSymbolList refs = collect(it->references, it.key(), SCsSymbol::Reference);
+        if (!refs.isEmpty())
+            res.append(refs.first());
+    }
+
+    std::sort(res.begin(), res.end(), positionLess);
+    return res;
+}
+
+QList<SCsSymbolTable::Chunk*> SCsSymbolTable::parseChunks(const QString &text, int firstLine, bool &complete) const
+{
+    bool hasLexerErrors = false;
+    SCsParser parser;
+    QSharedPointer<SCsParserTokenArray> allTokens = parser.getTokens(text, &hasLexerErrors);
+
+    // parser doesn't need whitespaces, lines are moved to position of text in document
+    SCsParserTokenArray tokens;
+    tokens.reserve(allTokens->size());
+    SCsParserTokenArray::const_iterator it;
+    for (it = allTokens->constBegin(); it != allTokens->constEnd(); ++it)
+    {
+        if (it->tokenType() == WS || it->tokenType() == (int)ANTLR3_TOKEN_EOF)
+            continue;
+        tokens.append(SCsParserToken(it->tokenType(), it->tokenText(), it->line() + firstLine - 1, it->positionInLine()));
+    }
+
+    SCsSyntaxTree tree;
+    tree.build(tokens);
+
+    QList<Chunk*> chunks;
+    bool lastClosed = true;
+    int sentence = tree.node(tree.root()).firstChild;
+    int i = 0;
+    while (i < tokens.size())
+    {
+        Chunk *chunk = new Chunk();
+        chunk->firstLine = tokens.at(i).line();
+
+        int lastToken = i;
+        if (sentence != SCsSyntaxTree::InvalidIndex && tree.node(sentence).firstToken == i)
+        {
+            lastToken = tree.node(sentence).lastToken;
+            lastClosed = tokens.at(lastToken).tokenType() == SENTSEP;
+            fillChunk(chunk, tree, sentence);
+            sentence = tree.node(sentence).nextSibling;
+        }
+        else
+        {
+            // comments and keywords between sentences
+            const SCsParserToken &token = tokens.at(i);
+            lastClosed = token.tokenType() != COMMENT
+                    || token.tokenText().startsWith("//") || token.tokenText().endsWith("*/");
+        }
+
+        chunk->lastLine = lastLineOf(tokens.at(lastToken));
+        chunks.append(chunk);
+        i = lastToken + 1;
+    }
+
+    complete = !hasLexerErrors && lastClosed;
+    return chunks;
+}
+
+void SCsSymbolTable::fillChunk(Chunk *chunk, const SCsSyntaxTree &tree, int sentence) const
+{
+    using namespace SCsAST;
+
+    const SCsSyntaxTree::Node &sentenceNode = tree.node(sentence);
+    if (sentenceNode.hasException)
+    {
+        // identifiers of sentence, that is being typed, are still found as references
+        for (int i = sentenceNode.firstToken; i <= sentenceNode.lastToken; ++i)
+        {
+            const SCsParserToken &token = tree.token(i);
+            if (token.tokenType() != NAME)
+                continue;
+
+            SCsSymbol symbol;
+            symbol.identifier = token.tokenText();
+            symbol.line = token.line() - chunk->firstLine;
+            symbol.column = token.positionInLine();
+            symbol.kind = SCsSymbol::Reference;
+            chunk->symbols.append(symbol);
+        }
+        return;
+    }
+
+    const int end = tree.subtreeEnd(sentence);
+    for (int i = sentence + 1; i < end; ++i)
+    {
+        const SCsSyntaxTree::Node &node = tree.node(i);
+
+        if (node.type == SIMPLE_IDENTIFIER && tree.token(node.token).tokenType() == NAME)
+        {
+            const SCsSyntaxTree::Node &parent = tree.node(node.parent);
+            const bool isSubject = (parent.type == SENTENCE_LVL1 || parent.type == SENTENCE_LVL23456)
+                    && parent.firstChild == i;
+
+            const SCsParserToken &token = tree.token(node.token);
+            SCsSymbol symbol;
+            symbol.identifier = token.tokenText();
+            symbol.line = token.line() - chunk->firstLine;
+            symbol.column = token.positionInLine();
+            symbol.kind = isSubject ? SCsSymbol::Definition : SCsSymbol::Reference;
+            chunk->symbols.append(symbol);
+        }
+        else if (node.type == SENTENCE_LVL23456 && tree.token(node.token).tokenText() == "=")
+        {
+            // children are subject, attributes and objects
+            const SCsSyntaxTree::Node &subject = tree.node(node.firstChild);
+            if (subject.type != SIMPLE_IDENTIFIER || tree.token(subject.token).tokenType() != NAME)
+                continue;
+
+            const SCsSyntaxTree::Node &attributes = tree.node(subject.nextSibling);
+            if (attributes.firstChild != SCsSyntaxTree::InvalidIndex)
+                continue;
+
+            const QString name = tree.token(subject.token).tokenText();
+            const SCsSyntaxTree::Node &objects = tree.node(attributes.nextSibling);
+            for (int obj = objects.firstChild; obj != SCsSyntaxTree::InvalidIndex; obj = tree.node(obj).nextSibling)
+            {
+                const SCsSyntaxTree::Node &idtf = tree.node(tree.node(obj).firstChild);
+                const SCsParserToken &token = tree.token(idtf.token);
+
+                if (idtf.type == SIMPLE_IDENTIFIER && token.tokenType() == NAME)
+                    chunk->aliases.append(qMakePair(name, token.tokenText()));
+                else if (idtf.type == ANY_IDENTIFIER)
+                    chunk->contents.append(qMakePair(name, token.tokenText().mid(1, token.tokenText().size() - 2)));
+            }
+        }
+    }
+}
+
+void SCsSymbolTable::addChunk(const Chunk *chunk)
+{
+    foreach (const SCsSymbol &symbol, chunk->symbols)
+    {
+        Entry &entry = mEntries[symbol.identifier];
+        if (symbol.kind == SCsSymbol::Definition)
+            entry.definitions.append(chunk);
+        else
+            entry.references.append(chunk);
+    }
+
+    for (int i = 0; i < chunk->aliases.size(); ++i)
+        mEntries[chunk->aliases.at(i).first].aliases.append(chunk);
+    for (int i = 0; i < chunk->contents.size(); ++i)
+        mEntries[chunk->contents.at(i).first].contents.append(chunk);
+}
+
+void SCsSymbolTable::removeChunk(const Chunk *chunk)
+{
+    QStringList identifiers;
+
+    foreach (const SCsSymbol &symbol, chunk->symbols)
+    {
+        Entry &entry = mEntries[symbol.identifier];
+        if (symbol.kind == SCsSymbol::Definition)
+            removeOnce(entry.definitions, chunk);
+        else
+            removeOnce(entry.references, chunk);
+        identifiers.append(symbol.identifier);
+    }
+
+    for (int i = 0; i < chunk->aliases.size(); ++i)
+    {
+        removeOnce(mEntries[chunk->aliases.at(i).first].aliases, chunk);
+        identifiers.append(chunk->aliases.at(i).first);
+    }
+    for (int i = 0; i < chunk->contents.size(); ++i)
+    {
+        removeOnce(mEntries[chunk->contents.at(i).first].contents, chunk);
+        identifiers.append(chunk->contents.at(i).first);
+    }
+
+    foreach (const QString &identifier, identifiers)
+    {
+        QHash<QString, Entry>::iterator it = mEntries.find(identifier);
+        if (it != mEntries.end() && it->isEmpty())
+            mEntries.erase(it);
+    }
+}
+
+SCsSymbolList SCsSymbolTable::collect(const QVector<const Chunk*> &chunks, const QString &identifier,
+                                      SCsSymbol::Kind kind) const
+{
+    SCsSymbolList res;
+    for (int i = 0; i < chunks.size(); ++i)
+    {
+        // chunk is repeated for every occurrence, repeats follow each other
+        if (i > 0 && chunks.at(i) == chunks.at(i - 1))
+            continue;
+
+        const Chunk *chunk = chunks.at(i);
+        foreach (const SCsSymbol &symbol, chunk->symbols)
+        {
+            if (symbol.kind != kind || symbol.identifier != identifier)
+                continue;
+
+            SCsSymbol s = symbol;
+            s.line += chunk->firstLine;
+            res.append(s);
+        }
+    }
+
+    std::sort(res.begin(), res.end(), positionLess);
+    return res;
+}
+
+QString SCsSymbolTable::linesOf(const QTextDocument *document, int firstLine, int lastLine)
+{
+    // blocks are found by number without reading text before them
+    QString res;
+    QTextBlock block = document->findBlockByNumber(firstLine - 1);
+    for (int line = firstLine; line <= lastLine && block.isValid(); ++line)
+    {
+        res += block.text();
+        block = block.next();
+        if (block.isValid())
+            res += QLatin1Char('\n');
+    }
+    return res;
+}
+
+bool SCsSymbolTable::endsBefore(const Chunk *chunk, int line)
+{
+    return chunk->lastLine < line;
+}
+
+bool SCsSymbolTable::startsAfter(int line, const Chunk *chunk)
+{
+    return line < chunk->firstLine;
+}
+
+bool SCsSymbolTable::positionLess(const SCsSymbol &left, const SCsSymbol &right)
+{
+    if (left.line != right.line)
+        return left.line < right.line;
+    return left.column < right.column;
+}
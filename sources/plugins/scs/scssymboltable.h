@@ -0,0 +1,135 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+
+class SCsSyntaxTree;
+class QTextDocument;
+
+//! Occurrence of identifier in sc.s-text.
+struct SCsSymbol
+{
+    enum Kind
+    {
+        //! Identifier is subject of sentence.
+        Definition,
+        Reference
+    };
+
+    QString identifier;
+    //! Line number starting from 1.
+    int line;
+    //! Position in line as lexer counts it, starting from 0.
+    int column;
+    Kind kind;
+};
+
+typedef QList<SCsSymbol> SCsSymbolList;
+
+/*! Symbol table of one sc.s-document: definitions and references of identifiers, aliases
+ * (@code a = b;; @endcode) and contents (@code a = [text];; @endcode).
+ *
+ * Table is split into sentences, so after edit only sentences at changed lines are read from
+ * document, lexed and parsed again, following sentences are just moved. Identifiers are indexed by hash,
+ * so lookups don't depend on document size, and symbol at position is found by binary search.
+ */
+class SCsSymbolTable
+{
+public:
+    SCsSymbolTable();
+    ~SCsSymbolTable();
+
+    void clear();
+    //! Builds table of whole @p text.
+    void build(const QString &text);
+    /*! Updates table after edit of @p document. Lines [fromLine, fromLine + removedLines] of old text
+      are replaced by lines [fromLine, fromLine + addedLines] of document.
+      @param fromLine Number of first changed line starting from 1.
+      @param removedLines Number of line breaks, that are removed.
+      @param addedLines Number of line breaks, that are inserted.
+      */
+    void update(const QTextDocument *document, int fromLine, int removedLines, int addedLines);
+
+    bool contains(const QString &identifier) const;
+    //! @return True, if @p identifier is subject of some sentence.
+    bool isDefined(const QString &identifier) const;
+
+    //! @return Definitions of @p identifier sorted by position.
+    SCsSymbolList definitions(const QString &identifier) const;
+    //! @return References of @p identifier sorted by position.
+    SCsSymbolList references(const QString &identifier) const;
+    //! @return Definitions and references of @p identifier sorted by position.
+    SCsSymbolList symbols(const QString &identifier) const;
+
+    //! @return Identifier, that is assigned to @p identifier by "=" connector, or empty string.
+    QString alias(const QString &identifier) const;
+    //! @return Content, that is assigned to @p identifier by "=" connector, or empty string.
+    QString content(const QString &identifier) const;
+
+    /*! Finds symbol at position. Position right after identifier belongs to it too.
+      @return True, if symbol is found.
+      */
+    bool symbolAt(int line, int column, SCsSymbol &symbol) const;
+
+    //! @return First references of identifiers, that don't have definitions.
+    SCsSymbolList undefinedSymbols() const;
+
+private:
+    //! Symbols of one sentence, or comment and keyword between sentences.
+    struct Chunk
+    {
+        int firstLine;
+        int lastLine;
+        //! Symbols, their lines are relative to firstLine.
+        QVector<SCsSymbol> symbols;
+        QVector< QPair<QString, QString> > aliases;
+        QVector< QPair<QString, QString> > contents;
+    };
+
+    //! Chunks, that contain identifier. Chunk is repeated for every occurrence.
+    struct Entry
+    {
+        QVector<const Chunk*> definitions;
+        QVector<const Chunk*> references;
+        QVector<const Chunk*> aliases;
+        QVector<const Chunk*> contents;
+
+        bool isEmpty() const;
+    };
+
+    /*! Lexes and parses @p text, that starts at @p firstLine.
+      @param complete Set to false, if last sentence isn't finished or some characters aren't recognized,
+      so text can't be parsed without following lines.
+      */
+    QList<Chunk*> parseChunks(const QString &text, int firstLine, bool &complete) const;
+    void fillChunk(Chunk *chunk, const SCsSyntaxTree &tree, int sentence) const;
+
+    void addChunk(const Chunk *chunk);
+    void removeChunk(const Chunk *chunk);
+
+    //! @return Symbols of @p identifier with @p kind from @p chunks, lines are absolute.
+    SCsSymbolList collect(const QVector<const Chunk*> &chunks, const QString &identifier, SCsSymbol::Kind kind) const;
+
+    //! @return Text of lines [firstLine, lastLine] of @p document, with line break after last one.
+    static QString linesOf(const QTextDocument *document, int firstLine, int lastLine);
+
+    //! Comparators for binary search of chunks by lines.
+    static bool endsBefore(const Chunk *chunk, int line);
+    static bool startsAfter(int line, const Chunk *chunk);
+    static bool positionLess(const SCsSymbol &left, const SCsSymbol &right);
+
+private:
+    //! Chunks in document order.
+    QList<Chunk*> mChunks;
+    QHash<QString, Entry> mEntries;
+};
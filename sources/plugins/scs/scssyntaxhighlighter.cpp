@@ -5,15 +5,69 @@
  */
 
 #include "scssyntaxhighlighter.h"
+#include "trace.h"
+
+#include <QPlainTextEdit>
+#include <QScrollBar>
+#include <QTextDocument>
+#include <QTextBlock>
 
 SCsSyntaxHighlighter::SCsSyntaxHighlighter(QTextDocument *parent, QList<SCsAbstractHighlightingRule*> highlightingRules)
     : QSyntaxHighlighter(parent)
+    , mEditor(0)
+    , mIncomingState(-1)
+    , mScanState(-1)
+    , mScanning(false)
+    , mDeferred(false)
+    , mHasPending(false)
+    , mBudget(0)
+    , mInRequest(false)
+    , mNextPending(0)
 {
     mHighlightingRules = highlightingRules;
+    foreach (SCsAbstractHighlightingRule* rule, mHighlightingRules)
+    {
+        if (rule->affectsBlockState())
+            mStateRules.append(rule);
+    }
+
+    mCheckpoints.append(-1);
+
+    mVisibleTimer.setSingleShot(true);
+    mVisibleTimer.setInterval(0);
+    connect(&mVisibleTimer, SIGNAL(timeout()), this, SLOT(highlightVisibleBlocks()));
+
+    mIdleTimer.setSingleShot(true);
+    mIdleTimer.setInterval(0);
+    connect(&mIdleTimer, SIGNAL(timeout()), this, SLOT(highlightNextSlice()));
+
+    connect(parent, SIGNAL(contentsChange(int,int,int)), this, SLOT(documentContentsChanged(int,int,int)));
 }
 
 void SCsSyntaxHighlighter::highlightBlock(const QString &text)
 {
+    if (mDeferred)
+    {
+        setCurrentBlockState(PendingState);
+        return;
+    }
+
+    // pending block keeps its state, so highlighting isn't propagated further
+    if (currentBlockState() == PendingState)
+    {
+        if (mBudget <= 0)
+            return;
+        --mBudget;
+    }
+
+    const QTextBlock block = currentBlock();
+    const int incomingState = stateBefore(block);
+    saveCheckpoint(block.blockNumber(), incomingState);
+
+    // state left from previous highlighting must not affect rules
+    mIncomingState = incomingState;
+    setCurrentBlockState(-1);
+
     foreach (SCsAbstractHighlightingRule* rule, mHighlightingRules)
     {
         rule->assignFormat(this, text);
@@ -22,21 +76,170 @@ void SCsSyntaxHighlighter::highlightBlock(const QString &text)
 
 void SCsSyntaxHighlighter::setFormating(int index, int length, QTextCharFormat format)
 {
+    if (mScanning)
+        return;
+
     setFormat(index, length, format);
 }
 
 void SCsSyntaxHighlighter::setCurBlockState(int state)
 {
-    setCurrentBlockState(state);
+    if (mScanning)
+        mScanState = state;
+    else
+        setCurrentBlockState(state);
 }
 
 int SCsSyntaxHighlighter::prevBlockState()
 {
-    return previousBlockState();
+    return mIncomingState;
 }
 
 
 int SCsSyntaxHighlighter::curBlockState()
 {
-	return currentBlockState();
+	return mScanning ? mScanState : currentBlockState();
+}
+
+void SCsSyntaxHighlighter::setEditor(QPlainTextEdit *editor)
+{
+    if (mEditor)
+        disconnect(mEditor->verticalScrollBar(), 0, this, 0);
+
+    mEditor = editor;
+
+    if (mEditor)
+        connect(mEditor->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(scheduleVisibleBlocks()));
+}
+
+void SCsSyntaxHighlighter::deferHighlighting()
+{
+    mDeferred = true;
+}
+
+void SCsSyntaxHighlighter::resumeHighlighting()
+{
+    mDeferred = false;
+    mHasPending = true;
+    mNextPending = 0;
+    mCheckpoints.resize(1);
+
+    // editor may be not laid out yet, so visible blocks are checked again later
+    highlightVisibleBlocks();
+    mVisibleTimer.start();
+    mIdleTimer.start();
+}
+
+void SCsSyntaxHighlighter::highlightVisibleBlocks()
+{
+    if (!mHasPending || !mEditor)
+        return;
+
+    QTextBlock block = mEditor->firstVisibleBlock();
+    const int last = mEditor->cursorForPosition(QPoint(0, mEditor->viewport()->height())).block().blockNumber();
+
+    for (; block.isValid() && block.blockNumber() <= last; block = block.next())
+    {
+        if (block.userState() == PendingState)
+            highlightPending(block, last - block.blockNumber() + 1);
+    }
+}
+
+void SCsSyntaxHighlighter::highlightNextSlice()
+{
+    KBE_TRACE_SCOPE("scs", "highlight.slice");
+
+    QTextBlock block = document()->findBlockByNumber(mNextPending);
+    while (block.isValid() && block.userState() != PendingState)
+        block = block.next();
+
+    if (!block.isValid())
+    {
+        mHasPending = false;
+        return;
+    }
+
+    mNextPending = block.blockNumber();
+    highlightPending(block, IdleSliceBlocks);
+    mIdleTimer.start();
+}
+
+void SCsSyntaxHighlighter::scheduleVisibleBlocks()
+{
+    if (mHasPending)
+        mVisibleTimer.start();
+}
+
+void SCsSyntaxHighlighter::documentContentsChanged(int position, int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(charsRemoved);
+    Q_UNUSED(charsAdded);
+
+    // formats, applied by own requests, don't change states
+    if (mInRequest || mDeferred)
+        return;
+
+    const int blockNumber = document()->findBlock(position).blockNumber();
+    if (blockNumber < 0)
+        return;
+
+    mCheckpoints.resize(qMax(1, qMin(mCheckpoints.size(), blockNumber / CheckpointInterval + 1)));
+
+    if (mHasPending)
+    {
+        mNextPending = qMin(mNextPending, blockNumber);
+        mIdleTimer.start();
+    }
+}
+
+int SCsSyntaxHighlighter::stateBefore(const QTextBlock &block)
+{
+    const QTextBlock prev = block.previous();
+    if (!prev.isValid())
+        return -1;
+    if (prev.userState() != PendingState)
+        return prev.userState();
+
+    // blocks above aren't highlighted, so state is scanned from nearest checkpoint
+    const int number = block.blockNumber();
+    const int index = qMin(number / CheckpointInterval, mCheckpoints.size() - 1);
+
+    int state = mCheckpoints.at(index);
+    for (QTextBlock b = document()->findBlockByNumber(index * CheckpointInterval); b != block; )
+    {
+        state = scanState(b.text(), state);
+        b = b.next();
+        saveCheckpoint(b.blockNumber(), state);
+    }
+    return state;
+}
+
+int SCsSyntaxHighlighter::scanState(const QString &text, int incomingState)
+{
+    mScanning = true;
+    mIncomingState = incomingState;
+    mScanState = -1;
+
+    foreach (SCsAbstractHighlightingRule* rule, mStateRules)
+        rule->assignFormat(this, text);
+
+    mScanning = false;
+    return mScanState;
+}
+
+void SCsSyntaxHighlighter::saveCheckpoint(int blockNumber, int incomingState)
+{
+    if (blockNumber % CheckpointInterval == 0 && blockNumber / CheckpointInterval == mCheckpoints.size())
+        mCheckpoints.append(incomingState);
+}
+
+void SCsSyntaxHighlighter::highlightPending(const QTextBlock &block, int budget)
+{
+    // rehighlightBlock goes on to next blocks while their states change,
+    // pending blocks over budget keep their state and stop it
+    mInRequest = true;
+    mBudget = budget;
+    rehighlightBlock(block);
+    mBudget = 0;
+    mInRequest = false;
 }
@@ -9,14 +9,27 @@
 #include "scsabstracthighlightingrule.h"
 
 #include <QVector>
+#include <QTimer>
 #include <QSyntaxHighlighter>
 
 
 class SCsAbstractHighlightingRule;
+class QPlainTextEdit;
 
+/*! Syntax highlighter of sc.s-text. Highlighting of loaded document is lazy: blocks are marked
+ * as pending, visible ones are highlighted first and the rest are highlighted in idle time slices.
+ *
+ * Multi-line rules pass state from block to block. When pending block is highlighted before
+ * blocks above it, its incoming state is found by scan of state rules only, starting from nearest
+ * checkpoint. Checkpoints keep incoming state of every CheckpointInterval-th block.
+ */
 class SCsSyntaxHighlighter : public QSyntaxHighlighter
 {
+    Q_OBJECT
 public:
+    //! State of block, that isn't highlighted yet.
+    static const int PendingState = -2;
+
     SCsSyntaxHighlighter(QTextDocument *parent, QList<SCsAbstractHighlightingRule*> highlightingRules);
     void highlightBlock(const QString &text);
     void setFormating(int, int, QTextCharFormat);
@@ -24,9 +37,57 @@ public:
     int prevBlockState();
 	int curBlockState();
 
+    //! Sets editor, whose visible blocks are highlighted first.
+    void setEditor(QPlainTextEdit *editor);
+
+    /*! Blocks, that are changed after this call, aren't highlighted but marked as pending.
+      Used to load big documents. @see resumeHighlighting
+      */
+    void deferHighlighting();
+    //! Highlights visible pending blocks and schedules highlighting of the rest.
+    void resumeHighlighting();
+
+private slots:
+    void highlightVisibleBlocks();
+    void highlightNextSlice();
+    void scheduleVisibleBlocks();
+    void documentContentsChanged(int position, int charsRemoved, int charsAdded);
+
 private:
+    //! @return State at the end of block, that precedes @p block.
+    int stateBefore(const QTextBlock &block);
+    //! @return State at the end of block with @p text, runs state rules only.
+    int scanState(const QString &text, int incomingState);
+    void saveCheckpoint(int blockNumber, int incomingState);
+    //! Highlights @p block and following pending blocks, at most @p budget pending blocks.
+    void highlightPending(const QTextBlock &block, int budget);
+
+private:
+    static const int CheckpointInterval = 512;
+    static const int IdleSliceBlocks = 256;
+
     QList<SCsAbstractHighlightingRule*> mHighlightingRules;
+    //! Rules, that pass state to next block.
+    QList<SCsAbstractHighlightingRule*> mStateRules;
 
-};
+    QPlainTextEdit *mEditor;
 
+    //! Incoming states of blocks CheckpointInterval * i, first one is always valid.
+    QVector<int> mCheckpoints;
+    //! State of block, that precedes highlighted or scanned block.
+    int mIncomingState;
+    //! Outgoing state of scanned block.
+    int mScanState;
+    bool mScanning;
 
+    bool mDeferred;
+    bool mHasPending;
+    //! Number of pending blocks, that can be highlighted by current request.
+    int mBudget;
+    bool mInRequest;
+    //! Number of block, from which next idle slice looks for pending blocks.
+    int mNextPending;
+
+    QTimer mVisibleTimer;
+    QTimer mIdleTimer;
+};
@@ -10,6 +10,8 @@
 #include "scssyntaxhighlighter.h"
 #include "scsfindwidget.h"
 #include "scserrortablewidget.h"
+#include "projectindex.h"
+#include "interfaces/documentsearcherinterface.h"
 
 
 #include <QHBoxLayout>
@@ -21,6 +23,10 @@
 #include <QTextStream>
 #include <QShortcut>
 #include <QTextCodec>
+#include <QTextBlock>
+
+//! Pause of typing in milliseconds, after which text is passed to project index.
+#define SCS_INDEX_UPDATE_DELAY 300
 
 SCsWindow::SCsWindow(const QString& _windowTitle, QWidget *parent)
     : QWidget(parent)
@@ -48,6 +54,7 @@ SCsWindow::SCsWindow(const QString& _windowTitle, QWidget *parent)
     connect(mFindWidget, SIGNAL(find(QString)), this, SLOT(findTextChanged(QString)));
 
     mHighlighter = new SCsSyntaxHighlighter(mEditor->document(), SCsHighlightingRulesPool::getInstance()->rules());
+    mHighlighter->setEditor(mEditor);
 
 
 
@@ -70,11 +77,18 @@ SCsWindow::SCsWindow(const QString& _windowTitle, QWidget *parent)
 
     connect(mEditor, SIGNAL(textChanged()), this, SLOT(textChanged()));
 
+    mIndexTimer.setSingleShot(true);
+    mIndexTimer.setInterval(SCS_INDEX_UPDATE_DELAY);
+    connect(&mIndexTimer, SIGNAL(timeout()), this, SLOT(updateIndex()));
+
     setWindowTitle(_windowTitle);
 }
 
 SCsWindow::~SCsWindow()
 {
+    if (ProjectIndex::instance() && !mFileName.isEmpty())
+        ProjectIndex::instance()->documentClosed(mFileName);
+
     delete mHighlighter;
     delete mEditor;
 }
@@ -118,7 +132,10 @@ bool SCsWindow::loadFromFile(const QString &fileName)
     QTextStream in(&fileIn);
     in.setCodec("UTF-8");
 
+    // big documents must be usable before all blocks are highlighted
+    mHighlighter->deferHighlighting();
     mEditor->document()->setPlainText(in.readAll());
+    mHighlighter->resumeHighlighting();
     mEditor->setDocumentPath(fileName);
     fileIn.close();
 
@@ -126,6 +143,11 @@ bool SCsWindow::loadFromFile(const QString &fileName)
     setWindowTitle(mFileName + "[*]");
     mIsSaved = true;
 
+    // index reads loaded text from file
+    mIndexTimer.stop();
+    if (ProjectIndex::instance())
+        ProjectIndex::instance()->documentOpened(mFileName);
+
     emitEvent(EditorObserverInterface::ContentLoaded);
 
     return true;
@@ -152,6 +174,14 @@ bool SCsWindow::saveToFile(const QString &fileName)
     out << content;
     fileOut.close();
 
+    mIndexTimer.stop();
+    if (ProjectIndex::instance())
+    {
+        if (!mFileName.isEmpty() && mFileName != fileName)
+            ProjectIndex::instance()->documentClosed(mFileName);
+        ProjectIndex::instance()->documentOpened(fileName);
+    }
+
     mFileName = fileName;
     setWindowTitle(mFileName + "[*]");
     mIsSaved = true;
@@ -184,9 +214,20 @@ QIcon SCsWindow::findIcon(const QString &iconName)
 void SCsWindow::textChanged()
 {
     mIsSaved = false;
+
+    // text is copied only when typing pauses
+    if (ProjectIndex::instance() && !mFileName.isEmpty())
+        mIndexTimer.start();
+
     emitEvent(EditorObserverInterface::ContentChanged);
 }
 
+void SCsWindow::updateIndex()
+{
+    if (ProjectIndex::instance() && !mFileName.isEmpty())
+        ProjectIndex::instance()->documentChanged(mFileName, mEditor->document()->toPlainText().toUtf8());
+}
+
 
 void SCsWindow::findNext()
 {
@@ -231,6 +272,25 @@ void SCsWindow::activate(QMainWindow *window)
     mEditor->setFocus();
 }
 
+void SCsWindow::showSearchHit(const SearchHit &hit)
+{
+    QTextBlock block = mEditor->document()->findBlockByNumber(hit.line - 1);
+    if (!block.isValid())
+        return;
+
+    // lexer counts columns in utf-8 bytes, so they are checked against line text
+    int pos = hit.column - 1;
+    if (pos < 0 || block.text().mid(pos, hit.text.length()) != hit.text)
+        pos = qMax(block.text().indexOf(hit.text), 0);
+
+    QTextCursor cursor(block);
+    cursor.movePosition(QTextCursor::Right, QTextCursor::MoveAnchor, pos);
+    cursor.movePosition(QTextCursor::Right, QTextCursor::KeepAnchor, hit.text.length());
+    mEditor->setTextCursor(cursor);
+    mEditor->centerCursor();
+    mEditor->setFocus();
+}
+
 // ---------------------
 SCsWindowFactory::SCsWindowFactory(QObject *parent) :
     QObject(parent)
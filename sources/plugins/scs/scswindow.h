@@ -10,6 +10,7 @@
 #include "scscodeeditor.h"
 #include "scssyntaxhighlighter.h"
 #include <QWidget>
+#include <QTimer>
 
 class SCsFindWidget;
 class SCsErrorTableWidget;
@@ -56,6 +57,9 @@ public:
 
     void activate(QMainWindow *window);
 
+    //! Selects found identifier. @copydoc EditorInterface::showSearchHit
+    void showSearchHit(const SearchHit &hit);
+
     /*! Get icon specified for window type
     */
     QIcon icon() const;
@@ -68,10 +72,14 @@ private:
     SCsFindWidget *mFindWidget;
     SCsErrorTableWidget *mErrorTable;
     bool mIsSaved;
+    //! Merges edits, so text is passed to project index after typing pauses.
+    QTimer mIndexTimer;
 
 private slots:
     //! Content text changed slot
     void textChanged();
+    //! Passes current text to project index. @see ProjectIndexInterface::documentChanged
+    void updateIndex();
     void findNext();
 
     //! Handle find previous button pressed event